@@ -57,6 +57,9 @@
 #include "ota_context.h"
 /* Storage specific */
 #include "cy_ota_storage_api.h"
+#include "app_ota_resume.h"
+#include "app_ota_erase.h"
+#include "app_log.h"
 /*******************************************************************************
  * Macros
  *******************************************************************************/
@@ -82,9 +85,9 @@ cy_ota_agent_params_t ota_test_agent_params = {0};
  */
 cy_ota_storage_interface_t ota_interfaces =
     {
-        .ota_file_open = cy_ota_storage_open,
+        .ota_file_open = app_ota_resume_storage_open,
         .ota_file_read = cy_ota_storage_read,
-        .ota_file_write = cy_ota_storage_write,
+        .ota_file_write = app_ota_erase_storage_write,
         .ota_file_close = cy_ota_storage_close,
         .ota_file_verify = cy_ota_storage_verify,
         .ota_file_validate = cy_ota_storage_image_validate,
@@ -145,6 +148,13 @@ int main(void)
         printf("\ncy_log_init failed with Error : [0x%X] \n", (unsigned int)result);
     }
 
+    /* Format the Bluetooth(r) hot path messages in a low priority thread */
+    result = app_log_init();
+    if (result != CY_RSLT_SUCCESS)
+    {
+        printf("\napp_log_init failed with Error : [0x%X] \n", (unsigned int)result);
+    }
+
     /* default for OTA logging to NOTICE */
     cy_ota_set_log_level(CY_LOG_NOTICE);
 
@@ -68,7 +68,7 @@
 
 #ifdef USE_EEPROM_TO_STORE_BOND_INFO
 /* EEPROM Configuration details. */
-#define EEPROM_SIZE (sizeof(bondinfo_t))
+#define EEPROM_SIZE (sizeof(bondinfo_t) + EEPROM_INSTALLED_SIZE)
 #define SIMPLE_MODE (0u)
 #define WEAR_LEVELLING_FACTOR (2u)
 #define REDUNDANT_COPY (1u)
@@ -81,6 +81,9 @@
 #define EEPROM_IDENTITY_KEYS_START (EEPROM_SLOT_DATA + sizeof(bondinfo.slot_data))
 #define EEPROM_LINK_KEYS_START (EEPROM_IDENTITY_KEYS_START + sizeof(wiced_bt_local_identity_keys_t))
 #define GET_ADDR_FOR_DEVICE_KEYS(x) (EEPROM_LINK_KEYS_START + (x * sizeof(wiced_bt_device_link_keys_t)))
+/* Record of the last image installed over the air, see app_ota_identity.c */
+#define EEPROM_INSTALLED_START (LOGICAL_EEPROM_START + sizeof(bondinfo_t))
+#define EEPROM_INSTALLED_SIZE (16u)
 
 /* enum for slot_data structure */
 enum
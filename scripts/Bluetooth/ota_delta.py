@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""
+Create and apply OTA delta patches for the Bluetooth LE OTA example.
+
+The patch format is described in source/COMPONENT_OTA_BLUETOOTH/app_ota_delta.h.
+
+  ota_delta.py diff  <running image>.bin <new image>.bin <patch>.otad
+  ota_delta.py apply <running image>.bin <patch>.otad <new image>.bin
+
+"diff" applies the patch it created and compares the result with the new
+image before writing it. Send the patch with bit 0x02 set in the
+CY_OTA_UPGRADE_COMMAND_DOWNLOAD options octet, the image size and the VERIFY
+CRC32 are those of the new image.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = b"OTAD"
+VERSION = 1
+HEADER = struct.Struct("<4sB3xIII")
+
+OP_COPY = 0x01
+OP_ADD = 0x02
+OP_INSERT = 0x03
+
+KEY_LEN = 8         # bytes hashed to find match candidates
+MIN_MATCH = 16      # shortest region worth a COPY or ADD record
+MIN_COPY = 16       # shortest exact run split out of an ADD region
+
+
+def crc32(data):
+    return zlib.crc32(data) & 0xFFFFFFFF
+
+
+def _index(old):
+    index = {}
+    for pos in range(0, len(old) - KEY_LEN + 1):
+        index.setdefault(old[pos:pos + KEY_LEN], pos)
+    return index
+
+
+def _extend(old, new, old_pos, new_pos):
+    """Extend a match with the bsdiff score: keep going while equal bytes
+    outnumber the differences, return the best length."""
+    score = best_score = 0
+    best_len = 0
+    length = 0
+    limit = min(len(old) - old_pos, len(new) - new_pos)
+    while length < limit:
+        score += 1 if old[old_pos + length] == new[new_pos + length] else -1
+        length += 1
+        if score > best_score:
+            best_score, best_len = score, length
+        if score < best_score - MIN_MATCH:
+            break
+    return best_len
+
+
+def _emit_region(records, old, new, old_pos, new_pos, length):
+    """Split a matched region into COPY records for long exact runs and ADD
+    records for the rest."""
+    start = 0
+    pos = 0
+    while pos < length:
+        if old[old_pos + pos] != new[new_pos + pos]:
+            pos += 1
+            continue
+        run = pos
+        while run < length and old[old_pos + run] == new[new_pos + run]:
+            run += 1
+        if run - pos >= MIN_COPY:
+            if pos > start:
+                records.append((OP_ADD, old_pos + start, new_pos + start, pos - start))
+            records.append((OP_COPY, old_pos + pos, new_pos + pos, run - pos))
+            start = run
+        pos = run
+    if length > start:
+        records.append((OP_ADD, old_pos + start, new_pos + start, length - start))
+
+
+def diff(old, new):
+    index = _index(old)
+    records = []
+    insert_start = 0
+    pos = 0
+    last_delta = None
+    while pos < len(new):
+        candidates = []
+        if last_delta is not None and 0 <= pos + last_delta < len(old):
+            candidates.append(pos + last_delta)
+        found = index.get(new[pos:pos + KEY_LEN])
+        if found is not None:
+            candidates.append(found)
+        best_len, best_old = 0, 0
+        for old_pos in candidates:
+            length = _extend(old, new, old_pos, pos)
+            if length > best_len:
+                best_len, best_old = length, old_pos
+        if best_len < MIN_MATCH:
+            pos += 1
+            continue
+        if pos > insert_start:
+            records.append((OP_INSERT, 0, insert_start, pos - insert_start))
+        _emit_region(records, old, new, best_old, pos, best_len)
+        last_delta = best_old - pos
+        pos += best_len
+        insert_start = pos
+    if len(new) > insert_start:
+        records.append((OP_INSERT, 0, insert_start, len(new) - insert_start))
+
+    patch = bytearray(HEADER.pack(MAGIC, VERSION, len(old), crc32(old), len(new)))
+    for op, old_pos, new_pos, length in records:
+        if op == OP_COPY:
+            patch += struct.pack("<BII", op, length, old_pos)
+        elif op == OP_ADD:
+            patch += struct.pack("<BII", op, length, old_pos)
+            patch += bytes((new[new_pos + i] - old[old_pos + i]) & 0xFF for i in range(length))
+        else:
+            patch += struct.pack("<BI", op, length)
+            patch += new[new_pos:new_pos + length]
+    return bytes(patch)
+
+
+def apply(old, patch):
+    magic, version, old_size, old_crc, new_size = HEADER.unpack_from(patch, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not a version %d OTA delta patch" % VERSION)
+    if old_size != len(old) or old_crc != crc32(old):
+        raise ValueError("patch was made for a different base image")
+    new = bytearray()
+    pos = HEADER.size
+    while len(new) < new_size:
+        op = patch[pos]
+        if op in (OP_COPY, OP_ADD):
+            _, length, old_pos = struct.unpack_from("<BII", patch, pos)
+            pos += 9
+            if old_pos + length > len(old):
+                raise ValueError("record outside of the base image")
+            if op == OP_COPY:
+                new += old[old_pos:old_pos + length]
+            else:
+                new += bytes((old[old_pos + i] + patch[pos + i]) & 0xFF for i in range(length))
+                pos += length
+        elif op == OP_INSERT:
+            _, length = struct.unpack_from("<BI", patch, pos)
+            pos += 5
+            new += patch[pos:pos + length]
+            pos += length
+        else:
+            raise ValueError("bad record 0x%x at offset %d" % (op, pos))
+    if len(new) != new_size:
+        raise ValueError("patch exceeds the image size")
+    return bytes(new)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="OTA delta patch tool")
+    sub = parser.add_subparsers(dest="command", required=True)
+    p_diff = sub.add_parser("diff", help="create a patch")
+    p_diff.add_argument("old")
+    p_diff.add_argument("new")
+    p_diff.add_argument("patch")
+    p_apply = sub.add_parser("apply", help="apply a patch")
+    p_apply.add_argument("old")
+    p_apply.add_argument("patch")
+    p_apply.add_argument("new")
+    args = parser.parse_args()
+
+    with open(args.old, "rb") as f:
+        old = f.read()
+
+    if args.command == "diff":
+        with open(args.new, "rb") as f:
+            new = f.read()
+        patch = diff(old, new)
+        if apply(old, patch) != new:
+            sys.exit("internal error: the patch does not rebuild the new image")
+        with open(args.patch, "wb") as f:
+            f.write(patch)
+        print("patch %d bytes for a %d byte image (%d%%), image CRC32 0x%08x"
+              % (len(patch), len(new), (100 * len(patch)) // max(len(new), 1), crc32(new)))
+    else:
+        with open(args.patch, "rb") as f:
+            patch = f.read()
+        new = apply(old, patch)
+        with open(args.new, "wb") as f:
+            f.write(new)
+        print("image %d bytes, CRC32 0x%08x" % (len(new), crc32(new)))
+
+
+if __name__ == "__main__":
+    main()
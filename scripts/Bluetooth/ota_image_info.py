@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""
+Prepend the image info descriptor for the Bluetooth LE OTA example.
+
+The format is described in source/COMPONENT_OTA_BLUETOOTH/app_ota_image_info.h.
+
+  ota_image_info.py <image>.bin <output> --board 0x5913 --version 1.0.1 [--data <payload>]
+
+The descriptor holds the board ID and version the image was built with, and
+the size of <image>.bin. It is followed by <image>.bin, or by --data when the
+image is sent compressed, as a patch or Merkle framed. Send <output> as the
+image data with bit 0x10 set in the CY_OTA_UPGRADE_COMMAND_DOWNLOAD options
+octet. The image size and the VERIFY CRC32 stay those of <image>.bin.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"OTAI"
+VERSION = 1
+DESCRIPTOR = struct.Struct("<4sBxHBBHI")
+
+
+def descriptor(board, major, minor, build, image_size):
+    return DESCRIPTOR.pack(MAGIC, VERSION, board, major, minor, build, image_size)
+
+
+def _version(text):
+    parts = text.split(".")
+    if len(parts) != 3:
+        raise argparse.ArgumentTypeError("version must be MAJOR.MINOR.BUILD")
+    major, minor, build = (int(p, 0) for p in parts)
+    if not (0 <= major <= 0xFF and 0 <= minor <= 0xFF and 0 <= build <= 0xFFFF):
+        raise argparse.ArgumentTypeError("version out of range")
+    return major, minor, build
+
+
+def main():
+    parser = argparse.ArgumentParser(description="OTA image info descriptor tool")
+    parser.add_argument("image", help="image as built, gives the image size")
+    parser.add_argument("output", help="descriptor followed by the data to send")
+    parser.add_argument("--board", type=lambda v: int(v, 0), required=True,
+                        help="board ID, APP_OTA_BOARD_ID of the target build")
+    parser.add_argument("--version", type=_version, required=True,
+                        help="APP_VERSION_MAJOR.MINOR.BUILD of the image")
+    parser.add_argument("--data", help="data to send instead of the image")
+    args = parser.parse_args()
+
+    if not 0 <= args.board <= 0xFFFF:
+        sys.exit("board ID out of range")
+    with open(args.data or args.image, "rb") as f:
+        data = f.read()
+    info = descriptor(args.board, *args.version, os.path.getsize(args.image))
+    with open(args.output, "wb") as f:
+        f.write(info + data)
+    print("board 0x%04x version %d.%d.%d, %d bytes of data" % ((args.board,) + args.version + (len(data),)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""
+Frame OTA data in Merkle tree groups for the Bluetooth LE OTA example.
+
+The format is described in source/COMPONENT_OTA_BLUETOOTH/app_ota_merkle.h.
+
+  ota_merkle.py frame   <payload> <header>.bin <framed>.otam [--group-shift 12]
+  ota_merkle.py unframe <header>.bin <framed>.otam <payload>
+
+The payload is what would otherwise be sent: the image, or its compressed or
+delta form. "frame" unframes its own output and compares the result with the
+payload before writing the files. Sign the header with
+
+  ecdsa_sign <header>.bin
+
+which appends the signature, and send the 108 bytes after 0x22 on the Control
+Point. Set bit 0x08 in the CY_OTA_UPGRADE_COMMAND_DOWNLOAD options octet, the
+image size and the VERIFY CRC32 stay those of the image.
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+
+MAGIC = b"OTAM"
+VERSION = 1
+HEADER = struct.Struct("<4sBBBxI32s")
+HASH_LEN = 32
+MIN_GROUP_SHIFT = 9
+MAX_GROUP_SHIFT = 12
+MAX_DEPTH = 16
+
+LEAF_PREFIX = b"\x00"
+NODE_PREFIX = b"\x01"
+
+
+def _leaf(data):
+    return hashlib.sha256(LEAF_PREFIX + data).digest()
+
+
+def _node(left, right):
+    return hashlib.sha256(NODE_PREFIX + left + right).digest()
+
+
+def _depth(groups):
+    depth = 0
+    while (1 << depth) < groups:
+        depth += 1
+    return depth
+
+
+def _levels(leaves, depth):
+    """All levels of the tree, leaves first. A node without a right child is
+    paired with itself."""
+    levels = [leaves]
+    for _ in range(depth):
+        below = levels[-1]
+        levels.append([_node(below[i], below[i + 1] if i + 1 < len(below) else below[i])
+                       for i in range(0, len(below), 2)])
+    return levels
+
+
+def frame(payload, group_shift):
+    if not MIN_GROUP_SHIFT <= group_shift <= MAX_GROUP_SHIFT:
+        raise ValueError("group shift must be %d to %d" % (MIN_GROUP_SHIFT, MAX_GROUP_SHIFT))
+    if not payload:
+        raise ValueError("empty payload")
+    size = 1 << group_shift
+    groups = [payload[i:i + size] for i in range(0, len(payload), size)]
+    depth = _depth(len(groups))
+    if depth > MAX_DEPTH:
+        raise ValueError("payload too large for group size %d" % size)
+    levels = _levels([_leaf(g) for g in groups], depth)
+    header = HEADER.pack(MAGIC, VERSION, group_shift, depth, len(payload), levels[-1][0])
+
+    framed = bytearray()
+    for index, group in enumerate(groups):
+        node = index
+        for level in range(depth):
+            below = levels[level]
+            sibling = node ^ 1
+            framed += below[sibling] if sibling < len(below) else below[node]
+            node >>= 1
+        framed += group
+    return header, bytes(framed)
+
+
+def unframe(header, framed):
+    magic, version, group_shift, depth, payload_size, root = HEADER.unpack_from(header, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not a version %d Merkle header" % VERSION)
+    size = 1 << group_shift
+    payload = bytearray()
+    pos = 0
+    index = 0
+    while len(payload) < payload_size:
+        siblings = [framed[pos + i * HASH_LEN:pos + (i + 1) * HASH_LEN] for i in range(depth)]
+        pos += depth * HASH_LEN
+        group = framed[pos:pos + min(size, payload_size - len(payload))]
+        pos += len(group)
+        node = _leaf(group)
+        for level, sibling in enumerate(siblings):
+            node = _node(sibling, node) if (index >> level) & 1 else _node(node, sibling)
+        if node != root:
+            raise ValueError("group %d does not match the root" % index)
+        payload += group
+        index += 1
+    if pos != len(framed):
+        raise ValueError("data past the last group")
+    return bytes(payload)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="OTA Merkle framing tool")
+    sub = parser.add_subparsers(dest="command", required=True)
+    p_frame = sub.add_parser("frame", help="frame a payload")
+    p_frame.add_argument("payload")
+    p_frame.add_argument("header")
+    p_frame.add_argument("framed")
+    p_frame.add_argument("--group-shift", type=int, default=MAX_GROUP_SHIFT)
+    p_unframe = sub.add_parser("unframe", help="check framed data and extract the payload")
+    p_unframe.add_argument("header")
+    p_unframe.add_argument("framed")
+    p_unframe.add_argument("payload")
+    args = parser.parse_args()
+
+    if args.command == "frame":
+        with open(args.payload, "rb") as f:
+            payload = f.read()
+        header, framed = frame(payload, args.group_shift)
+        if unframe(header, framed) != payload:
+            sys.exit("internal error: the framed data does not rebuild the payload")
+        with open(args.header, "wb") as f:
+            f.write(header)
+        with open(args.framed, "wb") as f:
+            f.write(framed)
+        print("%d bytes framed in %d groups, %d bytes of hashes (%d%%)"
+              % (len(payload), -(-len(payload) // (1 << args.group_shift)), len(framed) - len(payload),
+                 (100 * (len(framed) - len(payload))) // len(payload)))
+    else:
+        with open(args.header, "rb") as f:
+            header = f.read()
+        with open(args.framed, "rb") as f:
+            framed = f.read()
+        payload = unframe(header, framed)
+        with open(args.payload, "wb") as f:
+            f.write(payload)
+        print("payload %d bytes" % len(payload))
+
+
+if __name__ == "__main__":
+    main()
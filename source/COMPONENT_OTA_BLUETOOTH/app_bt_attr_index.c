@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the handle index over the GATT
+ *              attribute table generated by the Bluetooth® Configurator.
+ *              The index is a dense array from attribute handle to table
+ *              entry, so that a lookup costs the same for any database size.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <string.h>
+#include "cy_ota_api.h"
+#include "app_bt_attr_index.h"
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+/* Table the index was built over */
+static gatt_db_lookup_table_t *attr_table;
+static uint16_t attr_table_size;
+
+/* Dense handle -> attr_table[] index, 0 means "no entry", otherwise entry index + 1 */
+static uint16_t attr_index[APP_BT_ATTR_INDEX_MAX_HANDLE + 1];
+
+/* *****************************************************************************
+ *                              FUNCTIONS
+ * ****************************************************************************/
+
+/*
+ * Function Name:
+ * app_bt_attr_index_build
+ *
+ * Function Description:
+ * @brief  Build the handle index over an attribute table. The first entry
+ *         of a handle wins, as it did with the linear search.
+ *
+ * @param p_table     Pointer to the attribute table, app_gatt_db_ext_attr_tbl
+ * @param table_size  Number of entries in the table
+ *
+ * @return void
+ */
+void app_bt_attr_index_build(gatt_db_lookup_table_t *p_table, uint16_t table_size)
+{
+    uint16_t i;
+
+    attr_table = p_table;
+    attr_table_size = table_size;
+    memset(attr_index, 0x00, sizeof(attr_index));
+    for (i = 0; i < table_size; i++)
+    {
+        uint16_t handle = p_table[i].handle;
+
+        if ((handle <= APP_BT_ATTR_INDEX_MAX_HANDLE) && (attr_index[handle] == 0))
+        {
+            attr_index[handle] = (uint16_t)(i + 1);
+        }
+        else if (handle > APP_BT_ATTR_INDEX_MAX_HANDLE)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s() handle 0x%04x above APP_BT_ATTR_INDEX_MAX_HANDLE, not indexed\n", __func__, handle);
+        }
+    }
+}
+
+/*
+ * Function Name:
+ * app_bt_attr_index_find
+ *
+ * Function Description:
+ * @brief  Find the attribute table entry of a handle.
+ *
+ * @param handle  Attribute handle
+ *
+ * @return gatt_db_lookup_table_t*  Table entry, NULL if the handle is not in the table
+ */
+gatt_db_lookup_table_t *app_bt_attr_index_find(uint16_t handle)
+{
+    uint16_t i;
+
+    if (handle <= APP_BT_ATTR_INDEX_MAX_HANDLE)
+    {
+        return (attr_index[handle] != 0) ? &attr_table[attr_index[handle] - 1] : NULL;
+    }
+
+    for (i = 0; i < attr_table_size; i++)
+    {
+        if (attr_table[i].handle == handle)
+        {
+            return &attr_table[i];
+        }
+    }
+    return NULL;
+}
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the handle
+ *              index over the GATT attribute table generated by the
+ *              Bluetooth® Configurator.
+ */
+
+#ifndef __APP_BT_ATTR_INDEX_H__
+#define __APP_BT_ATTR_INDEX_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include "GeneratedSource/cycfg_gatt_db.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Handles above this value are not indexed and fall back to a linear search */
+#ifndef APP_BT_ATTR_INDEX_MAX_HANDLE
+#define APP_BT_ATTR_INDEX_MAX_HANDLE        (255)
+#endif
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_bt_attr_index_build(gatt_db_lookup_table_t *p_table, uint16_t table_size);
+
+gatt_db_lookup_table_t *app_bt_attr_index_find(uint16_t handle);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_BT_ATTR_INDEX_H__ */
+
+/* [] END OF FILE */
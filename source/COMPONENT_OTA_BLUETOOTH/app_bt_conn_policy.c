@@ -0,0 +1,367 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the
+ *              connection parameter policy.
+ *
+ *              During an OTA session the throughput is bounded by the number
+ *              of connection events per second, so the shortest interval
+ *              with no peripheral latency is requested on PREPARE_DOWNLOAD.
+ *              After VERIFY, ABORT or a disconnection the relaxed profile is
+ *              used again to save power. The central may reject or adjust a
+ *              request; if the parameters it applies do not match the profile
+ *              the request is repeated a few times from a timer. The timer
+ *              only hands the retry over to the Bluetooth® stack thread,
+ *              which owns the policy state.
+ *
+ *              With the default 27 byte LL payload on the 1M PHY, every
+ *              MTU sized write is split into many short link layer PDUs.
+ *              On PREPARE_DOWNLOAD the 251 byte payload and the 2M PHY are
+ *              requested as well. Both stay in place after the session, the
+ *              central is free to change them.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cyabs_rtos.h"
+#include "wiced_bt_l2c.h"
+#include "wiced_bt_stack.h"
+#include "app_bt_conn_policy.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef struct
+{
+    uint16_t    min_interval;
+    uint16_t    max_interval;
+    uint16_t    latency;
+    uint16_t    timeout;
+} app_bt_conn_params_t;
+
+typedef struct
+{
+    bool                    connected;
+    wiced_bt_device_address_t bd_addr;
+    app_bt_conn_profile_t   profile;
+    bool                    requested;      /* a request for the profile is outstanding */
+    uint8_t                 retries;
+    cy_timer_t              retry_timer;
+    bool                    link_setup;     /* DLE and PHY were requested on this connection */
+    uint8_t                 tx_phy;
+    uint8_t                 rx_phy;
+} app_bt_conn_policy_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static const app_bt_conn_params_t conn_profiles[] =
+{
+    [APP_BT_CONN_PROFILE_RELAXED] = { APP_BT_CONN_RELAXED_MIN_INTERVAL, APP_BT_CONN_RELAXED_MAX_INTERVAL, APP_BT_CONN_RELAXED_LATENCY, APP_BT_CONN_RELAXED_TIMEOUT },
+    [APP_BT_CONN_PROFILE_OTA]     = { APP_BT_CONN_OTA_MIN_INTERVAL,     APP_BT_CONN_OTA_MAX_INTERVAL,     APP_BT_CONN_OTA_LATENCY,     APP_BT_CONN_OTA_TIMEOUT     },
+};
+
+static const char *conn_profile_names[] =
+{
+    [APP_BT_CONN_PROFILE_RELAXED] = "RELAXED",
+    [APP_BT_CONN_PROFILE_OTA]     = "OTA",
+};
+
+static app_bt_conn_policy_t policy;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static void app_bt_conn_policy_request(void)
+{
+    const app_bt_conn_params_t *p = &conn_profiles[policy.profile];
+
+    if (!policy.connected)
+    {
+        return;
+    }
+
+    policy.requested = true;
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Conn params -> %s interval %d-%d latency %d timeout %d (try %d)\n",
+               conn_profile_names[policy.profile], p->min_interval, p->max_interval, p->latency, p->timeout, policy.retries + 1);
+    if (wiced_bt_l2cap_update_ble_conn_params(policy.bd_addr, p->min_interval, p->max_interval, p->latency, p->timeout) == 0)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_bt_l2cap_update_ble_conn_params() failed\n", __func__);
+        if (policy.retries < APP_BT_CONN_POLICY_MAX_RETRIES)
+        {
+            policy.retries++;
+            cy_rtos_start_timer(&policy.retry_timer, APP_BT_CONN_POLICY_RETRY_MS);
+        }
+    }
+}
+
+#ifdef APP_BT_CONN_PHY_UPDATE_SUPPORTED
+static void app_bt_conn_policy_set_phy(bool coded)
+{
+    wiced_bt_ble_phy_preferences_t phy_preferences;
+    wiced_bt_dev_status_t status;
+
+    memset(&phy_preferences, 0x00, sizeof(phy_preferences));
+    memcpy(phy_preferences.remote_bd_addr, policy.bd_addr, sizeof(phy_preferences.remote_bd_addr));
+    phy_preferences.tx_phys = (coded) ? BTM_BLE_PREFER_LELR_PHY : BTM_BLE_PREFER_2M_PHY;
+    phy_preferences.rx_phys = phy_preferences.tx_phys;
+    phy_preferences.phy_opts = (coded) ? BTM_BLE_PREFER_LELR_S2 : BTM_BLE_PREFER_NO_LELR;
+
+    status = wiced_bt_ble_set_phy(&phy_preferences);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "PHY -> %s requested, status 0x%x\n", (coded) ? "LE Coded" : "2M", status);
+}
+
+#ifdef APP_BT_CONN_CODED_PHY_RSSI
+static void app_bt_conn_policy_rssi_cb(void *p_data)
+{
+    wiced_bt_dev_rssi_result_t *p_rssi = (wiced_bt_dev_rssi_result_t *)p_data;
+    bool coded = false;
+
+    if ((p_rssi != NULL) && (p_rssi->status == WICED_BT_SUCCESS))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Link RSSI %d dBm\n", p_rssi->rssi);
+        coded = (p_rssi->rssi < APP_BT_CONN_CODED_PHY_RSSI);
+    }
+    app_bt_conn_policy_set_phy(coded);
+}
+#endif
+#endif /* APP_BT_CONN_PHY_UPDATE_SUPPORTED */
+
+/*
+ * Request the 251 byte LL payload and a faster PHY, once per connection
+ */
+static void app_bt_conn_policy_link_setup(void)
+{
+    wiced_bt_dev_status_t status;
+
+    if ((!policy.connected) || (policy.link_setup))
+    {
+        return;
+    }
+    policy.link_setup = true;
+
+    status = wiced_bt_ble_set_data_packet_length(policy.bd_addr, APP_BT_CONN_DLE_TX_OCTETS, APP_BT_CONN_DLE_TX_TIME);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "LL data length -> %d bytes %d us requested, status 0x%x\n",
+               APP_BT_CONN_DLE_TX_OCTETS, APP_BT_CONN_DLE_TX_TIME, status);
+
+#ifdef APP_BT_CONN_PHY_UPDATE_SUPPORTED
+#ifdef APP_BT_CONN_CODED_PHY_RSSI
+    /* The PHY is chosen once the RSSI of the link is known */
+    if (wiced_bt_dev_read_rssi(policy.bd_addr, BT_TRANSPORT_LE, app_bt_conn_policy_rssi_cb) != WICED_BT_PENDING)
+    {
+        app_bt_conn_policy_set_phy(false);
+    }
+#else
+    app_bt_conn_policy_set_phy(false);
+#endif
+#endif
+}
+
+/*
+ * Retry in the Bluetooth® stack thread, the request was granted or dropped
+ * if the policy changed while the event was queued
+ */
+static int app_bt_conn_policy_retry(void *p_data)
+{
+    (void)p_data;
+    if (policy.requested)
+    {
+        app_bt_conn_policy_request();
+    }
+    return 0;
+}
+
+static void app_bt_conn_policy_retry_cb(cy_timer_callback_arg_t arg)
+{
+    (void)arg;
+    if (wiced_app_event_serialize(app_bt_conn_policy_retry, NULL) != WICED_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_app_event_serialize() failed\n", __func__);
+    }
+}
+
+/*
+ * Function Name:
+ * app_bt_conn_policy_init
+ *
+ * Function Description:
+ * @brief  Create the retry timer, called once from bt_app_init().
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_bt_conn_policy_init(void)
+{
+    memset(&policy, 0x00, sizeof(policy));
+    policy.profile = APP_BT_CONN_PROFILE_RELAXED;
+
+    if (cy_rtos_init_timer(&policy.retry_timer, CY_TIMER_TYPE_ONCE, app_bt_conn_policy_retry_cb, 0) != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() cy_rtos_init_timer() failed\n", __func__);
+    }
+}
+
+void app_bt_conn_policy_connected(wiced_bt_device_address_t bd_addr)
+{
+    memcpy(policy.bd_addr, bd_addr, sizeof(policy.bd_addr));
+    policy.connected = true;
+    policy.link_setup = false;
+    policy.tx_phy = 0;
+    policy.rx_phy = 0;
+    policy.requested = false;
+    policy.profile = APP_BT_CONN_PROFILE_RELAXED;
+    policy.retries = 0;
+}
+
+void app_bt_conn_policy_disconnected(void)
+{
+    cy_rtos_stop_timer(&policy.retry_timer);
+    policy.connected = false;
+    policy.requested = false;
+    if (policy.profile != APP_BT_CONN_PROFILE_RELAXED)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Conn params %s -> RELAXED (disconnected)\n", conn_profile_names[policy.profile]);
+    }
+    policy.profile = APP_BT_CONN_PROFILE_RELAXED;
+}
+
+/*
+ * Function Name:
+ * app_bt_conn_policy_set
+ *
+ * Function Description:
+ * @brief  Switch to a connection parameter profile and request it from the
+ *         central.
+ *
+ * @param profile  APP_BT_CONN_PROFILE_OTA on PREPARE_DOWNLOAD,
+ *                 APP_BT_CONN_PROFILE_RELAXED on VERIFY and ABORT
+ *
+ * @return void
+ */
+void app_bt_conn_policy_set(app_bt_conn_profile_t profile)
+{
+    if ((profile == policy.profile) && (!policy.requested))
+    {
+        return;
+    }
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Conn params %s -> %s\n", conn_profile_names[policy.profile], conn_profile_names[profile]);
+    cy_rtos_stop_timer(&policy.retry_timer);
+    policy.profile = profile;
+    policy.retries = 0;
+    app_bt_conn_policy_request();
+
+    if (profile == APP_BT_CONN_PROFILE_OTA)
+    {
+        app_bt_conn_policy_link_setup();
+    }
+}
+
+/*
+ * Function Name:
+ * app_bt_conn_policy_param_update
+ *
+ * Function Description:
+ * @brief  Check the outcome of a connection parameter update against the
+ *         current profile, called on BTM_BLE_CONNECTION_PARAM_UPDATE.
+ *
+ * @param p_update  event data
+ * @param p_params  effective parameters from wiced_bt_ble_get_connection_parameters(), NULL if unknown
+ *
+ * @return void
+ */
+void app_bt_conn_policy_param_update(wiced_bt_ble_connection_param_update_t *p_update, wiced_bt_ble_conn_params_t *p_params)
+{
+    const app_bt_conn_params_t *p = &conn_profiles[policy.profile];
+    uint16_t interval = p_update->conn_interval;
+    uint16_t latency = p_update->conn_latency;
+
+    if (p_params != NULL)
+    {
+        interval = p_params->conn_interval;
+        latency = p_params->conn_latency;
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Conn params %s in effect: interval %d (%d.%02d ms) latency %d timeout %d\n",
+                   conn_profile_names[policy.profile], interval, (interval * 125) / 100, (interval * 125) % 100,
+                   latency, p_params->supervision_timeout);
+    }
+
+    /* Updates started by the central are accepted as they are */
+    if (!policy.requested)
+    {
+        return;
+    }
+
+    if ((p_update->status == 0) &&
+        (interval >= p->min_interval) && (interval <= p->max_interval) && (latency <= p->latency))
+    {
+        cy_rtos_stop_timer(&policy.retry_timer);
+        policy.requested = false;
+        policy.retries = 0;
+        return;
+    }
+
+    /* Rejected or adjusted by the central */
+    if (policy.retries >= APP_BT_CONN_POLICY_MAX_RETRIES)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "Conn params %s not granted after %d tries\n", conn_profile_names[policy.profile], policy.retries + 1);
+        policy.requested = false;
+    }
+    else if (policy.connected)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "Conn params status %d interval %d latency %d do not match %s, retry in %d ms\n",
+                   p_update->status, interval, latency, conn_profile_names[policy.profile], APP_BT_CONN_POLICY_RETRY_MS);
+        policy.retries++;
+        cy_rtos_start_timer(&policy.retry_timer, APP_BT_CONN_POLICY_RETRY_MS);
+    }
+}
+
+#ifdef APP_BT_CONN_PHY_UPDATE_SUPPORTED
+/*
+ * Function Name:
+ * app_bt_conn_policy_phy_update
+ *
+ * Function Description:
+ * @brief  Record the PHY in use, called on BTM_BLE_PHY_UPDATE_EVT.
+ *
+ * @param p_phy_update  event data
+ *
+ * @return void
+ */
+void app_bt_conn_policy_phy_update(wiced_bt_ble_phy_update_t *p_phy_update)
+{
+    if (p_phy_update->status != WICED_BT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "PHY update failed, status 0x%x\n", p_phy_update->status);
+        return;
+    }
+
+    policy.tx_phy = (uint8_t)p_phy_update->tx_phy;
+    policy.rx_phy = (uint8_t)p_phy_update->rx_phy;
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "PHY in effect: tx %d rx %d (1 = 1M, 2 = 2M, 3 = LE Coded)\n", policy.tx_phy, policy.rx_phy);
+}
+#endif /* APP_BT_CONN_PHY_UPDATE_SUPPORTED */
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
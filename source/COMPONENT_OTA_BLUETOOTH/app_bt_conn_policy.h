@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the
+ *              connection parameter policy: the connection interval,
+ *              peripheral latency and supervision timeout requested from
+ *              the central while an OTA session is running and while idle,
+ *              and the PHY and LL data length used for the OTA session.
+ */
+
+#ifndef __APP_BT_CONN_POLICY_H__
+#define __APP_BT_CONN_POLICY_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* OTA profile: shortest interval, no latency. Intervals in 1.25 ms, timeout in 10 ms units */
+#ifndef APP_BT_CONN_OTA_MIN_INTERVAL
+#define APP_BT_CONN_OTA_MIN_INTERVAL        (6)
+#endif
+#ifndef APP_BT_CONN_OTA_MAX_INTERVAL
+#define APP_BT_CONN_OTA_MAX_INTERVAL        (12)
+#endif
+#ifndef APP_BT_CONN_OTA_LATENCY
+#define APP_BT_CONN_OTA_LATENCY             (0)
+#endif
+#ifndef APP_BT_CONN_OTA_TIMEOUT
+#define APP_BT_CONN_OTA_TIMEOUT             (200)
+#endif
+
+/* Relaxed profile: used outside of an OTA session */
+#ifndef APP_BT_CONN_RELAXED_MIN_INTERVAL
+#define APP_BT_CONN_RELAXED_MIN_INTERVAL    (40)
+#endif
+#ifndef APP_BT_CONN_RELAXED_MAX_INTERVAL
+#define APP_BT_CONN_RELAXED_MAX_INTERVAL    (80)
+#endif
+#ifndef APP_BT_CONN_RELAXED_LATENCY
+#define APP_BT_CONN_RELAXED_LATENCY         (4)
+#endif
+#ifndef APP_BT_CONN_RELAXED_TIMEOUT
+#define APP_BT_CONN_RELAXED_TIMEOUT         (600)
+#endif
+
+/* Retries of a request the central rejected or did not apply */
+#ifndef APP_BT_CONN_POLICY_MAX_RETRIES
+#define APP_BT_CONN_POLICY_MAX_RETRIES      (3)
+#endif
+#ifndef APP_BT_CONN_POLICY_RETRY_MS
+#define APP_BT_CONN_POLICY_RETRY_MS         (1000)
+#endif
+
+/* LL payload and time requested for the OTA session (Data Length Extension) */
+#ifndef APP_BT_CONN_DLE_TX_OCTETS
+#define APP_BT_CONN_DLE_TX_OCTETS           (251)
+#endif
+#ifndef APP_BT_CONN_DLE_TX_TIME
+#define APP_BT_CONN_DLE_TX_TIME             (2120)
+#endif
+
+/*
+ * Define APP_BT_CONN_CODED_PHY_RSSI (for example -85) to ask for the LE Coded
+ * PHY instead of the 2M PHY when the RSSI of the link is below this value.
+ */
+
+#if ( defined(CYW20819A1) || defined(CYW20829A0LKML) || defined (CYW20829B0LKML) || defined (CYW89829B01MKSBG) || defined(COMPONENT_H1_CP))
+#define APP_BT_CONN_PHY_UPDATE_SUPPORTED
+#endif
+
+typedef enum
+{
+    APP_BT_CONN_PROFILE_RELAXED,
+    APP_BT_CONN_PROFILE_OTA,
+} app_bt_conn_profile_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_bt_conn_policy_init(void);
+
+void app_bt_conn_policy_connected(wiced_bt_device_address_t bd_addr);
+
+void app_bt_conn_policy_disconnected(void);
+
+void app_bt_conn_policy_set(app_bt_conn_profile_t profile);
+
+void app_bt_conn_policy_param_update(wiced_bt_ble_connection_param_update_t *p_update, wiced_bt_ble_conn_params_t *p_params);
+
+#ifdef APP_BT_CONN_PHY_UPDATE_SUPPORTED
+void app_bt_conn_policy_phy_update(wiced_bt_ble_phy_update_t *p_phy_update);
+#endif
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_BT_CONN_POLICY_H__ */
+
+/* [] END OF FILE */
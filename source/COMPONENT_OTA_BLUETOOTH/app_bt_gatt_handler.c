@@ -33,9 +33,31 @@
 
 #include "app_bt_gatt_handler.h"
 #include "app_bt_utils.h"
+#include "app_ota_metrics.h"
+#include "app_ota_timing.h"
+#include "app_ota_stats.h"
+#include "app_ota_crc32.h"
+#include "app_ota_stage.h"
+#include "app_ota_stream.h"
+#include "app_ota_decomp.h"
+#include "app_ota_delta.h"
+#include "app_ota_resume.h"
+#include "app_ota_erase.h"
+#include "app_ota_activate.h"
+#include "app_ota_verify.h"
+#include "app_ota_merkle.h"
+#include "app_ota_image_info.h"
+#include "app_ota_identity.h"
+#include "app_ota_coc.h"
+#include "app_bt_conn_policy.h"
+#include "app_bt_pool.h"
+#include "app_bt_attr_index.h"
+#include "app_bt_write_queue.h"
+#include "app_log.h"
 #include "GeneratedSource/cycfg_gatt_db.h"
 #include "GeneratedSource/cycfg_bt_settings.h"
 #include "GeneratedSource/cycfg_gap.h"
+#include "cyhal.h"
 #include "cyhal_gpio.h"
 
 #ifndef COMPONENT_H1_CP
@@ -45,9 +67,9 @@
 #endif
 #include "wiced_bt_ble.h"
 #include "wiced_bt_l2c.h"
+#include "wiced_bt_stack.h"
 
 #include "cyabs_rtos.h"
-#include <stdlib.h>
 /* *****************************************************************************
  *                              DEFINES
  * ****************************************************************************/
@@ -63,6 +85,11 @@ static const uint8_t BLE_CONFIG_UUID_SERVICE_OTA_FW_UPGRADE_SERVICE[] = {__UUID_
 
 typedef void (*pfn_free_buffer_t)(uint8_t *p_data);
 
+/* The host may send an Execute Write of DATA once the ring has APP_OTA_STAGE_HEADROOM free */
+#if (APP_BT_WRITE_QUEUE_SIZE > APP_OTA_STAGE_HEADROOM)
+#error "APP_BT_WRITE_QUEUE_SIZE does not fit in APP_OTA_STAGE_HEADROOM"
+#endif
+
 ota_app_context_t ota_app;
 /* *****************************************************************************
  *                              Data
@@ -81,16 +108,43 @@ static bondinfo_t bondinfo;
  * uint8_t ds_image_prefix[8] = { 'B', 'R', 'C', 'M', 'c', 'f', 'g', 'D' };
  */
 
-/* The write req info structure to handle GATT_REQ_PREPARE_WRITE and GATT_REQ_EXECUTE_WRITE */
-typedef struct gatt_write_req_buf
+/* Running CRC32 of the image bytes accepted since CY_OTA_UPGRADE_COMMAND_DOWNLOAD, kept by the storage thread */
+static uint32_t ota_image_crc32 = APP_OTA_CRC32_INIT;
+
+/* Write response to a DATA write or Execute Write, held back while the staging ring is short of APP_OTA_STAGE_HEADROOM */
+typedef struct
 {
-    uint8_t value[CY_BT_MTU_SIZE];
-    uint16_t written;
-    uint16_t handle;
-    bool in_use;
-} gatt_write_req_buf_t;
+    volatile bool           pending;
+    uint16_t                conn_id;
+    wiced_bt_gatt_opcode_t  opcode;
+    uint16_t                handle;
+} app_bt_deferred_rsp_t;
+
+static app_bt_deferred_rsp_t deferred_write_rsp;
+
+/* Streaming acknowledgement, held back while the staging ring is short of APP_OTA_STAGE_HEADROOM */
+static volatile bool deferred_stream_ack;
+
+/* The Execute Write being applied staged image data */
+static bool execute_write_data;
+
+/* The host was told that the image data of this download was lost */
+static bool data_failure_notified;
+
+/* CY_OTA_UPGRADE_COMMAND_VERIFY waits for APP_OTA_STAGE_EVT_DONE */
+static bool verify_pending;
+static uint32_t verify_final_crc32;
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+static bool verify_signed;          /* the storage thread checks the signature */
+#endif
+
+/* ATT MTU of the current connection */
+static uint16_t bt_mtu = GATT_DEF_BLE_MTU_SIZE;
 
-gatt_write_req_buf_t write_buff;
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+static void app_bt_ota_verify_done(cy_rslt_t result);
 
 /* *****************************************************************************
  *                              FUNCTION DEFINITIONS
@@ -98,8 +152,8 @@ gatt_write_req_buf_t write_buff;
 
 static uint8_t *app_bt_alloc_buffer(uint16_t len)
 {
-    uint8_t *p = (uint8_t *)malloc(len);
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "%s() len %d alloc %p\n", __FUNCTION__, len, p);
+    uint8_t *p = app_bt_pool_alloc(len);
+    APP_LOG(CY_LOG_DEBUG, "%s() len %d alloc %p\n", __FUNCTION__, len, p);
     return p;
 }
 
@@ -108,8 +162,8 @@ static void app_bt_free_buffer(uint8_t *p_data)
     if (p_data != NULL)
     {
         /* moved before free() CID 419663 (#1 of 1): Use after free (USE_AFTER_FREE) */
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "%s()        free:%p\n", __FUNCTION__, p_data);
-        free(p_data);
+        APP_LOG(CY_LOG_DEBUG, "%s()        free:%p\n", __FUNCTION__, p_data);
+        app_bt_pool_free(p_data);
     }
 }
 
@@ -117,11 +171,12 @@ static wiced_bt_gatt_status_t app_bt_ble_send_notification(uint16_t bt_conn_id,
 {
     wiced_bt_gatt_status_t status = (wiced_bt_gatt_status_t)WICED_BT_GATT_ERROR;
 
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "%s() Sending Notification conn_id: 0x%x (%d) handle: 0x%x (%d) val_len: %d value:%d\n", __func__, bt_conn_id, bt_conn_id, attr_handle, attr_handle, val_len, *p_val);
+    APP_LOG(CY_LOG_DEBUG, "%s() Sending Notification conn_id: 0x%x handle: 0x%x val_len: %d value:%d\n", __func__, bt_conn_id, attr_handle, val_len, *p_val);
     status = wiced_bt_gatt_server_send_notification(bt_conn_id, attr_handle, val_len, p_val, NULL); /* bt_notify_buff is not allocated, no need to keep track of it w/context */
     if (status != WICED_BT_SUCCESS)
     {
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() Notification FAILED conn_id:0x%x (%d) handle: %d val_len: %d value:%d\n", __func__, bt_conn_id, bt_conn_id, attr_handle, val_len, *p_val);
+        app_ota_stats_notify_failed();
+        APP_LOG(CY_LOG_ERR, "%s() Notification FAILED conn_id: 0x%x handle: 0x%x val_len: %d value:%d\n", __func__, bt_conn_id, attr_handle, val_len, *p_val);
     }
     return status;
 }
@@ -130,15 +185,295 @@ static wiced_bt_gatt_status_t app_bt_ble_send_indication(uint16_t bt_conn_id, ui
 {
     wiced_bt_gatt_status_t status = (wiced_bt_gatt_status_t)WICED_BT_GATT_ERROR;
 
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "%s() Sending Indication conn_id: 0x%x (%d) handle: %d val_len: %d value:%d\n", __func__, bt_conn_id, bt_conn_id, attr_handle, val_len, *p_val);
+    APP_LOG(CY_LOG_DEBUG, "%s() Sending Indication conn_id: 0x%x handle: 0x%x val_len: %d value:%d\n", __func__, bt_conn_id, attr_handle, val_len, *p_val);
     status = wiced_bt_gatt_server_send_indication(bt_conn_id, attr_handle, val_len, p_val, NULL); /* bt_notify_buff is not allocated, no need to keep track of it w/context */
     if (status != WICED_BT_SUCCESS)
     {
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() Indication FAILED conn_id:0x%x (%d) handle: %d val_len: %d value:%d\n", __func__, bt_conn_id, bt_conn_id, attr_handle, val_len, *p_val);
+        APP_LOG(CY_LOG_ERR, "%s() Indication FAILED conn_id: 0x%x handle: 0x%x val_len: %d value:%d\n", __func__, bt_conn_id, attr_handle, val_len, *p_val);
     }
     return status;
 }
 
+#ifdef HDLC_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_VALUE
+/* A statistics notification is queued to the Bluetooth® stack thread */
+static volatile bool stats_notify_pending;
+
+/*
+ * Periodic OTA Statistics notification, serialized to the Bluetooth® stack thread
+ */
+static int app_bt_notify_stats_event(void *p_data)
+{
+    static app_ota_stats_value_t value;
+
+    (void)p_data;
+
+    stats_notify_pending = false;
+    if (ota_app.bt_conn_id == 0)
+    {
+        return 0;
+    }
+    app_ota_stats_get(&value);
+    (void)app_bt_ble_send_notification(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_VALUE,
+                                       (uint16_t)MIN(sizeof(value), bt_mtu - 3), (uint8_t *)&value);
+    return 0;
+}
+
+/*
+ * Called from the statistics timer, hands the notification over to the Bluetooth® stack thread
+ */
+static void app_bt_notify_stats(void)
+{
+    if (stats_notify_pending)
+    {
+        return;
+    }
+    stats_notify_pending = true;
+    if (wiced_app_event_serialize(app_bt_notify_stats_event, NULL) != WICED_SUCCESS)
+    {
+        stats_notify_pending = false;
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_app_event_serialize() failed\n", __func__);
+    }
+}
+#endif
+
+/*
+ * Switch to the verified image, called once by app_ota_activate
+ */
+static void app_bt_ota_activate(void)
+{
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s()   RESETTING NOW !!!!\n", __func__);
+    app_ota_timing_mark(APP_OTA_PHASE_RESET);
+    app_ota_timing_report();
+#ifdef COMPONENT_H1_CP
+    cy_ota_storage_switch_to_new_image(1);
+#endif
+#ifdef COMPONENT_THREADX
+    cyhal_system_reset_device();
+#else
+    NVIC_SystemReset();
+#endif
+}
+
+/*
+ * Take ownership of a deferred response, only one caller can win
+ */
+static bool app_bt_claim_deferred(volatile bool *p_pending)
+{
+    bool pending;
+    uint32_t irq_state = cyhal_system_critical_section_enter();
+
+    pending = *p_pending;
+    *p_pending = false;
+    cyhal_system_critical_section_exit(irq_state);
+
+    return pending;
+}
+
+/*
+ * Write Response, or Execute Write Response to a long write
+ */
+static void app_bt_send_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t handle)
+{
+    if (opcode == GATT_REQ_EXECUTE_WRITE)
+    {
+        wiced_bt_gatt_server_send_execute_write_rsp(conn_id, opcode);
+    }
+    else
+    {
+        wiced_bt_gatt_server_send_write_rsp(conn_id, opcode, handle);
+    }
+}
+
+/*
+ * Function Name:
+ * app_bt_send_data_write_rsp
+ *
+ * Function Description:
+ * @brief  Acknowledge a DATA write, or an Execute Write that carried DATA.
+ *         While the staging ring is short of APP_OTA_STAGE_HEADROOM the
+ *         response is held back, the host cannot send the next DATA write
+ *         before it gets the response, so the radio is paced by the flash.
+ *
+ * @param conn_id  Bluetooth® connection ID
+ * @param opcode   GATT opcode of the write request
+ * @param handle   GATT attribute handle
+ *
+ * @return void
+ */
+static void app_bt_send_data_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t handle)
+{
+    deferred_write_rsp.conn_id = conn_id;
+    deferred_write_rsp.opcode = opcode;
+    deferred_write_rsp.handle = handle;
+    deferred_write_rsp.pending = true;
+
+    if (app_ota_stage_has_room() && app_bt_claim_deferred(&deferred_write_rsp.pending))
+    {
+        app_bt_send_write_rsp(conn_id, opcode, handle);
+    }
+    else
+    {
+        APP_LOG(CY_LOG_DEBUG, "%s() staging ring short of headroom, write response deferred\n", __func__);
+    }
+}
+
+/*
+ * Streaming acknowledgement, only sent from the Bluetooth® stack thread,
+ * which also owns the stream sequence state
+ */
+static void app_bt_notify_stream_ack(uint8_t status)
+{
+    uint8_t bt_notify_buff[APP_OTA_STREAM_ACK_LEN];
+    uint16_t len = app_ota_stream_build_ack(status, bt_notify_buff);
+
+    app_bt_ble_send_notification(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, len, bt_notify_buff);
+}
+
+/*
+ * Function Name:
+ * app_bt_notify_data_failed
+ *
+ * Function Description:
+ * @brief  Tell the host that image data was lost, once per download. A Write
+ *         Command and the L2CAP data channel have no error response, the
+ *         host learns of the failure from this notification instead.
+ *
+ * @param void
+ *
+ * @return void
+ */
+static void app_bt_notify_data_failed(void)
+{
+    uint8_t bt_notify_buff = CY_OTA_UPGRADE_STATUS_BAD;
+
+    if ((ota_app.bt_conn_id != 0) && !data_failure_notified)
+    {
+        data_failure_notified = true;
+        app_bt_ble_send_notification(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, 1, &bt_notify_buff);
+    }
+}
+
+/*
+ * Function Name:
+ * app_bt_send_stream_ack
+ *
+ * Function Description:
+ * @brief  Return credits to the host of a streaming transfer. Like the write
+ *         response of the legacy transfer, the acknowledgement is held back
+ *         while the staging ring is short of APP_OTA_STAGE_HEADROOM, which
+ *         covers a full window.
+ *
+ * @param void
+ *
+ * @return void
+ */
+static void app_bt_send_stream_ack(void)
+{
+    deferred_stream_ack = true;
+
+    if (app_ota_stage_has_room() && app_bt_claim_deferred(&deferred_stream_ack))
+    {
+        app_bt_notify_stream_ack(APP_OTA_STATUS_STREAM_ACK);
+    }
+}
+
+/*
+ * Function Name:
+ * app_bt_stage_event
+ *
+ * Function Description:
+ * @brief  Events from the OTA storage thread, see app_ota_stage.h, handled in
+ *         the Bluetooth® stack thread like every other GATT operation.
+ *
+ * @param p_event  APP_OTA_STAGE_EVT_xxx
+ *
+ * @return int  0
+ */
+static int app_bt_stage_event(void *p_event)
+{
+    switch ((app_ota_stage_evt_t)(uintptr_t)p_event)
+    {
+    case APP_OTA_STAGE_EVT_ROOM:
+        /* More data may have arrived since the block was freed, another ROOM follows then */
+        if (!app_ota_stage_has_room())
+        {
+            break;
+        }
+        if (app_bt_claim_deferred(&deferred_write_rsp.pending))
+        {
+            app_bt_send_write_rsp(deferred_write_rsp.conn_id, deferred_write_rsp.opcode, deferred_write_rsp.handle);
+        }
+        if (app_bt_claim_deferred(&deferred_stream_ack))
+        {
+            app_bt_notify_stream_ack(APP_OTA_STATUS_STREAM_ACK);
+        }
+        app_ota_coc_room();
+        break;
+
+    case APP_OTA_STAGE_EVT_COMMIT:
+    {
+        uint32_t offset;
+        uint32_t crc32;
+
+        app_ota_stage_checkpoint(&offset, &crc32);
+        app_ota_resume_save(offset, crc32);
+        break;
+    }
+
+    case APP_OTA_STAGE_EVT_DONE:
+        app_bt_ota_verify_done(app_ota_stage_error());
+        break;
+
+    case APP_OTA_STAGE_EVT_ERROR:
+    {
+        cy_rslt_t result = app_ota_stage_error();
+
+        /* The session was aborted or restarted since */
+        if (result == CY_RSLT_SUCCESS)
+        {
+            break;
+        }
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() image data failed - result: 0x%lx\n", __func__, result);
+        if (app_bt_claim_deferred(&deferred_write_rsp.pending))
+        {
+            wiced_bt_gatt_server_send_error_rsp(deferred_write_rsp.conn_id, deferred_write_rsp.opcode, deferred_write_rsp.handle, WICED_BT_GATT_ERROR);
+        }
+        (void)app_bt_claim_deferred(&deferred_stream_ack);
+        app_bt_notify_data_failed();
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+/*
+ * Function Name:
+ * app_bt_stage_callback
+ *
+ * Function Description:
+ * @brief  Events from the OTA storage thread, see app_ota_stage.h. This runs
+ *         in the storage thread, the event is only passed on to the
+ *         Bluetooth® stack thread, which owns the GATT state.
+ *
+ * @param event   APP_OTA_STAGE_EVT_xxx
+ * @param result  storage result for APP_OTA_STAGE_EVT_ERROR, see app_ota_stage_error()
+ *
+ * @return void
+ */
+static void app_bt_stage_callback(app_ota_stage_evt_t event, cy_rslt_t result)
+{
+    (void)result;
+
+    if (wiced_app_event_serialize(app_bt_stage_event, (void *)(uintptr_t)event) != WICED_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_app_event_serialize() failed for event %d\n", __func__, event);
+    }
+}
+
 /*
  * Function Name:
  * app_bt_connect_callback
@@ -177,6 +512,10 @@ static wiced_bt_gatt_status_t app_bt_connect_callback(wiced_bt_gatt_connection_s
 
         ota_app.bt_conn_id = p_conn_status->conn_id;                       /* Save Bluetooth® connection ID in application data structure */
         memcpy(ota_app.bt_peer_addr, p_conn_status->bd_addr, BD_ADDR_LEN); /* Save Bluetooth® peer ADDRESS in application data structure */
+        app_ota_timing_connected();
+        app_ota_stats_connected();
+        bt_mtu = GATT_DEF_BLE_MTU_SIZE;
+        app_bt_conn_policy_connected(p_conn_status->bd_addr);
         gatt_status = wiced_bt_start_advertisements(BTM_BLE_ADVERT_OFF,
                                                     BLE_ADDR_PUBLIC,
                                                     NULL);
@@ -192,6 +531,16 @@ static wiced_bt_gatt_status_t app_bt_connect_callback(wiced_bt_gatt_connection_s
 
         /* Handle the disconnection */
         ota_app.bt_conn_id = 0; /* clear Bluetooth® connection ID in application structure */
+        (void)app_bt_claim_deferred(&deferred_write_rsp.pending);
+        app_bt_write_queue_clear();
+        app_ota_resume_flush();
+        app_ota_coc_enable(false);
+        app_bt_conn_policy_disconnected();
+        app_ota_stats_disconnected();
+        app_ota_identity_disconnected();
+        app_ota_activate_disconnected();
+        app_bt_pool_log_stats();
+        app_ota_timing_report();
 
         gatt_status = wiced_bt_start_advertisements(
             BTM_BLE_ADVERT_UNDIRECTED_HIGH,
@@ -207,15 +556,7 @@ static wiced_bt_gatt_status_t app_bt_connect_callback(wiced_bt_gatt_connection_s
  */
 static gatt_db_lookup_table_t *app_bt_find_by_handle(uint16_t handle)
 {
-    int i;
-    for (i = 0; i < app_gatt_db_ext_attr_tbl_size; i++)
-    {
-        if (app_gatt_db_ext_attr_tbl[i].handle == handle)
-        {
-            return (&app_gatt_db_ext_attr_tbl[i]);
-        }
-    }
-    return NULL;
+    return app_bt_attr_index_find(handle);
 }
 
 static wiced_bt_gatt_status_t app_gatt_req_read_handler(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, wiced_bt_gatt_read_t *p_read_req, uint16_t len_requested)
@@ -230,6 +571,37 @@ static wiced_bt_gatt_status_t app_gatt_req_read_handler(uint16_t conn_id, wiced_
         wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, p_read_req->handle, WICED_BT_GATT_INVALID_HANDLE);
         return WICED_BT_GATT_INVALID_HANDLE;
     }
+#ifdef HDLC_OTA_FW_UPGRADE_SERVICE_OTA_TIMING_VALUE
+    if ((p_read_req->handle == HDLC_OTA_FW_UPGRADE_SERVICE_OTA_TIMING_VALUE) && (p_read_req->offset == 0))
+    {
+        /* Refresh the value on the first read, a long read continues on the same snapshot */
+        app_ota_timing_summary_t summary;
+
+        app_ota_timing_get(&summary);
+        puAttribute->cur_len = MIN(puAttribute->max_len, sizeof(summary));
+        memcpy(puAttribute->p_data, &summary, puAttribute->cur_len);
+    }
+#endif
+#ifdef HDLC_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_VALUE
+    if ((p_read_req->handle == HDLC_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_VALUE) && (p_read_req->offset == 0))
+    {
+        app_ota_stats_value_t value;
+
+        app_ota_stats_get(&value);
+        puAttribute->cur_len = MIN(puAttribute->max_len, sizeof(value));
+        memcpy(puAttribute->p_data, &value, puAttribute->cur_len);
+    }
+#endif
+#ifdef HDLC_OTA_FW_UPGRADE_SERVICE_OTA_IMAGE_IDENTITY_VALUE
+    if ((p_read_req->handle == HDLC_OTA_FW_UPGRADE_SERVICE_OTA_IMAGE_IDENTITY_VALUE) && (p_read_req->offset == 0))
+    {
+        app_ota_identity_value_t value;
+
+        app_ota_identity_get(&value);
+        puAttribute->cur_len = MIN(puAttribute->max_len, sizeof(value));
+        memcpy(puAttribute->p_data, &value, puAttribute->cur_len);
+    }
+#endif
     attr_len_to_copy = puAttribute->cur_len;
     cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() conn_id: %d handle:0x%04x offset:%d len:%d\n", __func__,
                conn_id, p_read_req->handle, p_read_req->offset, attr_len_to_copy);
@@ -357,76 +729,337 @@ static wiced_bt_gatt_status_t app_gatt_req_read_multi_handler(uint16_t conn_id,
         }
     }
 
-    if (used == 0)
+    if (used == 0)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s() no attr found\n", __func__);
+
+        wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, *p_read_req->p_handle_stream, WICED_BT_GATT_INVALID_HANDLE);
+        /* CID 470528 (#1 of 1): Resource leak (RESOURCE_LEAK) */
+        app_bt_free_buffer(p_rsp);
+        return WICED_BT_GATT_INVALID_HANDLE;
+    }
+
+    /* Send the response */
+    wiced_bt_gatt_server_send_read_multiple_rsp(conn_id, opcode, used, p_rsp, (void *)app_bt_free_buffer);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_bt_set_value
+ *
+ * Function Description:
+ * @brief  The function is invoked by app_bt_write_handler to set a value
+ *         to GATT DB.
+ *
+ * @param attr_handle  GATT attribute handle
+ * @param p_val        Pointer to Bluetooth® GATT write request value
+ * @param len          length of GATT write request
+ *
+ * @return wiced_bt_gatt_status_t  Bluetooth® GATT status
+ */
+static wiced_bt_gatt_status_t app_bt_set_value(uint16_t attr_handle,
+                                               uint8_t *p_val,
+                                               uint16_t len)
+{
+    wiced_bt_gatt_status_t result = WICED_BT_GATT_INVALID_HANDLE;
+    gatt_db_lookup_table_t *puAttribute;
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() handle : 0x%x (%d)\n", __func__, attr_handle, attr_handle);
+
+    /* Check for a matching handle entry */
+    if ((puAttribute = app_bt_find_by_handle(attr_handle)) != NULL)
+    {
+        /* Detected a matching handle in the external lookup table */
+        if (puAttribute->max_len >= len)
+        {
+            /* Value fits within the supplied buffer; copy over the value */
+            puAttribute->cur_len = len;
+            memset(puAttribute->p_data, 0x00, puAttribute->max_len);
+            memcpy(puAttribute->p_data, p_val, puAttribute->cur_len);
+
+            if (memcmp(puAttribute->p_data, p_val, puAttribute->cur_len) == 0)
+            {
+                result = WICED_BT_GATT_SUCCESS;
+            }
+        }
+        else
+        {
+            /* Value to write will not fit within the table */
+            result = WICED_BT_GATT_INVALID_ATTR_LEN;
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "Invalid attribute length\n");
+        }
+    }
+    if (result != WICED_BT_GATT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() FAILED 0x%lx\n", __func__, result);
+    }
+
+    return result;
+}
+
+/*
+ * Decoded image bytes, in order, in the storage thread
+ */
+static cy_rslt_t app_bt_ota_image_write(const uint8_t *p_data, uint16_t len)
+{
+    cy_rslt_t result;
+
+    /* Gathered into a sector sized block that is programmed once it is full */
+    result = app_ota_stage_output(p_data, len);
+    if (result == CY_RSLT_SUCCESS)
+    {
+        ota_image_crc32 = app_ota_crc32_update(ota_image_crc32, p_data, len);
+    }
+    return result;
+}
+
+/*
+ * Uncompressed image data, a patch is applied to the running image here
+ */
+static cy_rslt_t app_bt_ota_decoded_write(const uint8_t *p_data, uint16_t len)
+{
+    if (app_ota_delta_enabled())
+    {
+        return app_ota_delta_write(p_data, len);
+    }
+    return app_bt_ota_image_write(p_data, len);
+}
+
+/*
+ * Payload, after the Merkle framing is removed
+ */
+static cy_rslt_t app_bt_ota_payload_write(const uint8_t *p_data, uint16_t len)
+{
+    if (app_ota_decomp_enabled())
+    {
+        return app_ota_decomp_write(p_data, len);
+    }
+    return app_bt_ota_decoded_write(p_data, len);
+}
+
+/*
+ * Function Name:
+ * app_bt_ota_data_process
+ *
+ * Function Description:
+ * @brief  Staged OTA image data, in the storage thread. The image info
+ *         descriptor is checked, framed data is authenticated, a compressed
+ *         image is decoded and a patch is applied on the way, the CRC32
+ *         covers the resulting image. The output of one block may be many
+ *         times its size, it is written before the next block is taken.
+ *
+ * @param p_data  image data as received
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, the image refusal, authentication,
+ *                    decoder, patch or storage error
+ */
+static cy_rslt_t app_bt_ota_data_process(const uint8_t *p_data, uint16_t len)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    const uint8_t *p_payload = p_data;
+    uint16_t payload_len = len;
+
+    /* The descriptor comes first, a refused image goes no further */
+    if (app_ota_image_info_pending())
+    {
+        result = app_ota_image_info_write(&p_payload, &payload_len);
+    }
+    if ((result == CY_RSLT_SUCCESS) && (payload_len != 0))
+    {
+        if (app_ota_merkle_enabled())
+        {
+            result = app_ota_merkle_write(p_payload, payload_len);
+        }
+        else
+        {
+            result = app_bt_ota_payload_write(p_payload, payload_len);
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Function Name:
+ * app_bt_ota_data_write
+ *
+ * Function Description:
+ * @brief  Common path for OTA image data, from GATT DATA writes and from the
+ *         L2CAP data channel. The data is only copied into the staging ring,
+ *         see app_bt_ota_data_process() for the rest of the path.
+ *
+ * @param p_data  image data as received
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS or the staging error
+ */
+static cy_rslt_t app_bt_ota_data_write(const uint8_t *p_data, uint16_t len)
+{
+    cy_rslt_t result;
+    uint32_t write_start = app_ota_metrics_write_begin();
+
+    result = app_ota_stage_write(p_data, len);
+    app_ota_metrics_write_end(write_start, len);
+    app_ota_timing_data(write_start);
+    app_ota_stats_data(write_start, len);
+    if (result == CY_RSLT_SUCCESS)
+    {
+        APP_LOG(CY_LOG_NOTICE, "   Received 0x%lx of 0x%lx\n", app_ota_stage_received(),
+                ((cy_ota_context_t *)(ota_app.ota_context))->ota_storage_context.total_image_size);
+    }
+
+    return result;
+}
+
+/*
+ * Image refused by the image info policy, tell the host why
+ */
+static int app_bt_ota_image_rejected_event(void *p_reason)
+{
+    uint8_t bt_notify_buff[APP_OTA_IMAGE_REJECT_LEN];
+    uint16_t len = app_ota_image_info_build_reject((uint8_t)(uintptr_t)p_reason, bt_notify_buff);
+
+    /* The reason replaces the failure notification of the refused data */
+    data_failure_notified = true;
+    if (ota_app.bt_conn_id != 0)
+    {
+        app_bt_ble_send_notification(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, len, bt_notify_buff);
+    }
+    return 0;
+}
+
+/*
+ * The descriptor is checked in the storage thread, the notification is sent
+ * from the Bluetooth® stack thread ahead of the error event of the data
+ */
+static void app_bt_ota_image_rejected(uint8_t reason)
+{
+    if (wiced_app_event_serialize(app_bt_ota_image_rejected_event, (void *)(uintptr_t)reason) != WICED_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_app_event_serialize() failed\n", __func__);
+    }
+}
+
+/*
+ * OTA image data received on the L2CAP data channel
+ */
+static cy_rslt_t app_bt_coc_data_callback(const uint8_t *p_data, uint16_t len)
+{
+    cy_rslt_t result = app_bt_ota_data_write(p_data, len);
+
+    if (result != CY_RSLT_SUCCESS)
     {
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s() no attr found\n", __func__);
-
-        wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, *p_read_req->p_handle_stream, WICED_BT_GATT_INVALID_HANDLE);
-        /* CID 470528 (#1 of 1): Resource leak (RESOURCE_LEAK) */
-        app_bt_free_buffer(p_rsp);
-        return WICED_BT_GATT_INVALID_HANDLE;
+        app_bt_notify_data_failed();
     }
 
-    /* Send the response */
-    wiced_bt_gatt_server_send_read_multiple_rsp(conn_id, opcode, used, p_rsp, (void *)app_bt_free_buffer);
-    return WICED_BT_GATT_SUCCESS;
+    return result;
 }
 
 /*
  * Function Name:
- * app_bt_set_value
+ * app_bt_ota_verify_done
  *
  * Function Description:
- * @brief  The function is invoked by app_bt_write_handler to set a value
- *         to GATT DB.
+ * @brief  Complete CY_OTA_UPGRADE_COMMAND_VERIFY once the storage thread
+ *         wrote the last block, and send the outcome in an indication on
+ *         the control point.
  *
- * @param attr_handle  GATT attribute handle
- * @param p_val        Pointer to Bluetooth® GATT write request value
- * @param len          length of GATT write request
+ * @param result  CY_RSLT_SUCCESS, or the error of the storage thread or of
+ *                the checks done before it was asked to finish
  *
- * @return wiced_bt_gatt_status_t  Bluetooth® GATT status
+ * @return void
  */
-static wiced_bt_gatt_status_t app_bt_set_value(uint16_t attr_handle,
-                                               uint8_t *p_val,
-                                               uint16_t len)
+static void app_bt_ota_verify_done(cy_rslt_t result)
 {
-    wiced_bt_gatt_status_t result = WICED_BT_GATT_INVALID_HANDLE;
+    wiced_bt_gatt_status_t status;
+    uint8_t bt_notify_buff;
 
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() handle : 0x%x (%d)\n", __func__, attr_handle, attr_handle);
+    if (!verify_pending)
+    {
+        return;
+    }
+    verify_pending = false;
 
-    for (int i = 0; i < app_gatt_db_ext_attr_tbl_size; i++)
+    /* The storage thread ran the last data through the pipeline */
+    if ((result == CY_RSLT_SUCCESS) && app_ota_merkle_enabled() && !app_ota_merkle_complete())
     {
-        /* Check for a matching handle entry */
-        if (app_gatt_db_ext_attr_tbl[i].handle == attr_handle)
-        {
-            /* Detected a matching handle in the external lookup table */
-            if (app_gatt_db_ext_attr_tbl[i].max_len >= len)
-            {
-                /* Value fits within the supplied buffer; copy over the value */
-                app_gatt_db_ext_attr_tbl[i].cur_len = len;
-                memset(app_gatt_db_ext_attr_tbl[i].p_data, 0x00, app_gatt_db_ext_attr_tbl[i].max_len);
-                memcpy(app_gatt_db_ext_attr_tbl[i].p_data, p_val, app_gatt_db_ext_attr_tbl[i].cur_len);
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "Merkle framed image incomplete\n");
+        result = CY_RSLT_OTA_ERROR_VERIFY;
+    }
+    app_ota_decomp_stop();
+    app_ota_delta_stop();
+    app_ota_merkle_stop();
+    app_ota_image_info_stop();
 
-                if (memcmp(app_gatt_db_ext_attr_tbl[i].p_data, p_val, app_gatt_db_ext_attr_tbl[i].cur_len) == 0)
-                {
-                    result = WICED_BT_GATT_SUCCESS;
-                }
-            }
-            else
-            {
-                /* Value to write will not fit within the table */
-                result = WICED_BT_GATT_INVALID_ATTR_LEN;
-                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "Invalid attribute length\n");
-            }
-            break;
-        }
+#ifndef COMPONENT_OTA_BLUETOOTH_SECURE
+    if ((result == CY_RSLT_SUCCESS) && (APP_OTA_CRC32_FINAL(app_ota_stage_committed_crc32()) != verify_final_crc32))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Received CRC        : 0x%lx\n", APP_OTA_CRC32_FINAL(ota_image_crc32));
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Stored CRC          : 0x%lx\n", APP_OTA_CRC32_FINAL(app_ota_stage_committed_crc32()));
+        result = CY_RSLT_OTA_ERROR_VERIFY;
     }
-    if (result != WICED_BT_GATT_SUCCESS)
+#if APP_OTA_STAGE_READ_BACK
+    else if ((result == CY_RSLT_SUCCESS) && (app_ota_stage_read_back_crc32() != app_ota_stage_committed_crc32()))
     {
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() FAILED 0x%lx\n", __func__, result);
+        /* What was stored matches, so the flash does not hold what was written */
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Read back CRC       : 0x%lx\n", APP_OTA_CRC32_FINAL(app_ota_stage_read_back_crc32()));
+        result = CY_RSLT_OTA_ERROR_VERIFY;
     }
+#endif
+    else if (result == CY_RSLT_SUCCESS)
+    {
+        /* The CRC32 was kept by the storage thread, the library only closes and validates the storage */
+        result = cy_ota_ble_download_verify(ota_app.ota_context, verify_final_crc32, false);
+    }
+#else
+    if ((result == CY_RSLT_SUCCESS) && verify_signed)
+    {
+        /* The signature was checked by the storage thread */
+        result = cy_ota_ble_download_verify(ota_app.ota_context, verify_final_crc32, false);
+    }
+    else if (result == CY_RSLT_SUCCESS)
+    {
+        uint32_t verify_us = app_ota_metrics_now_us();
 
-    return result;
+        result = cy_ota_ble_download_verify(ota_app.ota_context, verify_final_crc32, true);
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Signature verified by the OTA library in %lu us\n", app_ota_metrics_now_us() - verify_us);
+    }
+#endif
+    app_ota_erase_stop();
+    app_ota_timing_mark(APP_OTA_PHASE_VERIFY_END);
+    app_ota_resume_clear();
+    app_ota_metrics_session_report(result == CY_RSLT_SUCCESS);
+    app_bt_conn_policy_set(APP_BT_CONN_PROFILE_RELAXED);
+    if (result == CY_RSLT_SUCCESS)
+    {
+        app_ota_identity_installed(((cy_ota_context_t *)(ota_app.ota_context))->ota_storage_context.total_image_size);
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "\ncy_ota_ble_download completed, Sending notification");
+        bt_notify_buff = CY_OTA_UPGRADE_STATUS_OK;
+        status = app_bt_ble_send_indication(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, 1, &bt_notify_buff);
+
+        /* Switch to the new image once the peer app confirmed, see app_ota_activate.h */
+        if (ota_app.reboot_at_end != 0)
+        {
+            app_ota_activate_arm(status == WICED_BT_GATT_SUCCESS);
+        }
+        if (status != WICED_BT_GATT_SUCCESS)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "\nApplication BT Send Indication callback failed: 0x%lx\n", result);
+        }
+    }
+    else
+    {
+        app_ota_identity_slot_state(APP_OTA_IDENTITY_SLOT_NONE);
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "cy_ota_ble_download_verify() Failed - result: 0x%lx\n", result);
+        bt_notify_buff = CY_OTA_UPGRADE_STATUS_BAD;
+        status = app_bt_ble_send_indication(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, 1, &bt_notify_buff);
+        if (status != WICED_BT_GATT_SUCCESS)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "\nApplication BT Send Indication callback failed: 0x%lx\n", result);
+        }
+    }
 }
 
 static wiced_bt_gatt_status_t app_bt_write_handler(wiced_bt_gatt_event_data_t *p_req)
@@ -441,10 +1074,10 @@ static wiced_bt_gatt_status_t app_bt_write_handler(wiced_bt_gatt_event_data_t *p
 
     if (p_req != NULL)
     {
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() handle : 0x%x (%d)\n", __func__, p_write_req->handle, p_write_req->handle);
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "     offset : 0x%x\n", p_write_req->offset);
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "     p_val  : %p\n", p_write_req->p_val);
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "     val_len: 0x%x\n", p_write_req->val_len);
+        APP_LOG(CY_LOG_INFO, "%s() handle : 0x%x (%d)\n", __func__, p_write_req->handle, p_write_req->handle);
+        APP_LOG(CY_LOG_INFO, "     offset : 0x%x\n", p_write_req->offset);
+        APP_LOG(CY_LOG_INFO, "     p_val  : %p\n", p_write_req->p_val);
+        APP_LOG(CY_LOG_INFO, "     val_len: 0x%x\n", p_write_req->val_len);
         if (p_write_req->val_len < 64)
         {
             // cy_ota_print_data((const char *)p_write_req->p_val, p_write_req->val_len);
@@ -465,12 +1098,22 @@ static wiced_bt_gatt_status_t app_bt_write_handler(wiced_bt_gatt_event_data_t *p
                                                                                                                                                                                                                                                                            : "Unknown");
         return WICED_BT_GATT_SUCCESS;
 
+#ifdef HDLD_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_CLIENT_CHAR_CONFIG
+    case HDLD_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_CLIENT_CHAR_CONFIG:
+        app_ota_stats_enable_notify((p_write_req->val_len >= 1) && ((p_write_req->p_val[0] & GATT_CLIENT_CONFIG_NOTIFICATION) != 0));
+        return app_bt_set_value(p_write_req->handle,
+                                p_write_req->p_val,
+                                p_write_req->val_len);
+#endif
+
     case HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE:
         cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() HDLC_O[TA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE \n", __func__);
         switch (p_write_req->p_val[0])
         {
         case CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD:
         {
+            app_ota_timing_mark(APP_OTA_PHASE_PREPARE_START);
+
             /* We are using Bluetooth® for this connection */
             ota_app.connection_type = CY_OTA_CONNECTION_BLE; /* Mark Connection type in Application data structure - used when calling cy_ota_agent_start() */
             result = init_ota(&ota_app);                     /* Call application-level OTA initialization (calls cy_ota_agent_start() ) */
@@ -480,12 +1123,31 @@ static wiced_bt_gatt_status_t app_bt_write_handler(wiced_bt_gatt_event_data_t *p
                 return WICED_BT_GATT_ERROR;
             }
 
+            app_ota_metrics_session_start();
+            app_bt_conn_policy_set(APP_BT_CONN_PROFILE_OTA);
             result = cy_ota_ble_download_prepare(ota_app.ota_context);
+            app_ota_timing_mark(APP_OTA_PHASE_PREPARE_END);
             if (result == CY_RSLT_SUCCESS)
             {
                 cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "\ncy_ota_ble_download_prepare completed, Sending notification");
-                uint8_t bt_notify_buff = CY_OTA_UPGRADE_STATUS_OK;
-                status = app_bt_ble_send_notification(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, 1, &bt_notify_buff);
+                /* The extra octets are only sent when the host asked for a transfer option */
+                uint8_t bt_notify_buff[4] = {CY_OTA_UPGRADE_STATUS_OK, 0, 0, 0};
+                uint16_t notify_len = 1;
+                bool use_coc = (p_write_req->val_len >= 2) && ((p_write_req->p_val[1] & APP_OTA_PREPARE_OPT_COC) != 0);
+
+                bt_notify_buff[1] = app_ota_stream_negotiate(p_write_req->p_val, p_write_req->val_len);
+                if (bt_notify_buff[1] != 0)
+                {
+                    notify_len = 2;
+                }
+                app_ota_coc_enable(use_coc);
+                if (use_coc)
+                {
+                    bt_notify_buff[2] = (uint8_t)(APP_OTA_COC_PSM >> 0);
+                    bt_notify_buff[3] = (uint8_t)(APP_OTA_COC_PSM >> 8);
+                    notify_len = 4;
+                }
+                status = app_bt_ble_send_notification(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, notify_len, bt_notify_buff);
                 if (status != WICED_BT_GATT_SUCCESS)
                 {
                     cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "\nApplication BT Send notification callback failed: 0x%lx\n", result);
@@ -503,6 +1165,11 @@ static wiced_bt_gatt_status_t app_bt_write_handler(wiced_bt_gatt_event_data_t *p
         case CY_OTA_UPGRADE_COMMAND_DOWNLOAD:
         {
             uint32_t total_size = 0;
+            uint32_t image_id = 0;
+            uint32_t resume_offset = 0;
+            uint32_t resume_crc32 = APP_OTA_CRC32_INIT;
+            bool resuming;
+            bool skip_unchanged = false;
             /* let OTA lib know what is going on */
             cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE : CY_OTA_UPGRADE_COMMAND_DOWNLOAD\n", __func__);
 
@@ -517,12 +1184,105 @@ static wiced_bt_gatt_status_t app_bt_write_handler(wiced_bt_gatt_event_data_t *p
                          (((uint32_t)p_write_req->p_val[2]) << 8) +
                          (((uint32_t)p_write_req->p_val[1]) << 0);
 
+            if ((p_write_req->val_len >= 6) && ((p_write_req->p_val[5] & APP_OTA_DOWNLOAD_OPT_DELTA) != 0) &&
+                !app_ota_delta_supported())
+            {
+                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "Delta update requested, the running image cannot be read\n");
+                return WICED_BT_GATT_ERROR;
+            }
+            if ((p_write_req->val_len >= 6) && ((p_write_req->p_val[5] & APP_OTA_DOWNLOAD_OPT_MERKLE) != 0) &&
+                !app_ota_merkle_supported())
+            {
+                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "Merkle framed image requested, not a secure build\n");
+                return WICED_BT_GATT_ERROR;
+            }
+            /* Before the slot is opened, a download refused by the policy leaves it untouched */
+            if (app_ota_image_info_start((p_write_req->val_len >= 6) &&
+                                         ((p_write_req->p_val[5] & APP_OTA_DOWNLOAD_OPT_IMAGE_INFO) != 0),
+                                         total_size) != CY_RSLT_SUCCESS)
+            {
+                return WICED_BT_GATT_ERROR;
+            }
+
+            /* Only a plain image can be continued at a byte offset */
+            if ((p_write_req->val_len >= 10) &&
+                ((p_write_req->p_val[5] & (APP_OTA_DOWNLOAD_OPT_HEATSHRINK | APP_OTA_DOWNLOAD_OPT_DELTA | APP_OTA_DOWNLOAD_OPT_MERKLE)) == 0))
+            {
+                image_id = (((uint32_t)p_write_req->p_val[6]) << 0) +
+                           (((uint32_t)p_write_req->p_val[7]) << 8) +
+                           (((uint32_t)p_write_req->p_val[8]) << 16) +
+                           (((uint32_t)p_write_req->p_val[9]) << 24);
+            }
+
+            /* Unchanged blocks can only be kept when the slot is not cleared on open */
+            if ((p_write_req->val_len >= 6) && ((p_write_req->p_val[5] & APP_OTA_DOWNLOAD_OPT_SKIP_UNCHANGED) != 0))
+            {
+                skip_unchanged = app_ota_erase_supported();
+                if (!skip_unchanged)
+                {
+                    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Skip unchanged needs erase ahead, the whole image is written\n");
+                }
+            }
+            app_ota_erase_skip_unchanged(skip_unchanged);
+            resuming = app_ota_resume_begin(image_id, total_size, &resume_offset, &resume_crc32);
+
+            app_ota_metrics_set_image_size(total_size);
+            ota_image_crc32 = APP_OTA_CRC32_INIT;
+            data_failure_notified = false;
+            verify_pending = false;
             result = cy_ota_ble_download(ota_app.ota_context, total_size);
             if (result == CY_RSLT_SUCCESS)
             {
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+                app_ota_verify_start(total_size);
+#endif
+                app_ota_stage_start(ota_app.ota_context);
+                if (skip_unchanged)
+                {
+                    app_ota_stage_skip_unchanged(&((cy_ota_context_t *)(ota_app.ota_context))->ota_storage_context);
+                }
+                app_ota_identity_slot_state(APP_OTA_IDENTITY_SLOT_RECEIVING);
+                if (resuming)
+                {
+                    /* The slot was not erased, the library continues after the stored bytes */
+                    app_ota_resume_continue(&((cy_ota_context_t *)(ota_app.ota_context))->ota_storage_context);
+                    app_ota_stage_resume(resume_offset, resume_crc32);
+                    ota_image_crc32 = resume_crc32;
+                }
+                app_ota_stream_start();
+                if ((p_write_req->val_len >= 6) && ((p_write_req->p_val[5] & APP_OTA_DOWNLOAD_OPT_HEATSHRINK) != 0))
+                {
+                    /* The image size is the size after decoding, and after patching with APP_OTA_DOWNLOAD_OPT_DELTA */
+                    app_ota_decomp_start(total_size);
+                }
+                else
+                {
+                    app_ota_decomp_stop();
+                }
+                if ((p_write_req->val_len >= 6) && ((p_write_req->p_val[5] & APP_OTA_DOWNLOAD_OPT_DELTA) != 0))
+                {
+                    /* The image size is the size of the rebuilt image */
+                    app_ota_delta_start(total_size);
+                }
+                else
+                {
+                    app_ota_delta_stop();
+                }
+                if ((p_write_req->val_len >= 6) && ((p_write_req->p_val[5] & APP_OTA_DOWNLOAD_OPT_MERKLE) != 0))
+                {
+                    /* Data is refused until APP_OTA_COMMAND_MERKLE brings the signed root */
+                    app_ota_merkle_start();
+                }
+                else
+                {
+                    app_ota_merkle_stop();
+                }
                 cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "\ncy_ota_ble_download completed, Sending notification");
-                uint8_t bt_notify_buff = CY_OTA_UPGRADE_STATUS_OK;
-                status = app_bt_ble_send_notification(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, 1, &bt_notify_buff);
+                /* A host that sent an image ID also gets the offset to continue at */
+                uint8_t bt_notify_buff[5] = {CY_OTA_UPGRADE_STATUS_OK,
+                                             (uint8_t)(resume_offset >> 0), (uint8_t)(resume_offset >> 8),
+                                             (uint8_t)(resume_offset >> 16), (uint8_t)(resume_offset >> 24)};
+                status = app_bt_ble_send_notification(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, (image_id != 0) ? 5 : 1, bt_notify_buff);
                 if (status != WICED_BT_GATT_SUCCESS)
                 {
                     cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "\nApplication BT Send notification callback failed: 0x%lx\n", result);
@@ -540,78 +1300,155 @@ static wiced_bt_gatt_status_t app_bt_write_handler(wiced_bt_gatt_event_data_t *p
 
         case CY_OTA_UPGRADE_COMMAND_VERIFY:
         {
-            bool crc_or_sig_verify = true;
             uint32_t final_crc32 = 0;
 
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+            if ((p_write_req->val_len != 5) && (p_write_req->val_len != (5 + APP_OTA_SIGNATURE_LEN)))
+#else
             if (p_write_req->val_len != 5)
+#endif
             {
                 cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "CY_OTA_UPGRADE_COMMAND_VERIFY len != 5\n");
                 return WICED_BT_GATT_ERROR;
             }
+            if (verify_pending)
+            {
+                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "CY_OTA_UPGRADE_COMMAND_VERIFY already in progress\n");
+                return WICED_BT_GATT_ERROR;
+            }
 
             final_crc32 = (((uint32_t)p_write_req->p_val[1]) << 0) +
                           (((uint32_t)p_write_req->p_val[2]) << 8) +
                           (((uint32_t)p_write_req->p_val[3]) << 16) +
                           (((uint32_t)p_write_req->p_val[4]) << 24);
             cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Final CRC from Host : 0x%lx\n", final_crc32);
+            app_ota_timing_mark(APP_OTA_PHASE_VERIFY_START);
 
-            result = cy_ota_ble_download_verify(ota_app.ota_context, final_crc32, crc_or_sig_verify);
-            if (result == CY_RSLT_SUCCESS)
+            app_ota_stream_stop();
+            app_ota_coc_enable(false);
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+            if (p_write_req->val_len == (5 + APP_OTA_SIGNATURE_LEN))
             {
-                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "\ncy_ota_ble_download completed, Sending notification");
-                uint8_t bt_notify_buff = CY_OTA_UPGRADE_STATUS_OK;
-                status = app_bt_ble_send_indication(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, 1, &bt_notify_buff);
-                if (status != WICED_BT_GATT_SUCCESS)
-                {
-                    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "\nApplication BT Send Indication callback failed: 0x%lx\n", result);
-#ifdef COMPONENT_H1_CP
-                    cy_rtos_delay_milliseconds(3000);
-                    cy_ota_storage_switch_to_new_image(1);
-#endif
-                    return WICED_BT_GATT_ERROR;
-                }
-#ifdef COMPONENT_H1_CP
-                cy_rtos_delay_milliseconds(3000);
-                cy_ota_storage_switch_to_new_image(1);
+                app_ota_verify_set_signature(&p_write_req->p_val[5]);
+            }
+            verify_signed = app_ota_verify_has_signature();
 #endif
+            /* The storage thread processes what is staged, writes the tail, reads the slot back and reports APP_OTA_STAGE_EVT_DONE */
+            result = app_ota_stage_finish(&((cy_ota_context_t *)(ota_app.ota_context))->ota_storage_context);
+            verify_final_crc32 = final_crc32;
+            verify_pending = true;
+            if (result != CY_RSLT_SUCCESS)
+            {
+                app_bt_ota_verify_done(result);
+                return WICED_BT_GATT_ERROR;
             }
-            else
+
+            return WICED_BT_GATT_SUCCESS;
+        }
+
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+        case APP_OTA_COMMAND_SIGNATURE:
+            if (p_write_req->val_len != (1 + APP_OTA_SIGNATURE_LEN))
             {
-                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "cy_ota_ble_download_verify() Failed - result: 0x%lx\n", result);
-                uint8_t bt_notify_buff = CY_OTA_UPGRADE_STATUS_BAD;
-                status = app_bt_ble_send_indication(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, 1, &bt_notify_buff);
-                if (status != WICED_BT_GATT_SUCCESS)
-                {
-                    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "\nApplication BT Send Indication callback failed: 0x%lx\n", result);
-                }
+                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "APP_OTA_COMMAND_SIGNATURE len != %d\n", 1 + APP_OTA_SIGNATURE_LEN);
+                return WICED_BT_GATT_ERROR;
+            }
+            app_ota_verify_set_signature(&p_write_req->p_val[1]);
+            return WICED_BT_GATT_SUCCESS;
+#endif
 
+        case APP_OTA_COMMAND_MERKLE:
+            /* The storage thread may already run the merkle check on staged data */
+            if (app_ota_stage_received() != 0)
+            {
+                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "APP_OTA_COMMAND_MERKLE after image data\n");
                 return WICED_BT_GATT_ERROR;
             }
+            result = app_ota_merkle_set_header(&p_write_req->p_val[1], p_write_req->val_len - 1);
+            return (result == CY_RSLT_SUCCESS) ? WICED_BT_GATT_SUCCESS : WICED_BT_GATT_ERROR;
 
-            return WICED_BT_GATT_SUCCESS;
+        case APP_OTA_COMMAND_RESUME:
+        {
+            uint32_t image_id;
+            uint32_t offset;
+
+            if (p_write_req->val_len != 5)
+            {
+                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "APP_OTA_COMMAND_RESUME len != 5\n");
+                return WICED_BT_GATT_ERROR;
+            }
+            image_id = (((uint32_t)p_write_req->p_val[1]) << 0) +
+                       (((uint32_t)p_write_req->p_val[2]) << 8) +
+                       (((uint32_t)p_write_req->p_val[3]) << 16) +
+                       (((uint32_t)p_write_req->p_val[4]) << 24);
+            offset = app_ota_resume_query(image_id);
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Resume query image 0x%lx: offset 0x%lx\n", image_id, offset);
+
+            uint8_t bt_notify_buff[5] = {APP_OTA_STATUS_RESUME,
+                                         (uint8_t)(offset >> 0), (uint8_t)(offset >> 8),
+                                         (uint8_t)(offset >> 16), (uint8_t)(offset >> 24)};
+            status = app_bt_ble_send_notification(ota_app.bt_conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, sizeof(bt_notify_buff), bt_notify_buff);
+            return (status == WICED_BT_GATT_SUCCESS) ? WICED_BT_GATT_SUCCESS : WICED_BT_GATT_ERROR;
         }
 
         case CY_OTA_UPGRADE_COMMAND_ABORT:
+            verify_pending = false;
+            (void)app_bt_claim_deferred(&deferred_write_rsp.pending);
+            (void)app_bt_claim_deferred(&deferred_stream_ack);
+            app_ota_stream_stop();
+            app_ota_coc_enable(false);
+            /* Before the pipeline is stopped, the storage thread may still run it */
+            app_ota_stage_abort();
+            app_ota_decomp_stop();
+            app_ota_delta_stop();
+            app_ota_erase_stop();
+            app_ota_merkle_stop();
+            app_ota_image_info_stop();
             result = cy_ota_ble_download_abort(&ota_app.ota_context);
+            app_ota_resume_clear();
+            app_ota_identity_slot_state(APP_OTA_IDENTITY_SLOT_NONE);
+            app_ota_metrics_session_report(false);
+            app_bt_conn_policy_set(APP_BT_CONN_PROFILE_RELAXED);
             return WICED_BT_GATT_SUCCESS;
         }
         break;
 
     case HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE:
     {
-        result = cy_ota_ble_download_write(ota_app.ota_context, p_write_req->p_val, p_write_req->val_len, p_write_req->offset);
-        if (result == CY_RSLT_SUCCESS)
+        const uint8_t *p_data = p_write_req->p_val;
+        uint16_t data_len = p_write_req->val_len;
+
+        if (app_ota_stream_enabled())
         {
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "   Downloaded 0x%lx of 0x%lx (%d%%)\n",
-                       ((cy_ota_context_t *)(ota_app.ota_context))->ota_storage_context.total_bytes_written,
-                       ((cy_ota_context_t *)(ota_app.ota_context))->ota_storage_context.total_image_size,
-                       ((cy_ota_context_t *)(ota_app.ota_context))->ble.percent);
-            return WICED_BT_GATT_SUCCESS;
+            switch (app_ota_stream_rx(p_write_req->p_val, p_write_req->val_len, &p_data, &data_len))
+            {
+            case APP_OTA_STREAM_RX_ACCEPT:
+                break;
+            case APP_OTA_STREAM_RX_OUT_OF_ORDER:
+                app_bt_notify_stream_ack(APP_OTA_STATUS_STREAM_NAK);
+                return WICED_BT_GATT_SUCCESS;
+            case APP_OTA_STREAM_RX_DUPLICATE:
+                return WICED_BT_GATT_SUCCESS;
+            default:
+                return WICED_BT_GATT_INVALID_ATTR_LEN;
+            }
         }
-        else
+
+        result = app_bt_ota_data_write(p_data, data_len);
+        if (result != CY_RSLT_SUCCESS)
         {
+            /* Only a Write Request gets the error response */
+            if (p_req->attribute_request.opcode != GATT_REQ_WRITE)
+            {
+                app_bt_notify_data_failed();
+            }
             return WICED_BT_GATT_ERROR;
         }
+        if (app_ota_stream_enabled() && app_ota_stream_accepted(data_len))
+        {
+            app_bt_send_stream_ack();
+        }
+        return WICED_BT_GATT_SUCCESS;
     }
 
     default:
@@ -629,92 +1466,142 @@ static wiced_bt_gatt_status_t app_bt_prepare_write_handler(uint16_t conn_id,
                                                            wiced_bt_gatt_opcode_t opcode,
                                                            wiced_bt_gatt_write_req_t *p_req)
 {
-    if (write_buff.in_use == false)
-    {
-        memset(&(write_buff.value[0]), 0x00, CY_BT_MTU_SIZE);
-        write_buff.written = 0;
-        write_buff.in_use = true;
-        write_buff.handle = 0;
-    }
+    wiced_bt_gatt_status_t status;
+    const uint8_t *p_stored = NULL;
 
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() handle : 0x%x (%d)\n", __func__, p_req->handle, p_req->handle);
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "     offset : 0x%x\n", p_req->offset);
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "     p_val  : %p\n", p_req->p_val);
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "     val_len: 0x%x\n", p_req->val_len);
+    APP_LOG(CY_LOG_INFO, "%s() handle : 0x%x (%d)\n", __func__, p_req->handle, p_req->handle);
+    APP_LOG(CY_LOG_INFO, "     offset : 0x%x\n", p_req->offset);
+    APP_LOG(CY_LOG_INFO, "     p_val  : %p\n", p_req->p_val);
+    APP_LOG(CY_LOG_INFO, "     val_len: 0x%x\n", p_req->val_len);
 
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "val_len = %d \n", p_req->val_len);
+    /*
+     * Refused now, in the Prepare Write Response, not on Execute Write. The
+     * stack checks the permissions the GATT DB declares for the attribute
+     * before the request gets here, as for a Write Request. Any attribute a
+     * Write Request can set can be prepared.
+     */
+    if (app_bt_find_by_handle(p_req->handle) == NULL)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s()  attr not found handle: 0x%04x\n", __func__, p_req->handle);
+        return WICED_BT_GATT_INVALID_HANDLE;
+    }
 
     /** store the data  */
-    if (write_buff.written == p_req->offset)
+    status = app_bt_write_queue_prepare(conn_id, p_req->handle, p_req->offset, p_req->p_val, p_req->val_len, &p_stored);
+    if (status != WICED_BT_GATT_SUCCESS)
     {
-        int remaining = CY_BT_MTU_SIZE - write_buff.written;
-        int to_write = p_req->val_len;
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "app_bt_write_queue_prepare() failed: 0x%x\n", status);
+        return status;
+    }
+
+    /* send success response, echoing the queued copy */
+    APP_LOG(CY_LOG_INFO, "== Sending prepare write success response...\n");
+    wiced_bt_gatt_server_send_prepare_write_rsp(conn_id, opcode, p_req->handle,
+                                                p_req->offset, p_req->val_len,
+                                                (uint8_t *)p_stored, NULL);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_bt_queued_write
+ *
+ * Function Description:
+ * @brief  Write the queued value of one handle on Execute Write. Image data
+ *         segments go to the OTA library in place, any other value is
+ *         gathered and written like a single Write Request.
+ *
+ * @param context    Execute Write request event data
+ * @param handle     attribute handle
+ * @param p_segs     queued segments of the value, in offset order
+ * @param num_segs   number of segments
+ * @param total_len  length of the value
+ *
+ * @return wiced_bt_gatt_status_t
+ */
+static wiced_bt_gatt_status_t app_bt_queued_write(void *context, uint16_t handle, const app_bt_write_seg_t *p_segs,
+                                                  uint8_t num_segs, uint16_t total_len)
+{
+    wiced_bt_gatt_event_data_t *p_req = (wiced_bt_gatt_event_data_t *)context;
+    wiced_bt_gatt_write_req_t *p_write_req = &p_req->attribute_request.data.write_req;
+    wiced_bt_gatt_status_t status;
+    uint8_t *p_value;
+    uint16_t pos = 0;
+    uint8_t i;
 
-        if (remaining >= to_write)
+    APP_LOG(CY_LOG_INFO, "%s() handle : 0x%x segments: %d val_len: %d\n", __func__, handle, num_segs, total_len);
+
+    if (handle == HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE)
+    {
+        /* A long write carries plain image data, streaming headers only come with Write Commands */
+        if (app_ota_stream_enabled())
         {
-            memcpy((void *)((uint32_t)(&(write_buff.value[0]) + write_buff.written)), p_req->p_val, to_write);
-
-            /* send success response */
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "== Sending prepare write success response...\n");
-            wiced_bt_gatt_server_send_prepare_write_rsp(conn_id, opcode, p_req->handle,
-                                                        p_req->offset, to_write,
-                                                        &(write_buff.value[write_buff.written]), NULL);
-            write_buff.written += to_write;
-            write_buff.handle = p_req->handle;
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "    Total val_len: %d\n", write_buff.written);
-            return WICED_BT_GATT_SUCCESS;
+            return WICED_BT_GATT_REQ_NOT_SUPPORTED;
         }
-        else
+        /* All segments or none, the host sends a refused Execute Write again from the start */
+        if (!app_ota_stage_fits(total_len))
         {
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "remaining >= to_write error...\n");
-            return WICED_BT_GATT_ERROR;
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() %d bytes do not fit in the staging ring\n", __func__, total_len);
+            return WICED_BT_GATT_INSUF_RESOURCE;
+        }
+        for (i = 0; i < num_segs; i++)
+        {
+            if (app_bt_ota_data_write(p_segs[i].p_data, p_segs[i].len) != CY_RSLT_SUCCESS)
+            {
+                return WICED_BT_GATT_ERROR;
+            }
         }
+        execute_write_data = true;
+        return WICED_BT_GATT_SUCCESS;
     }
-    else
+
+    if (total_len > CY_BT_MTU_SIZE)
+    {
+        return WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+    p_value = app_bt_alloc_buffer(total_len);
+    if (p_value == NULL)
+    {
+        return WICED_BT_GATT_INSUF_RESOURCE;
+    }
+    for (i = 0; i < num_segs; i++)
     {
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "write_buff.written != p_req->offset...\n");
+        memcpy(&p_value[pos], p_segs[i].p_data, p_segs[i].len);
+        pos += p_segs[i].len;
     }
 
-    return WICED_BT_GATT_ERROR;
+    p_write_req->handle = handle;
+    p_write_req->offset = 0;
+    p_write_req->p_val = p_value;
+    p_write_req->val_len = total_len;
+
+    status = app_bt_write_handler(p_req);
+
+    app_bt_free_buffer(p_value);
+
+    return status;
 }
 
-static wiced_bt_gatt_status_t app_bt_execute_write_handler(wiced_bt_gatt_event_data_t *p_req)
+static wiced_bt_gatt_status_t app_bt_execute_write_handler(wiced_bt_gatt_event_data_t *p_req, uint16_t *p_err_handle)
 {
-    wiced_bt_gatt_write_req_t *p_write_req;
     wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
 
     CY_ASSERT(p_req != NULL);
 
-    p_write_req = &p_req->attribute_request.data.write_req;
-
-    CY_ASSERT(p_req != NULL);
-
-    if (write_buff.in_use == false)
+    if (p_req->attribute_request.data.exec_write == GATT_PREPARE_WRITE_CANCEL)
     {
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "write_buff.inuse is false returning error...\n");
-        return WICED_BT_GATT_ERROR;
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "Execute Write cancelled\n");
+        app_bt_write_queue_clear();
+        return WICED_BT_GATT_SUCCESS;
     }
 
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "Execute Write with %d bytes\n", write_buff.written);
-
-    p_write_req->handle = write_buff.handle;
-    p_write_req->offset = 0;
-    p_write_req->p_val = &(write_buff.value[0]);
-    p_write_req->val_len = write_buff.written;
-
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() handle : 0x%x (%d)\n", __func__, p_write_req->handle, p_write_req->handle);
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "     offset : 0x%x\n", p_write_req->offset);
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "     p_val  : %p\n", p_write_req->p_val);
-    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "     val_len: 0x%x\n", p_write_req->val_len);
-
-    status = app_bt_write_handler(p_req);
+    execute_write_data = false;
+    status = app_bt_write_queue_execute(p_req->attribute_request.conn_id, app_bt_queued_write, p_req, p_err_handle);
     if (status != WICED_BT_GATT_SUCCESS)
     {
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "app_bt_write_handler() failed....\n");
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "app_bt_write_queue_execute() failed for handle 0x%x: 0x%x\n", *p_err_handle, status);
     }
 
-    write_buff.in_use = false;
-
     return status;
 }
 
@@ -734,6 +1621,7 @@ static wiced_bt_gatt_status_t app_bt_server_callback(wiced_bt_gatt_event_data_t
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
     wiced_bt_gatt_attribute_request_t *p_att_req = &p_data->attribute_request;
+    uint16_t err_handle;
 
     switch (p_att_req->opcode)
     {
@@ -787,17 +1675,24 @@ static wiced_bt_gatt_status_t app_bt_server_callback(wiced_bt_gatt_event_data_t
         // Application writes the data in wiced_bt_gatt_write_t.p_val of length                           // TODO requires new code?
         // wiced_bt_gatt_write_t.val_len into the attribute handle and
         // calls the wiced_bt_gatt_server_send_write_rsp in case of success else sends an error rsp
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "  %s() GATTS_REQ_WRITE\n", __func__);
+        APP_LOG(CY_LOG_INFO, "  %s() GATTS_REQ_WRITE\n", __func__);
         status = app_bt_write_handler(p_data);
         if ((p_att_req->opcode == GATT_REQ_WRITE) && (status == WICED_BT_GATT_SUCCESS))
         {
             wiced_bt_gatt_write_req_t *p_write_request = &p_att_req->data.write_req;
-            wiced_bt_gatt_server_send_write_rsp(p_att_req->conn_id, p_att_req->opcode, p_write_request->handle);
+            if (p_write_request->handle == HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE)
+            {
+                app_bt_send_data_write_rsp(p_att_req->conn_id, p_att_req->opcode, p_write_request->handle);
+            }
+            else
+            {
+                wiced_bt_gatt_server_send_write_rsp(p_att_req->conn_id, p_att_req->opcode, p_write_request->handle);
+            }
         }
         break;
 
     case GATT_REQ_PREPARE_WRITE:
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "  %s() GATT_REQ_PREPARE_WRITE\n", __func__);
+        APP_LOG(CY_LOG_INFO, "  %s() GATT_REQ_PREPARE_WRITE\n", __func__);
         status = app_bt_prepare_write_handler(p_att_req->conn_id,
                                               p_att_req->opcode,
                                               &p_att_req->data.write_req);
@@ -811,12 +1706,21 @@ static wiced_bt_gatt_status_t app_bt_server_callback(wiced_bt_gatt_event_data_t
         break;
 
     case GATT_REQ_EXECUTE_WRITE:
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "  %s() GATTS_REQ_TYPE_WRITE_EXEC\n", __func__);
-        status = app_bt_execute_write_handler(p_data);
+        APP_LOG(CY_LOG_INFO, "  %s() GATTS_REQ_TYPE_WRITE_EXEC\n", __func__);
+        err_handle = 0;
+        status = app_bt_execute_write_handler(p_data, &err_handle);
         if ((p_att_req->opcode == GATT_REQ_EXECUTE_WRITE) && (status == WICED_BT_GATT_SUCCESS))
         {
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "== Sending execute write success response...\n");
-            wiced_bt_gatt_server_send_execute_write_rsp(p_att_req->conn_id, p_att_req->opcode);
+            APP_LOG(CY_LOG_DEBUG, "== Sending execute write success response...\n");
+            if (execute_write_data)
+            {
+                /* Paced by the flash like any other DATA write */
+                app_bt_send_data_write_rsp(p_att_req->conn_id, p_att_req->opcode, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE);
+            }
+            else
+            {
+                wiced_bt_gatt_server_send_execute_write_rsp(p_att_req->conn_id, p_att_req->opcode);
+            }
             status = WICED_BT_GATT_SUCCESS;
         }
         else
@@ -824,7 +1728,7 @@ static wiced_bt_gatt_status_t app_bt_server_callback(wiced_bt_gatt_event_data_t
             cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "== Sending execute write error response...\n");
             wiced_bt_gatt_server_send_error_rsp(p_att_req->conn_id,
                                                 p_att_req->opcode,
-                                                p_att_req->data.write_req.handle, status);
+                                                err_handle, status);
         }
 
         break;
@@ -836,34 +1740,27 @@ static wiced_bt_gatt_status_t app_bt_server_callback(wiced_bt_gatt_event_data_t
         status = wiced_bt_gatt_server_send_mtu_rsp(p_att_req->conn_id,
                                                    p_att_req->data.remote_mtu,
                                                    CY_BT_MTU_SIZE);
+        app_ota_timing_mark(APP_OTA_PHASE_MTU);
+        bt_mtu = MIN(p_att_req->data.remote_mtu, CY_BT_MTU_SIZE);
         cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    Set MTU size to : %d  status: 0x%lx\r\n", CY_BT_MTU_SIZE, status);
         cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "     RX PDU Size    : %d  status: 0x%lx\r\n", p_att_req->data.remote_mtu, status);
         break;
 
     case GATT_HANDLE_VALUE_CONF: /* Value confirmation */
         cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "  %s() GATTS_REQ_TYPE_CONF\n", __func__);
+        app_ota_timing_mark(APP_OTA_PHASE_CONFIRM);
         cy_ota_agent_state_t ota_lib_state;
         cy_ota_get_state(ota_app.ota_context, &ota_lib_state);
         cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "  %s() ota_lib_state : %d \n", __func__, (int)ota_lib_state);
-        if ((ota_lib_state == CY_OTA_STATE_OTA_COMPLETE) && /* Check if we completed the download before rebooting */
-            (ota_app.reboot_at_end != 0))
-        {
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s()   RESETTING NOW !!!!\n", __func__);
-            cy_rtos_delay_milliseconds(1000);
-#ifdef COMPONENT_THREADX
-            cyhal_system_reset_device();
-#else
-            NVIC_SystemReset();
-#endif
-        }
-        else
+        /* After VERIFY the activation continues once the last responses are transmitted */
+        if (!app_ota_activate_confirmed())
         {
             cy_ota_agent_stop(&ota_app.ota_context); /* Stop OTA */
         }
         break;
 
     case GATT_HANDLE_VALUE_NOTIF:
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "  %s() GATT_HANDLE_VALUE_NOTIF - Client received our notification\n", __func__);
+        APP_LOG(CY_LOG_INFO, "  %s() GATT_HANDLE_VALUE_NOTIF - Client received our notification\n", __func__);
         break;
 
     default:
@@ -941,19 +1838,19 @@ static wiced_bt_gatt_status_t app_bt_gatt_event_handler(wiced_bt_gatt_evt_t even
         break;
 
     case GATT_ATTRIBUTE_REQUEST_EVT: /* GATT attribute request (from remote client). Event data: #wiced_bt_gatt_attribute_request_t */
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "\n\n%s() GATT_ATTRIBUTE_REQUEST_EVT:  %d type:%d\n", __func__, event, p_attr_req->opcode);
+        APP_LOG(CY_LOG_INFO, "\n\n%s() GATT_ATTRIBUTE_REQUEST_EVT:  %d type:%d\n", __func__, event, p_attr_req->opcode);
         status = app_bt_server_callback(p_event_data);
         break;
 
     case GATT_GET_RESPONSE_BUFFER_EVT: /* GATT buffer request, typically sized to max of bearer mtu - 1 */
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "\n\n%s() GATT_GET_RESPONSE_BUFFER_EVT\n", __func__);
+        APP_LOG(CY_LOG_INFO, "\n\n%s() GATT_GET_RESPONSE_BUFFER_EVT\n", __func__);
         p_event_data->buffer_request.buffer.p_app_rsp_buffer = app_bt_alloc_buffer(p_event_data->buffer_request.len_requested);
         p_event_data->buffer_request.buffer.p_app_ctxt = (void *)app_bt_free_buffer;
         status = WICED_BT_GATT_SUCCESS;
         break;
 
     case GATT_APP_BUFFER_TRANSMITTED_EVT: /* GATT buffer transmitted event,  check \ref wiced_bt_gatt_buffer_transmitted_t*/
-        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "\n\n%s() GATT_APP_BUFFER_TRANSMITTED_EVT.\n", __func__);
+        APP_LOG(CY_LOG_INFO, "\n\n%s() GATT_APP_BUFFER_TRANSMITTED_EVT.\n", __func__);
         {
             pfn_free_buffer_t pfn_free = (pfn_free_buffer_t)p_event_data->buffer_xmitted.p_app_ctxt;
 
@@ -962,6 +1859,7 @@ static wiced_bt_gatt_status_t app_bt_gatt_event_handler(wiced_bt_gatt_evt_t even
             {
                 pfn_free(p_event_data->buffer_xmitted.p_app_data);
             }
+            app_ota_activate_transmitted();
 
             status = WICED_BT_GATT_SUCCESS;
         }
@@ -996,7 +1894,36 @@ static void bt_app_init(void)
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_BUSY;
 
-    memset(&write_buff, 0x00, sizeof(gatt_write_req_buf_t));
+    app_bt_write_queue_clear();
+
+    app_ota_metrics_init();
+    app_bt_pool_init();
+    memset(&deferred_write_rsp, 0x00, sizeof(deferred_write_rsp));
+    deferred_stream_ack = false;
+    app_ota_resume_init();
+    app_ota_identity_init();
+    app_ota_decomp_init(app_bt_ota_decoded_write);
+    app_ota_delta_init(app_bt_ota_image_write);
+    app_ota_merkle_init(app_bt_ota_payload_write);
+    app_ota_image_info_init(app_bt_ota_image_rejected);
+    if (app_ota_stage_init(app_bt_stage_callback, app_bt_ota_data_process) != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() app_ota_stage_init() FAILED !\n", __func__);
+    }
+    if (app_ota_coc_init(app_bt_coc_data_callback, app_ota_stage_has_room) != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() app_ota_coc_init() FAILED !\n", __func__);
+    }
+    app_bt_conn_policy_init();
+#ifdef HDLC_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_VALUE
+    app_ota_stats_init(app_bt_notify_stats);
+#else
+    app_ota_stats_init(NULL);
+#endif
+    app_ota_activate_init(app_bt_ota_activate);
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+    app_ota_verify_init();
+#endif
 
     /* Register with stack to receive GATT callback */
     status = wiced_bt_gatt_register(app_bt_gatt_event_handler);
@@ -1008,6 +1935,7 @@ static void bt_app_init(void)
     {
         cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_bt_gatt_db_init() FAILED 0x%lx !\n", __func__, status);
     }
+    app_bt_attr_index_build(app_gatt_db_ext_attr_tbl, (uint16_t)app_gatt_db_ext_attr_tbl_size);
 
     /* Allow peer to pair */
     wiced_bt_set_pairable_mode(WICED_TRUE, 0);
@@ -1051,8 +1979,6 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
 #ifdef USE_EEPROM_TO_STORE_BOND_INFO
     cy_en_em_eeprom_status_t eepromReturnValue;
 #endif
-    uint16_t min_interval = 6; // TODO: Magic number from BTSDK implementation
-    uint16_t max_interval = 6; // TODO: Magic number from BTSDK implementation
 
     cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_DEBUG, "\n%s() Event: (%d) %s\n", __func__, event, app_get_bt_event_name(event));
 
@@ -1113,6 +2039,10 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
     case BTM_PAIRING_COMPLETE_EVT:
         p_info = &p_event_data->pairing_complete.pairing_complete_info.ble;
         cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "  Pairing Complete: %d ", p_info->reason);
+        if (p_info->status == WICED_SUCCESS)
+        {
+            app_ota_timing_mark(APP_OTA_PHASE_PAIRED);
+        }
         break;
 
     case BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT:
@@ -1264,38 +2194,20 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
         if (status != WICED_BT_SUCCESS)
         {
             cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "  wiced_bt_ble_get_connection_parameters() failed: 0x%lx\n", status);
-            status = WICED_ERROR;
-            break;
-        }
-        if (p_event_data->ble_connection_param_update.conn_interval < min_interval)
-        {
-            min_interval = p_event_data->ble_connection_param_update.conn_interval;
-        }
-        if (p_event_data->ble_connection_param_update.conn_interval > max_interval)
-        {
-            max_interval = p_event_data->ble_connection_param_update.conn_interval;
         }
+        /* Retries the current profile if the central did not apply it */
+        app_bt_conn_policy_param_update(&p_event_data->ble_connection_param_update,
+                                        (status == WICED_BT_SUCCESS) ? &ota_app.bt_conn_params : NULL);
         status = WICED_SUCCESS;
-        if (wiced_bt_l2cap_update_ble_conn_params(p_event_data->ble_connection_param_update.bd_addr,
-                                                  min_interval, max_interval,
-                                                  p_event_data->ble_connection_param_update.conn_latency,
-                                                  p_event_data->ble_connection_param_update.supervision_timeout) == 0)
-        {
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "          wiced_bt_l2cap_update_ble_conn_params() failed\n");
-            status = WICED_ERROR;
-        }
-        else
-        {
-            memcpy(ota_app.bt_peer_addr, p_event_data->ble_connection_param_update.bd_addr, sizeof(ota_app.bt_peer_addr)); /* Save peer Bluetooth® addr in Application data structure */
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "  NEW SETTINGS\n");
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "    min_interval       : %d\n", min_interval);
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "    max_interval       : %d\n", max_interval);
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "    conn_latency       : %d\n", p_event_data->ble_connection_param_update.conn_latency);
-            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "    supervision_timeout: %d\n", p_event_data->ble_connection_param_update.supervision_timeout);
-            status = WICED_SUCCESS;
-        }
         break;
 
+#ifdef APP_BT_CONN_PHY_UPDATE_SUPPORTED
+    case BTM_BLE_PHY_UPDATE_EVT:
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "  BTM_BLE_PHY_UPDATE_EVT\n");
+        app_bt_conn_policy_phy_update(&p_event_data->ble_phy_update_event);
+        break;
+#endif
+
     default:
         cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s()  UNHANDLED Bluetooth(r) Management Event: (%d) %s\n", __func__, event, app_get_bt_event_name(event));
         break;
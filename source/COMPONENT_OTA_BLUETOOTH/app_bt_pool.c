@@ -0,0 +1,280 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the fixed
+ *              block pool used for the GATT request and response buffers.
+ *
+ *              Every read-by-type and read-multiple response and every
+ *              GATT_GET_RESPONSE_BUFFER_EVT used to go through malloc() and
+ *              free(). Over long uptimes with repeated connect / discover
+ *              cycles that fragments the heap. The pool is sized at build
+ *              time, an allocation takes the smallest class that fits and
+ *              claims a free bit of the class bitmap with a compare-and-swap,
+ *              so alloc and free are O(1) and need no lock. The buffers are
+ *              freed from GATT_APP_BUFFER_TRANSMITTED_EVT as before.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_bt_pool.h"
+#include <stdatomic.h>
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#if (APP_BT_POOL_SMALL_COUNT > APP_BT_POOL_MAX_BLOCKS_PER_CLASS) || (APP_BT_POOL_LARGE_COUNT > APP_BT_POOL_MAX_BLOCKS_PER_CLASS)
+#error "APP_BT_POOL_xxx_COUNT must not exceed APP_BT_POOL_MAX_BLOCKS_PER_CLASS"
+#endif
+
+/* Keep every block 8 byte aligned */
+#define APP_BT_POOL_ALIGN(x)                (((x) + 7u) & ~7u)
+
+typedef struct
+{
+    uint8_t             *p_base;
+    uint16_t            block_size;
+    uint16_t            num_blocks;
+    atomic_uint_fast32_t free_map;      /* bit n set: block n is free */
+    atomic_uint_fast16_t in_use;
+    atomic_uint_fast16_t high_water;
+    atomic_uint_fast32_t allocs;
+    atomic_uint_fast32_t exhausted;
+} app_bt_pool_class_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+__attribute__((aligned(8)))
+static uint8_t pool_small[APP_BT_POOL_SMALL_COUNT][APP_BT_POOL_ALIGN(APP_BT_POOL_SMALL_SIZE)];
+
+__attribute__((aligned(8)))
+static uint8_t pool_large[APP_BT_POOL_LARGE_COUNT][APP_BT_POOL_ALIGN(APP_BT_POOL_LARGE_SIZE)];
+
+/* Ordered by block size */
+static app_bt_pool_class_t pool_classes[] =
+{
+    { .p_base = &pool_small[0][0], .block_size = APP_BT_POOL_ALIGN(APP_BT_POOL_SMALL_SIZE), .num_blocks = APP_BT_POOL_SMALL_COUNT },
+    { .p_base = &pool_large[0][0], .block_size = APP_BT_POOL_ALIGN(APP_BT_POOL_LARGE_SIZE), .num_blocks = APP_BT_POOL_LARGE_COUNT },
+};
+
+#define APP_BT_POOL_NUM_CLASSES             (sizeof(pool_classes) / sizeof(pool_classes[0]))
+
+/* Allocations larger than the largest class */
+static atomic_uint_fast32_t pool_oversize;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static uint8_t *app_bt_pool_class_alloc(app_bt_pool_class_t *p_class)
+{
+    uint_fast32_t map = atomic_load(&p_class->free_map);
+    uint_fast32_t bit;
+    uint_fast16_t in_use;
+    uint_fast16_t high;
+
+    do
+    {
+        if (map == 0)
+        {
+            atomic_fetch_add(&p_class->exhausted, 1);
+            return NULL;
+        }
+        bit = (uint_fast32_t)__builtin_ctz((unsigned int)map);
+    } while (!atomic_compare_exchange_weak(&p_class->free_map, &map, map & ~(1UL << bit)));
+
+    atomic_fetch_add(&p_class->allocs, 1);
+    in_use = atomic_fetch_add(&p_class->in_use, 1) + 1;
+    high = atomic_load(&p_class->high_water);
+    while ((in_use > high) && (!atomic_compare_exchange_weak(&p_class->high_water, &high, in_use)))
+    {
+    }
+
+    return p_class->p_base + (bit * p_class->block_size);
+}
+
+/*
+ * Function Name:
+ * app_bt_pool_init
+ *
+ * Function Description:
+ * @brief  Mark all blocks free and clear the counters.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_bt_pool_init(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < APP_BT_POOL_NUM_CLASSES; i++)
+    {
+        app_bt_pool_class_t *p_class = &pool_classes[i];
+
+        atomic_store(&p_class->free_map, (p_class->num_blocks == 32) ? 0xFFFFFFFFUL : ((1UL << p_class->num_blocks) - 1));
+        atomic_store(&p_class->in_use, 0);
+        atomic_store(&p_class->high_water, 0);
+        atomic_store(&p_class->allocs, 0);
+        atomic_store(&p_class->exhausted, 0);
+    }
+    atomic_store(&pool_oversize, 0);
+}
+
+/*
+ * Function Name:
+ * app_bt_pool_alloc
+ *
+ * Function Description:
+ * @brief  Take a block from the smallest class that fits. A class that is
+ *         empty is skipped in favour of the next larger one.
+ *
+ * @param len  number of bytes needed
+ *
+ * @return uint8_t*  block, NULL if no class can serve the request
+ */
+uint8_t *app_bt_pool_alloc(uint16_t len)
+{
+    uint32_t i;
+    uint8_t *p = NULL;
+
+    for (i = 0; (i < APP_BT_POOL_NUM_CLASSES) && (p == NULL); i++)
+    {
+        if (len <= pool_classes[i].block_size)
+        {
+            p = app_bt_pool_class_alloc(&pool_classes[i]);
+        }
+    }
+    if ((p == NULL) && (len > pool_classes[APP_BT_POOL_NUM_CLASSES - 1].block_size))
+    {
+        atomic_fetch_add(&pool_oversize, 1);
+    }
+
+    return p;
+}
+
+/*
+ * Function Name:
+ * app_bt_pool_free
+ *
+ * Function Description:
+ * @brief  Return a block to its class.
+ *
+ * @param p_data  block from app_bt_pool_alloc(), NULL is ignored
+ *
+ * @return void
+ */
+void app_bt_pool_free(uint8_t *p_data)
+{
+    uint32_t i;
+
+    if (p_data == NULL)
+    {
+        return;
+    }
+
+    for (i = 0; i < APP_BT_POOL_NUM_CLASSES; i++)
+    {
+        app_bt_pool_class_t *p_class = &pool_classes[i];
+        uint8_t *p_end = p_class->p_base + (p_class->num_blocks * p_class->block_size);
+
+        if ((p_data >= p_class->p_base) && (p_data < p_end))
+        {
+            uint32_t bit = (uint32_t)(p_data - p_class->p_base) / p_class->block_size;
+
+            atomic_fetch_sub(&p_class->in_use, 1);
+            atomic_fetch_or(&p_class->free_map, 1UL << bit);
+            return;
+        }
+    }
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() %p is not a pool block\n", __func__, p_data);
+}
+
+uint8_t app_bt_pool_num_classes(void)
+{
+    return (uint8_t)APP_BT_POOL_NUM_CLASSES;
+}
+
+/*
+ * Function Name:
+ * app_bt_pool_get_stats
+ *
+ * Function Description:
+ * @brief  Read the counters of one size class.
+ *
+ * @param class_idx  0 .. app_bt_pool_num_classes() - 1, smallest first
+ * @param p_stats    filled in
+ *
+ * @return bool  false if class_idx is out of range
+ */
+bool app_bt_pool_get_stats(uint8_t class_idx, app_bt_pool_stats_t *p_stats)
+{
+    app_bt_pool_class_t *p_class;
+
+    if ((class_idx >= APP_BT_POOL_NUM_CLASSES) || (p_stats == NULL))
+    {
+        return false;
+    }
+
+    p_class = &pool_classes[class_idx];
+    p_stats->block_size = p_class->block_size;
+    p_stats->num_blocks = p_class->num_blocks;
+    p_stats->in_use = (uint16_t)atomic_load(&p_class->in_use);
+    p_stats->high_water = (uint16_t)atomic_load(&p_class->high_water);
+    p_stats->allocs = (uint32_t)atomic_load(&p_class->allocs);
+    p_stats->exhausted = (uint32_t)atomic_load(&p_class->exhausted);
+
+    return true;
+}
+
+/*
+ * Function Name:
+ * app_bt_pool_log_stats
+ *
+ * Function Description:
+ * @brief  Log the usage of every class, called on disconnection.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_bt_pool_log_stats(void)
+{
+    app_bt_pool_stats_t stats;
+    uint8_t i;
+
+    for (i = 0; app_bt_pool_get_stats(i, &stats); i++)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "GATT buffer pool %4d x %2d: in use %d high water %d allocs %lu exhausted %lu\n",
+                   stats.block_size, stats.num_blocks, stats.in_use, stats.high_water, stats.allocs, stats.exhausted);
+    }
+    if (atomic_load(&pool_oversize) != 0)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "GATT buffer pool: %lu requests above %d bytes\n",
+                   (uint32_t)atomic_load(&pool_oversize), APP_BT_POOL_ALIGN(APP_BT_POOL_LARGE_SIZE));
+    }
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the fixed
+ *              block pool used for the GATT request and response buffers.
+ */
+
+#ifndef __APP_BT_POOL_H__
+#define __APP_BT_POOL_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "GeneratedSource/cycfg_bt_settings.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Small blocks, for short read responses */
+#ifndef APP_BT_POOL_SMALL_SIZE
+#define APP_BT_POOL_SMALL_SIZE              (64)
+#endif
+#ifndef APP_BT_POOL_SMALL_COUNT
+#define APP_BT_POOL_SMALL_COUNT             (8)
+#endif
+
+/* Large blocks, one ATT PDU of the negotiated MTU */
+#ifndef APP_BT_POOL_LARGE_SIZE
+#define APP_BT_POOL_LARGE_SIZE              (CY_BT_MTU_SIZE)
+#endif
+#ifndef APP_BT_POOL_LARGE_COUNT
+#define APP_BT_POOL_LARGE_COUNT             (4)
+#endif
+
+/* Each class keeps its free blocks in one 32 bit map */
+#define APP_BT_POOL_MAX_BLOCKS_PER_CLASS    (32)
+
+typedef struct
+{
+    uint16_t    block_size;
+    uint16_t    num_blocks;
+    uint16_t    in_use;
+    uint16_t    high_water;
+    uint32_t    allocs;
+    uint32_t    exhausted;      /* allocations that found the class empty */
+} app_bt_pool_stats_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_bt_pool_init(void);
+
+uint8_t *app_bt_pool_alloc(uint16_t len);
+
+void app_bt_pool_free(uint8_t *p_data);
+
+uint8_t app_bt_pool_num_classes(void);
+
+bool app_bt_pool_get_stats(uint8_t class_idx, app_bt_pool_stats_t *p_stats);
+
+void app_bt_pool_log_stats(void);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_BT_POOL_H__ */
+
+/* [] END OF FILE */
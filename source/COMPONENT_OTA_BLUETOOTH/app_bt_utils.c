@@ -85,7 +85,7 @@ const char *app_get_bt_event_name(wiced_bt_management_evt_t event)
     CASE_RETURN_STR(BTM_SCO_CONNECTION_REQUEST_EVT)
     CASE_RETURN_STR(BTM_SCO_CONNECTION_CHANGE_EVT)
     CASE_RETURN_STR(BTM_BLE_CONNECTION_PARAM_UPDATE)
-#if ( defined(CYW20819A1) || defined(CYW20829A0LKML) || defined (CYW20829B0LKML) || defined (CYW89829B01MKSBG))
+#if ( defined(CYW20819A1) || defined(CYW20829A0LKML) || defined (CYW20829B0LKML) || defined (CYW89829B01MKSBG) || defined(COMPONENT_H1_CP))
     CASE_RETURN_STR(BTM_BLE_PHY_UPDATE_EVT)
 #endif
     }
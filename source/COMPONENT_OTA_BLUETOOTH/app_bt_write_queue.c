@@ -0,0 +1,234 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the queued
+ *              writes (ATT Prepare Write / Execute Write) engine.
+ *
+ *              Prepared values of any number of handles are appended to one
+ *              arena of APP_BT_WRITE_QUEUE_SIZE bytes. On Execute Write the
+ *              segments of each handle are handed to the caller as a scatter
+ *              list in the order the handles were first prepared, so a host
+ *              can send a large block of image data with one Execute Write
+ *              round trip and the values are never copied a second time.
+ *
+ *              The configuration allows a single client connection, the
+ *              queue belongs to the connection that prepared the first value.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_bt_write_queue.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef struct
+{
+    uint16_t    handle;
+    uint16_t    offset;
+    uint16_t    len;
+    uint16_t    arena_pos;
+} app_bt_write_queue_entry_t;
+
+typedef struct
+{
+    bool                        in_use;
+    uint16_t                    conn_id;
+    uint16_t                    arena_used;
+    uint8_t                     num_entries;
+    app_bt_write_queue_entry_t  entries[APP_BT_WRITE_QUEUE_MAX_SEGMENTS];
+} app_bt_write_queue_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_bt_write_queue_t write_queue;
+
+__attribute__((aligned(4)))
+static uint8_t write_queue_arena[APP_BT_WRITE_QUEUE_SIZE];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/*
+ * Number of bytes already queued for a handle, which is the only valid offset
+ * for its next Prepare Write
+ */
+static uint16_t app_bt_write_queue_handle_len(uint16_t handle)
+{
+    uint16_t len = 0;
+    uint8_t i;
+
+    for (i = 0; i < write_queue.num_entries; i++)
+    {
+        if (write_queue.entries[i].handle == handle)
+        {
+            len += write_queue.entries[i].len;
+        }
+    }
+    return len;
+}
+
+/*
+ * Function Name:
+ * app_bt_write_queue_clear
+ *
+ * Function Description:
+ * @brief  Drop all prepared values, on Execute Write with the cancel flag,
+ *         after an Execute Write and on disconnection.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_bt_write_queue_clear(void)
+{
+    write_queue.in_use = false;
+    write_queue.arena_used = 0;
+    write_queue.num_entries = 0;
+}
+
+/*
+ * Function Name:
+ * app_bt_write_queue_prepare
+ *
+ * Function Description:
+ * @brief  Queue the value of a Prepare Write request.
+ *
+ * @param conn_id    connection of the request
+ * @param handle     attribute handle
+ * @param offset     value offset, must follow the values already queued for the handle
+ * @param p_val      value
+ * @param len        value length
+ * @param pp_stored  set to the queued copy, to be echoed in the Prepare Write response
+ *
+ * @return wiced_bt_gatt_status_t  WICED_BT_GATT_SUCCESS, WICED_BT_GATT_PREPARE_Q_FULL or WICED_BT_GATT_INVALID_OFFSET
+ */
+wiced_bt_gatt_status_t app_bt_write_queue_prepare(uint16_t conn_id, uint16_t handle, uint16_t offset,
+                                                  const uint8_t *p_val, uint16_t len, const uint8_t **pp_stored)
+{
+    app_bt_write_queue_entry_t *p_entry;
+
+    if (!write_queue.in_use)
+    {
+        app_bt_write_queue_clear();
+        write_queue.in_use = true;
+        write_queue.conn_id = conn_id;
+    }
+    else if (write_queue.conn_id != conn_id)
+    {
+        return WICED_BT_GATT_PREPARE_Q_FULL;
+    }
+
+    if ((write_queue.num_entries >= APP_BT_WRITE_QUEUE_MAX_SEGMENTS) ||
+        (len > (APP_BT_WRITE_QUEUE_SIZE - write_queue.arena_used)))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s() queue full, %d segments %d bytes\n", __func__, write_queue.num_entries, write_queue.arena_used);
+        return WICED_BT_GATT_PREPARE_Q_FULL;
+    }
+    if (offset != app_bt_write_queue_handle_len(handle))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s() handle 0x%x offset %d, expected %d\n", __func__, handle, offset, app_bt_write_queue_handle_len(handle));
+        return WICED_BT_GATT_INVALID_OFFSET;
+    }
+
+    p_entry = &write_queue.entries[write_queue.num_entries++];
+    p_entry->handle = handle;
+    p_entry->offset = offset;
+    p_entry->len = len;
+    p_entry->arena_pos = write_queue.arena_used;
+    memcpy(&write_queue_arena[write_queue.arena_used], p_val, len);
+    write_queue.arena_used += len;
+
+    *pp_stored = &write_queue_arena[p_entry->arena_pos];
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_bt_write_queue_execute
+ *
+ * Function Description:
+ * @brief  Apply the queued values, one callback per handle. Stops at the
+ *         first handle the callback fails. The queue is empty afterwards.
+ *
+ * @param conn_id       connection of the Execute Write request
+ * @param callback      writes the value of one handle
+ * @param context       passed to the callback
+ * @param p_err_handle  set to the failing handle on error
+ *
+ * @return wiced_bt_gatt_status_t  WICED_BT_GATT_SUCCESS or the status of the failing callback
+ */
+wiced_bt_gatt_status_t app_bt_write_queue_execute(uint16_t conn_id, app_bt_write_queue_cb_t callback, void *context,
+                                                  uint16_t *p_err_handle)
+{
+    app_bt_write_seg_t segs[APP_BT_WRITE_QUEUE_MAX_SEGMENTS];
+    bool done[APP_BT_WRITE_QUEUE_MAX_SEGMENTS] = { false };
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
+    uint8_t i, j;
+
+    if ((!write_queue.in_use) || (write_queue.conn_id != conn_id))
+    {
+        return WICED_BT_GATT_SUCCESS;
+    }
+
+    for (i = 0; (i < write_queue.num_entries) && (status == WICED_BT_GATT_SUCCESS); i++)
+    {
+        uint16_t handle = write_queue.entries[i].handle;
+        uint16_t total_len = 0;
+        uint8_t num_segs = 0;
+
+        if (done[i])
+        {
+            continue;
+        }
+
+        /* Entries of one handle were queued in offset order */
+        for (j = i; j < write_queue.num_entries; j++)
+        {
+            if (write_queue.entries[j].handle == handle)
+            {
+                segs[num_segs].p_data = &write_queue_arena[write_queue.entries[j].arena_pos];
+                segs[num_segs].len = write_queue.entries[j].len;
+                total_len += segs[num_segs].len;
+                num_segs++;
+                done[j] = true;
+            }
+        }
+
+        status = callback(context, handle, segs, num_segs, total_len);
+        if (status != WICED_BT_GATT_SUCCESS)
+        {
+            *p_err_handle = handle;
+        }
+    }
+
+    app_bt_write_queue_clear();
+
+    return status;
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the queued
+ *              writes (ATT Prepare Write / Execute Write) engine.
+ */
+
+#ifndef __APP_BT_WRITE_QUEUE_H__
+#define __APP_BT_WRITE_QUEUE_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "wiced_bt_gatt.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Bytes of prepared values held until Execute Write */
+#ifndef APP_BT_WRITE_QUEUE_SIZE
+#define APP_BT_WRITE_QUEUE_SIZE             (4096)
+#endif
+
+/* Prepare Write requests held until Execute Write */
+#ifndef APP_BT_WRITE_QUEUE_MAX_SEGMENTS
+#define APP_BT_WRITE_QUEUE_MAX_SEGMENTS     (32)
+#endif
+
+/* One queued Prepare Write value, in offset order for its handle */
+typedef struct
+{
+    const uint8_t   *p_data;
+    uint16_t        len;
+} app_bt_write_seg_t;
+
+/*
+ * Called once per handle on Execute Write with all segments of that handle.
+ * The segments point into the queue, they are valid until the callback returns.
+ */
+typedef wiced_bt_gatt_status_t (*app_bt_write_queue_cb_t)(void *context, uint16_t handle, const app_bt_write_seg_t *p_segs, uint8_t num_segs, uint16_t total_len);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_bt_write_queue_clear(void);
+
+wiced_bt_gatt_status_t app_bt_write_queue_prepare(uint16_t conn_id, uint16_t handle, uint16_t offset,
+                                                  const uint8_t *p_val, uint16_t len, const uint8_t **pp_stored);
+
+wiced_bt_gatt_status_t app_bt_write_queue_execute(uint16_t conn_id, app_bt_write_queue_cb_t callback, void *context,
+                                                  uint16_t *p_err_handle);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_BT_WRITE_QUEUE_H__ */
+
+/* [] END OF FILE */
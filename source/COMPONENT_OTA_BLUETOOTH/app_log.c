@@ -0,0 +1,239 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the deferred
+ *              binary log.
+ *
+ *              cy_log_msg() formats the message with vsnprintf() and writes it
+ *              to the UART in the caller's context, which costs more than the
+ *              processing of a DATA write. APP_LOG() only copies the format
+ *              string pointer and up to APP_LOG_MAX_ARGS argument words into a
+ *              ring of fixed size records and returns.
+ *
+ *              Writers (the Bluetooth® stack, the storage thread, ...) reserve a
+ *              record with a compare-and-swap on the head index, the record's
+ *              sequence number tells the single reader when it is complete.
+ *              Nothing blocks: when the ring is full the record is dropped and
+ *              counted, the count is reported with the next formatted message.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cyabs_rtos.h"
+#include "app_log.h"
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#if (APP_LOG_NUM_RECORDS & (APP_LOG_NUM_RECORDS - 1)) != 0
+#error "APP_LOG_NUM_RECORDS must be a power of 2"
+#endif
+
+#define APP_LOG_MASK                        (APP_LOG_NUM_RECORDS - 1)
+
+/*
+ * For the record at ring position pos, seq + (pos & APP_LOG_MASK) is pos while
+ * the record is free for a writer and pos + 1 once it is complete. The bias
+ * lets the zero initialized ring be used before app_log_init().
+ */
+typedef struct
+{
+    atomic_uint_fast32_t    seq;
+    const char              *fmt;
+    uint32_t                level;
+    uint32_t                args[APP_LOG_MAX_ARGS];
+} app_log_record_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_log_record_t log_ring[APP_LOG_NUM_RECORDS];
+static atomic_uint_fast32_t log_head;
+static uint32_t log_tail;
+static atomic_uint_fast32_t log_dropped;
+static uint32_t log_dropped_reported;
+static cy_thread_t log_thread;
+
+__attribute__((aligned(8)))
+static uint8_t log_thread_stack[APP_LOG_THREAD_STACK_SIZE];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/*
+ * Format every complete record, the only reader of the ring
+ */
+static void app_log_drain(void)
+{
+    while (true)
+    {
+        app_log_record_t *p_rec = &log_ring[log_tail & APP_LOG_MASK];
+        uint32_t *a = p_rec->args;
+        uint32_t dropped;
+
+        if ((uint32_t)(atomic_load_explicit(&p_rec->seq, memory_order_acquire) + (log_tail & APP_LOG_MASK)) != (log_tail + 1))
+        {
+            break;
+        }
+
+        dropped = (uint32_t)atomic_load(&log_dropped);
+        if (dropped != log_dropped_reported)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "app_log: %lu messages dropped\n", dropped - log_dropped_reported);
+            log_dropped_reported = dropped;
+        }
+
+        /* Unused argument words are passed as well, the format string does not read them */
+        cy_log_msg(CYLF_MIDDLEWARE, (CY_LOG_LEVEL_T)p_rec->level, p_rec->fmt, a[0], a[1], a[2], a[3], a[4], a[5]);
+
+        atomic_store_explicit(&p_rec->seq, log_tail + APP_LOG_NUM_RECORDS - (log_tail & APP_LOG_MASK), memory_order_release);
+        log_tail++;
+    }
+}
+
+static void app_log_thread(cy_thread_arg_t arg)
+{
+    (void)arg;
+
+    while (true)
+    {
+        cy_rtos_delay_milliseconds(APP_LOG_FLUSH_MS);
+        app_log_drain();
+    }
+}
+
+/*
+ * Function Name:
+ * app_log_init
+ *
+ * Function Description:
+ * @brief  Create the formatting thread, called once after cy_log_init().
+ *         Messages logged before are kept in the ring until the thread runs.
+ *
+ * @param void
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS or the RTOS error
+ */
+cy_rslt_t app_log_init(void)
+{
+    cy_rslt_t result;
+
+    result = cy_rtos_thread_create(&log_thread,
+                                   &app_log_thread,
+                                   "app log",
+                                   &log_thread_stack,
+                                   APP_LOG_THREAD_STACK_SIZE,
+                                   APP_LOG_THREAD_PRIORITY,
+                                   0);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() Failed - result: 0x%lx\n", __func__, result);
+    }
+
+    return result;
+}
+
+/*
+ * Function Name:
+ * app_log_write
+ *
+ * Function Description:
+ * @brief  Store a message for the formatting thread, use APP_LOG().
+ *
+ * @param level  CY_LOG_xxx level
+ * @param fmt    format string, must stay valid
+ * @param nargs  number of arguments that follow
+ *
+ * @return void
+ */
+void app_log_write(CY_LOG_LEVEL_T level, const char *fmt, uint32_t nargs, ...)
+{
+    app_log_record_t *p_rec;
+    uint_fast32_t pos;
+    va_list args;
+    uint32_t i;
+
+    pos = atomic_load_explicit(&log_head, memory_order_relaxed);
+    while (true)
+    {
+        int32_t dif;
+
+        p_rec = &log_ring[pos & APP_LOG_MASK];
+        dif = (int32_t)(uint32_t)(atomic_load_explicit(&p_rec->seq, memory_order_acquire) + (pos & APP_LOG_MASK) - pos);
+        if (dif == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&log_head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (dif < 0)
+        {
+            /* Ring full */
+            atomic_fetch_add(&log_dropped, 1);
+            return;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&log_head, memory_order_relaxed);
+        }
+    }
+
+    if (nargs > APP_LOG_MAX_ARGS)
+    {
+        nargs = APP_LOG_MAX_ARGS;
+    }
+    p_rec->fmt = fmt;
+    p_rec->level = (uint32_t)level;
+    va_start(args, nargs);
+    for (i = 0; i < APP_LOG_MAX_ARGS; i++)
+    {
+        p_rec->args[i] = (i < nargs) ? va_arg(args, uint32_t) : 0;
+    }
+    va_end(args);
+
+    atomic_store_explicit(&p_rec->seq, pos + 1 - (pos & APP_LOG_MASK), memory_order_release);
+}
+
+/*
+ * Function Name:
+ * app_log_dropped
+ *
+ * Function Description:
+ * @brief  Number of messages lost because the ring was full.
+ *
+ * @param void
+ *
+ * @return uint32_t  dropped messages since start up
+ */
+uint32_t app_log_dropped(void)
+{
+    return (uint32_t)atomic_load(&log_dropped);
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
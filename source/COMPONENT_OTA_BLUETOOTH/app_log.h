@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the deferred
+ *              binary log. APP_LOG() stores the format string and the raw
+ *              arguments, a low priority thread formats them later with
+ *              cy_log_msg(), outside of the caller's time critical path.
+ */
+
+#ifndef __APP_LOG_H__
+#define __APP_LOG_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* 0: APP_LOG() calls cy_log_msg() directly */
+#ifndef APP_LOG_DEFERRED
+#define APP_LOG_DEFERRED                    (1)
+#endif
+
+/* Number of records in the ring, a power of 2 */
+#ifndef APP_LOG_NUM_RECORDS
+#define APP_LOG_NUM_RECORDS                 (128)
+#endif
+
+/* Period of the formatting thread */
+#ifndef APP_LOG_FLUSH_MS
+#define APP_LOG_FLUSH_MS                    (20)
+#endif
+
+#ifndef APP_LOG_THREAD_STACK_SIZE
+#define APP_LOG_THREAD_STACK_SIZE           (2048)
+#endif
+
+#ifndef APP_LOG_THREAD_PRIORITY
+#define APP_LOG_THREAD_PRIORITY             (CY_RTOS_PRIORITY_LOW)
+#endif
+
+/* Most arguments of one APP_LOG() call */
+#define APP_LOG_MAX_ARGS                    (6)
+
+/*
+ * Log a message to CYLF_MIDDLEWARE at the given CY_LOG_xxx level.
+ *
+ * Arguments are stored as 32-bit words, so only integers and pointers of
+ * up to 32 bits may be passed. A string argument must stay valid until it
+ * is formatted (a literal or __func__).
+ */
+#if APP_LOG_DEFERRED
+#define APP_LOG(level, fmt, ...)            app_log_write((level), (fmt), APP_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#else
+#define APP_LOG(level, fmt, ...)            cy_log_msg(CYLF_MIDDLEWARE, (level), (fmt), ##__VA_ARGS__)
+#endif
+
+#define APP_LOG_NARGS(...)                  APP_LOG_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define APP_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, N, ...)  N
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+cy_rslt_t app_log_init(void);
+
+void app_log_write(CY_LOG_LEVEL_T level, const char *fmt, uint32_t nargs, ...);
+
+uint32_t app_log_dropped(void);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_LOG_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,275 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the
+ *              activation of a verified image.
+ *
+ *              After a successful VERIFY the activation waits for, in order:
+ *              - the confirmation of the CY_OTA_UPGRADE_STATUS_OK indication,
+ *              - the GATT buffers in flight, released on
+ *                GATT_APP_BUFFER_TRANSMITTED_EVT.
+ *              Each wait is bounded by a one shot timer, and a disconnection
+ *              ends it, so the new image is activated even if the peer app
+ *              goes away. Nothing sleeps in the Bluetooth stack callback,
+ *              and the timeout is handed over to the Bluetooth stack thread,
+ *              so the image is always switched from that thread.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "app_ota_activate.h"
+#include "app_bt_pool.h"
+#include "wiced_bt_stack.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef enum
+{
+    APP_OTA_ACTIVATE_IDLE = 0,
+    APP_OTA_ACTIVATE_WAIT_CONFIRM,      /* indication sent                      */
+    APP_OTA_ACTIVATE_WAIT_TRANSMITTED,  /* confirmed, responses still in flight */
+    APP_OTA_ACTIVATE_DONE,
+} app_ota_activate_state_t;
+
+typedef struct
+{
+    volatile app_ota_activate_state_t state;
+    bool                        timer_ok;
+    cy_timer_t                  timer;
+    cy_time_t                   armed_ms;
+    app_ota_activate_cb_t       callback;
+} app_ota_activate_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_activate_t activate;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/*
+ * Check that no GATT buffer is waiting to be transmitted
+ */
+static bool app_ota_activate_tx_idle(void)
+{
+    app_bt_pool_stats_t pool_stats;
+    uint8_t i;
+
+    for (i = 0; i < app_bt_pool_num_classes(); i++)
+    {
+        if (app_bt_pool_get_stats(i, &pool_stats) && (pool_stats.in_use != 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Move from one waiting state to the next, only one caller can win
+ */
+static bool app_ota_activate_move(app_ota_activate_state_t from, app_ota_activate_state_t to)
+{
+    bool moved = false;
+    uint32_t irq_state = cyhal_system_critical_section_enter();
+
+    if (activate.state == from)
+    {
+        activate.state = to;
+        moved = true;
+    }
+
+    cyhal_system_critical_section_exit(irq_state);
+    return moved;
+}
+
+static void app_ota_activate_now(app_ota_activate_state_t from, const char *reason)
+{
+    cy_time_t now_ms;
+
+    if ((from == APP_OTA_ACTIVATE_IDLE) || (from == APP_OTA_ACTIVATE_DONE) ||
+        !app_ota_activate_move(from, APP_OTA_ACTIVATE_DONE))
+    {
+        return;
+    }
+    if (activate.timer_ok)
+    {
+        cy_rtos_stop_timer(&activate.timer);
+    }
+
+    cy_rtos_get_time(&now_ms);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Activating new image on %s, %lu ms after VERIFY\n", reason, (uint32_t)(now_ms - activate.armed_ms));
+    if (activate.callback != NULL)
+    {
+        activate.callback();
+    }
+}
+
+/*
+ * Timeout, serialized to the Bluetooth® stack thread
+ */
+static int app_ota_activate_timeout_event(void *p_data)
+{
+    (void)p_data;
+
+    app_ota_activate_now(activate.state, "timeout");
+    return 0;
+}
+
+static void app_ota_activate_timer_cb(cy_timer_callback_arg_t arg)
+{
+    (void)arg;
+
+    if (wiced_app_event_serialize(app_ota_activate_timeout_event, NULL) != WICED_SUCCESS)
+    {
+        /* Try again later rather than switching images from the timer thread */
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_app_event_serialize() failed\n", __func__);
+        cy_rtos_start_timer(&activate.timer, APP_OTA_ACTIVATE_DRAIN_TIMEOUT_MS);
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_activate_init
+ *
+ * Function Description:
+ * @brief  Create the timeout timer, called once from bt_app_init().
+ *
+ * @param callback  switches to the new image
+ *
+ * @return void
+ */
+void app_ota_activate_init(app_ota_activate_cb_t callback)
+{
+    memset(&activate, 0x00, sizeof(activate));
+    activate.callback = callback;
+
+    if (cy_rtos_init_timer(&activate.timer, CY_TIMER_TYPE_ONCE, app_ota_activate_timer_cb, 0) == CY_RSLT_SUCCESS)
+    {
+        activate.timer_ok = true;
+    }
+    else
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() cy_rtos_init_timer() failed\n", __func__);
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_activate_arm
+ *
+ * Function Description:
+ * @brief  Start the activation after a successful VERIFY.
+ *
+ * @param indicated  true if the verification indication was sent, false to
+ *                   only wait for the buffers in flight
+ *
+ * @return void
+ */
+void app_ota_activate_arm(bool indicated)
+{
+    cy_rtos_get_time(&activate.armed_ms);
+    activate.state = (indicated) ? APP_OTA_ACTIVATE_WAIT_CONFIRM : APP_OTA_ACTIVATE_WAIT_TRANSMITTED;
+
+    if (!activate.timer_ok)
+    {
+        /* No fallback without the timer, do not wait for events that may never come */
+        app_ota_activate_now(activate.state, "timer failure");
+        return;
+    }
+    cy_rtos_start_timer(&activate.timer, (indicated) ? APP_OTA_ACTIVATE_CONFIRM_TIMEOUT_MS : APP_OTA_ACTIVATE_DRAIN_TIMEOUT_MS);
+}
+
+/*
+ * Function Name:
+ * app_ota_activate_confirmed
+ *
+ * Function Description:
+ * @brief  Account the confirmation of an indication, called on
+ *         GATT_HANDLE_VALUE_CONF.
+ *
+ * @param void
+ *
+ * @return bool  true if it confirmed the verification indication
+ */
+bool app_ota_activate_confirmed(void)
+{
+    if (!app_ota_activate_move(APP_OTA_ACTIVATE_WAIT_CONFIRM, APP_OTA_ACTIVATE_WAIT_TRANSMITTED))
+    {
+        return (activate.state != APP_OTA_ACTIVATE_IDLE);
+    }
+
+    if (app_ota_activate_tx_idle())
+    {
+        app_ota_activate_now(APP_OTA_ACTIVATE_WAIT_TRANSMITTED, "confirmation");
+    }
+    else if (activate.timer_ok)
+    {
+        cy_rtos_stop_timer(&activate.timer);
+        cy_rtos_start_timer(&activate.timer, APP_OTA_ACTIVATE_DRAIN_TIMEOUT_MS);
+    }
+    return true;
+}
+
+/*
+ * Function Name:
+ * app_ota_activate_transmitted
+ *
+ * Function Description:
+ * @brief  Called on GATT_APP_BUFFER_TRANSMITTED_EVT, once the buffer is freed.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_activate_transmitted(void)
+{
+    if ((activate.state == APP_OTA_ACTIVATE_WAIT_TRANSMITTED) && app_ota_activate_tx_idle())
+    {
+        app_ota_activate_now(APP_OTA_ACTIVATE_WAIT_TRANSMITTED, "transmission");
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_activate_disconnected
+ *
+ * Function Description:
+ * @brief  Nothing is left to wait for once the peer app is gone.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_activate_disconnected(void)
+{
+    app_ota_activate_now(activate.state, "disconnection");
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the
+ *              activation of a verified image. The device switches to the new
+ *              image as soon as the peer app confirmed the verification
+ *              indication and the last responses left, instead of after a
+ *              fixed delay.
+ */
+
+#ifndef __APP_OTA_ACTIVATE_H__
+#define __APP_OTA_ACTIVATE_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Longest wait for the confirmation of the verification indication */
+#ifndef APP_OTA_ACTIVATE_CONFIRM_TIMEOUT_MS
+#define APP_OTA_ACTIVATE_CONFIRM_TIMEOUT_MS (3000)
+#endif
+
+/* Longest wait for the GATT buffers in flight once confirmed */
+#ifndef APP_OTA_ACTIVATE_DRAIN_TIMEOUT_MS
+#define APP_OTA_ACTIVATE_DRAIN_TIMEOUT_MS   (100)
+#endif
+
+/* Switches to the new image, called once from the Bluetooth stack thread */
+typedef void (*app_ota_activate_cb_t)(void);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_activate_init(app_ota_activate_cb_t callback);
+
+void app_ota_activate_arm(bool indicated);
+
+bool app_ota_activate_confirmed(void);
+
+void app_ota_activate_transmitted(void);
+
+void app_ota_activate_disconnected(void);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_ACTIVATE_H__ */
+
+/* [] END OF FILE */
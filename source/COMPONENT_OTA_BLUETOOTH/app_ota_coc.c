@@ -0,0 +1,261 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the LE
+ *              credit based L2CAP channel (CoC) used for the OTA image data.
+ *
+ *              On the GATT path every chunk is an ATT PDU of at most
+ *              (MTU - 3) bytes which goes through the attribute request
+ *              handling. On the channel the host sends SDUs of up to
+ *              APP_OTA_COC_MTU bytes, segmented and flow controlled by
+ *              L2CAP credits, and each SDU is handed to the OTA data path
+ *              in one piece.
+ *
+ *              The PSM is registered at start-up, but a channel is only
+ *              accepted while an OTA session asked for it with
+ *              APP_OTA_PREPARE_OPT_COC. The data callback must not block,
+ *              so the SDU is only copied into the staging ring. When the
+ *              ring is left short of room the channel is marked congested,
+ *              the stack then stops returning credits and the host runs out
+ *              of them. app_ota_coc_room() clears the congestion once the
+ *              storage thread freed a block and the withheld credits go back
+ *              to the host. The credits the host holds when the channel is
+ *              marked congested must fit in APP_OTA_STAGE_HEADROOM.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "wiced_bt_l2c.h"
+#include "app_ota_coc.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef struct
+{
+    app_ota_coc_data_cb_t   data_cb;
+    app_ota_coc_room_cb_t   room_cb;
+    bool                    enabled;        /* the current OTA session accepts a channel */
+    bool                    congested;      /* credits are withheld from the host        */
+    uint16_t                lcid;           /* local channel ID, 0 if not connected      */
+    uint32_t                sdus;
+    uint32_t                bytes;
+    uint32_t                stalls;         /* times the credits were withheld           */
+} app_ota_coc_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_coc_t coc;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static void app_ota_coc_set_congested(bool congested)
+{
+    if ((coc.lcid == 0) || (coc.congested == congested))
+    {
+        return;
+    }
+    if (!wiced_bt_l2cap_le_set_user_congestion(coc.lcid, congested ? WICED_TRUE : WICED_FALSE))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_bt_l2cap_le_set_user_congestion(%d) failed\n", __func__, congested);
+        return;
+    }
+    coc.congested = congested;
+    if (congested)
+    {
+        coc.stalls++;
+    }
+}
+
+static void app_ota_coc_connected_ind(void *context, wiced_bt_device_address_t bd_addr, uint16_t lcid, uint16_t psm, uint8_t id, uint16_t mtu_peer)
+{
+    uint16_t result = L2CAP_LE_RESULT_CONN_OK;
+
+    (void)context;
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() psm 0x%x lcid 0x%x peer mtu %d\n", __func__, psm, lcid, mtu_peer);
+
+    if ((!coc.enabled) || (coc.lcid != 0))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s() no OTA session for the channel, rejected\n", __func__);
+        result = L2CAP_LE_RESULT_NO_RESOURCES;
+    }
+    if (!wiced_bt_l2cap_le_connect_rsp(bd_addr, id, lcid, result, APP_OTA_COC_MTU))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_bt_l2cap_le_connect_rsp() failed\n", __func__);
+        return;
+    }
+    if (result == L2CAP_LE_RESULT_CONN_OK)
+    {
+        coc.lcid = lcid;
+        coc.congested = false;
+        coc.sdus = 0;
+        coc.bytes = 0;
+        coc.stalls = 0;
+    }
+}
+
+static void app_ota_coc_disconnect_ind(void *context, uint16_t lcid, wiced_bool_t ack)
+{
+    (void)context;
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() lcid 0x%x, %lu SDUs %lu bytes %lu stalls\n", __func__, lcid, coc.sdus, coc.bytes, coc.stalls);
+
+    if (ack)
+    {
+        wiced_bt_l2cap_le_disconnect_rsp(lcid);
+    }
+    if (lcid == coc.lcid)
+    {
+        coc.lcid = 0;
+    }
+}
+
+static void app_ota_coc_disconnect_cfm(void *context, uint16_t lcid, uint16_t result)
+{
+    (void)context;
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() lcid 0x%x result 0x%x\n", __func__, lcid, result);
+
+    if (lcid == coc.lcid)
+    {
+        coc.lcid = 0;
+    }
+}
+
+static void app_ota_coc_data_ind(void *context, uint16_t lcid, uint8_t *p_buff, uint16_t buf_len)
+{
+    cy_rslt_t result;
+
+    (void)context;
+    if ((lcid != coc.lcid) || (coc.data_cb == NULL))
+    {
+        return;
+    }
+
+    result = coc.data_cb(p_buff, buf_len);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        /* The session is lost, the host learns why from the control point */
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() SDU of %d bytes rejected - result: 0x%lx\n", __func__, buf_len, result);
+        app_ota_coc_disconnect();
+        return;
+    }
+    coc.sdus++;
+    coc.bytes += buf_len;
+
+    if ((coc.room_cb != NULL) && (!coc.room_cb()))
+    {
+        app_ota_coc_set_congested(true);
+    }
+}
+
+static wiced_bt_l2cap_le_appl_information_t app_ota_coc_appl_info =
+{
+    .le_connected_indication_cback      = app_ota_coc_connected_ind,
+    .le_connected_confirmation_cback    = NULL,
+    .le_disconnect_indication_cback     = app_ota_coc_disconnect_ind,
+    .le_disconnect_confirmation_cback   = app_ota_coc_disconnect_cfm,
+    .le_data_indication_cback           = app_ota_coc_data_ind,
+    .le_congestion_status_cback         = NULL,
+    .le_tx_complete_cback               = NULL,
+};
+
+/*
+ * Function Name:
+ * app_ota_coc_init
+ *
+ * Function Description:
+ * @brief  Register the OTA data PSM, called once from bt_app_init().
+ *
+ * @param data_cb  receives every SDU of the channel
+ * @param room_cb  tells after every SDU whether the host may send more
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS or CY_RSLT_OTA_ERROR_GENERAL
+ */
+cy_rslt_t app_ota_coc_init(app_ota_coc_data_cb_t data_cb, app_ota_coc_room_cb_t room_cb)
+{
+    memset(&coc, 0x00, sizeof(coc));
+    coc.data_cb = data_cb;
+    coc.room_cb = room_cb;
+
+    if (wiced_bt_l2cap_le_register(APP_OTA_COC_PSM, &app_ota_coc_appl_info, NULL) != APP_OTA_COC_PSM)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() wiced_bt_l2cap_le_register(0x%x) failed\n", __func__, APP_OTA_COC_PSM);
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_coc_enable
+ *
+ * Function Description:
+ * @brief  Accept or refuse the channel for the current OTA session. Refusing
+ *         also closes a channel that is still open.
+ *
+ * @param enable  true after PREPARE_DOWNLOAD with APP_OTA_PREPARE_OPT_COC
+ *
+ * @return void
+ */
+void app_ota_coc_enable(bool enable)
+{
+    coc.enabled = enable;
+    if (!enable)
+    {
+        app_ota_coc_disconnect();
+    }
+}
+
+bool app_ota_coc_connected(void)
+{
+    return (coc.lcid != 0);
+}
+
+void app_ota_coc_disconnect(void)
+{
+    if (coc.lcid != 0)
+    {
+        wiced_bt_l2cap_le_disconnect_req(coc.lcid);
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_coc_room
+ *
+ * Function Description:
+ * @brief  Give the withheld credits back to the host, called from the
+ *         Bluetooth® stack thread once the staging ring has room again.
+ *
+ * @return void
+ */
+void app_ota_coc_room(void)
+{
+    app_ota_coc_set_congested(false);
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
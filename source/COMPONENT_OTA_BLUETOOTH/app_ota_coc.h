@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the LE
+ *              credit based L2CAP channel (CoC) used as an alternate path
+ *              for the OTA image data. Commands and status stay on the GATT
+ *              control point.
+ */
+
+#ifndef __APP_OTA_COC_H__
+#define __APP_OTA_COC_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* LE PSM of the OTA data channel, from the dynamic range 0x0080 - 0x00FF */
+#ifndef APP_OTA_COC_PSM
+#define APP_OTA_COC_PSM                     (0x0081)
+#endif
+
+/* Largest SDU accepted on the channel, must not exceed "L2capMtuSize" of the .cybt file */
+#ifndef APP_OTA_COC_MTU
+#define APP_OTA_COC_MTU                     (4096)
+#endif
+
+/* Called from the Bluetooth® stack thread for every SDU received on the channel */
+typedef cy_rslt_t (*app_ota_coc_data_cb_t)(const uint8_t *p_data, uint16_t len);
+
+/* Called from the Bluetooth® stack thread after every SDU, false withholds the
+ * credits of the channel until app_ota_coc_room() is called
+ */
+typedef bool (*app_ota_coc_room_cb_t)(void);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+cy_rslt_t app_ota_coc_init(app_ota_coc_data_cb_t data_cb, app_ota_coc_room_cb_t room_cb);
+
+void app_ota_coc_enable(bool enable);
+
+bool app_ota_coc_connected(void);
+
+void app_ota_coc_disconnect(void);
+
+void app_ota_coc_room(void);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_COC_H__ */
+
+/* [] END OF FILE */
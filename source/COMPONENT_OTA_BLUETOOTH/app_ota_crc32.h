@@ -0,0 +1,47 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes for the running
+ *              CRC32 (IEEE 802.3, reflected, polynomial 0xEDB88320) that is
+ *              computed over the OTA image while it is being received.
+ */
+
+#ifndef __APP_OTA_CRC32_H__
+#define __APP_OTA_CRC32_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Seed of a new running CRC32 */
+#define APP_OTA_CRC32_INIT                  (0xFFFFFFFFUL)
+
+/* Convert a running CRC32 to the value sent by the host with VERIFY */
+#define APP_OTA_CRC32_FINAL(crc)            ((uint32_t)((crc) ^ 0xFFFFFFFFUL))
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+uint32_t app_ota_crc32_update(uint32_t crc, const uint8_t *p_data, uint32_t len);
+
+#endif      /* __APP_OTA_CRC32_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,300 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the OTA
+ *              image decoder.
+ *
+ *              The compressed image is a heatshrink (LZSS) bit stream, most
+ *              significant bit first:
+ *
+ *                1 <8 bits>                           literal byte
+ *                0 <WINDOW_BITS index> <LOOKAHEAD_BITS count>
+ *                                                     copy count + 1 bytes
+ *                                                     from index + 1 bytes back
+ *
+ *              The last byte is padded with zero bits. The decoder keeps the
+ *              last (1 << WINDOW_BITS) output bytes and the undecoded bits of
+ *              the previous input chunk, so chunk boundaries do not need to
+ *              line up with anything. The RAM used is fixed at build time.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_ota_decomp.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define APP_OTA_DECOMP_WINDOW_SIZE          (1UL << APP_OTA_DECOMP_WINDOW_BITS)
+#define APP_OTA_DECOMP_WINDOW_MASK          (APP_OTA_DECOMP_WINDOW_SIZE - 1)
+
+#if (APP_OTA_DECOMP_WINDOW_BITS > 15) || (APP_OTA_DECOMP_LOOKAHEAD_BITS >= APP_OTA_DECOMP_WINDOW_BITS)
+#error "Unsupported APP_OTA_DECOMP_WINDOW_BITS / APP_OTA_DECOMP_LOOKAHEAD_BITS"
+#endif
+
+typedef enum
+{
+    APP_OTA_DECOMP_STATE_TAG,
+    APP_OTA_DECOMP_STATE_LITERAL,
+    APP_OTA_DECOMP_STATE_INDEX,
+    APP_OTA_DECOMP_STATE_COUNT,
+} app_ota_decomp_state_t;
+
+typedef struct
+{
+    bool                        enabled;
+    app_ota_decomp_state_t      state;
+    uint32_t                    bits;           /* undecoded input bits, right aligned */
+    uint8_t                     num_bits;
+    uint16_t                    index;
+    uint32_t                    head;           /* output bytes produced, the window write position */
+    uint32_t                    image_size;
+    uint16_t                    out_len;
+    cy_rslt_t                   error;
+    app_ota_decomp_output_cb_t  output_cb;
+} app_ota_decomp_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_decomp_t decomp;
+
+static uint8_t decomp_window[APP_OTA_DECOMP_WINDOW_SIZE];
+static uint8_t decomp_out[APP_OTA_DECOMP_OUT_SIZE];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static void app_ota_decomp_flush(void)
+{
+    cy_rslt_t result;
+
+    if ((decomp.out_len == 0) || (decomp.error != CY_RSLT_SUCCESS))
+    {
+        return;
+    }
+    result = decomp.output_cb(decomp_out, decomp.out_len);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        decomp.error = result;
+    }
+    decomp.out_len = 0;
+}
+
+static void app_ota_decomp_emit(uint8_t c)
+{
+    if (decomp.head >= decomp.image_size)
+    {
+        /* The stream decodes to more than the announced image size */
+        decomp.error = CY_RSLT_OTA_ERROR_GENERAL;
+        return;
+    }
+    decomp_window[decomp.head & APP_OTA_DECOMP_WINDOW_MASK] = c;
+    decomp.head++;
+
+    decomp_out[decomp.out_len++] = c;
+    if (decomp.out_len == APP_OTA_DECOMP_OUT_SIZE)
+    {
+        app_ota_decomp_flush();
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_decomp_init
+ *
+ * Function Description:
+ * @brief  Set the destination of the decoded image, called once at start up.
+ *
+ * @param output_cb  receives the decoded image in order
+ *
+ * @return void
+ */
+void app_ota_decomp_init(app_ota_decomp_output_cb_t output_cb)
+{
+    memset(&decomp, 0x00, sizeof(decomp));
+    decomp.output_cb = output_cb;
+}
+
+/*
+ * Function Name:
+ * app_ota_decomp_start
+ *
+ * Function Description:
+ * @brief  Decode the image data of this session, called on
+ *         CY_OTA_UPGRADE_COMMAND_DOWNLOAD with APP_OTA_DOWNLOAD_OPT_HEATSHRINK.
+ *
+ * @param image_size  size of the decoded image
+ *
+ * @return void
+ */
+void app_ota_decomp_start(uint32_t image_size)
+{
+    app_ota_decomp_output_cb_t output_cb = decomp.output_cb;
+
+    memset(&decomp, 0x00, sizeof(decomp));
+    memset(decomp_window, 0x00, sizeof(decomp_window));
+    decomp.output_cb = output_cb;
+    decomp.image_size = image_size;
+    decomp.state = APP_OTA_DECOMP_STATE_TAG;
+    decomp.enabled = true;
+}
+
+/*
+ * Function Name:
+ * app_ota_decomp_stop
+ *
+ * Function Description:
+ * @brief  Pass image data through unchanged again.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_decomp_stop(void)
+{
+    decomp.enabled = false;
+}
+
+/*
+ * Function Name:
+ * app_ota_decomp_enabled
+ *
+ * Function Description:
+ * @brief  Check if the image data of this session is compressed.
+ *
+ * @param void
+ *
+ * @return bool  true between app_ota_decomp_start() and app_ota_decomp_stop()
+ */
+bool app_ota_decomp_enabled(void)
+{
+    return decomp.enabled;
+}
+
+/*
+ * Function Name:
+ * app_ota_decomp_write
+ *
+ * Function Description:
+ * @brief  Decode a chunk of the compressed image. Everything the chunk
+ *         completes is passed to the output callback before returning.
+ *
+ * @param p_data  compressed data
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, the output callback error, or
+ *                    CY_RSLT_OTA_ERROR_GENERAL if the stream exceeds the image size
+ */
+cy_rslt_t app_ota_decomp_write(const uint8_t *p_data, uint16_t len)
+{
+    uint16_t pos;
+
+    for (pos = 0; (pos < len) && (decomp.error == CY_RSLT_SUCCESS); pos++)
+    {
+        decomp.bits = (decomp.bits << 8) | p_data[pos];
+        decomp.num_bits += 8;
+
+        while (decomp.error == CY_RSLT_SUCCESS)
+        {
+            uint8_t need;
+            uint16_t value;
+
+            switch (decomp.state)
+            {
+            case APP_OTA_DECOMP_STATE_TAG:
+                need = 1;
+                break;
+            case APP_OTA_DECOMP_STATE_LITERAL:
+                need = 8;
+                break;
+            case APP_OTA_DECOMP_STATE_INDEX:
+                need = APP_OTA_DECOMP_WINDOW_BITS;
+                break;
+            default:
+                need = APP_OTA_DECOMP_LOOKAHEAD_BITS;
+                break;
+            }
+            if (decomp.num_bits < need)
+            {
+                break;
+            }
+            decomp.num_bits -= need;
+            value = (uint16_t)((decomp.bits >> decomp.num_bits) & ((1UL << need) - 1));
+            decomp.bits &= (1UL << decomp.num_bits) - 1;
+
+            switch (decomp.state)
+            {
+            case APP_OTA_DECOMP_STATE_TAG:
+                decomp.state = (value != 0) ? APP_OTA_DECOMP_STATE_LITERAL : APP_OTA_DECOMP_STATE_INDEX;
+                break;
+
+            case APP_OTA_DECOMP_STATE_LITERAL:
+                app_ota_decomp_emit((uint8_t)value);
+                decomp.state = APP_OTA_DECOMP_STATE_TAG;
+                break;
+
+            case APP_OTA_DECOMP_STATE_INDEX:
+                decomp.index = value + 1;
+                decomp.state = APP_OTA_DECOMP_STATE_COUNT;
+                break;
+
+            default:
+            {
+                uint16_t count;
+
+                for (count = value + 1; (count > 0) && (decomp.error == CY_RSLT_SUCCESS); count--)
+                {
+                    app_ota_decomp_emit(decomp_window[(decomp.head - decomp.index) & APP_OTA_DECOMP_WINDOW_MASK]);
+                }
+                decomp.state = APP_OTA_DECOMP_STATE_TAG;
+                break;
+            }
+            }
+        }
+    }
+
+    app_ota_decomp_flush();
+
+    return decomp.error;
+}
+
+/*
+ * Function Name:
+ * app_ota_decomp_output_len
+ *
+ * Function Description:
+ * @brief  Number of decoded bytes so far.
+ *
+ * @param void
+ *
+ * @return uint32_t  decoded bytes since app_ota_decomp_start()
+ */
+uint32_t app_ota_decomp_output_len(void)
+{
+    return decomp.head;
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the OTA
+ *              image decoder, which expands a compressed image on the fly
+ *              between the DATA path and the OTA storage.
+ */
+
+#ifndef __APP_OTA_DECOMP_H__
+#define __APP_OTA_DECOMP_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/*
+ * heatshrink parameters, the host must compress with the same values
+ * (heatshrink -e -w 10 -l 4). The window costs (1 << WINDOW_BITS) bytes of RAM.
+ */
+#ifndef APP_OTA_DECOMP_WINDOW_BITS
+#define APP_OTA_DECOMP_WINDOW_BITS          (10)
+#endif
+
+#ifndef APP_OTA_DECOMP_LOOKAHEAD_BITS
+#define APP_OTA_DECOMP_LOOKAHEAD_BITS       (4)
+#endif
+
+/* Decoded bytes are handed to the output callback in chunks of up to this size */
+#ifndef APP_OTA_DECOMP_OUT_SIZE
+#define APP_OTA_DECOMP_OUT_SIZE             (256)
+#endif
+
+/* Receives the decoded image */
+typedef cy_rslt_t (*app_ota_decomp_output_cb_t)(const uint8_t *p_data, uint16_t len);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_decomp_init(app_ota_decomp_output_cb_t output_cb);
+
+void app_ota_decomp_start(uint32_t image_size);
+
+void app_ota_decomp_stop(void);
+
+bool app_ota_decomp_enabled(void);
+
+cy_rslt_t app_ota_decomp_write(const uint8_t *p_data, uint16_t len);
+
+uint32_t app_ota_decomp_output_len(void);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_DECOMP_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,389 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the OTA
+ *              delta decoder.
+ *
+ *              A patch describes the new image as a sequence of COPY, ADD and
+ *              INSERT records against the running image, see app_ota_delta.h.
+ *              ADD carries the bytewise difference of a region that moved
+ *              with small changes, like bsdiff, so the patch compresses well
+ *              when it is also heatshrink encoded.
+ *
+ *              The patch is applied while it arrives, in any chunk sizes. The
+ *              running image is read through a fixed chunk buffer and the new
+ *              image leaves through the output callback, the RAM used does not
+ *              depend on the image or patch size. The base image CRC32 in the
+ *              header is checked before anything is written, so a patch made
+ *              for another version is refused.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_ota_delta.h"
+#include "app_ota_slot.h"
+#include "app_ota_crc32.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Longest record header, op + len + base offset */
+#define APP_OTA_DELTA_RECORD_MAX_LEN        (9)
+
+typedef enum
+{
+    APP_OTA_DELTA_STATE_HEADER,         /* collecting the patch header */
+    APP_OTA_DELTA_STATE_RECORD,         /* collecting a record header */
+    APP_OTA_DELTA_STATE_DATA,           /* ADD or INSERT bytes of the current record */
+} app_ota_delta_state_t;
+
+typedef struct
+{
+    bool                        enabled;
+    app_ota_delta_state_t       state;
+    uint8_t                     acc[APP_OTA_DELTA_HEADER_LEN];
+    uint8_t                     acc_len;
+    uint8_t                     acc_need;
+    uint8_t                     op;
+    uint32_t                    remaining;      /* bytes left in the current record */
+    uint32_t                    base_offset;
+    uint32_t                    base_size;
+    uint32_t                    image_size;
+    uint32_t                    written;
+    cy_rslt_t                   error;
+    app_ota_delta_output_cb_t   output_cb;
+} app_ota_delta_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_delta_t delta;
+
+static uint8_t delta_chunk[APP_OTA_DELTA_CHUNK_SIZE];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static uint32_t app_ota_delta_get_u32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 0) | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static cy_rslt_t app_ota_delta_read_base(uint32_t offset, uint8_t *p_buf, uint32_t len)
+{
+    cy_rslt_t result = app_ota_slot_read_active(offset, p_buf, len);
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() running image not readable at 0x%lx - result: 0x%lx\n", __func__, offset, result);
+    }
+    return result;
+}
+
+static cy_rslt_t app_ota_delta_output(const uint8_t *p_data, uint16_t len)
+{
+    if (len > (delta.image_size - delta.written))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() patch exceeds the image size 0x%lx\n", __func__, delta.image_size);
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    delta.written += len;
+    return delta.output_cb(p_data, len);
+}
+
+/* Check the patch header and that it was made for the running image */
+static cy_rslt_t app_ota_delta_check_header(void)
+{
+    uint32_t base_crc32 = APP_OTA_CRC32_INIT;
+    uint32_t offset;
+    cy_rslt_t result;
+
+    if ((memcmp(delta.acc, APP_OTA_DELTA_MAGIC, 4) != 0) || (delta.acc[4] != APP_OTA_DELTA_VERSION))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() not a version %d patch\n", __func__, APP_OTA_DELTA_VERSION);
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    if (app_ota_delta_get_u32(&delta.acc[16]) != delta.image_size)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() patch image size 0x%lx, expected 0x%lx\n", __func__, app_ota_delta_get_u32(&delta.acc[16]), delta.image_size);
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    delta.base_size = app_ota_delta_get_u32(&delta.acc[8]);
+
+    for (offset = 0; offset < delta.base_size; offset += APP_OTA_DELTA_CHUNK_SIZE)
+    {
+        uint32_t len = delta.base_size - offset;
+
+        if (len > APP_OTA_DELTA_CHUNK_SIZE)
+        {
+            len = APP_OTA_DELTA_CHUNK_SIZE;
+        }
+        result = app_ota_delta_read_base(offset, delta_chunk, len);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+        base_crc32 = app_ota_crc32_update(base_crc32, delta_chunk, len);
+    }
+    if (APP_OTA_CRC32_FINAL(base_crc32) != app_ota_delta_get_u32(&delta.acc[12]))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() patch base CRC 0x%lx, running image 0x%lx\n", __func__, app_ota_delta_get_u32(&delta.acc[12]), APP_OTA_CRC32_FINAL(base_crc32));
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* Decode a complete record header and run a COPY */
+static cy_rslt_t app_ota_delta_start_record(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    delta.remaining = app_ota_delta_get_u32(&delta.acc[1]);
+    delta.base_offset = (delta.op != APP_OTA_DELTA_OP_INSERT) ? app_ota_delta_get_u32(&delta.acc[5]) : 0;
+
+    if ((delta.op != APP_OTA_DELTA_OP_INSERT) &&
+        ((delta.base_offset > delta.base_size) || (delta.remaining > (delta.base_size - delta.base_offset))))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() record outside of the base image\n", __func__);
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+
+    while ((delta.op == APP_OTA_DELTA_OP_COPY) && (delta.remaining > 0) && (result == CY_RSLT_SUCCESS))
+    {
+        uint16_t len = (delta.remaining > APP_OTA_DELTA_CHUNK_SIZE) ? APP_OTA_DELTA_CHUNK_SIZE : (uint16_t)delta.remaining;
+
+        result = app_ota_delta_read_base(delta.base_offset, delta_chunk, len);
+        if (result == CY_RSLT_SUCCESS)
+        {
+            result = app_ota_delta_output(delta_chunk, len);
+        }
+        delta.base_offset += len;
+        delta.remaining -= len;
+    }
+
+    return result;
+}
+
+/* Apply up to len ADD or INSERT bytes of the current record, returns the number used */
+static uint16_t app_ota_delta_record_data(const uint8_t *p_data, uint16_t len, cy_rslt_t *p_result)
+{
+    uint16_t i;
+
+    if (len > delta.remaining)
+    {
+        len = (uint16_t)delta.remaining;
+    }
+
+    if (delta.op == APP_OTA_DELTA_OP_INSERT)
+    {
+        *p_result = app_ota_delta_output(p_data, len);
+    }
+    else
+    {
+        if (len > APP_OTA_DELTA_CHUNK_SIZE)
+        {
+            len = APP_OTA_DELTA_CHUNK_SIZE;
+        }
+        *p_result = app_ota_delta_read_base(delta.base_offset, delta_chunk, len);
+        if (*p_result == CY_RSLT_SUCCESS)
+        {
+            for (i = 0; i < len; i++)
+            {
+                delta_chunk[i] = (uint8_t)(delta_chunk[i] + p_data[i]);
+            }
+            *p_result = app_ota_delta_output(delta_chunk, len);
+        }
+        delta.base_offset += len;
+    }
+    delta.remaining -= len;
+
+    return len;
+}
+
+/*
+ * Function Name:
+ * app_ota_delta_init
+ *
+ * Function Description:
+ * @brief  Set the destination of the rebuilt image, called once at start up.
+ *
+ * @param output_cb  receives the new image in order
+ *
+ * @return void
+ */
+void app_ota_delta_init(app_ota_delta_output_cb_t output_cb)
+{
+    memset(&delta, 0x00, sizeof(delta));
+    delta.output_cb = output_cb;
+}
+
+/*
+ * Function Name:
+ * app_ota_delta_supported
+ *
+ * Function Description:
+ * @brief  Check if the running image can be read as the base of a patch.
+ *
+ * @param void
+ *
+ * @return bool  true if the running image can be read, see app_ota_slot.h
+ */
+bool app_ota_delta_supported(void)
+{
+    return app_ota_slot_active_readable();
+}
+
+/*
+ * Function Name:
+ * app_ota_delta_start
+ *
+ * Function Description:
+ * @brief  Apply the image data of this session as a patch, called on
+ *         CY_OTA_UPGRADE_COMMAND_DOWNLOAD with APP_OTA_DOWNLOAD_OPT_DELTA.
+ *
+ * @param image_size  size of the new image
+ *
+ * @return void
+ */
+void app_ota_delta_start(uint32_t image_size)
+{
+    app_ota_delta_output_cb_t output_cb = delta.output_cb;
+
+    memset(&delta, 0x00, sizeof(delta));
+    delta.output_cb = output_cb;
+    delta.image_size = image_size;
+    delta.state = APP_OTA_DELTA_STATE_HEADER;
+    delta.acc_need = APP_OTA_DELTA_HEADER_LEN;
+    delta.enabled = true;
+}
+
+/*
+ * Function Name:
+ * app_ota_delta_stop
+ *
+ * Function Description:
+ * @brief  Pass image data through unchanged again.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_delta_stop(void)
+{
+    delta.enabled = false;
+}
+
+/*
+ * Function Name:
+ * app_ota_delta_enabled
+ *
+ * Function Description:
+ * @brief  Check if the image data of this session is a patch.
+ *
+ * @param void
+ *
+ * @return bool  true between app_ota_delta_start() and app_ota_delta_stop()
+ */
+bool app_ota_delta_enabled(void)
+{
+    return delta.enabled;
+}
+
+/*
+ * Function Name:
+ * app_ota_delta_write
+ *
+ * Function Description:
+ * @brief  Apply a chunk of the patch. Everything the chunk completes is
+ *         passed to the output callback before returning.
+ *
+ * @param p_data  patch data
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, the output callback error, or
+ *                    CY_RSLT_OTA_ERROR_GENERAL for a patch that does not apply
+ */
+cy_rslt_t app_ota_delta_write(const uint8_t *p_data, uint16_t len)
+{
+    cy_rslt_t result = delta.error;
+    uint16_t pos = 0;
+
+    while ((pos < len) && (result == CY_RSLT_SUCCESS))
+    {
+        if (delta.state == APP_OTA_DELTA_STATE_DATA)
+        {
+            pos += app_ota_delta_record_data(&p_data[pos], len - pos, &result);
+            if (delta.remaining == 0)
+            {
+                delta.state = APP_OTA_DELTA_STATE_RECORD;
+            }
+            continue;
+        }
+
+        delta.acc[delta.acc_len++] = p_data[pos++];
+        if ((delta.state == APP_OTA_DELTA_STATE_RECORD) && (delta.acc_len == 1))
+        {
+            delta.op = delta.acc[0];
+            switch (delta.op)
+            {
+            case APP_OTA_DELTA_OP_COPY:
+            case APP_OTA_DELTA_OP_ADD:
+                delta.acc_need = APP_OTA_DELTA_RECORD_MAX_LEN;
+                break;
+            case APP_OTA_DELTA_OP_INSERT:
+                delta.acc_need = 5;
+                break;
+            default:
+                cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() bad record 0x%x\n", __func__, delta.op);
+                result = CY_RSLT_OTA_ERROR_GENERAL;
+                break;
+            }
+        }
+        if ((result != CY_RSLT_SUCCESS) || (delta.acc_len < delta.acc_need))
+        {
+            continue;
+        }
+
+        if (delta.state == APP_OTA_DELTA_STATE_HEADER)
+        {
+            result = app_ota_delta_check_header();
+        }
+        else
+        {
+            result = app_ota_delta_start_record();
+        }
+        delta.acc_len = 0;
+        delta.acc_need = 1;
+        delta.state = ((delta.state == APP_OTA_DELTA_STATE_RECORD) && (delta.remaining > 0)) ? APP_OTA_DELTA_STATE_DATA : APP_OTA_DELTA_STATE_RECORD;
+    }
+
+    /* The record boundaries are lost after an error, refuse the rest of the session */
+    delta.error = result;
+
+    return result;
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the OTA
+ *              delta decoder, which rebuilds the new image from a patch and
+ *              the image that is currently running.
+ */
+
+#ifndef __APP_OTA_DELTA_H__
+#define __APP_OTA_DELTA_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* The running image, the base of the patches, is read with app_ota_slot_read_active() */
+
+/* Bytes of the running image read at a time */
+#ifndef APP_OTA_DELTA_CHUNK_SIZE
+#define APP_OTA_DELTA_CHUNK_SIZE            (256)
+#endif
+
+/*
+ * Patch format, all values little-endian
+ *
+ *   Header
+ *     [0..3]   APP_OTA_DELTA_MAGIC "OTAD"
+ *     [4]      APP_OTA_DELTA_VERSION
+ *     [5..7]   reserved, 0
+ *     [8..11]  size of the base image
+ *     [12..15] CRC32 of the base image
+ *     [16..19] size of the new image
+ *
+ *   Followed by records, until the new image is complete
+ *     COPY   [op][len (4)][base offset (4)]            len bytes of the base image
+ *     ADD    [op][len (4)][base offset (4)][len bytes] base image bytes plus the given bytes, modulo 256
+ *     INSERT [op][len (4)][len bytes]                  the given bytes
+ */
+#define APP_OTA_DELTA_MAGIC                 "OTAD"
+#define APP_OTA_DELTA_VERSION               (1)
+#define APP_OTA_DELTA_HEADER_LEN            (20)
+
+#define APP_OTA_DELTA_OP_COPY               (0x01)
+#define APP_OTA_DELTA_OP_ADD                (0x02)
+#define APP_OTA_DELTA_OP_INSERT             (0x03)
+
+/* Receives the rebuilt image */
+typedef cy_rslt_t (*app_ota_delta_output_cb_t)(const uint8_t *p_data, uint16_t len);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_delta_init(app_ota_delta_output_cb_t output_cb);
+
+bool app_ota_delta_supported(void);
+
+void app_ota_delta_start(uint32_t image_size);
+
+void app_ota_delta_stop(void);
+
+bool app_ota_delta_enabled(void);
+
+cy_rslt_t app_ota_delta_write(const uint8_t *p_data, uint16_t len);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_DELTA_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,365 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the erase
+ *              ahead of the upgrade slot.
+ *
+ *              cy_ota_storage_open() clears the whole upgrade slot, which
+ *              takes seconds and delays the reply to the host before the
+ *              first byte can be sent. When the application can erase the
+ *              slot, see app_ota_slot_erase_upgrade(), the open only keeps
+ *              track of the session and the slot is erased while the image
+ *              arrives: the storage thread erases up to
+ *              APP_OTA_ERASE_AHEAD_BYTES ahead of the write pointer whenever
+ *              it has no block to program, and a write that catches up with
+ *              the erased area erases what it needs first. Nothing past the
+ *              image size given with CY_OTA_UPGRADE_COMMAND_DOWNLOAD is
+ *              erased.
+ *
+ *              Only the storage thread erases and programs, so the flash is
+ *              never busy with two operations at once.
+ *
+ *              Since the slot is not cleared, its previous content is still
+ *              there when the image arrives. When the host asks to skip
+ *              unchanged blocks, nothing is erased ahead and only sectors are
+ *              erased. The storage thread compares each block with the slot
+ *              first, see app_ota_stage.c, and a block that matches is
+ *              neither erased nor programmed.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cy_ota_storage_api.h"
+#include "cyhal.h"
+#include "app_ota_erase.h"
+#include "app_ota_slot.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define APP_OTA_ERASE_ROUND_UP(x, size)     ((((x) + (size) - 1) / (size)) * (size))
+
+typedef struct
+{
+    volatile bool               active;         /* erase ahead for the current session      */
+    bool                        failed;         /* stop erasing ahead after an error        */
+    bool                        skip_unchanged; /* erase only on demand, sector by sector   */
+    cy_ota_storage_context_t    *storage_ptr;
+    uint32_t                    sector_size;
+    uint32_t                    erased;         /* bytes from the slot start known erased   */
+    uint32_t                    write_end;      /* end of the furthest write                */
+    uint32_t                    erase_ops;
+} app_ota_erase_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_erase_t erase;
+
+/* Mode of the next session, see app_ota_erase_skip_unchanged() */
+static bool skip_unchanged_next;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/* End of the sectors the image uses, never past the slot */
+static uint32_t app_ota_erase_image_end(void)
+{
+    uint32_t image_end = APP_OTA_ERASE_ROUND_UP(erase.storage_ptr->total_image_size, erase.sector_size);
+
+    if ((APP_OTA_UPGRADE_SLOT_SIZE != 0) && (image_end > APP_OTA_UPGRADE_SLOT_SIZE))
+    {
+        image_end = APP_OTA_UPGRADE_SLOT_SIZE;
+    }
+    return image_end;
+}
+
+/*
+ * End of the area to keep erased: the write pointer plus the erase ahead,
+ * within the image
+ */
+static uint32_t app_ota_erase_limit(void)
+{
+    uint32_t image_end = app_ota_erase_image_end();
+    uint32_t ahead = erase.write_end + APP_OTA_ERASE_AHEAD_BYTES;
+
+    return (ahead < image_end) ? ahead : image_end;
+}
+
+/*
+ * Erase the next unit after erase.erased: a large block when aligned and
+ * within the image, even if it reaches past the erase ahead, a sector
+ * otherwise. Sectors after the current one may still match the image when
+ * skipping unchanged blocks, they are never erased ahead.
+ */
+static cy_rslt_t app_ota_erase_next(void)
+{
+    uint32_t len = erase.sector_size;
+    cy_rslt_t result;
+
+    if ((!erase.skip_unchanged) &&
+        ((erase.erased % APP_OTA_ERASE_BLOCK_SIZE) == 0) && ((erase.erased + APP_OTA_ERASE_BLOCK_SIZE) <= app_ota_erase_image_end()))
+    {
+        len = APP_OTA_ERASE_BLOCK_SIZE;
+    }
+
+    result = app_ota_slot_erase_upgrade(erase.erased, len);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() erase at 0x%lx len 0x%lx Failed - result: 0x%lx\n", __func__, erase.erased, len, result);
+        erase.failed = true;
+        return result;
+    }
+    erase.erased += len;
+    erase.erase_ops++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+static void app_ota_erase_begin(cy_ota_storage_context_t *storage_ptr, uint32_t erased)
+{
+    erase.active = false;
+    __DMB();
+    erase.storage_ptr = storage_ptr;
+    erase.sector_size = app_ota_slot_upgrade_erase_size();
+    erase.erased = APP_OTA_ERASE_ROUND_UP(erased, erase.sector_size);
+    erase.write_end = erased;
+    erase.erase_ops = 0;
+    erase.failed = false;
+    erase.skip_unchanged = skip_unchanged_next;
+
+    /* The storage thread may only see the session with its fields set */
+    __DMB();
+    erase.active = true;
+}
+
+/*
+ * Function Name:
+ * app_ota_erase_supported
+ *
+ * Function Description:
+ * @brief  Check if the upgrade slot is erased ahead on this target.
+ *
+ * @param void
+ *
+ * @return bool  true if the application can erase the slot, see app_ota_slot.h
+ */
+bool app_ota_erase_supported(void)
+{
+    return (app_ota_slot_upgrade_erase_size() != 0);
+}
+
+/*
+ * Function Name:
+ * app_ota_erase_skip_unchanged
+ *
+ * Function Description:
+ * @brief  Select the mode of the next session, called before the upgrade
+ *         slot is opened.
+ *
+ * @param enable  true if the storage thread compares each block with the
+ *                slot before writing it
+ *
+ * @return void
+ */
+void app_ota_erase_skip_unchanged(bool enable)
+{
+    skip_unchanged_next = enable;
+}
+
+/*
+ * Function Name:
+ * app_ota_erase_storage_open
+ *
+ * Function Description:
+ * @brief  ota_file_open of the storage interface, through
+ *         app_ota_resume_storage_open(). When the application can erase the
+ *         slot, it is not cleared here, the sectors are erased as the image
+ *         is written.
+ *
+ * @param storage_ptr  OTA storage context
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS or the result of cy_ota_storage_open()
+ */
+cy_rslt_t app_ota_erase_storage_open(cy_ota_storage_context_t *storage_ptr)
+{
+    if (app_ota_slot_upgrade_erase_size() == 0)
+    {
+        return cy_ota_storage_open(storage_ptr);
+    }
+    app_ota_erase_begin(storage_ptr, 0);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() erase ahead, sector 0x%lx\n", __func__, erase.sector_size);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_erase_resume
+ *
+ * Function Description:
+ * @brief  Continue erasing ahead in a slot that already holds offset bytes,
+ *         used instead of app_ota_erase_storage_open() when resuming. The
+ *         sector holding the last stored byte was erased before it was
+ *         written and is not erased again.
+ *
+ * @param storage_ptr  OTA storage context
+ * @param offset       bytes already written to the slot
+ *
+ * @return void
+ */
+void app_ota_erase_resume(cy_ota_storage_context_t *storage_ptr, uint32_t offset)
+{
+    if (app_ota_slot_upgrade_erase_size() != 0)
+    {
+        app_ota_erase_begin(storage_ptr, offset);
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_erase_storage_write
+ *
+ * Function Description:
+ * @brief  ota_file_write of the storage interface, called by the OTA library
+ *         in the storage thread. Erases the sectors the chunk goes to if the
+ *         storage thread did not get to them yet.
+ *
+ * @param storage_ptr  OTA storage context
+ * @param chunk_info   data to write and its offset in the slot
+ *
+ * @return cy_rslt_t  result of cy_ota_storage_write(), CY_RSLT_OTA_ERROR_WRITE_STORAGE if the erase failed
+ */
+cy_rslt_t app_ota_erase_storage_write(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_write_info_t *chunk_info)
+{
+    if (erase.active)
+    {
+        uint32_t end = chunk_info->offset + chunk_info->size;
+
+        if (end > erase.write_end)
+        {
+            erase.write_end = end;
+        }
+        while (erase.erased < end)
+        {
+            if (app_ota_erase_next() != CY_RSLT_SUCCESS)
+            {
+                return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+            }
+        }
+    }
+    return cy_ota_storage_write(storage_ptr, chunk_info);
+}
+
+/*
+ * Function Name:
+ * app_ota_erase_ahead
+ *
+ * Function Description:
+ * @brief  Erase one unit ahead of the write pointer, called by the storage
+ *         thread while it has no block to program.
+ *
+ * @param void
+ *
+ * @return bool  true if a unit was erased, false if there is nothing to do
+ */
+bool app_ota_erase_ahead(void)
+{
+    if ((!erase.active) || erase.failed || erase.skip_unchanged || (erase.erased >= app_ota_erase_limit()))
+    {
+        return false;
+    }
+    return (app_ota_erase_next() == CY_RSLT_SUCCESS);
+}
+
+/*
+ * Function Name:
+ * app_ota_erase_may_skip
+ *
+ * Function Description:
+ * @brief  Check if a block may be left as the slot holds it, called by the
+ *         storage thread before it compares the block. Only whole sectors
+ *         that were not erased yet can be kept, the tail of the image ends
+ *         the last one.
+ *
+ * @param offset  offset of the block in the slot
+ * @param len     number of bytes
+ *
+ * @return bool  true if the block is skipped when the slot already holds it
+ */
+bool app_ota_erase_may_skip(uint32_t offset, uint32_t len)
+{
+    uint32_t end = offset + len;
+
+    return erase.active && erase.skip_unchanged && (offset == erase.erased) && ((offset % erase.sector_size) == 0) &&
+           (((end % erase.sector_size) == 0) || (end >= erase.storage_ptr->total_image_size));
+}
+
+/*
+ * Function Name:
+ * app_ota_erase_skipped
+ *
+ * Function Description:
+ * @brief  A block the slot already holds was not written, its sectors must
+ *         not be erased by the next write.
+ *
+ * @param offset  offset of the block in the slot
+ * @param len     number of bytes
+ *
+ * @return void
+ */
+void app_ota_erase_skipped(uint32_t offset, uint32_t len)
+{
+    uint32_t end = offset + len;
+
+    if (end > erase.write_end)
+    {
+        erase.write_end = end;
+    }
+    erase.erased = APP_OTA_ERASE_ROUND_UP(end, erase.sector_size);
+}
+
+/*
+ * Function Name:
+ * app_ota_erase_stop
+ *
+ * Function Description:
+ * @brief  End erasing ahead, called when the session is verified or aborted,
+ *         once the storage thread is idle.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_erase_stop(void)
+{
+    if (erase.active)
+    {
+        erase.active = false;
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Erase ahead: 0x%lx bytes in %lu erase operations\n", erase.erased, erase.erase_ops);
+    }
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
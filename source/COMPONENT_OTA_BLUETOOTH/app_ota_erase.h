@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the erase
+ *              ahead of the upgrade slot. Instead of clearing the whole slot
+ *              when it is opened, only the sectors that the image will use
+ *              are erased, by the storage thread, a little ahead of the data
+ *              written to them. Blocks that the slot already holds can be
+ *              left untouched.
+ */
+
+#ifndef __APP_OTA_ERASE_H__
+#define __APP_OTA_ERASE_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cy_ota_storage_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Bytes kept erased ahead of the write pointer */
+#ifndef APP_OTA_ERASE_AHEAD_BYTES
+#define APP_OTA_ERASE_AHEAD_BYTES           (0x10000)
+#endif
+
+/* Erase unit used when the offset is aligned to it, the large block erase of the flash */
+#ifndef APP_OTA_ERASE_BLOCK_SIZE
+#define APP_OTA_ERASE_BLOCK_SIZE            (0x10000)
+#endif
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+bool app_ota_erase_supported(void);
+
+void app_ota_erase_skip_unchanged(bool enable);
+
+cy_rslt_t app_ota_erase_storage_open(cy_ota_storage_context_t *storage_ptr);
+
+void app_ota_erase_resume(cy_ota_storage_context_t *storage_ptr, uint32_t offset);
+
+cy_rslt_t app_ota_erase_storage_write(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_write_info_t *chunk_info);
+
+bool app_ota_erase_ahead(void);
+
+bool app_ota_erase_may_skip(uint32_t offset, uint32_t len);
+
+void app_ota_erase_skipped(uint32_t offset, uint32_t len);
+
+void app_ota_erase_stop(void);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_ERASE_H__ */
+
+/* [] END OF FILE */
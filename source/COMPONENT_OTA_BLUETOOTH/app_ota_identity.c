@@ -0,0 +1,302 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the
+ *              installed image identity.
+ *
+ *              The active slot is hashed once at start up, through
+ *              app_ota_slot_read_active(). The header of the image does not
+ *              give its length, so the size of each image verified over the
+ *              air is kept in the emulated EEPROM and the next start up
+ *              hashes that many bytes. Without the record, before the first
+ *              update, for an image flashed by a programmer or without
+ *              USE_EEPROM_TO_STORE_BOND_INFO, the whole active slot is
+ *              hashed and reported as such.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "ota_context.h"
+#include "app_ota_identity.h"
+#include "app_ota_image_info.h"
+#include "app_ota_resume.h"
+#include "app_ota_slot.h"
+#include "app_ota_stage.h"
+#include "app_ota_crc32.h"
+#include <stddef.h>
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define APP_OTA_IDENTITY_MAGIC              (0x4F54414EUL)     /* "OTAN" */
+
+/* Persistent record of the last image installed over the air, EEPROM_INSTALLED_SIZE bytes */
+typedef struct
+{
+    uint32_t    magic;
+    uint32_t    image_size;
+    uint32_t    reserved;
+    uint32_t    check;          /* CRC32 of the fields above */
+} app_ota_identity_record_t;
+
+typedef struct
+{
+    app_ota_identity_value_t    value;      /* hash and version, filled at start up */
+    uint8_t                     slot_state;
+    uint32_t                    installed;  /* size of the image verified in this session */
+} app_ota_identity_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_identity_t identity;
+
+/* Read buffer of the hash at start up */
+static uint8_t identity_buf[APP_OTA_IDENTITY_READ_SIZE];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static uint32_t app_ota_identity_check(const app_ota_identity_record_t *p_record)
+{
+    return APP_OTA_CRC32_FINAL(app_ota_crc32_update(APP_OTA_CRC32_INIT, (const uint8_t *)p_record,
+                                                    offsetof(app_ota_identity_record_t, check)));
+}
+
+/* Size of the last image installed over the air, 0 if there is none */
+static uint32_t app_ota_identity_load(void)
+{
+    app_ota_identity_record_t record;
+
+    memset(&record, 0x00, sizeof(record));
+#ifdef USE_EEPROM_TO_STORE_BOND_INFO
+    if (CY_EM_EEPROM_SUCCESS != Cy_Em_EEPROM_Read(EEPROM_INSTALLED_START, &record, sizeof(record), &ota_app.Em_EEPROM_context))
+    {
+        return 0;
+    }
+#endif
+    if ((record.magic != APP_OTA_IDENTITY_MAGIC) || (record.check != app_ota_identity_check(&record)))
+    {
+        return 0;
+    }
+    if ((app_ota_slot_active_size() != 0) && (record.image_size > app_ota_slot_active_size()))
+    {
+        return 0;
+    }
+    return record.image_size;
+}
+
+#ifdef USE_EEPROM_TO_STORE_BOND_INFO
+/*
+ * Write the record of a verified image, runs in the storage thread because
+ * an emulated EEPROM write erases and programs flash
+ */
+static void app_ota_identity_store(uint32_t image_size)
+{
+    app_ota_identity_record_t record;
+    cy_en_em_eeprom_status_t eepromReturnValue;
+
+    memset(&record, 0x00, sizeof(record));
+    record.magic = APP_OTA_IDENTITY_MAGIC;
+    record.image_size = image_size;
+    record.check = app_ota_identity_check(&record);
+
+    eepromReturnValue = Cy_Em_EEPROM_Write(EEPROM_INSTALLED_START, &record, sizeof(record), &ota_app.Em_EEPROM_context);
+    if (CY_EM_EEPROM_SUCCESS != eepromReturnValue)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() EEPROM Write Error: %d\n", __func__, eepromReturnValue);
+    }
+}
+#endif
+
+/*
+ * Function Name:
+ * app_ota_identity_init
+ *
+ * Function Description:
+ * @brief  Hash the active image, called once from bt_app_init() after the
+ *         resume checkpoint is loaded.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_identity_init(void)
+{
+    app_ota_sha256_t sha;
+    cy_time_t start_ms;
+    cy_time_t end_ms;
+    uint32_t size;
+    uint32_t offset;
+
+    memset(&identity, 0x00, sizeof(identity));
+    identity.value.format = APP_OTA_IDENTITY_FORMAT;
+    identity.value.board_id = APP_OTA_BOARD_ID;
+    identity.value.version_major = (uint8_t)APP_VERSION_MAJOR;
+    identity.value.version_minor = (uint8_t)APP_VERSION_MINOR;
+    identity.value.version_build = (uint16_t)APP_VERSION_BUILD;
+    identity.value.slot_size = APP_OTA_UPGRADE_SLOT_SIZE;
+    identity.slot_state = (app_ota_resume_stored() != 0) ? APP_OTA_IDENTITY_SLOT_PARTIAL : APP_OTA_IDENTITY_SLOT_NONE;
+
+    if (!app_ota_slot_active_readable())
+    {
+        return;
+    }
+    size = app_ota_identity_load();
+    if (size == 0)
+    {
+        size = app_ota_slot_active_size();
+        identity.value.flags |= APP_OTA_IDENTITY_FLAG_WHOLE_SLOT;
+    }
+    if (size == 0)
+    {
+        identity.value.flags = 0;
+        return;
+    }
+
+    cy_rtos_get_time(&start_ms);
+    app_ota_sha256_start(&sha);
+    for (offset = 0; offset < size; offset += APP_OTA_IDENTITY_READ_SIZE)
+    {
+        uint32_t len = size - offset;
+
+        if (len > APP_OTA_IDENTITY_READ_SIZE)
+        {
+            len = APP_OTA_IDENTITY_READ_SIZE;
+        }
+        if (app_ota_slot_read_active(offset, identity_buf, len) != CY_RSLT_SUCCESS)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() active slot read at 0x%lx failed, hash unknown\n", __func__, offset);
+            identity.value.flags = 0;
+            return;
+        }
+        app_ota_sha256_update(&sha, identity_buf, len);
+    }
+    app_ota_sha256_finish(&sha, identity.value.sha256);
+    cy_rtos_get_time(&end_ms);
+    identity.value.image_size = size;
+    identity.value.flags |= APP_OTA_IDENTITY_FLAG_HASH;
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Active %s: 0x%lx bytes hashed in %lu ms, SHA-256 %02x%02x%02x%02x...\n",
+               ((identity.value.flags & APP_OTA_IDENTITY_FLAG_WHOLE_SLOT) != 0) ? "slot" : "image",
+               identity.value.image_size, (uint32_t)(end_ms - start_ms),
+               identity.value.sha256[0], identity.value.sha256[1], identity.value.sha256[2], identity.value.sha256[3]);
+}
+
+/*
+ * Function Name:
+ * app_ota_identity_slot_state
+ *
+ * Function Description:
+ * @brief  Record what the upgrade slot holds, on DOWNLOAD, VERIFY and ABORT.
+ *
+ * @param state  APP_OTA_IDENTITY_SLOT_xxx
+ *
+ * @return void
+ */
+void app_ota_identity_slot_state(uint8_t state)
+{
+    identity.slot_state = state;
+}
+
+/*
+ * Function Name:
+ * app_ota_identity_installed
+ *
+ * Function Description:
+ * @brief  Keep the size of a verified image, it is hashed after the reset
+ *         into it. The record is written by the storage thread.
+ *
+ * @param image_size  size of the verified image
+ *
+ * @return void
+ */
+void app_ota_identity_installed(uint32_t image_size)
+{
+    identity.installed = image_size;
+    identity.slot_state = APP_OTA_IDENTITY_SLOT_VERIFIED;
+
+#ifdef USE_EEPROM_TO_STORE_BOND_INFO
+    if (app_ota_stage_run(app_ota_identity_store, image_size) != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() installed image record not written\n", __func__);
+    }
+#endif
+}
+
+/*
+ * Function Name:
+ * app_ota_identity_disconnected
+ *
+ * Function Description:
+ * @brief  A download cut by the disconnection is left as a partial image,
+ *         called after the resume checkpoint is flushed.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_identity_disconnected(void)
+{
+    if (identity.slot_state == APP_OTA_IDENTITY_SLOT_RECEIVING)
+    {
+        identity.slot_state = (app_ota_resume_stored() != 0) ? APP_OTA_IDENTITY_SLOT_PARTIAL : APP_OTA_IDENTITY_SLOT_NONE;
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_identity_get
+ *
+ * Function Description:
+ * @brief  Fill the value of the OTA Image Identity characteristic.
+ *
+ * @param p_value  value to fill
+ *
+ * @return void
+ */
+void app_ota_identity_get(app_ota_identity_value_t *p_value)
+{
+    memcpy(p_value, &identity.value, sizeof(*p_value));
+    p_value->slot_state = identity.slot_state;
+
+    switch (identity.slot_state)
+    {
+    case APP_OTA_IDENTITY_SLOT_PARTIAL:
+        p_value->slot_stored = app_ota_resume_stored();
+        break;
+    case APP_OTA_IDENTITY_SLOT_RECEIVING:
+        p_value->slot_stored = app_ota_stage_committed();
+        break;
+    case APP_OTA_IDENTITY_SLOT_VERIFIED:
+        p_value->slot_stored = identity.installed;
+        break;
+    default:
+        p_value->slot_stored = 0;
+        break;
+    }
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the
+ *              installed image identity, read on the OTA Image Identity
+ *              characteristic so that a host can tell what a device runs
+ *              before it sends an image.
+ */
+
+#ifndef __APP_OTA_IDENTITY_H__
+#define __APP_OTA_IDENTITY_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_ota_sha256.h"
+#include "app_ota_slot.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Bytes of the active slot read at a time while it is hashed */
+#ifndef APP_OTA_IDENTITY_READ_SIZE
+#define APP_OTA_IDENTITY_READ_SIZE          (512)
+#endif
+
+/* Value format, incremented when the layout changes */
+#define APP_OTA_IDENTITY_FORMAT             (3)
+
+/* image_size bytes of the active slot were hashed, sha256 is valid */
+#define APP_OTA_IDENTITY_FLAG_HASH          (0x01)
+
+/* The size of the active image is not known, the whole active slot was hashed */
+#define APP_OTA_IDENTITY_FLAG_WHOLE_SLOT    (0x02)
+
+/* Upgrade slot state */
+#define APP_OTA_IDENTITY_SLOT_NONE          (0)     /* nothing usable */
+#define APP_OTA_IDENTITY_SLOT_PARTIAL       (1)     /* an interrupted download that can be resumed */
+#define APP_OTA_IDENTITY_SLOT_RECEIVING     (2)     /* a download is running */
+#define APP_OTA_IDENTITY_SLOT_VERIFIED      (3)     /* verified, waiting for activation */
+
+/*
+ * Value of the OTA Image Identity characteristic, little-endian. The hash
+ * is computed once at start up, the upgrade slot fields when the value is
+ * read.
+ */
+typedef struct
+{
+    uint8_t     format;             /* APP_OTA_IDENTITY_FORMAT                          */
+    uint8_t     flags;              /* APP_OTA_IDENTITY_FLAG_xxx                        */
+    uint16_t    board_id;           /* APP_OTA_BOARD_ID                                 */
+    uint8_t     version_major;      /* running application                              */
+    uint8_t     version_minor;
+    uint16_t    version_build;
+    uint32_t    image_size;         /* bytes of the active slot hashed, 0 if unknown    */
+    uint8_t     sha256[APP_OTA_SHA256_HASH_LEN];
+    uint8_t     slot_state;         /* APP_OTA_IDENTITY_SLOT_xxx                        */
+    uint8_t     reserved[3];
+    uint32_t    slot_stored;        /* image bytes held by the upgrade slot             */
+    uint32_t    slot_size;          /* APP_OTA_UPGRADE_SLOT_SIZE, 0 if unknown          */
+} app_ota_identity_value_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_identity_init(void);
+
+void app_ota_identity_slot_state(uint8_t state);
+
+void app_ota_identity_installed(uint32_t image_size);
+
+void app_ota_identity_disconnected(void);
+
+void app_ota_identity_get(app_ota_identity_value_t *p_value);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_IDENTITY_H__ */
+
+/* [] END OF FILE */
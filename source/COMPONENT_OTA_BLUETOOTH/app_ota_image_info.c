@@ -0,0 +1,332 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the image
+ *              info check.
+ *
+ *              The descriptor is taken off the front of the data before any
+ *              other processing, so that the image is refused on the first
+ *              DATA packet: for another board, older than the running
+ *              application or the same version, depending on the policy
+ *              selected in app_ota_image_info.h. The peer app is told why on
+ *              the control point and aborts the transfer.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_ota_image_info.h"
+#include "app_ota_protocol.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Versions compared as one number */
+#define APP_OTA_IMAGE_VERSION(major, minor, build) \
+    ((((uint32_t)(major) & 0xFF) << 24) | (((uint32_t)(minor) & 0xFF) << 16) | ((uint32_t)(build) & 0xFFFF))
+
+#define APP_OTA_IMAGE_VERSION_RUNNING \
+    APP_OTA_IMAGE_VERSION(APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD)
+
+typedef enum
+{
+    APP_OTA_IMAGE_INFO_STATE_IDLE,      /* no descriptor in this download */
+    APP_OTA_IMAGE_INFO_STATE_PENDING,   /* collecting the descriptor */
+    APP_OTA_IMAGE_INFO_STATE_ACCEPTED,
+    APP_OTA_IMAGE_INFO_STATE_REJECTED,
+} app_ota_image_info_state_t;
+
+typedef struct
+{
+    app_ota_image_info_state_t      state;
+    uint8_t                         acc[APP_OTA_IMAGE_INFO_LEN];
+    uint8_t                         acc_len;
+    uint32_t                        image_size;
+    bool                            has_version;    /* a descriptor was accepted since the last start */
+    uint8_t                         version_major;
+    uint8_t                         version_minor;
+    uint16_t                        version_build;
+    app_ota_image_info_reject_cb_t  reject_cb;
+} app_ota_image_info_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_image_info_t image_info;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static uint16_t app_ota_image_info_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(((uint16_t)p[0] << 0) | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t app_ota_image_info_get_u32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 0) | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static cy_rslt_t app_ota_image_info_reject(uint8_t reason)
+{
+    image_info.state = APP_OTA_IMAGE_INFO_STATE_REJECTED;
+    if (image_info.reject_cb != NULL)
+    {
+        image_info.reject_cb(reason);
+    }
+    return CY_RSLT_OTA_ERROR_VERIFY;
+}
+
+/* Apply the policy to a complete descriptor, returns APP_OTA_IMAGE_REJECT_NONE if the image is accepted */
+static uint8_t app_ota_image_info_check(void)
+{
+    uint16_t board_id;
+    uint32_t version;
+
+    if ((memcmp(image_info.acc, APP_OTA_IMAGE_INFO_MAGIC, 4) != 0) || (image_info.acc[4] != APP_OTA_IMAGE_INFO_VERSION))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() not a version %d image info descriptor\n", __func__, APP_OTA_IMAGE_INFO_VERSION);
+        return APP_OTA_IMAGE_REJECT_FORMAT;
+    }
+    if (app_ota_image_info_get_u32(&image_info.acc[12]) != image_info.image_size)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() descriptor image size 0x%lx, expected 0x%lx\n", __func__,
+                   app_ota_image_info_get_u32(&image_info.acc[12]), image_info.image_size);
+        return APP_OTA_IMAGE_REJECT_FORMAT;
+    }
+
+    board_id = app_ota_image_info_get_u16(&image_info.acc[6]);
+    version = APP_OTA_IMAGE_VERSION(image_info.acc[8], image_info.acc[9], app_ota_image_info_get_u16(&image_info.acc[10]));
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Image %d.%d.%d for board 0x%04x, running %d.%d.%d on board 0x%04x\n",
+               image_info.acc[8], image_info.acc[9], app_ota_image_info_get_u16(&image_info.acc[10]), board_id,
+               APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD, APP_OTA_BOARD_ID);
+
+    if (board_id != APP_OTA_BOARD_ID)
+    {
+        return APP_OTA_IMAGE_REJECT_BOARD;
+    }
+    if ((APP_OTA_IMAGE_ALLOW_DOWNGRADE == 0) && (version < APP_OTA_IMAGE_VERSION_RUNNING))
+    {
+        return APP_OTA_IMAGE_REJECT_DOWNGRADE;
+    }
+    if ((APP_OTA_IMAGE_ALLOW_SAME_VERSION == 0) && (version == APP_OTA_IMAGE_VERSION_RUNNING))
+    {
+        return APP_OTA_IMAGE_REJECT_SAME_VERSION;
+    }
+
+    return APP_OTA_IMAGE_REJECT_NONE;
+}
+
+/*
+ * Function Name:
+ * app_ota_image_info_init
+ *
+ * Function Description:
+ * @brief  Initialize the image info check.
+ *
+ * @param reject_cb  called when an image is refused, to tell the peer app
+ *
+ * @return void
+ */
+void app_ota_image_info_init(app_ota_image_info_reject_cb_t reject_cb)
+{
+    memset(&image_info, 0x00, sizeof(image_info));
+    image_info.reject_cb = reject_cb;
+}
+
+/*
+ * Function Name:
+ * app_ota_image_info_start
+ *
+ * Function Description:
+ * @brief  Prepare for a new download, called on CY_OTA_UPGRADE_COMMAND_DOWNLOAD
+ *         before the upgrade slot is opened.
+ *
+ * @param present     APP_OTA_DOWNLOAD_OPT_IMAGE_INFO was set, the data
+ *                    starts with a descriptor
+ * @param image_size  image size announced with the command
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_VERIFY if a
+ *                    descriptor is required and none is announced
+ */
+cy_rslt_t app_ota_image_info_start(bool present, uint32_t image_size)
+{
+    image_info.acc_len = 0;
+    image_info.image_size = image_size;
+    image_info.has_version = false;
+    image_info.state = (present) ? APP_OTA_IMAGE_INFO_STATE_PENDING : APP_OTA_IMAGE_INFO_STATE_IDLE;
+
+    if (!present && (APP_OTA_IMAGE_INFO_REQUIRED != 0))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "Download without image info descriptor refused\n");
+        return app_ota_image_info_reject(APP_OTA_IMAGE_REJECT_MISSING);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_image_info_stop
+ *
+ * Function Description:
+ * @brief  End the check, called on VERIFY or ABORT.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_image_info_stop(void)
+{
+    image_info.state = APP_OTA_IMAGE_INFO_STATE_IDLE;
+}
+
+/*
+ * Function Name:
+ * app_ota_image_info_pending
+ *
+ * Function Description:
+ * @brief  Check whether the data must still go through app_ota_image_info_write().
+ *
+ * @param void
+ *
+ * @return bool  true while the descriptor is collected, and after a refusal
+ */
+bool app_ota_image_info_pending(void)
+{
+    return (image_info.state == APP_OTA_IMAGE_INFO_STATE_PENDING) ||
+           (image_info.state == APP_OTA_IMAGE_INFO_STATE_REJECTED);
+}
+
+/*
+ * Function Name:
+ * app_ota_image_info_write
+ *
+ * Function Description:
+ * @brief  Take the descriptor off the front of the data. Once the descriptor
+ *         is complete it is checked, the data after it is left in place.
+ *
+ * @param pp_data  in: received data, out: data after the descriptor
+ * @param p_len    in: received length, out: bytes left, may be 0
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_VERIFY once the image
+ *                    is refused
+ */
+cy_rslt_t app_ota_image_info_write(const uint8_t **pp_data, uint16_t *p_len)
+{
+    uint16_t take;
+    uint8_t reason;
+
+    if (image_info.state == APP_OTA_IMAGE_INFO_STATE_REJECTED)
+    {
+        return CY_RSLT_OTA_ERROR_VERIFY;
+    }
+    if (image_info.state != APP_OTA_IMAGE_INFO_STATE_PENDING)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    take = APP_OTA_IMAGE_INFO_LEN - image_info.acc_len;
+    if (take > *p_len)
+    {
+        take = *p_len;
+    }
+    memcpy(&image_info.acc[image_info.acc_len], *pp_data, take);
+    image_info.acc_len += (uint8_t)take;
+    *pp_data += take;
+    *p_len -= take;
+
+    if (image_info.acc_len < APP_OTA_IMAGE_INFO_LEN)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    reason = app_ota_image_info_check();
+    if (reason != APP_OTA_IMAGE_REJECT_NONE)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "Image refused, reason %d\n", reason);
+        return app_ota_image_info_reject(reason);
+    }
+    image_info.state = APP_OTA_IMAGE_INFO_STATE_ACCEPTED;
+    image_info.has_version = true;
+    image_info.version_major = image_info.acc[8];
+    image_info.version_minor = image_info.acc[9];
+    image_info.version_build = app_ota_image_info_get_u16(&image_info.acc[10]);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_image_info_version
+ *
+ * Function Description:
+ * @brief  Version of the image being downloaded, from its descriptor. It is
+ *         kept after app_ota_image_info_stop() until the next download.
+ *
+ * @param p_major  major version
+ * @param p_minor  minor version
+ * @param p_build  build number
+ *
+ * @return bool  true if a descriptor was accepted, false if the image came
+ *               without one and its version is unknown
+ */
+bool app_ota_image_info_version(uint8_t *p_major, uint8_t *p_minor, uint16_t *p_build)
+{
+    if (!image_info.has_version)
+    {
+        return false;
+    }
+    *p_major = image_info.version_major;
+    *p_minor = image_info.version_minor;
+    *p_build = image_info.version_build;
+    return true;
+}
+
+/*
+ * Function Name:
+ * app_ota_image_info_build_reject
+ *
+ * Function Description:
+ * @brief  Format the refusal notification.
+ *
+ * @param reason  APP_OTA_IMAGE_REJECT_xxx
+ * @param p_buf   at least APP_OTA_IMAGE_REJECT_LEN bytes
+ *
+ * @return uint16_t  notification length
+ */
+uint16_t app_ota_image_info_build_reject(uint8_t reason, uint8_t *p_buf)
+{
+    p_buf[0] = APP_OTA_STATUS_IMAGE_REJECTED;
+    p_buf[1] = reason;
+    p_buf[2] = (uint8_t)(APP_OTA_BOARD_ID >> 0);
+    p_buf[3] = (uint8_t)(APP_OTA_BOARD_ID >> 8);
+    p_buf[4] = (uint8_t)APP_VERSION_MAJOR;
+    p_buf[5] = (uint8_t)APP_VERSION_MINOR;
+    p_buf[6] = (uint8_t)(APP_VERSION_BUILD >> 0);
+    p_buf[7] = (uint8_t)(APP_VERSION_BUILD >> 8);
+
+    return APP_OTA_IMAGE_REJECT_LEN;
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the image
+ *              info check, which decides from a short descriptor sent ahead
+ *              of the image data whether the image is meant for this device,
+ *              before the rest of the image is transferred.
+ */
+
+#ifndef __APP_OTA_IMAGE_INFO_H__
+#define __APP_OTA_IMAGE_INFO_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Identifies the hardware the application is built for, images for another board ID are refused */
+#ifndef APP_OTA_BOARD_ID
+#define APP_OTA_BOARD_ID                    (0x5913)
+#endif
+
+/* 1: refuse a download that does not start with an image info descriptor */
+#ifndef APP_OTA_IMAGE_INFO_REQUIRED
+#define APP_OTA_IMAGE_INFO_REQUIRED         (0)
+#endif
+
+/* 1: accept an image older than the running application */
+#ifndef APP_OTA_IMAGE_ALLOW_DOWNGRADE
+#define APP_OTA_IMAGE_ALLOW_DOWNGRADE       (0)
+#endif
+
+/* 1: accept an image with the version of the running application */
+#ifndef APP_OTA_IMAGE_ALLOW_SAME_VERSION
+#define APP_OTA_IMAGE_ALLOW_SAME_VERSION    (0)
+#endif
+
+/*
+ * Image info descriptor, the first bytes of the data with
+ * APP_OTA_DOWNLOAD_OPT_IMAGE_INFO, all values little-endian
+ *
+ *   [0..3]   APP_OTA_IMAGE_INFO_MAGIC "OTAI"
+ *   [4]      APP_OTA_IMAGE_INFO_VERSION
+ *   [5]      reserved, 0
+ *   [6..7]   board ID
+ *   [8]      APP_VERSION_MAJOR of the image
+ *   [9]      APP_VERSION_MINOR of the image
+ *   [10..11] APP_VERSION_BUILD of the image
+ *   [12..15] image size, as sent with CY_OTA_UPGRADE_COMMAND_DOWNLOAD
+ *
+ * The descriptor is not part of the image, it is not counted in the image
+ * size or the CRC32. It is sent again at the start of a resumed download.
+ */
+#define APP_OTA_IMAGE_INFO_MAGIC            "OTAI"
+#define APP_OTA_IMAGE_INFO_VERSION          (1)
+#define APP_OTA_IMAGE_INFO_LEN              (16)
+
+/* Called once when the image is refused, reason is APP_OTA_IMAGE_REJECT_xxx */
+typedef void (*app_ota_image_info_reject_cb_t)(uint8_t reason);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_image_info_init(app_ota_image_info_reject_cb_t reject_cb);
+
+cy_rslt_t app_ota_image_info_start(bool present, uint32_t image_size);
+
+void app_ota_image_info_stop(void);
+
+bool app_ota_image_info_pending(void);
+
+cy_rslt_t app_ota_image_info_write(const uint8_t **pp_data, uint16_t *p_len);
+
+bool app_ota_image_info_version(uint8_t *p_major, uint8_t *p_minor, uint16_t *p_build);
+
+uint16_t app_ota_image_info_build_reject(uint8_t reason, uint8_t *p_buf);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_IMAGE_INFO_H__ */
+
+/* [] END OF FILE */
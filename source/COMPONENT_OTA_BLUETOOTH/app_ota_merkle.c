@@ -0,0 +1,397 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the Merkle
+ *              tree authentication of the OTA data.
+ *
+ *              The host signs the root of a hash tree over the payload and
+ *              sends each group with the sibling hashes on its path to the
+ *              root, see app_ota_merkle.h. A group is collected in RAM,
+ *              hashed up to the root and compared with the signed one. Only
+ *              then is it handed to the decoders and the storage. A corrupted
+ *              or forged group fails the DATA write at once, instead of the
+ *              whole image failing at VERIFY.
+ *
+ *              The groups are hashed in software on the Bluetooth thread, the
+ *              crypto engine is left to the storage thread, which hashes the
+ *              image for its signature at the same time.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_ota_merkle.h"
+#include "app_ota_sha256.h"
+#include "app_ota_protocol.h"
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+#include "app_ota_verify.h"
+#endif
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define APP_OTA_MERKLE_LEAF_PREFIX          (0x00)
+#define APP_OTA_MERKLE_NODE_PREFIX          (0x01)
+
+#define APP_OTA_MERKLE_SIBLINGS_MAX_LEN     (APP_OTA_MERKLE_MAX_DEPTH * APP_OTA_MERKLE_HASH_LEN)
+
+typedef struct
+{
+    bool                        enabled;
+    bool                        has_header;
+    bool                        failed;
+    uint8_t                     group_shift;
+    uint8_t                     depth;
+    uint32_t                    payload_size;
+    uint32_t                    groups;
+    uint32_t                    group;          /* group being collected    */
+    uint32_t                    fill;           /* bytes of it in merkle_buf */
+    uint8_t                     root[APP_OTA_MERKLE_HASH_LEN];
+    app_ota_merkle_output_cb_t  output_cb;
+} app_ota_merkle_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_merkle_t merkle;
+
+/* Sibling hashes followed by the group payload */
+static uint8_t merkle_buf[APP_OTA_MERKLE_SIBLINGS_MAX_LEN + (1UL << APP_OTA_MERKLE_MAX_GROUP_SHIFT)];
+
+static app_ota_sha256_t merkle_sha;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static uint32_t app_ota_merkle_get_u32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 0) | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Payload bytes in the group being collected */
+static uint32_t app_ota_merkle_group_len(void)
+{
+    uint32_t offset = merkle.group << merkle.group_shift;
+    uint32_t len = merkle.payload_size - offset;
+
+    return (len > (1UL << merkle.group_shift)) ? (1UL << merkle.group_shift) : len;
+}
+
+/* Node hash of two children */
+static void app_ota_merkle_node(const uint8_t *p_left, const uint8_t *p_right, uint8_t *p_out)
+{
+    static const uint8_t prefix = APP_OTA_MERKLE_NODE_PREFIX;
+
+    app_ota_sha256_start(&merkle_sha);
+    app_ota_sha256_update(&merkle_sha, &prefix, 1);
+    app_ota_sha256_update(&merkle_sha, p_left, APP_OTA_MERKLE_HASH_LEN);
+    app_ota_sha256_update(&merkle_sha, p_right, APP_OTA_MERKLE_HASH_LEN);
+    app_ota_sha256_finish(&merkle_sha, p_out);
+}
+
+/*
+ * Hash the collected group up to the root and compare it with the signed one
+ */
+static bool app_ota_merkle_check_group(const uint8_t *p_data, uint32_t len)
+{
+    static const uint8_t prefix = APP_OTA_MERKLE_LEAF_PREFIX;
+    uint8_t hash[APP_OTA_MERKLE_HASH_LEN];
+    uint32_t index = merkle.group;
+    uint8_t level;
+
+    app_ota_sha256_start(&merkle_sha);
+    app_ota_sha256_update(&merkle_sha, &prefix, 1);
+    app_ota_sha256_update(&merkle_sha, p_data, len);
+    app_ota_sha256_finish(&merkle_sha, hash);
+
+    for (level = 0; level < merkle.depth; level++)
+    {
+        const uint8_t *p_sibling = &merkle_buf[level * APP_OTA_MERKLE_HASH_LEN];
+
+        if ((index & 1) != 0)
+        {
+            app_ota_merkle_node(p_sibling, hash, hash);
+        }
+        else
+        {
+            app_ota_merkle_node(hash, p_sibling, hash);
+        }
+        index >>= 1;
+    }
+
+    return (memcmp(hash, merkle.root, sizeof(hash)) == 0);
+}
+
+/*
+ * Function Name:
+ * app_ota_merkle_init
+ *
+ * Function Description:
+ * @brief  Set the receiver of the authenticated payload, called once from
+ *         bt_app_init().
+ *
+ * @param output_cb  receives the payload of every group that checked out
+ *
+ * @return void
+ */
+void app_ota_merkle_init(app_ota_merkle_output_cb_t output_cb)
+{
+    memset(&merkle, 0x00, sizeof(merkle));
+    merkle.output_cb = output_cb;
+}
+
+/*
+ * Function Name:
+ * app_ota_merkle_supported
+ *
+ * Function Description:
+ * @brief  Check if the root signature can be verified.
+ *
+ * @param void
+ *
+ * @return bool  true in secure builds, which hold the public key
+ */
+bool app_ota_merkle_supported(void)
+{
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ * Function Name:
+ * app_ota_merkle_start
+ *
+ * Function Description:
+ * @brief  Expect a framed payload in this session, called on
+ *         CY_OTA_UPGRADE_COMMAND_DOWNLOAD with APP_OTA_DOWNLOAD_OPT_MERKLE.
+ *         No data is accepted before the header.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_merkle_start(void)
+{
+    app_ota_merkle_output_cb_t output_cb = merkle.output_cb;
+
+    memset(&merkle, 0x00, sizeof(merkle));
+    merkle.output_cb = output_cb;
+    merkle.enabled = true;
+}
+
+/*
+ * Function Name:
+ * app_ota_merkle_stop
+ *
+ * Function Description:
+ * @brief  End the session, called on VERIFY and ABORT.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_merkle_stop(void)
+{
+    merkle.enabled = false;
+    merkle.has_header = false;
+}
+
+/*
+ * Function Name:
+ * app_ota_merkle_enabled
+ *
+ * Function Description:
+ * @brief  Check if the data of this session is framed.
+ *
+ * @param void
+ *
+ * @return bool  true between app_ota_merkle_start() and app_ota_merkle_stop()
+ */
+bool app_ota_merkle_enabled(void)
+{
+    return merkle.enabled;
+}
+
+/*
+ * Function Name:
+ * app_ota_merkle_set_header
+ *
+ * Function Description:
+ * @brief  Check the signature of the header and keep its root.
+ *
+ * @param p_data  header followed by its signature
+ * @param len     APP_OTA_MERKLE_HEADER_LEN + APP_OTA_SIGNATURE_LEN
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS if the header is valid and signed
+ */
+cy_rslt_t app_ota_merkle_set_header(const uint8_t *p_data, uint16_t len)
+{
+    uint8_t hash[APP_OTA_SHA256_HASH_LEN];
+    uint32_t payload_size;
+    uint32_t groups;
+    uint8_t group_shift;
+    uint8_t depth;
+
+    if ((!merkle.enabled) || merkle.has_header || (len != (APP_OTA_MERKLE_HEADER_LEN + APP_OTA_SIGNATURE_LEN)))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() unexpected header, len %d\n", __func__, len);
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+    if ((memcmp(p_data, APP_OTA_MERKLE_MAGIC, 4) != 0) || (p_data[4] != APP_OTA_MERKLE_VERSION))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() not a version %d header\n", __func__, APP_OTA_MERKLE_VERSION);
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    group_shift = p_data[5];
+    depth = p_data[6];
+    payload_size = app_ota_merkle_get_u32(&p_data[8]);
+    if ((group_shift < APP_OTA_MERKLE_MIN_GROUP_SHIFT) || (group_shift > APP_OTA_MERKLE_MAX_GROUP_SHIFT) || (payload_size == 0))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() group size 2^%d, payload 0x%lx not supported\n", __func__, group_shift, payload_size);
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+    groups = ((payload_size - 1) >> group_shift) + 1;
+    if ((depth > APP_OTA_MERKLE_MAX_DEPTH) || ((1UL << depth) < groups) || ((depth > 0) && ((1UL << (depth - 1)) >= groups)))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() depth %d does not match %lu groups\n", __func__, depth, groups);
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    app_ota_sha256_start(&merkle_sha);
+    app_ota_sha256_update(&merkle_sha, p_data, APP_OTA_MERKLE_HEADER_LEN);
+    app_ota_sha256_finish(&merkle_sha, hash);
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+    if (!app_ota_verify_signature(hash, &p_data[APP_OTA_MERKLE_HEADER_LEN]))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() header signature NOT verified\n", __func__);
+        return CY_RSLT_OTA_ERROR_VERIFY;
+    }
+#else
+    /* No public key to check the root against */
+    return CY_RSLT_OTA_ERROR_VERIFY;
+#endif
+
+    merkle.group_shift = group_shift;
+    merkle.depth = depth;
+    merkle.payload_size = payload_size;
+    merkle.groups = groups;
+    memcpy(merkle.root, &p_data[12], sizeof(merkle.root));
+    merkle.has_header = true;
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Merkle root verified: %lu groups of %lu bytes\n", groups, (1UL << group_shift));
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_merkle_write
+ *
+ * Function Description:
+ * @brief  Collect framed data, in any chunk sizes, and pass on the payload of
+ *         every complete group that checks out. Once a group fails, all
+ *         further data is refused until the next session.
+ *
+ * @param p_data  framed data
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_VERIFY for a group
+ *                    that does not match the root, or the output error
+ */
+cy_rslt_t app_ota_merkle_write(const uint8_t *p_data, uint16_t len)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t siblings_len = (uint32_t)merkle.depth * APP_OTA_MERKLE_HASH_LEN;
+
+    if ((!merkle.has_header) || merkle.failed)
+    {
+        return CY_RSLT_OTA_ERROR_VERIFY;
+    }
+
+    while ((len > 0) && (result == CY_RSLT_SUCCESS))
+    {
+        uint32_t group_len;
+        uint32_t frame_len;
+        uint32_t n;
+
+        if (merkle.group >= merkle.groups)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() data past the last group\n", __func__);
+            merkle.failed = true;
+            return CY_RSLT_OTA_ERROR_VERIFY;
+        }
+
+        group_len = app_ota_merkle_group_len();
+        frame_len = siblings_len + group_len;
+        n = frame_len - merkle.fill;
+        if (n > len)
+        {
+            n = len;
+        }
+        memcpy(&merkle_buf[merkle.fill], p_data, n);
+        merkle.fill += n;
+        p_data += n;
+        len -= (uint16_t)n;
+        if (merkle.fill < frame_len)
+        {
+            break;
+        }
+
+        if (!app_ota_merkle_check_group(&merkle_buf[siblings_len], group_len))
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() group %lu does not match the signed root\n", __func__, merkle.group);
+            merkle.failed = true;
+            return CY_RSLT_OTA_ERROR_VERIFY;
+        }
+        merkle.group++;
+        merkle.fill = 0;
+        if (merkle.output_cb != NULL)
+        {
+            result = merkle.output_cb(&merkle_buf[siblings_len], (uint16_t)group_len);
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Function Name:
+ * app_ota_merkle_complete
+ *
+ * Function Description:
+ * @brief  Check that every group was received, called on VERIFY.
+ *
+ * @param void
+ *
+ * @return bool  true if the whole payload was authenticated
+ */
+bool app_ota_merkle_complete(void)
+{
+    return merkle.has_header && (!merkle.failed) && (merkle.group == merkle.groups) && (merkle.fill == 0);
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the Merkle
+ *              tree authentication of the OTA data. Every group of image
+ *              data is checked against a signed root hash as soon as it
+ *              arrives, before it goes any further.
+ */
+
+#ifndef __APP_OTA_MERKLE_H__
+#define __APP_OTA_MERKLE_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/*
+ * Header, sent with APP_OTA_COMMAND_MERKLE, all values little-endian
+ *
+ *   [0..3]   APP_OTA_MERKLE_MAGIC "OTAM"
+ *   [4]      APP_OTA_MERKLE_VERSION
+ *   [5]      log2 of the group size, APP_OTA_MERKLE_MIN_GROUP_SHIFT to
+ *            APP_OTA_MERKLE_MAX_GROUP_SHIFT
+ *   [6]      depth of the tree, ceil(log2(number of groups))
+ *   [7]      reserved, 0
+ *   [8..11]  payload size, the data as it would be sent without framing
+ *   [12..43] root hash
+ *
+ * followed by the ECDSA P-256 signature of the SHA-256 of these 44 bytes, as
+ * appended by ecdsa_sign.
+ *
+ * The payload is cut in groups of the group size, the last one may be
+ * shorter. Each group is sent as
+ *
+ *   [depth x 32] sibling hashes, from the leaf level up
+ *   [group size] payload
+ *
+ * A leaf is SHA-256(0x00, group payload). A node is SHA-256(0x01, left, right),
+ * the right child of a node without one is the left child again. Bit n of the
+ * group number tells if the node at level n is a left (0) or right (1) child.
+ */
+#define APP_OTA_MERKLE_MAGIC                "OTAM"
+#define APP_OTA_MERKLE_VERSION              (1)
+#define APP_OTA_MERKLE_HEADER_LEN           (44)
+#define APP_OTA_MERKLE_HASH_LEN             (32)
+
+#define APP_OTA_MERKLE_MIN_GROUP_SHIFT      (9)
+
+/* Largest group, one group and its sibling hashes are buffered in RAM */
+#ifndef APP_OTA_MERKLE_MAX_GROUP_SHIFT
+#define APP_OTA_MERKLE_MAX_GROUP_SHIFT      (12)
+#endif
+
+/* Deepest tree, 2^16 groups */
+#ifndef APP_OTA_MERKLE_MAX_DEPTH
+#define APP_OTA_MERKLE_MAX_DEPTH            (16)
+#endif
+
+/* Receives the authenticated payload */
+typedef cy_rslt_t (*app_ota_merkle_output_cb_t)(const uint8_t *p_data, uint16_t len);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_merkle_init(app_ota_merkle_output_cb_t output_cb);
+
+bool app_ota_merkle_supported(void);
+
+void app_ota_merkle_start(void);
+
+void app_ota_merkle_stop(void);
+
+bool app_ota_merkle_enabled(void);
+
+cy_rslt_t app_ota_merkle_set_header(const uint8_t *p_data, uint16_t len);
+
+cy_rslt_t app_ota_merkle_write(const uint8_t *p_data, uint16_t len);
+
+bool app_ota_merkle_complete(void);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_MERKLE_H__ */
+
+/* [] END OF FILE */
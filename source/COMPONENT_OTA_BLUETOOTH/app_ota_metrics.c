@@ -0,0 +1,324 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions used to measure
+ *              the throughput of a Bluetooth® OTA session on the target.
+ *
+ *              Timestamps are taken from the DWT cycle counter when the core
+ *              provides one, and from the RTOS tick otherwise. The session
+ *              summary is logged at NOTICE level when the host sends VERIFY or
+ *              ABORT, so that every throughput change can be compared against
+ *              the same numbers.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "app_ota_metrics.h"
+#include <string.h>
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#include <malloc.h>
+#define APP_OTA_METRICS_HEAP_SUPPORTED
+#endif
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Number of DATA writes between two heap usage samples */
+#define APP_OTA_METRICS_HEAP_SAMPLE_INTERVAL    (16)
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+#define APP_OTA_METRICS_USE_DWT
+#endif
+
+/* Session metrics */
+typedef struct
+{
+    bool        active;
+    uint32_t    image_size;
+    cy_time_t   start_ms;
+    uint32_t    bytes;
+    uint32_t    writes;
+    uint64_t    write_us_total;
+    uint32_t    write_us_min;
+    uint32_t    write_us_max;
+    uint32_t    heap_base;
+    uint32_t    heap_peak;
+
+    /* Free running microsecond clock */
+    uint32_t    cycles_per_us;
+    uint32_t    last_cycles;
+    cy_time_t   last_ms;
+    uint64_t    clock_cycles;
+} app_ota_metrics_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_metrics_t metrics;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static uint32_t app_ota_metrics_heap_in_use(void)
+{
+#ifdef APP_OTA_METRICS_HEAP_SUPPORTED
+    struct mallinfo mi = mallinfo();
+    return (uint32_t)mi.uordblks;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Function Name:
+ * app_ota_metrics_init
+ *
+ * Function Description:
+ * @brief  Enable the cycle counter used for the OTA session timestamps.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_metrics_init(void)
+{
+    memset(&metrics, 0x00, sizeof(metrics));
+
+#ifdef APP_OTA_METRICS_USE_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    metrics.cycles_per_us = SystemCoreClock / 1000000UL;
+    if (metrics.cycles_per_us == 0)
+    {
+        metrics.cycles_per_us = 1;
+    }
+    metrics.last_cycles = DWT->CYCCNT;
+#endif
+    cy_rtos_get_time(&metrics.last_ms);
+}
+
+/*
+ * Function Name:
+ * app_ota_metrics_now_us
+ *
+ * Function Description:
+ * @brief  Free running microsecond clock. The value wraps after ~71 minutes,
+ *         differences between two readings are valid across the wrap.
+ *
+ * @param void
+ *
+ * @return uint32_t  current time in microseconds
+ */
+uint32_t app_ota_metrics_now_us(void)
+{
+    uint32_t now_us;
+    uint32_t irq_state = cyhal_system_critical_section_enter();
+    cy_time_t now_ms;
+
+    cy_rtos_get_time(&now_ms);
+
+#ifdef APP_OTA_METRICS_USE_DWT
+    {
+        uint32_t cycles = DWT->CYCCNT;
+        uint32_t wrap_ms = (UINT32_MAX / metrics.cycles_per_us) / 1000UL;
+
+        if ((uint32_t)(now_ms - metrics.last_ms) >= wrap_ms)
+        {
+            /* The cycle counter may have wrapped since the last reading, fall back to the RTOS tick */
+            metrics.clock_cycles += (uint64_t)(now_ms - metrics.last_ms) * 1000ULL * metrics.cycles_per_us;
+        }
+        else
+        {
+            metrics.clock_cycles += (uint32_t)(cycles - metrics.last_cycles);
+        }
+        metrics.last_cycles = cycles;
+        now_us = (uint32_t)(metrics.clock_cycles / metrics.cycles_per_us);
+    }
+#else
+    now_us = (uint32_t)((uint64_t)now_ms * 1000ULL);
+#endif
+    metrics.last_ms = now_ms;
+
+    cyhal_system_critical_section_exit(irq_state);
+
+    return now_us;
+}
+
+/*
+ * Function Name:
+ * app_ota_metrics_session_start
+ *
+ * Function Description:
+ * @brief  Reset the session counters, called on PREPARE_DOWNLOAD.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_metrics_session_start(void)
+{
+    metrics.active = true;
+    metrics.image_size = 0;
+    metrics.bytes = 0;
+    metrics.writes = 0;
+    metrics.write_us_total = 0;
+    metrics.write_us_min = UINT32_MAX;
+    metrics.write_us_max = 0;
+    metrics.heap_base = app_ota_metrics_heap_in_use();
+    metrics.heap_peak = metrics.heap_base;
+    cy_rtos_get_time(&metrics.start_ms);
+}
+
+/*
+ * Function Name:
+ * app_ota_metrics_set_image_size
+ *
+ * Function Description:
+ * @brief  Record the image size announced by the DOWNLOAD command.
+ *
+ * @param total_size  image size in bytes
+ *
+ * @return void
+ */
+void app_ota_metrics_set_image_size(uint32_t total_size)
+{
+    metrics.image_size = total_size;
+}
+
+/*
+ * Function Name:
+ * app_ota_metrics_write_begin
+ *
+ * Function Description:
+ * @brief  Timestamp the start of a DATA write.
+ *
+ * @param void
+ *
+ * @return uint32_t  start timestamp to pass to app_ota_metrics_write_end()
+ */
+uint32_t app_ota_metrics_write_begin(void)
+{
+    return app_ota_metrics_now_us();
+}
+
+/*
+ * Function Name:
+ * app_ota_metrics_write_end
+ *
+ * Function Description:
+ * @brief  Account a DATA write that started at start_us.
+ *
+ * @param start_us  value returned by app_ota_metrics_write_begin()
+ * @param len       number of image bytes in the write
+ *
+ * @return void
+ */
+void app_ota_metrics_write_end(uint32_t start_us, uint16_t len)
+{
+    uint32_t elapsed_us = app_ota_metrics_now_us() - start_us;
+    uint32_t heap;
+
+    if (!metrics.active)
+    {
+        return;
+    }
+
+    metrics.bytes += len;
+    metrics.writes++;
+    metrics.write_us_total += elapsed_us;
+    if (elapsed_us < metrics.write_us_min)
+    {
+        metrics.write_us_min = elapsed_us;
+    }
+    if (elapsed_us > metrics.write_us_max)
+    {
+        metrics.write_us_max = elapsed_us;
+    }
+
+    /* mallinfo() walks the allocator bins, sample it instead of calling it on every write */
+    if ((metrics.writes % APP_OTA_METRICS_HEAP_SAMPLE_INTERVAL) == 1)
+    {
+        heap = app_ota_metrics_heap_in_use();
+        if (heap > metrics.heap_peak)
+        {
+            metrics.heap_peak = heap;
+        }
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_metrics_session_report
+ *
+ * Function Description:
+ * @brief  Log the session summary, called on VERIFY or ABORT.
+ *
+ * @param success  true if the image was verified
+ *
+ * @return void
+ */
+void app_ota_metrics_session_report(bool success)
+{
+    cy_time_t now_ms;
+    uint32_t elapsed_ms;
+    uint32_t bytes_per_sec = 0;
+    uint32_t write_us_avg = 0;
+
+    if (!metrics.active)
+    {
+        return;
+    }
+    metrics.active = false;
+
+    cy_rtos_get_time(&now_ms);
+    elapsed_ms = (uint32_t)(now_ms - metrics.start_ms);
+    if (elapsed_ms != 0)
+    {
+        bytes_per_sec = (uint32_t)(((uint64_t)metrics.bytes * 1000ULL) / elapsed_ms);
+    }
+    if (metrics.writes != 0)
+    {
+        write_us_avg = (uint32_t)(metrics.write_us_total / metrics.writes);
+    }
+    else
+    {
+        metrics.write_us_min = 0;
+    }
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "OTA session %s\n", (success) ? "VERIFIED" : "ENDED");
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    bytes          : %lu of %lu\n", metrics.bytes, metrics.image_size);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    elapsed        : %lu ms\n", elapsed_ms);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    throughput     : %lu bytes/s\n", bytes_per_sec);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    DATA writes    : %lu\n", metrics.writes);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    us per write   : avg %lu min %lu max %lu\n", write_us_avg, metrics.write_us_min, metrics.write_us_max);
+#ifdef APP_OTA_METRICS_HEAP_SUPPORTED
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    peak heap      : %lu bytes (+%lu during session)\n", metrics.heap_peak, metrics.heap_peak - metrics.heap_base);
+#endif
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes used to measure
+ *              the throughput of a Bluetooth® OTA session on the target:
+ *              bytes per second, CPU time spent per DATA write and the peak
+ *              heap usage while the image is being received.
+ */
+
+#ifndef __APP_OTA_METRICS_H__
+#define __APP_OTA_METRICS_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+
+void app_ota_metrics_init(void);
+
+uint32_t app_ota_metrics_now_us(void);
+
+void app_ota_metrics_session_start(void);
+
+void app_ota_metrics_set_image_size(uint32_t total_size);
+
+uint32_t app_ota_metrics_write_begin(void);
+
+void app_ota_metrics_write_end(uint32_t start_us, uint16_t len);
+
+void app_ota_metrics_session_report(bool success);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_METRICS_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the default definitions of the OTA
+ *              persistent area, see app_ota_nv.h.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_ota_nv.h"
+#ifdef APP_OTA_NV_ADDR
+#include "cy_ota_flash.h"
+#endif
+#include <stdbool.h>
+#include <string.h>
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+/* RAM copy of the persistent area */
+static uint8_t nv_area[APP_OTA_NV_SIZE];
+#ifdef APP_OTA_NV_ADDR
+static bool nv_loaded;
+#endif
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/*
+ * Function Name:
+ * app_ota_nv_read
+ *
+ * Function Description:
+ * @brief  Read bytes of the persistent area. Weak, the default loads the
+ *         sector at APP_OTA_NV_ADDR on the first call.
+ *
+ * @param offset  offset in the area
+ * @param p_buf   destination
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_READ_STORAGE outside
+ *                    of the area or if the sector cannot be read
+ */
+__attribute__((weak))
+cy_rslt_t app_ota_nv_read(uint32_t offset, void *p_buf, uint32_t len)
+{
+    if ((offset > APP_OTA_NV_SIZE) || (len > (APP_OTA_NV_SIZE - offset)))
+    {
+        return CY_RSLT_OTA_ERROR_READ_STORAGE;
+    }
+#ifdef APP_OTA_NV_ADDR
+    if (!nv_loaded)
+    {
+        if (cy_ota_mem_read(APP_OTA_NV_MEM_TYPE, APP_OTA_NV_ADDR, nv_area, sizeof(nv_area)) != CY_RSLT_SUCCESS)
+        {
+            return CY_RSLT_OTA_ERROR_READ_STORAGE;
+        }
+        nv_loaded = true;
+    }
+#endif
+    memcpy(p_buf, &nv_area[offset], len);
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_nv_write
+ *
+ * Function Description:
+ * @brief  Write bytes of the persistent area. Weak, the default erases the
+ *         sector at APP_OTA_NV_ADDR and writes the whole area back.
+ *
+ * @param offset  offset in the area
+ * @param p_buf   data
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_WRITE_STORAGE outside
+ *                    of the area or if the sector cannot be written
+ */
+__attribute__((weak))
+cy_rslt_t app_ota_nv_write(uint32_t offset, const void *p_buf, uint32_t len)
+{
+    if ((offset > APP_OTA_NV_SIZE) || (len > (APP_OTA_NV_SIZE - offset)))
+    {
+        return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+    }
+#ifdef APP_OTA_NV_ADDR
+    if (!nv_loaded)
+    {
+        /* Keep the other records of the area */
+        if (cy_ota_mem_read(APP_OTA_NV_MEM_TYPE, APP_OTA_NV_ADDR, nv_area, sizeof(nv_area)) != CY_RSLT_SUCCESS)
+        {
+            memset(nv_area, 0x00, sizeof(nv_area));
+        }
+        nv_loaded = true;
+    }
+#endif
+    memcpy(&nv_area[offset], p_buf, len);
+#ifdef APP_OTA_NV_ADDR
+    if ((cy_ota_mem_erase(APP_OTA_NV_MEM_TYPE, APP_OTA_NV_ADDR, cy_ota_mem_get_erase_size(APP_OTA_NV_MEM_TYPE, APP_OTA_NV_ADDR)) != CY_RSLT_SUCCESS) ||
+        (cy_ota_mem_write(APP_OTA_NV_MEM_TYPE, APP_OTA_NV_ADDR, nv_area, sizeof(nv_area)) != CY_RSLT_SUCCESS))
+    {
+        return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+    }
+#endif
+    return CY_RSLT_SUCCESS;
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the OTA
+ *              persistent area, a few bytes of flash that hold the resume
+ *              checkpoint. It does not depend on the emulated EEPROM of the
+ *              bonding information.
+ *
+ *              Both functions are weak. The default keeps a RAM copy of the
+ *              area, which survives disconnections, and writes it to the
+ *              flash sector at APP_OTA_NV_ADDR when the target defines one,
+ *              which makes it survive a reset as well.
+ */
+
+#ifndef __APP_OTA_NV_H__
+#define __APP_OTA_NV_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/*
+ * Flash sector of the persistent area, used with cy_ota_mem_*() in
+ * APP_OTA_NV_MEM_TYPE. It must not overlap an image slot.
+ */
+/* #define APP_OTA_NV_ADDR                     (0x...) */
+
+#ifndef APP_OTA_NV_MEM_TYPE
+#define APP_OTA_NV_MEM_TYPE                 (CY_OTA_MEM_TYPE_EXTERNAL_FLASH)
+#endif
+
+/* Layout of the persistent area */
+#define APP_OTA_NV_RESUME_START             (0u)
+#define APP_OTA_NV_RESUME_SIZE              (32u)
+
+#define APP_OTA_NV_SIZE                     (APP_OTA_NV_RESUME_START + APP_OTA_NV_RESUME_SIZE)
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+cy_rslt_t app_ota_nv_read(uint32_t offset, void *p_buf, uint32_t len);
+
+cy_rslt_t app_ota_nv_write(uint32_t offset, const void *p_buf, uint32_t len);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_NV_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the application level extensions of the
+ *              OTA control point protocol. The commands and status codes of
+ *              the OTA update library (CY_OTA_UPGRADE_COMMAND_xxx and
+ *              CY_OTA_UPGRADE_STATUS_xxx) are left untouched, the values
+ *              defined here are kept clear of them so that a host which does
+ *              not know about the extensions never sees one.
+ *
+ *              All multi-octet values are little-endian.
+ */
+
+#ifndef __APP_OTA_PROTOCOL_H__
+#define __APP_OTA_PROTOCOL_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+
+/*
+ * CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD options, optional second octet
+ *
+ *   [0] CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD
+ *   [1] APP_OTA_PREPARE_OPT_xxx bit mask
+ *   [2] requested stream window in packets (APP_OTA_PREPARE_OPT_STREAM only)
+ *
+ * The answer is { CY_OTA_UPGRADE_STATUS_OK } for the legacy acknowledged
+ * transfer, otherwise
+ *
+ *   [0]    CY_OTA_UPGRADE_STATUS_OK
+ *   [1]    granted stream window, 0 if streaming is not used
+ *   [2..3] LE PSM of the OTA data channel (APP_OTA_PREPARE_OPT_COC only)
+ */
+#define APP_OTA_PREPARE_OPT_STREAM          (0x01)
+#define APP_OTA_PREPARE_OPT_COC             (0x02)
+
+/*
+ * CY_OTA_UPGRADE_COMMAND_DOWNLOAD options, optional sixth octet
+ *
+ *   [0]    CY_OTA_UPGRADE_COMMAND_DOWNLOAD
+ *   [1..4] image size, after decoding
+ *   [5]    APP_OTA_DOWNLOAD_OPT_xxx bit mask
+ *   [6..9] image ID, optional, makes a plain image download resumable
+ *
+ * With an image ID the answer is
+ *
+ *   [0]    CY_OTA_UPGRADE_STATUS_OK
+ *   [1..4] offset at which the host continues, 0 for a new download
+ *
+ * APP_OTA_DOWNLOAD_OPT_HEATSHRINK: the image data is heatshrink compressed,
+ * see app_ota_decomp.h for the parameters.
+ *
+ * APP_OTA_DOWNLOAD_OPT_DELTA: the image data is a patch against the running
+ * image, see app_ota_delta.h for the format. Combined with
+ * APP_OTA_DOWNLOAD_OPT_HEATSHRINK the patch is compressed.
+ *
+ * APP_OTA_DOWNLOAD_OPT_SKIP_UNCHANGED: each block is compared with the
+ * upgrade slot before it is written, the sectors that already hold it are
+ * neither erased nor programmed. Needs erase ahead, see app_ota_erase.h,
+ * the bit is ignored otherwise and the whole image is written.
+ *
+ * APP_OTA_DOWNLOAD_OPT_MERKLE: the data is framed in groups that carry the
+ * sibling hashes of a signed Merkle tree, see app_ota_merkle.h. The header
+ * is sent with APP_OTA_COMMAND_MERKLE before the data. Secure builds only.
+ * The framing is removed first, the payload can be compressed or a patch.
+ *
+ * APP_OTA_DOWNLOAD_OPT_IMAGE_INFO: the data starts with the image info
+ * descriptor of app_ota_image_info.h, ahead of any framing, compression or
+ * patch. It is checked as soon as it is received, a refused image is
+ * reported with APP_OTA_STATUS_IMAGE_REJECTED.
+ *
+ * The CRC32 sent with CY_OTA_UPGRADE_COMMAND_VERIFY is the CRC32 of the
+ * resulting image.
+ */
+#define APP_OTA_DOWNLOAD_OPT_HEATSHRINK     (0x01)
+#define APP_OTA_DOWNLOAD_OPT_DELTA          (0x02)
+#define APP_OTA_DOWNLOAD_OPT_SKIP_UNCHANGED (0x04)
+#define APP_OTA_DOWNLOAD_OPT_MERKLE         (0x08)
+#define APP_OTA_DOWNLOAD_OPT_IMAGE_INFO     (0x10)
+
+/*
+ * Resume query, any time before CY_OTA_UPGRADE_COMMAND_DOWNLOAD
+ *
+ *   [0]    APP_OTA_COMMAND_RESUME
+ *   [1..4] image ID
+ *
+ * Notified answer
+ *
+ *   [0]    APP_OTA_STATUS_RESUME
+ *   [1..4] bytes of this image already stored, 0 if it cannot be resumed
+ *
+ * Compressed and delta downloads cannot be resumed, the decoders do not
+ * keep their state.
+ */
+#define APP_OTA_COMMAND_RESUME              (0x20)
+#define APP_OTA_STATUS_RESUME               (0x82)
+
+/*
+ * Image signature, secure builds only, any time between
+ * CY_OTA_UPGRADE_COMMAND_DOWNLOAD and CY_OTA_UPGRADE_COMMAND_VERIFY
+ *
+ *   [0]     APP_OTA_COMMAND_SIGNATURE
+ *   [1..64] ECDSA P-256 signature (r, s) of the SHA-256 of the image
+ *
+ * The signature may also follow the CRC32 of CY_OTA_UPGRADE_COMMAND_VERIFY
+ *
+ *   [0]     CY_OTA_UPGRADE_COMMAND_VERIFY
+ *   [1..4]  CRC32 of the image
+ *   [5..68] signature
+ *
+ * With a signature sent either way, the image does not carry one. It is
+ * hashed while it is stored, and VERIFY only checks the signature. Without
+ * one, the OTA update library verifies the image as before.
+ */
+#define APP_OTA_COMMAND_SIGNATURE           (0x21)
+
+#define APP_OTA_SIGNATURE_LEN               (64)
+
+/*
+ * Merkle tree header, after CY_OTA_UPGRADE_COMMAND_DOWNLOAD with
+ * APP_OTA_DOWNLOAD_OPT_MERKLE and before the data
+ *
+ *   [0]       APP_OTA_COMMAND_MERKLE
+ *   [1..44]   header, see app_ota_merkle.h
+ *   [45..108] signature of the SHA-256 of the header
+ *
+ * A DATA write fails as soon as a group does not match the signed root, the
+ * host then sends CY_OTA_UPGRADE_COMMAND_ABORT.
+ */
+#define APP_OTA_COMMAND_MERKLE              (0x22)
+
+/*
+ * Image refused, notified on the control point when the image info
+ * descriptor does not pass the policy, or on CY_OTA_UPGRADE_COMMAND_DOWNLOAD
+ * without a descriptor when one is required
+ *
+ *   [0]    APP_OTA_STATUS_IMAGE_REJECTED
+ *   [1]    APP_OTA_IMAGE_REJECT_xxx
+ *   [2..3] board ID of the device
+ *   [4]    APP_VERSION_MAJOR of the running application
+ *   [5]    APP_VERSION_MINOR
+ *   [6..7] APP_VERSION_BUILD
+ *
+ * DATA writes fail from then on, the host sends CY_OTA_UPGRADE_COMMAND_ABORT.
+ */
+#define APP_OTA_STATUS_IMAGE_REJECTED       (0x83)
+
+#define APP_OTA_IMAGE_REJECT_LEN            (8)
+
+#define APP_OTA_IMAGE_REJECT_NONE           (0x00)
+#define APP_OTA_IMAGE_REJECT_FORMAT         (0x01)  /* not a descriptor, or another image size */
+#define APP_OTA_IMAGE_REJECT_BOARD          (0x02)  /* built for another board */
+#define APP_OTA_IMAGE_REJECT_DOWNGRADE      (0x03)  /* older than the running application */
+#define APP_OTA_IMAGE_REJECT_SAME_VERSION   (0x04)  /* the version already running */
+#define APP_OTA_IMAGE_REJECT_MISSING        (0x05)  /* no descriptor, APP_OTA_IMAGE_INFO_REQUIRED */
+
+/*
+ * Streaming DATA packet, sent as GATT Write Command
+ *
+ *   [0..1] sequence number, starts at 0 after CY_OTA_UPGRADE_COMMAND_DOWNLOAD
+ *   [2.. ] image data
+ */
+#define APP_OTA_STREAM_HDR_LEN              (2)
+
+/*
+ * Streaming acknowledgement, notified on the control point
+ *
+ *   [0]    APP_OTA_STATUS_STREAM_ACK or APP_OTA_STATUS_STREAM_NAK
+ *   [1]    window, the host may send sequence numbers below next + window
+ *   [2..3] next expected sequence number
+ *   [4..7] image bytes accepted so far (cumulative ack offset)
+ *
+ * On NAK the host goes back to the next expected sequence number and the
+ * matching offset.
+ */
+#define APP_OTA_STATUS_STREAM_ACK           (0x80)
+#define APP_OTA_STATUS_STREAM_NAK           (0x81)
+
+#define APP_OTA_STREAM_ACK_LEN              (8)
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_PROTOCOL_H__ */
+
+/* [] END OF FILE */
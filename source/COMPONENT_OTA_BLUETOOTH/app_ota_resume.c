@@ -0,0 +1,328 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the OTA
+ *              resume checkpoint.
+ *
+ *              The checkpoint holds the image ID given by the host with
+ *              CY_OTA_UPGRADE_COMMAND_DOWNLOAD, the image size, the number of
+ *              bytes committed to the upgrade slot and the running CRC32 of
+ *              these bytes. It follows the storage thread one block at a time
+ *              and is only written from the Bluetooth® stack thread. It is
+ *              kept in the OTA persistent area, see app_ota_nv.h, and
+ *              survives a reset when the target defines APP_OTA_NV_ADDR,
+ *              otherwise it survives disconnections only.
+ *
+ *              When the host starts the same image again, the upgrade slot
+ *              is not erased, the OTA library continues at the checkpoint
+ *              and the host only sends the rest of the image.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cy_ota_storage_api.h"
+#include "app_ota_resume.h"
+#include "app_ota_crc32.h"
+#include "app_ota_erase.h"
+#include "app_ota_nv.h"
+#include <stddef.h>
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define APP_OTA_RESUME_MAGIC                (0x4F544152UL)     /* "OTAR" */
+
+/* Persistent checkpoint, at most APP_OTA_NV_RESUME_SIZE bytes */
+typedef struct
+{
+    uint32_t    magic;
+    uint32_t    image_id;
+    uint32_t    image_size;
+    uint32_t    offset;
+    uint32_t    crc32;          /* running CRC32 of the first offset bytes */
+    uint32_t    check;          /* CRC32 of the fields above */
+} app_ota_resume_record_t;
+
+typedef struct
+{
+    app_ota_resume_record_t record;
+    bool                    active;         /* the session can be resumed */
+    bool                    skip_erase;     /* the next storage open continues the slot */
+    uint32_t                saved_offset;   /* offset of the last persistent write */
+} app_ota_resume_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_resume_t resume;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static uint32_t app_ota_resume_check(const app_ota_resume_record_t *p_record)
+{
+    return APP_OTA_CRC32_FINAL(app_ota_crc32_update(APP_OTA_CRC32_INIT, (const uint8_t *)p_record,
+                                                    offsetof(app_ota_resume_record_t, check)));
+}
+
+static void app_ota_resume_persist(void)
+{
+    resume.record.check = app_ota_resume_check(&resume.record);
+    resume.saved_offset = resume.record.offset;
+    if (app_ota_nv_write(APP_OTA_NV_RESUME_START, &resume.record, sizeof(resume.record)) != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() checkpoint write failed\n", __func__);
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_resume_init
+ *
+ * Function Description:
+ * @brief  Load the checkpoint, called once from bt_app_init().
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_resume_init(void)
+{
+    memset(&resume, 0x00, sizeof(resume));
+    if (app_ota_nv_read(APP_OTA_NV_RESUME_START, &resume.record, sizeof(resume.record)) != CY_RSLT_SUCCESS)
+    {
+        memset(&resume.record, 0x00, sizeof(resume.record));
+    }
+    if ((resume.record.magic != APP_OTA_RESUME_MAGIC) || (resume.record.check != app_ota_resume_check(&resume.record)))
+    {
+        memset(&resume.record, 0x00, sizeof(resume.record));
+    }
+    else
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "OTA checkpoint: image 0x%lx at 0x%lx of 0x%lx\n", resume.record.image_id, resume.record.offset, resume.record.image_size);
+    }
+    resume.saved_offset = resume.record.offset;
+}
+
+/*
+ * Function Name:
+ * app_ota_resume_query
+ *
+ * Function Description:
+ * @brief  Offset at which the host can continue an image, answer to
+ *         APP_OTA_COMMAND_RESUME.
+ *
+ * @param image_id  image ID the host will send with CY_OTA_UPGRADE_COMMAND_DOWNLOAD
+ *
+ * @return uint32_t  bytes of the image already stored, 0 to start from the beginning
+ */
+uint32_t app_ota_resume_query(uint32_t image_id)
+{
+    if ((image_id == 0) || (resume.record.magic != APP_OTA_RESUME_MAGIC) || (resume.record.image_id != image_id))
+    {
+        return 0;
+    }
+    return resume.record.offset;
+}
+
+/*
+ * Function Name:
+ * app_ota_resume_begin
+ *
+ * Function Description:
+ * @brief  Start a resumable session, called on CY_OTA_UPGRADE_COMMAND_DOWNLOAD
+ *         before cy_ota_ble_download(). If the checkpoint matches, the next
+ *         storage open keeps the slot contents.
+ *
+ * @param image_id    image ID given by the host, 0 for a session that cannot be resumed
+ * @param image_size  image size
+ * @param p_offset    set to the offset to continue at
+ * @param p_crc32     set to the running CRC32 at that offset
+ *
+ * @return bool  true if the session continues at *p_offset
+ */
+bool app_ota_resume_begin(uint32_t image_id, uint32_t image_size, uint32_t *p_offset, uint32_t *p_crc32)
+{
+    resume.skip_erase = false;
+    resume.active = (image_id != 0);
+
+    if (resume.active && (app_ota_resume_query(image_id) != 0) &&
+        (resume.record.image_size == image_size) && (resume.record.offset < image_size))
+    {
+        resume.skip_erase = true;
+        *p_offset = resume.record.offset;
+        *p_crc32 = resume.record.crc32;
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Resuming image 0x%lx at 0x%lx\n", image_id, resume.record.offset);
+        return true;
+    }
+
+    memset(&resume.record, 0x00, sizeof(resume.record));
+    if (resume.active)
+    {
+        resume.record.magic = APP_OTA_RESUME_MAGIC;
+        resume.record.image_id = image_id;
+        resume.record.image_size = image_size;
+        resume.record.crc32 = APP_OTA_CRC32_INIT;
+    }
+    app_ota_resume_persist();
+
+    *p_offset = 0;
+    *p_crc32 = APP_OTA_CRC32_INIT;
+    return false;
+}
+
+/*
+ * Function Name:
+ * app_ota_resume_save
+ *
+ * Function Description:
+ * @brief  Move the checkpoint, called in the Bluetooth® stack thread on
+ *         APP_OTA_STAGE_EVT_COMMIT with app_ota_stage_checkpoint(), so all
+ *         writes of the checkpoint come from one thread.
+ *
+ * @param offset  bytes committed
+ * @param crc32   running CRC32 of the committed bytes
+ *
+ * @return void
+ */
+void app_ota_resume_save(uint32_t offset, uint32_t crc32)
+{
+    if (!resume.active)
+    {
+        return;
+    }
+    resume.record.offset = offset;
+    resume.record.crc32 = crc32;
+    if ((offset - resume.saved_offset) >= APP_OTA_RESUME_SAVE_INTERVAL)
+    {
+        app_ota_resume_persist();
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_resume_flush
+ *
+ * Function Description:
+ * @brief  Write the latest checkpoint, called on disconnection.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_resume_flush(void)
+{
+    if (resume.active && (resume.saved_offset != resume.record.offset))
+    {
+        app_ota_resume_persist();
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_resume_clear
+ *
+ * Function Description:
+ * @brief  Drop the checkpoint, called once the session ends with VERIFY or ABORT.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_resume_clear(void)
+{
+    resume.active = false;
+    resume.skip_erase = false;
+    if (resume.record.magic != 0)
+    {
+        memset(&resume.record, 0x00, sizeof(resume.record));
+        app_ota_resume_persist();
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_resume_stored
+ *
+ * Function Description:
+ * @brief  Bytes of the checkpointed image in the upgrade slot.
+ *
+ * @param void
+ *
+ * @return uint32_t  checkpoint offset, 0 without a checkpoint
+ */
+uint32_t app_ota_resume_stored(void)
+{
+    return resume.record.offset;
+}
+
+/*
+ * Function Name:
+ * app_ota_resume_continue
+ *
+ * Function Description:
+ * @brief  Make the OTA library continue after the stored bytes, called after
+ *         cy_ota_ble_download() when app_ota_resume_begin() returned true.
+ *
+ *         The OTA library has no call to start a download at an offset.
+ *         cy_ota_ble_download_write() writes each chunk at total_bytes_written
+ *         of the storage context and cy_ota_ble_download() clears it, which
+ *         is the behavior of ota-update v4.x, the version in deps/. Check it
+ *         when moving to another major version.
+ *
+ * @param storage_ptr  OTA storage context
+ *
+ * @return void
+ */
+void app_ota_resume_continue(cy_ota_storage_context_t *storage_ptr)
+{
+    storage_ptr->total_bytes_written = resume.record.offset;
+}
+
+/*
+ * Function Name:
+ * app_ota_resume_storage_open
+ *
+ * Function Description:
+ * @brief  ota_file_open of the storage interface. Opening the upgrade slot
+ *         erases it, which is skipped once when a session is resumed.
+ *
+ * @param storage_ptr  OTA storage context
+ *
+ * @return cy_rslt_t  result of app_ota_erase_storage_open(), CY_RSLT_SUCCESS when resuming
+ */
+cy_rslt_t app_ota_resume_storage_open(cy_ota_storage_context_t *storage_ptr)
+{
+    if (resume.skip_erase)
+    {
+        resume.skip_erase = false;
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() keeping 0x%lx bytes of the upgrade slot\n", __func__, resume.record.offset);
+        app_ota_erase_resume(storage_ptr, resume.record.offset);
+        return CY_RSLT_SUCCESS;
+    }
+    return app_ota_erase_storage_open(storage_ptr);
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the OTA
+ *              resume checkpoint, which lets a host continue an interrupted
+ *              download instead of starting over.
+ */
+
+#ifndef __APP_OTA_RESUME_H__
+#define __APP_OTA_RESUME_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cy_ota_storage_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/*
+ * Committed bytes between two checkpoint writes to the OTA persistent area.
+ * The RAM copy follows every committed block, the persistent copy is also
+ * written on disconnection.
+ */
+#ifndef APP_OTA_RESUME_SAVE_INTERVAL
+#define APP_OTA_RESUME_SAVE_INTERVAL        (64 * 1024)
+#endif
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_resume_init(void);
+
+uint32_t app_ota_resume_query(uint32_t image_id);
+
+bool app_ota_resume_begin(uint32_t image_id, uint32_t image_size, uint32_t *p_offset, uint32_t *p_crc32);
+
+void app_ota_resume_save(uint32_t offset, uint32_t crc32);
+
+void app_ota_resume_flush(void);
+
+void app_ota_resume_clear(void);
+
+uint32_t app_ota_resume_stored(void);
+
+void app_ota_resume_continue(cy_ota_storage_context_t *storage_ptr);
+
+cy_rslt_t app_ota_resume_storage_open(cy_ota_storage_context_t *storage_ptr);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_RESUME_H__ */
+
+/* [] END OF FILE */
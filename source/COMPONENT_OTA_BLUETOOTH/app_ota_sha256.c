@@ -0,0 +1,220 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the software SHA-256 used to check the
+ *              signature of the OTA image. Whole 64-byte blocks are
+ *              compressed straight from the caller's buffer, only a partial
+ *              block is copied.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "app_ota_sha256.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define APP_OTA_SHA256_ROR(x, n)            (((x) >> (n)) | ((x) << (32 - (n))))
+
+#define APP_OTA_SHA256_LOAD_BE(p)           (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                                             ((uint32_t)(p)[2] << 8) | ((uint32_t)(p)[3] << 0))
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static const uint32_t sha256_k[64] =
+{
+    0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
+    0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
+    0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
+    0x983E5152UL, 0xA831C66DUL, 0xB00327C8UL, 0xBF597FC7UL, 0xC6E00BF3UL, 0xD5A79147UL, 0x06CA6351UL, 0x14292967UL,
+    0x27B70A85UL, 0x2E1B2138UL, 0x4D2C6DFCUL, 0x53380D13UL, 0x650A7354UL, 0x766A0ABBUL, 0x81C2C92EUL, 0x92722C85UL,
+    0xA2BFE8A1UL, 0xA81A664BUL, 0xC24B8B70UL, 0xC76C51A3UL, 0xD192E819UL, 0xD6990624UL, 0xF40E3585UL, 0x106AA070UL,
+    0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
+    0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL
+};
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static void app_ota_sha256_compress(uint32_t state[8], const uint8_t *p_block)
+{
+    uint32_t w[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    uint32_t t1, t2;
+    uint32_t i;
+
+    for (i = 0; i < 64; i++)
+    {
+        /* The message schedule is kept as a 16 word window */
+        if (i < 16)
+        {
+            w[i] = APP_OTA_SHA256_LOAD_BE(&p_block[i * 4]);
+        }
+        else
+        {
+            uint32_t w15 = w[(i - 15) & 15];
+            uint32_t w2 = w[(i - 2) & 15];
+
+            w[i & 15] += (APP_OTA_SHA256_ROR(w15, 7) ^ APP_OTA_SHA256_ROR(w15, 18) ^ (w15 >> 3)) +
+                         (APP_OTA_SHA256_ROR(w2, 17) ^ APP_OTA_SHA256_ROR(w2, 19) ^ (w2 >> 10)) +
+                         w[(i - 7) & 15];
+        }
+
+        t1 = h + (APP_OTA_SHA256_ROR(e, 6) ^ APP_OTA_SHA256_ROR(e, 11) ^ APP_OTA_SHA256_ROR(e, 25)) +
+             ((e & f) ^ (~e & g)) + sha256_k[i] + w[i & 15];
+        t2 = (APP_OTA_SHA256_ROR(a, 2) ^ APP_OTA_SHA256_ROR(a, 13) ^ APP_OTA_SHA256_ROR(a, 22)) +
+             ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+/*
+ * Function Name:
+ * app_ota_sha256_start
+ *
+ * Function Description:
+ * @brief  Start a new hash.
+ *
+ * @param p_sha  hash context
+ *
+ * @return void
+ */
+void app_ota_sha256_start(app_ota_sha256_t *p_sha)
+{
+    p_sha->state[0] = 0x6A09E667UL;
+    p_sha->state[1] = 0xBB67AE85UL;
+    p_sha->state[2] = 0x3C6EF372UL;
+    p_sha->state[3] = 0xA54FF53AUL;
+    p_sha->state[4] = 0x510E527FUL;
+    p_sha->state[5] = 0x9B05688CUL;
+    p_sha->state[6] = 0x1F83D9ABUL;
+    p_sha->state[7] = 0x5BE0CD19UL;
+    p_sha->length = 0;
+    p_sha->used = 0;
+}
+
+/*
+ * Function Name:
+ * app_ota_sha256_update
+ *
+ * Function Description:
+ * @brief  Hash len more bytes.
+ *
+ * @param p_sha   hash context
+ * @param p_data  data to hash
+ * @param len     number of bytes
+ *
+ * @return void
+ */
+void app_ota_sha256_update(app_ota_sha256_t *p_sha, const uint8_t *p_data, uint32_t len)
+{
+    uint32_t n;
+
+    p_sha->length += len;
+
+    if (p_sha->used != 0)
+    {
+        n = APP_OTA_SHA256_BLOCK_LEN - p_sha->used;
+        if (n > len)
+        {
+            n = len;
+        }
+        memcpy(&p_sha->block[p_sha->used], p_data, n);
+        p_sha->used += n;
+        p_data += n;
+        len -= n;
+        if (p_sha->used < APP_OTA_SHA256_BLOCK_LEN)
+        {
+            return;
+        }
+        app_ota_sha256_compress(p_sha->state, p_sha->block);
+        p_sha->used = 0;
+    }
+
+    while (len >= APP_OTA_SHA256_BLOCK_LEN)
+    {
+        app_ota_sha256_compress(p_sha->state, p_data);
+        p_data += APP_OTA_SHA256_BLOCK_LEN;
+        len -= APP_OTA_SHA256_BLOCK_LEN;
+    }
+
+    memcpy(p_sha->block, p_data, len);
+    p_sha->used = len;
+}
+
+/*
+ * Function Name:
+ * app_ota_sha256_finish
+ *
+ * Function Description:
+ * @brief  Pad the message and return the hash.
+ *
+ * @param p_sha  hash context, must be started again to be reused
+ * @param hash   filled with the big-endian hash
+ *
+ * @return void
+ */
+void app_ota_sha256_finish(app_ota_sha256_t *p_sha, uint8_t hash[APP_OTA_SHA256_HASH_LEN])
+{
+    uint64_t bits = p_sha->length * 8;
+    uint32_t i;
+
+    p_sha->block[p_sha->used++] = 0x80;
+    if (p_sha->used > (APP_OTA_SHA256_BLOCK_LEN - 8))
+    {
+        memset(&p_sha->block[p_sha->used], 0x00, APP_OTA_SHA256_BLOCK_LEN - p_sha->used);
+        app_ota_sha256_compress(p_sha->state, p_sha->block);
+        p_sha->used = 0;
+    }
+    memset(&p_sha->block[p_sha->used], 0x00, (APP_OTA_SHA256_BLOCK_LEN - 8) - p_sha->used);
+    for (i = 0; i < 8; i++)
+    {
+        p_sha->block[APP_OTA_SHA256_BLOCK_LEN - 1 - i] = (uint8_t)(bits >> (i * 8));
+    }
+    app_ota_sha256_compress(p_sha->state, p_sha->block);
+
+    for (i = 0; i < 8; i++)
+    {
+        hash[(i * 4) + 0] = (uint8_t)(p_sha->state[i] >> 24);
+        hash[(i * 4) + 1] = (uint8_t)(p_sha->state[i] >> 16);
+        hash[(i * 4) + 2] = (uint8_t)(p_sha->state[i] >> 8);
+        hash[(i * 4) + 3] = (uint8_t)(p_sha->state[i] >> 0);
+    }
+}
+
+/* [] END OF FILE */
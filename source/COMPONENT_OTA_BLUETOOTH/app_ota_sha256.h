@@ -0,0 +1,57 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes for the
+ *              software SHA-256 (FIPS 180-4) used to check the signature of
+ *              the OTA image when no crypto accelerator is available.
+ */
+
+#ifndef __APP_OTA_SHA256_H__
+#define __APP_OTA_SHA256_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define APP_OTA_SHA256_HASH_LEN             (32)
+
+#define APP_OTA_SHA256_BLOCK_LEN            (64)
+
+typedef struct
+{
+    uint32_t    state[8];
+    uint64_t    length;                             /* bytes hashed so far  */
+    uint32_t    used;                               /* bytes in block[]     */
+    uint8_t     block[APP_OTA_SHA256_BLOCK_LEN];
+} app_ota_sha256_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_sha256_start(app_ota_sha256_t *p_sha);
+
+void app_ota_sha256_update(app_ota_sha256_t *p_sha, const uint8_t *p_data, uint32_t len);
+
+void app_ota_sha256_finish(app_ota_sha256_t *p_sha, uint8_t hash[APP_OTA_SHA256_HASH_LEN]);
+
+#endif      /* __APP_OTA_SHA256_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the default definitions of the access
+ *              to the running image and of the erase of the upgrade slot,
+ *              see app_ota_slot.h.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_ota_slot.h"
+#ifdef APP_OTA_UPGRADE_SLOT_ADDR
+#include "cy_ota_flash.h"
+#endif
+#include <string.h>
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/*
+ * Function Name:
+ * app_ota_slot_active_readable
+ *
+ * Function Description:
+ * @brief  Check if app_ota_slot_read_active() can read the running image.
+ *         Weak, an application that defines app_ota_slot_read_active()
+ *         defines this one as well.
+ *
+ * @param void
+ *
+ * @return bool  true if APP_OTA_ACTIVE_SLOT_ADDR is defined for the target
+ */
+__attribute__((weak))
+bool app_ota_slot_active_readable(void)
+{
+#ifdef APP_OTA_ACTIVE_SLOT_ADDR
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ * Function Name:
+ * app_ota_slot_read_active
+ *
+ * Function Description:
+ * @brief  Read bytes of the running image. Weak, the default reads the
+ *         memory mapped slot at APP_OTA_ACTIVE_SLOT_ADDR.
+ *
+ * @param offset  offset in the image
+ * @param p_buf   destination
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_READ_STORAGE if the
+ *                    image cannot be read there
+ */
+__attribute__((weak))
+cy_rslt_t app_ota_slot_read_active(uint32_t offset, uint8_t *p_buf, uint32_t len)
+{
+#ifdef APP_OTA_ACTIVE_SLOT_ADDR
+#ifdef APP_OTA_ACTIVE_SLOT_SIZE
+    if ((offset > APP_OTA_ACTIVE_SLOT_SIZE) || (len > (APP_OTA_ACTIVE_SLOT_SIZE - offset)))
+    {
+        return CY_RSLT_OTA_ERROR_READ_STORAGE;
+    }
+#endif
+    memcpy(p_buf, (const uint8_t *)(APP_OTA_ACTIVE_SLOT_ADDR + offset), len);
+    return CY_RSLT_SUCCESS;
+#else
+    (void)offset;
+    (void)p_buf;
+    (void)len;
+    return CY_RSLT_OTA_ERROR_READ_STORAGE;
+#endif
+}
+
+/*
+ * Function Name:
+ * app_ota_slot_active_size
+ *
+ * Function Description:
+ * @brief  Size of the active slot. Weak, an application that defines
+ *         app_ota_slot_read_active() may define this one as well.
+ *
+ * @param void
+ *
+ * @return uint32_t  APP_OTA_ACTIVE_SLOT_SIZE, 0 if it is not known
+ */
+__attribute__((weak))
+uint32_t app_ota_slot_active_size(void)
+{
+#ifdef APP_OTA_ACTIVE_SLOT_SIZE
+    return APP_OTA_ACTIVE_SLOT_SIZE;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Function Name:
+ * app_ota_slot_upgrade_erase_size
+ *
+ * Function Description:
+ * @brief  Erase unit of the upgrade slot. Weak, an application that defines
+ *         app_ota_slot_erase_upgrade() defines this one as well.
+ *
+ * @param void
+ *
+ * @return uint32_t  sector size at APP_OTA_UPGRADE_SLOT_ADDR, 0 if the slot
+ *                   cannot be erased by the application
+ */
+__attribute__((weak))
+uint32_t app_ota_slot_upgrade_erase_size(void)
+{
+#ifdef APP_OTA_UPGRADE_SLOT_ADDR
+    return (uint32_t)cy_ota_mem_get_erase_size(APP_OTA_UPGRADE_SLOT_MEM_TYPE, APP_OTA_UPGRADE_SLOT_ADDR);
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Function Name:
+ * app_ota_slot_erase_upgrade
+ *
+ * Function Description:
+ * @brief  Erase part of the upgrade slot. Weak, the default erases the
+ *         flash at APP_OTA_UPGRADE_SLOT_ADDR.
+ *
+ * @param offset  offset in the slot, a multiple of the erase unit
+ * @param len     number of bytes, a multiple of the erase unit
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_WRITE_STORAGE if the
+ *                    slot cannot be erased there
+ */
+__attribute__((weak))
+cy_rslt_t app_ota_slot_erase_upgrade(uint32_t offset, uint32_t len)
+{
+#if (APP_OTA_UPGRADE_SLOT_SIZE != 0)
+    if ((offset > APP_OTA_UPGRADE_SLOT_SIZE) || (len > (APP_OTA_UPGRADE_SLOT_SIZE - offset)))
+    {
+        return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+    }
+#endif
+#ifdef APP_OTA_UPGRADE_SLOT_ADDR
+    if (cy_ota_mem_erase(APP_OTA_UPGRADE_SLOT_MEM_TYPE, APP_OTA_UPGRADE_SLOT_ADDR + offset, len) != CY_RSLT_SUCCESS)
+    {
+        return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+    }
+    return CY_RSLT_SUCCESS;
+#else
+    (void)offset;
+    (void)len;
+    return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+#endif
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the access
+ *              to the running image, the base of delta updates, and of the
+ *              erase of the upgrade slot. The functions are weak: a target
+ *              that can read the active slot at a fixed address defines
+ *              APP_OTA_ACTIVE_SLOT_ADDR, and one that knows the flash address
+ *              of the upgrade slot APP_OTA_UPGRADE_SLOT_ADDR. Any other
+ *              target (an address known at run time) defines its own.
+ */
+
+#ifndef __APP_OTA_SLOT_H__
+#define __APP_OTA_SLOT_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/*
+ * Address at which the running image can be read with the default functions.
+ * Without it, or without an application defined app_ota_slot_read_active(),
+ * delta updates are refused.
+ */
+/* #define APP_OTA_ACTIVE_SLOT_ADDR            (0x...) */
+
+/* Size of the active slot, reads past it are refused by the default functions.
+ * Without it the active image is only hashed once its size is known, see
+ * app_ota_identity.c.
+ */
+/* #define APP_OTA_ACTIVE_SLOT_SIZE            (0x...) */
+
+/*
+ * Flash address of the upgrade slot, the same one the OTA library writes
+ * through cy_ota_storage_write(). With it, or with an application defined
+ * app_ota_slot_erase_upgrade(), the slot is erased ahead of the data instead
+ * of being cleared when it is opened, see app_ota_erase.h.
+ */
+/* #define APP_OTA_UPGRADE_SLOT_ADDR           (0x...) */
+
+/* Memory holding the upgrade slot, see cy_ota_flash.h */
+#ifndef APP_OTA_UPGRADE_SLOT_MEM_TYPE
+#define APP_OTA_UPGRADE_SLOT_MEM_TYPE       (CY_OTA_MEM_TYPE_EXTERNAL_FLASH)
+#endif
+
+/*
+ * Size of the upgrade slot, the largest image the device takes. The OTA
+ * library's CY_DS_SIZE is used when the target defines it, otherwise it is
+ * 0, unknown.
+ */
+#ifndef APP_OTA_UPGRADE_SLOT_SIZE
+#ifdef CY_DS_SIZE
+#define APP_OTA_UPGRADE_SLOT_SIZE           (CY_DS_SIZE)
+#else
+#define APP_OTA_UPGRADE_SLOT_SIZE           (0)
+#endif
+#endif
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+bool app_ota_slot_active_readable(void);
+
+cy_rslt_t app_ota_slot_read_active(uint32_t offset, uint8_t *p_buf, uint32_t len);
+
+uint32_t app_ota_slot_active_size(void);
+
+uint32_t app_ota_slot_upgrade_erase_size(void);
+
+cy_rslt_t app_ota_slot_erase_upgrade(uint32_t offset, uint32_t len);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_SLOT_H__ */
+
+/* [] END OF FILE */
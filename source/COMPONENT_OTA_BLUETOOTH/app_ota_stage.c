@@ -0,0 +1,954 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the staging
+ *              layer in front of cy_ota_ble_download_write().
+ *
+ *              A GATT DATA write carries at most (MTU - 3) bytes and is not
+ *              aligned to the flash geometry. Writing each one straight to
+ *              storage costs one small, unaligned program operation per
+ *              packet. Here the payloads are copied into sector sized
+ *              blocks and only whole blocks (plus the final tail) are
+ *              programmed, each starting on a block boundary of the slot.
+ *
+ *              The blocks form a single-producer / single-consumer ring of
+ *              the data as received. The Bluetooth® stack callback is the
+ *              only producer: it copies the payload and returns. The storage
+ *              thread is the only consumer: it runs each block through the
+ *              data callback (descriptor check, authentication, decoding,
+ *              patching), which passes the image on to
+ *              app_ota_stage_output(). The image is gathered in a second
+ *              block that is programmed once it is full. However much a
+ *              block expands, the storage thread simply writes more, and the
+ *              flow control towards the host only counts received bytes.
+ *              Each side only writes its own index, so the ring needs no
+ *              lock, only memory barriers around the index updates.
+ *
+ *              When the host asks to skip unchanged blocks, each image block
+ *              is first compared with what the upgrade slot holds at its
+ *              offset. A block that matches is not written, the OTA library
+ *              continues after it as after a resume.
+ *
+ *              On VERIFY the storage thread also writes the tail. The CRC32
+ *              compared with the host's is the one kept while the blocks
+ *              were committed, so VERIFY does not read the slot. With
+ *              APP_OTA_STAGE_READ_BACK the image is also read back from the
+ *              upgrade slot, to check what is really in flash. It reports
+ *              APP_OTA_STAGE_EVT_DONE when it is done.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cy_ota_storage_api.h"
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "app_ota_stage.h"
+#include "app_ota_crc32.h"
+#include "app_ota_metrics.h"
+#include "app_ota_timing.h"
+#include "app_ota_stats.h"
+#include "app_ota_erase.h"
+#include "app_ota_verify.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#if (APP_OTA_STAGE_HEADROOM > ((APP_OTA_STAGE_NUM_BLOCKS - 1) * APP_OTA_STAGE_BLOCK_SIZE))
+#error "APP_OTA_STAGE_HEADROOM must leave one block of the ring to the storage thread"
+#endif
+
+typedef struct
+{
+    cy_ota_context_ptr  ota_context;
+    app_ota_stage_cb_t  callback;
+    app_ota_stage_data_cb_t data_cb;
+
+    /* Written by the producer only */
+    volatile uint32_t   head;           /* number of blocks published to the storage thread */
+    uint32_t            fill_len;       /* bytes in the block being filled (slot head % N)  */
+    uint32_t            block_len[APP_OTA_STAGE_NUM_BLOCKS];
+    uint32_t            received;       /* bytes accepted since app_ota_stage_start()       */
+    volatile bool       room_wanted;    /* raise APP_OTA_STAGE_EVT_ROOM when a block frees  */
+    volatile bool       discard;        /* drop published blocks instead of writing them    */
+    volatile bool       finish;         /* write the tail once the ring is empty            */
+    cy_ota_storage_context_t *storage_ptr;  /* upgrade slot checked by the finish           */
+    cy_ota_storage_context_t *skip_ptr;     /* upgrade slot compared with, NULL to write all */
+
+    /* Written by the consumer only */
+    volatile uint32_t   tail;           /* number of blocks handled by the storage thread   */
+    uint32_t            out_len;        /* image bytes gathered in stage_out                */
+    volatile uint32_t   committed;      /* bytes handed to the OTA library                  */
+    volatile uint32_t   committed_crc32;/* running CRC32 of the committed bytes             */
+    volatile uint32_t   checkpoint_seq; /* odd while committed and committed_crc32 change  */
+    volatile uint32_t   blocks;         /* number of program operations                     */
+    volatile uint32_t   skipped;        /* number of blocks the slot already held           */
+    volatile cy_rslt_t  error;          /* first storage error of the session               */
+    volatile uint32_t   read_back_crc32;/* CRC32 of the slot contents, after the finish     */
+    volatile bool       erasing;        /* erasing the upgrade slot ahead of the data       */
+
+    /* Written by the Bluetooth stack thread, cleared by the consumer */
+    volatile app_ota_stage_job_t job;   /* run once the ring is empty, see app_ota_stage_run() */
+    uint32_t            job_arg;
+
+    cy_semaphore_t      work_sema;      /* producer -> consumer, a block was published      */
+    cy_semaphore_t      free_sema;      /* consumer -> producer, a block was freed          */
+    cy_thread_t         thread;
+} app_ota_stage_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_stage_t stage;
+
+__attribute__((aligned(8)))
+static uint8_t stage_block[APP_OTA_STAGE_NUM_BLOCKS][APP_OTA_STAGE_BLOCK_SIZE];
+
+/* Image output of the data callback, only used by the storage thread */
+__attribute__((aligned(8)))
+static uint8_t stage_out[APP_OTA_STAGE_BLOCK_SIZE];
+
+/* Slot contents read to compare a block, only used by the storage thread */
+static uint8_t stage_compare[APP_OTA_STAGE_COMPARE_SIZE];
+
+__attribute__((aligned(8)))
+static uint8_t stage_thread_stack[APP_OTA_STAGE_THREAD_STACK_SIZE];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/* Update the checkpoint, app_ota_stage_checkpoint() reads both values of one update */
+static void app_ota_stage_checkpoint_set(uint32_t offset, uint32_t crc32)
+{
+    stage.checkpoint_seq++;
+    __DMB();
+    stage.committed = offset;
+    stage.committed_crc32 = crc32;
+    __DMB();
+    stage.checkpoint_seq++;
+}
+
+/*
+ * Check if the upgrade slot already holds the len bytes of stage_out at the
+ * commit offset, reading it through the storage interface
+ */
+static bool app_ota_stage_unchanged(uint32_t len)
+{
+    cy_ota_storage_read_info_t read_info;
+    uint32_t done = 0;
+
+    if ((stage.skip_ptr == NULL) || !app_ota_erase_may_skip(stage.committed, len))
+    {
+        return false;
+    }
+    while (done < len)
+    {
+        read_info.offset = stage.committed + done;
+        read_info.buffer = stage_compare;
+        read_info.size = len - done;
+        if (read_info.size > sizeof(stage_compare))
+        {
+            read_info.size = sizeof(stage_compare);
+        }
+        if ((cy_ota_storage_read(stage.skip_ptr, &read_info) != CY_RSLT_SUCCESS) ||
+            (memcmp(stage_compare, &stage_out[done], read_info.size) != 0))
+        {
+            return false;
+        }
+        done += read_info.size;
+    }
+    return true;
+}
+
+static cy_rslt_t app_ota_stage_commit(uint32_t len)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t elapsed_us = app_ota_metrics_now_us();
+
+    if (app_ota_stage_unchanged(len))
+    {
+        /* Neither erased nor programmed, the library continues after the block as after a resume */
+        stage.skip_ptr->total_bytes_written += len;
+        app_ota_erase_skipped(stage.committed, len);
+        stage.skipped++;
+    }
+    else
+    {
+        result = cy_ota_ble_download_write(stage.ota_context, stage_out, (uint16_t)len, 0);
+        if (result == CY_RSLT_SUCCESS)
+        {
+            stage.blocks++;
+        }
+    }
+    elapsed_us = app_ota_metrics_now_us() - elapsed_us;
+    app_ota_timing_commit(elapsed_us);
+    app_ota_stats_flash_busy(elapsed_us);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() cy_ota_ble_download_write() at 0x%lx len %lu Failed - result: 0x%lx\n", __func__, stage.committed, len, result);
+        return result;
+    }
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+    app_ota_verify_update(stage.committed, stage_out, len);
+#endif
+    /* The running CRC32 of the GATT path is ahead of storage, a resume checkpoint needs this one */
+    app_ota_stage_checkpoint_set(stage.committed + len, app_ota_crc32_update(stage.committed_crc32, stage_out, len));
+    if (stage.callback != NULL)
+    {
+        stage.callback(APP_OTA_STAGE_EVT_COMMIT, CY_RSLT_SUCCESS);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Record the first error of the session, runs in the storage thread
+ */
+static void app_ota_stage_fail(cy_rslt_t result)
+{
+    if (stage.error != CY_RSLT_SUCCESS)
+    {
+        return;
+    }
+    stage.error = result;
+    /* A finish reports the error with APP_OTA_STAGE_EVT_DONE */
+    if ((stage.callback != NULL) && (!stage.finish))
+    {
+        stage.callback(APP_OTA_STAGE_EVT_ERROR, result);
+    }
+}
+
+#if APP_OTA_STAGE_READ_BACK
+/*
+ * Read the committed image back from the upgrade slot, runs in the storage
+ * thread once every block is written. The ring is empty and the producer
+ * refuses data during the finish, so the first block is the read buffer.
+ */
+static void app_ota_stage_read_back(void)
+{
+    cy_ota_storage_read_info_t read_info;
+    uint32_t crc32 = APP_OTA_CRC32_INIT;
+    uint32_t offset = 0;
+
+    while ((stage.error == CY_RSLT_SUCCESS) && (offset < stage.committed) && (!stage.discard))
+    {
+        read_info.offset = offset;
+        read_info.buffer = stage_block[0];
+        read_info.size = stage.committed - offset;
+        if (read_info.size > APP_OTA_STAGE_BLOCK_SIZE)
+        {
+            read_info.size = APP_OTA_STAGE_BLOCK_SIZE;
+        }
+        if (cy_ota_storage_read(stage.storage_ptr, &read_info) != CY_RSLT_SUCCESS)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() cy_ota_storage_read() at 0x%lx Failed\n", __func__, offset);
+            stage.error = CY_RSLT_OTA_ERROR_READ_STORAGE;
+            break;
+        }
+        crc32 = app_ota_crc32_update(crc32, stage_block[0], read_info.size);
+        offset += read_info.size;
+    }
+    stage.read_back_crc32 = crc32;
+}
+#endif
+
+/*
+ * Function Name:
+ * app_ota_stage_thread
+ *
+ * Function Description:
+ * @brief  Storage thread, the consumer side of the ring. Hands every
+ *         published block to the data callback in order and reports errors
+ *         and freed space, erases the upgrade slot ahead while the ring is
+ *         empty, and writes the tail when a finish is requested.
+ *
+ * @param arg  unused
+ *
+ * @return void
+ */
+static void app_ota_stage_thread(cy_thread_arg_t arg)
+{
+    (void)arg;
+
+    while (true)
+    {
+        /* Use the time between two blocks to erase the upgrade slot ahead of the data */
+        stage.erasing = true;
+        __DMB();
+        while ((stage.tail == stage.head) && (!stage.finish) && (!stage.discard) && (stage.ota_context != NULL) &&
+               app_ota_erase_ahead())
+        {
+        }
+        stage.erasing = false;
+        cy_rtos_set_semaphore(&stage.free_sema, false);
+
+        cy_rtos_get_semaphore(&stage.work_sema, CY_RTOS_NEVER_TIMEOUT, false);
+
+        while (stage.tail != stage.head)
+        {
+            uint32_t slot = stage.tail % APP_OTA_STAGE_NUM_BLOCKS;
+
+            /* Read the block length only after seeing the new head */
+            __DMB();
+            if ((!stage.discard) && (stage.error == CY_RSLT_SUCCESS))
+            {
+                cy_rslt_t result;
+
+                if (stage.data_cb != NULL)
+                {
+                    result = stage.data_cb(stage_block[slot], (uint16_t)stage.block_len[slot]);
+                }
+                else
+                {
+                    result = app_ota_stage_output(stage_block[slot], stage.block_len[slot]);
+                }
+                if (result != CY_RSLT_SUCCESS)
+                {
+                    app_ota_stage_fail(result);
+                }
+            }
+
+            /* The block must be fully consumed before the producer may reuse the slot */
+            __DMB();
+            stage.tail++;
+
+            cy_rtos_set_semaphore(&stage.free_sema, false);
+            if (stage.room_wanted)
+            {
+                stage.room_wanted = false;
+                if ((stage.callback != NULL) && (stage.error == CY_RSLT_SUCCESS))
+                {
+                    stage.callback(APP_OTA_STAGE_EVT_ROOM, CY_RSLT_SUCCESS);
+                }
+            }
+        }
+
+        /* The finish is requested after the tail was published, the ring is empty now */
+        if (stage.finish)
+        {
+            if ((stage.out_len != 0) && (!stage.discard) && (stage.error == CY_RSLT_SUCCESS))
+            {
+                cy_rslt_t result = app_ota_stage_commit(stage.out_len);
+                if (result != CY_RSLT_SUCCESS)
+                {
+                    app_ota_stage_fail(result);
+                }
+            }
+            stage.out_len = 0;
+#if APP_OTA_STAGE_READ_BACK
+            app_ota_stage_read_back();
+#endif
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+            /* The image was hashed while it was stored, only the signature is left to check */
+            if ((stage.error == CY_RSLT_SUCCESS) && (!stage.discard) && app_ota_verify_has_signature())
+            {
+                stage.error = app_ota_verify_finish(stage.storage_ptr);
+            }
+#endif
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_INFO, "%s() %lu bytes committed in %lu program operations, %lu unchanged blocks skipped\n",
+                       __func__, stage.committed, stage.blocks, stage.skipped);
+
+            /* Report before clearing the request, an abort waits until the event is out */
+            if (stage.callback != NULL)
+            {
+                stage.callback(APP_OTA_STAGE_EVT_DONE, stage.error);
+            }
+            __DMB();
+            stage.finish = false;
+            cy_rtos_set_semaphore(&stage.free_sema, false);
+        }
+
+        if (stage.job != NULL)
+        {
+            app_ota_stage_job_t job = stage.job;
+
+            job(stage.job_arg);
+            __DMB();
+            stage.job = NULL;
+        }
+    }
+}
+
+/*
+ * Wait until the storage thread emptied the ring, completed a finish and
+ * stopped erasing ahead
+ */
+static cy_rslt_t app_ota_stage_wait_idle(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    while ((stage.head != stage.tail) || stage.finish || stage.erasing)
+    {
+        /* Stale counts from earlier frees only cause another pass of the loop */
+        result = cy_rtos_get_semaphore(&stage.free_sema, APP_OTA_STAGE_DRAIN_TIMEOUT_MS, false);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() storage thread stalled, %lu blocks pending\n", __func__, stage.head - stage.tail);
+            result = CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+            break;
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Bytes that can be appended before the ring is full
+ */
+static uint32_t app_ota_stage_free(void)
+{
+    uint32_t used = stage.head - stage.tail;
+
+    if (used >= APP_OTA_STAGE_NUM_BLOCKS)
+    {
+        return 0;
+    }
+    return ((APP_OTA_STAGE_NUM_BLOCKS - used) * APP_OTA_STAGE_BLOCK_SIZE) - stage.fill_len;
+}
+
+static void app_ota_stage_publish(void)
+{
+    uint32_t slot = stage.head % APP_OTA_STAGE_NUM_BLOCKS;
+
+    stage.block_len[slot] = stage.fill_len;
+    stage.fill_len = 0;
+
+    /* Block contents and length must be visible before the new head */
+    __DMB();
+    stage.head++;
+    cy_rtos_set_semaphore(&stage.work_sema, false);
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_init
+ *
+ * Function Description:
+ * @brief  Create the storage thread, called once from bt_app_init().
+ *
+ * @param callback  called from the storage thread, see app_ota_stage_cb_t
+ * @param data_cb   called from the storage thread, see app_ota_stage_data_cb_t,
+ *                  NULL to write the data as received
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS or the RTOS error
+ */
+cy_rslt_t app_ota_stage_init(app_ota_stage_cb_t callback, app_ota_stage_data_cb_t data_cb)
+{
+    cy_rslt_t result;
+
+    memset(&stage, 0x00, sizeof(stage));
+    stage.callback = callback;
+    stage.data_cb = data_cb;
+
+    result = cy_rtos_init_semaphore(&stage.work_sema, APP_OTA_STAGE_NUM_BLOCKS, 0);
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cy_rtos_init_semaphore(&stage.free_sema, APP_OTA_STAGE_NUM_BLOCKS, 0);
+    }
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cy_rtos_thread_create(&stage.thread,
+                                       &app_ota_stage_thread,
+                                       "ota storage",
+                                       &stage_thread_stack,
+                                       APP_OTA_STAGE_THREAD_STACK_SIZE,
+                                       APP_OTA_STAGE_THREAD_PRIORITY,
+                                       0);
+    }
+    if (result != CY_RSLT_SUCCESS)
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() Failed - result: 0x%lx\n", __func__, result);
+    }
+
+    return result;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_start
+ *
+ * Function Description:
+ * @brief  Start staging a new image, called on CY_OTA_UPGRADE_COMMAND_DOWNLOAD.
+ *
+ * @param ota_context  OTA agent context the blocks are written to
+ *
+ * @return void
+ */
+void app_ota_stage_start(cy_ota_context_ptr ota_context)
+{
+    /* Make sure nothing of a previous session is still in flight */
+    app_ota_stage_abort();
+
+    app_ota_stage_checkpoint_set(0, APP_OTA_CRC32_INIT);
+    stage.blocks = 0;
+    stage.skipped = 0;
+    stage.skip_ptr = NULL;
+    stage.received = 0;
+    stage.error = CY_RSLT_SUCCESS;
+    stage.ota_context = ota_context;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_resume
+ *
+ * Function Description:
+ * @brief  Continue an image of which offset bytes are already in storage,
+ *         called after app_ota_stage_start().
+ *
+ * @param offset  bytes already committed, a multiple of APP_OTA_STAGE_BLOCK_SIZE
+ * @param crc32   running CRC32 of these bytes
+ *
+ * @return void
+ */
+void app_ota_stage_resume(uint32_t offset, uint32_t crc32)
+{
+    app_ota_stage_checkpoint_set(offset, crc32);
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_skip_unchanged
+ *
+ * Function Description:
+ * @brief  Compare each block with the upgrade slot before writing it and
+ *         leave the blocks the slot already holds, called after
+ *         app_ota_stage_start(). See app_ota_erase_may_skip() for the
+ *         blocks that can be left.
+ *
+ * @param storage_ptr  upgrade slot, opened without clearing it
+ *
+ * @return void
+ */
+void app_ota_stage_skip_unchanged(cy_ota_storage_context_t *storage_ptr)
+{
+    stage.skip_ptr = storage_ptr;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_write
+ *
+ * Function Description:
+ * @brief  Append data as received. Every block that becomes full is
+ *         published to the storage thread and filling continues in the next
+ *         block. This
+ *         never blocks: data that does not fit into the free blocks is
+ *         refused, which a host that follows the flow control (see
+ *         app_ota_stage_has_room()) never causes.
+ *
+ * @param p_data  data as received
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_OUT_OF_MEMORY if the
+ *                    ring is full, or the storage error reported by the
+ *                    storage thread
+ */
+cy_rslt_t app_ota_stage_write(const uint8_t *p_data, uint32_t len)
+{
+    if (stage.ota_context == NULL)
+    {
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+    if (stage.error != CY_RSLT_SUCCESS)
+    {
+        return stage.error;
+    }
+    if (stage.finish)
+    {
+        /* Data after VERIFY, the first block may be used for the read back */
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    if (len > app_ota_stage_free())
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() %lu bytes do not fit, %lu free, the host ignored the flow control\n", __func__, len, app_ota_stage_free());
+        return CY_RSLT_OTA_ERROR_OUT_OF_MEMORY;
+    }
+
+    stage.received += len;
+    while (len != 0)
+    {
+        uint32_t to_copy = APP_OTA_STAGE_BLOCK_SIZE - stage.fill_len;
+
+        if (to_copy > len)
+        {
+            to_copy = len;
+        }
+        memcpy(&stage_block[stage.head % APP_OTA_STAGE_NUM_BLOCKS][stage.fill_len], p_data, to_copy);
+        stage.fill_len += to_copy;
+        p_data += to_copy;
+        len -= to_copy;
+
+        if (stage.fill_len == APP_OTA_STAGE_BLOCK_SIZE)
+        {
+            app_ota_stage_publish();
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_output
+ *
+ * Function Description:
+ * @brief  Append image bytes, called by the data callback in the storage
+ *         thread only. A full block is programmed before this returns, after
+ *         an abort the bytes are dropped.
+ *
+ * @param p_data  image data
+ * @param len     number of bytes
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS or the storage error
+ */
+cy_rslt_t app_ota_stage_output(const uint8_t *p_data, uint32_t len)
+{
+    while ((len != 0) && (!stage.discard))
+    {
+        uint32_t to_copy = APP_OTA_STAGE_BLOCK_SIZE - stage.out_len;
+
+        if (stage.error != CY_RSLT_SUCCESS)
+        {
+            return stage.error;
+        }
+        if (to_copy > len)
+        {
+            to_copy = len;
+        }
+        memcpy(&stage_out[stage.out_len], p_data, to_copy);
+        stage.out_len += to_copy;
+        p_data += to_copy;
+        len -= to_copy;
+
+        if (stage.out_len == APP_OTA_STAGE_BLOCK_SIZE)
+        {
+            cy_rslt_t result = app_ota_stage_commit(stage.out_len);
+
+            stage.out_len = 0;
+            if (result != CY_RSLT_SUCCESS)
+            {
+                app_ota_stage_fail(result);
+                return result;
+            }
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_finish
+ *
+ * Function Description:
+ * @brief  Publish the partially filled tail block and have the storage thread
+ *         write everything, called on VERIFY. This does not wait,
+ *         APP_OTA_STAGE_EVT_DONE reports the outcome, see
+ *         app_ota_stage_error() and app_ota_stage_committed_crc32().
+ *
+ * @param storage_ptr  upgrade slot the image is written to
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS if the finish was started
+ */
+cy_rslt_t app_ota_stage_finish(cy_ota_storage_context_t *storage_ptr)
+{
+    if ((stage.ota_context == NULL) || (storage_ptr == NULL) || stage.finish)
+    {
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    if (stage.fill_len != 0)
+    {
+        app_ota_stage_publish();
+    }
+    stage.storage_ptr = storage_ptr;
+    stage.room_wanted = false;
+
+    /* The storage thread may only see the request with the tail block published */
+    __DMB();
+    stage.finish = true;
+    cy_rtos_set_semaphore(&stage.work_sema, false);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_abort
+ *
+ * Function Description:
+ * @brief  Drop everything that was not committed yet, called on ABORT. Only
+ *         waits for the block, the finish or the erase the storage thread is
+ *         busy with, so that the OTA library and the flash are not used from
+ *         two threads.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_stage_abort(void)
+{
+    stage.discard = true;
+    stage.room_wanted = false;
+    cy_rtos_set_semaphore(&stage.work_sema, false);
+    (void)app_ota_stage_wait_idle();
+
+    /* The storage thread is idle, the indexes can be rewound */
+    stage.head = 0;
+    stage.tail = 0;
+    stage.fill_len = 0;
+    stage.out_len = 0;
+    stage.error = CY_RSLT_SUCCESS;
+    stage.discard = false;
+    stage.ota_context = NULL;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_run
+ *
+ * Function Description:
+ * @brief  Have the storage thread call a function once it is done with the
+ *         ring, for work that must not block the Bluetooth® stack thread,
+ *         such as writing flash. This does not wait.
+ *
+ * @param job  function to call in the storage thread
+ * @param arg  passed to job
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_GENERAL if the
+ *                    previous job has not run yet
+ */
+cy_rslt_t app_ota_stage_run(app_ota_stage_job_t job, uint32_t arg)
+{
+    if ((job == NULL) || (stage.job != NULL))
+    {
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    stage.job_arg = arg;
+
+    /* The storage thread may only see the job with its argument */
+    __DMB();
+    stage.job = job;
+    cy_rtos_set_semaphore(&stage.work_sema, false);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_fits
+ *
+ * Function Description:
+ * @brief  Check whether app_ota_stage_write() takes len bytes now. Only the
+ *         storage thread frees room, a caller with data in several pieces
+ *         checks once and then stages all of them.
+ *
+ * @param len  number of bytes
+ *
+ * @return bool  true if the session accepts len more bytes
+ */
+bool app_ota_stage_fits(uint32_t len)
+{
+    return (stage.ota_context != NULL) && (stage.error == CY_RSLT_SUCCESS) && (!stage.finish) &&
+           (len <= app_ota_stage_free());
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_has_room
+ *
+ * Function Description:
+ * @brief  Check whether the host may send more data, that is whether the
+ *         ring has APP_OTA_STAGE_HEADROOM bytes free. If not,
+ *         APP_OTA_STAGE_EVT_ROOM is raised once a block is freed, the caller
+ *         delays its write response until then.
+ *
+ * @param void
+ *
+ * @return bool  true if another APP_OTA_STAGE_HEADROOM bytes can be accepted
+ */
+bool app_ota_stage_has_room(void)
+{
+    if (app_ota_stage_free() >= APP_OTA_STAGE_HEADROOM)
+    {
+        return true;
+    }
+
+    stage.room_wanted = true;
+    __DMB();
+
+    /* The storage thread may have freed a block before it could see room_wanted */
+    if (app_ota_stage_free() >= APP_OTA_STAGE_HEADROOM)
+    {
+        stage.room_wanted = false;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_depth
+ *
+ * Function Description:
+ * @brief  Number of full blocks waiting for the storage thread.
+ *
+ * @param void
+ *
+ * @return uint32_t  blocks pending
+ */
+uint32_t app_ota_stage_depth(void)
+{
+    return stage.head - stage.tail;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_received
+ *
+ * Function Description:
+ * @brief  Number of bytes accepted by app_ota_stage_write() in this session.
+ *
+ * @param void
+ *
+ * @return uint32_t  bytes received
+ */
+uint32_t app_ota_stage_received(void)
+{
+    return stage.received;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_committed
+ *
+ * Function Description:
+ * @brief  Number of image bytes that have been written to storage.
+ *
+ * @param void
+ *
+ * @return uint32_t  bytes committed
+ */
+uint32_t app_ota_stage_committed(void)
+{
+    return stage.committed;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_committed_crc32
+ *
+ * Function Description:
+ * @brief  Running CRC32 of the bytes that have been written to storage.
+ *
+ * @param void
+ *
+ * @return uint32_t  running CRC32, see APP_OTA_CRC32_FINAL()
+ */
+uint32_t app_ota_stage_committed_crc32(void)
+{
+    return stage.committed_crc32;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_skipped
+ *
+ * Function Description:
+ * @brief  Number of blocks of this session that the upgrade slot already
+ *         held and that were not written.
+ *
+ * @param void
+ *
+ * @return uint32_t  blocks skipped
+ */
+uint32_t app_ota_stage_skipped(void)
+{
+    return stage.skipped;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_checkpoint
+ *
+ * Function Description:
+ * @brief  Number of committed bytes and their running CRC32, read together
+ *         while the storage thread may commit the next block.
+ *
+ * @param p_offset  set to the bytes committed
+ * @param p_crc32   set to the running CRC32 of these bytes
+ *
+ * @return void
+ */
+void app_ota_stage_checkpoint(uint32_t *p_offset, uint32_t *p_crc32)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = stage.checkpoint_seq;
+        __DMB();
+        *p_offset = stage.committed;
+        *p_crc32 = stage.committed_crc32;
+        __DMB();
+    } while (((seq & 1u) != 0) || (seq != stage.checkpoint_seq));
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_read_back_crc32
+ *
+ * Function Description:
+ * @brief  CRC32 of the image as read back from the upgrade slot by the last
+ *         finish, only with APP_OTA_STAGE_READ_BACK.
+ *
+ * @param void
+ *
+ * @return uint32_t  running CRC32, see APP_OTA_CRC32_FINAL()
+ */
+uint32_t app_ota_stage_read_back_crc32(void)
+{
+    return stage.read_back_crc32;
+}
+
+/*
+ * Function Name:
+ * app_ota_stage_error
+ *
+ * Function Description:
+ * @brief  First storage error of the current session. A stale
+ *         APP_OTA_STAGE_EVT_ERROR is recognized by this being
+ *         CY_RSLT_SUCCESS again after app_ota_stage_start().
+ *
+ * @param void
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS or the storage error
+ */
+cy_rslt_t app_ota_stage_error(void)
+{
+    return stage.error;
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the staging
+ *              layer that gathers OTA DATA writes into flash sector sized
+ *              blocks and hands them to a storage thread, which processes
+ *              them and calls cy_ota_ble_download_write() outside of the
+ *              Bluetooth® stack callback.
+ */
+
+#ifndef __APP_OTA_STAGE_H__
+#define __APP_OTA_STAGE_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cy_ota_storage_api.h"
+#include "cyabs_rtos.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Size of one staged block, keep it a multiple of the flash sector size */
+#ifndef APP_OTA_STAGE_BLOCK_SIZE
+#define APP_OTA_STAGE_BLOCK_SIZE            (4096)
+#endif
+
+/* Number of staged blocks in the ring between the GATT callback and the storage thread */
+#ifndef APP_OTA_STAGE_NUM_BLOCKS
+#define APP_OTA_STAGE_NUM_BLOCKS            (4)
+#endif
+
+#ifndef APP_OTA_STAGE_THREAD_STACK_SIZE
+#define APP_OTA_STAGE_THREAD_STACK_SIZE     (4096)
+#endif
+
+#ifndef APP_OTA_STAGE_THREAD_PRIORITY
+#define APP_OTA_STAGE_THREAD_PRIORITY       (CY_RTOS_PRIORITY_ABOVENORMAL)
+#endif
+
+/* Free bytes the ring must keep before the next DATA write is allowed, see
+ * app_ota_stage_has_room(). It has to hold what the host may send after being
+ * allowed to: one Write Request, one Execute Write of up to
+ * APP_BT_WRITE_QUEUE_SIZE bytes, a streaming window of up to
+ * APP_OTA_STREAM_MAX_WINDOW packets of (MTU - 3) bytes, or the L2CAP credits
+ * granted to the data channel. The ring holds the data as received, so the
+ * expansion of a compressed image or a patch does not count.
+ */
+#ifndef APP_OTA_STAGE_HEADROOM
+#define APP_OTA_STAGE_HEADROOM              (2 * APP_OTA_STAGE_BLOCK_SIZE)
+#endif
+
+/* Bytes of the upgrade slot read at a time to compare a block with it */
+#ifndef APP_OTA_STAGE_COMPARE_SIZE
+#define APP_OTA_STAGE_COMPARE_SIZE          (256)
+#endif
+
+/* Read the whole image back from the upgrade slot at VERIFY and compare its
+ * CRC32 with the one kept while it was written. This costs a read of the
+ * image, off by default.
+ */
+#ifndef APP_OTA_STAGE_READ_BACK
+#define APP_OTA_STAGE_READ_BACK             (0)
+#endif
+
+/* Longest time ABORT waits for the storage thread to finish the block it writes */
+#ifndef APP_OTA_STAGE_DRAIN_TIMEOUT_MS
+#define APP_OTA_STAGE_DRAIN_TIMEOUT_MS      (10000)
+#endif
+
+/* Events reported from the storage thread */
+typedef enum
+{
+    APP_OTA_STAGE_EVT_ROOM,         /* A block was freed after app_ota_stage_has_room() returned false */
+    APP_OTA_STAGE_EVT_ERROR,        /* Writing a block to storage failed */
+    APP_OTA_STAGE_EVT_COMMIT,       /* A block was written, see app_ota_stage_checkpoint() */
+    APP_OTA_STAGE_EVT_DONE,         /* app_ota_stage_finish() completed, see app_ota_stage_error() */
+} app_ota_stage_evt_t;
+
+/* Called from the storage thread, the callback must only hand the event over to the Bluetooth® stack thread */
+typedef void (*app_ota_stage_cb_t)(app_ota_stage_evt_t event, cy_rslt_t result);
+
+/* Called from the storage thread with the data as received, in order. It
+ * passes the image on with app_ota_stage_output(), an error ends the session
+ * like a storage error.
+ */
+typedef cy_rslt_t (*app_ota_stage_data_cb_t)(const uint8_t *p_data, uint16_t len);
+
+/* Called from the storage thread, see app_ota_stage_run() */
+typedef void (*app_ota_stage_job_t)(uint32_t arg);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+cy_rslt_t app_ota_stage_init(app_ota_stage_cb_t callback, app_ota_stage_data_cb_t data_cb);
+
+void app_ota_stage_start(cy_ota_context_ptr ota_context);
+
+void app_ota_stage_resume(uint32_t offset, uint32_t crc32);
+
+void app_ota_stage_skip_unchanged(cy_ota_storage_context_t *storage_ptr);
+
+cy_rslt_t app_ota_stage_write(const uint8_t *p_data, uint32_t len);
+
+cy_rslt_t app_ota_stage_output(const uint8_t *p_data, uint32_t len);
+
+cy_rslt_t app_ota_stage_finish(cy_ota_storage_context_t *storage_ptr);
+
+void app_ota_stage_abort(void);
+
+cy_rslt_t app_ota_stage_run(app_ota_stage_job_t job, uint32_t arg);
+
+bool app_ota_stage_fits(uint32_t len);
+
+bool app_ota_stage_has_room(void);
+
+uint32_t app_ota_stage_depth(void);
+
+uint32_t app_ota_stage_received(void);
+
+uint32_t app_ota_stage_committed(void);
+
+uint32_t app_ota_stage_committed_crc32(void);
+
+uint32_t app_ota_stage_skipped(void);
+
+void app_ota_stage_checkpoint(uint32_t *p_offset, uint32_t *p_crc32);
+
+uint32_t app_ota_stage_read_back_crc32(void);
+
+cy_rslt_t app_ota_stage_error(void);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_STAGE_H__ */
+
+/* [] END OF FILE */
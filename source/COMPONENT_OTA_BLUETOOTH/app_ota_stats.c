@@ -0,0 +1,300 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the live OTA
+ *              statistics.
+ *
+ *              The counters are updated on every image data write and every
+ *              block written by the storage thread, so they only cost a few
+ *              additions. Write sizes and the gaps between writes are counted
+ *              in histograms of power of 2 buckets of fixed size. A host can
+ *              read the value at any time or enable notifications, which are
+ *              then sent every APP_OTA_STATS_NOTIFY_MS from a timer.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "app_ota_stats.h"
+#include "app_ota_metrics.h"
+#include "app_ota_stage.h"
+#include "app_bt_pool.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef struct
+{
+    app_ota_stats_value_t       value;          /* counters and histograms                  */
+    uint32_t                    last_data_us;   /* time of the previous image data write    */
+    uint32_t                    rate_writes;    /* writes at the last rate sample           */
+    uint32_t                    rate_us;        /* time of the last rate sample             */
+
+    app_ota_stats_notify_cb_t   callback;
+    bool                        notify;
+    bool                        timer_ok;
+    cy_timer_t                  timer;
+} app_ota_stats_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_stats_t stats;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static uint32_t app_ota_stats_bucket(uint32_t value, uint32_t num_buckets)
+{
+    uint32_t bucket = 0;
+
+    while ((value > 1) && (bucket < (num_buckets - 1)))
+    {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static void app_ota_stats_count(uint16_t *p_bucket)
+{
+    if (*p_bucket != UINT16_MAX)
+    {
+        (*p_bucket)++;
+    }
+}
+
+static void app_ota_stats_timer_cb(cy_timer_callback_arg_t arg)
+{
+    (void)arg;
+
+    if (stats.notify && (stats.callback != NULL))
+    {
+        stats.callback();
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_stats_init
+ *
+ * Function Description:
+ * @brief  Create the notification timer, called once from bt_app_init().
+ *
+ * @param callback  sends the notification, called from the timer
+ *
+ * @return void
+ */
+void app_ota_stats_init(app_ota_stats_notify_cb_t callback)
+{
+    memset(&stats, 0x00, sizeof(stats));
+    stats.callback = callback;
+
+    if (cy_rtos_init_timer(&stats.timer, CY_TIMER_TYPE_PERIODIC, app_ota_stats_timer_cb, 0) == CY_RSLT_SUCCESS)
+    {
+        stats.timer_ok = true;
+    }
+    else
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() cy_rtos_init_timer() failed\n", __func__);
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_stats_connected
+ *
+ * Function Description:
+ * @brief  Clear the counters for a new connection.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_stats_connected(void)
+{
+    uint32_t irq_state = cyhal_system_critical_section_enter();
+
+    memset(&stats.value, 0x00, sizeof(stats.value));
+    stats.last_data_us = 0;
+    stats.rate_writes = 0;
+    stats.rate_us = app_ota_metrics_now_us();
+
+    cyhal_system_critical_section_exit(irq_state);
+}
+
+/*
+ * Function Name:
+ * app_ota_stats_disconnected
+ *
+ * Function Description:
+ * @brief  Stop the notifications, the client configuration is per connection.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_stats_disconnected(void)
+{
+    app_ota_stats_enable_notify(false);
+}
+
+/*
+ * Function Name:
+ * app_ota_stats_enable_notify
+ *
+ * Function Description:
+ * @brief  Start or stop the periodic notifications, called when the client
+ *         writes the Client Characteristic Configuration descriptor.
+ *
+ * @param enable  true to send notifications
+ *
+ * @return void
+ */
+void app_ota_stats_enable_notify(bool enable)
+{
+    if (!stats.timer_ok)
+    {
+        return;
+    }
+
+    if (enable && !stats.notify)
+    {
+        stats.notify = true;
+        cy_rtos_start_timer(&stats.timer, APP_OTA_STATS_NOTIFY_MS);
+    }
+    else if (!enable && stats.notify)
+    {
+        stats.notify = false;
+        cy_rtos_stop_timer(&stats.timer);
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_stats_data
+ *
+ * Function Description:
+ * @brief  Account an image data write.
+ *
+ * @param now_us  value of app_ota_metrics_now_us() for this write
+ * @param len     number of bytes received
+ *
+ * @return void
+ */
+void app_ota_stats_data(uint32_t now_us, uint16_t len)
+{
+    app_ota_stats_value_t *p = &stats.value;
+
+    if (p->writes != 0)
+    {
+        /* Bucket 0 counts gaps below 128 us */
+        app_ota_stats_count(&p->gap_hist[app_ota_stats_bucket((now_us - stats.last_data_us) >> 6, APP_OTA_STATS_GAP_BUCKETS)]);
+    }
+    stats.last_data_us = now_us;
+
+    app_ota_stats_count(&p->size_hist[app_ota_stats_bucket(len, APP_OTA_STATS_SIZE_BUCKETS)]);
+    p->rx_bytes += len;
+    p->writes++;
+}
+
+/*
+ * Function Name:
+ * app_ota_stats_notify_failed
+ *
+ * Function Description:
+ * @brief  Account a notification the stack did not accept.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_stats_notify_failed(void)
+{
+    stats.value.notify_failures++;
+}
+
+/*
+ * Function Name:
+ * app_ota_stats_flash_busy
+ *
+ * Function Description:
+ * @brief  Account the time taken to write a block to storage, called from the
+ *         storage thread.
+ *
+ * @param elapsed_us  duration of the storage write
+ *
+ * @return void
+ */
+void app_ota_stats_flash_busy(uint32_t elapsed_us)
+{
+    stats.value.flash_busy_us += elapsed_us;
+}
+
+/*
+ * Function Name:
+ * app_ota_stats_get
+ *
+ * Function Description:
+ * @brief  Fill the value of the OTA Statistics characteristic.
+ *
+ * @param p_value  filled with the current counters
+ *
+ * @return void
+ */
+void app_ota_stats_get(app_ota_stats_value_t *p_value)
+{
+    uint32_t now_us = app_ota_metrics_now_us();
+    uint32_t elapsed_us;
+    uint32_t irq_state;
+    uint32_t pool_in_use = 0;
+    app_bt_pool_stats_t pool_stats;
+    uint8_t i;
+
+    irq_state = cyhal_system_critical_section_enter();
+    elapsed_us = now_us - stats.rate_us;
+    if (elapsed_us >= ((APP_OTA_STATS_NOTIFY_MS * 1000UL) / 2))
+    {
+        stats.value.writes_per_sec = (uint32_t)(((uint64_t)(stats.value.writes - stats.rate_writes) * 1000000ULL) / elapsed_us);
+        stats.rate_writes = stats.value.writes;
+        stats.rate_us = now_us;
+    }
+    memcpy(p_value, &stats.value, sizeof(*p_value));
+    cyhal_system_critical_section_exit(irq_state);
+
+    for (i = 0; i < app_bt_pool_num_classes(); i++)
+    {
+        if (app_bt_pool_get_stats(i, &pool_stats))
+        {
+            pool_in_use += pool_stats.in_use;
+        }
+    }
+    p_value->pool_in_use = (uint16_t)pool_in_use;
+    p_value->stage_depth = (uint16_t)app_ota_stage_depth();
+    p_value->committed_bytes = app_ota_stage_committed();
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
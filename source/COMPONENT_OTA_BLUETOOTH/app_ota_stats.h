@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the live OTA
+ *              statistics, read or notified on the OTA Statistics
+ *              characteristic while an update is running.
+ */
+
+#ifndef __APP_OTA_STATS_H__
+#define __APP_OTA_STATS_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Period of the notifications once the client enabled them */
+#ifndef APP_OTA_STATS_NOTIFY_MS
+#define APP_OTA_STATS_NOTIFY_MS             (1000)
+#endif
+
+/* Write size histogram: bucket b counts sizes in [2^b, 2^(b+1)), the last one is open ended */
+#define APP_OTA_STATS_SIZE_BUCKETS          (10)
+
+/* Inter-write gap histogram: bucket 0 counts gaps below 128 us, bucket b in [2^(b+6), 2^(b+7)) us */
+#define APP_OTA_STATS_GAP_BUCKETS           (16)
+
+/*
+ * Value of the OTA Statistics characteristic, little-endian. The counters
+ * start at zero on every connection, histogram buckets stop at 0xFFFF.
+ */
+typedef struct
+{
+    uint32_t    rx_bytes;           /* image bytes received                        */
+    uint32_t    committed_bytes;    /* image bytes written to storage              */
+    uint32_t    writes;             /* image data writes received                  */
+    uint32_t    writes_per_sec;     /* over the last notification period           */
+    uint32_t    notify_failures;    /* failed notifications                        */
+    uint32_t    flash_busy_us;      /* time spent writing to storage               */
+    uint16_t    pool_in_use;        /* GATT buffers allocated from the pool        */
+    uint16_t    stage_depth;        /* full blocks waiting for the storage thread  */
+    uint16_t    size_hist[APP_OTA_STATS_SIZE_BUCKETS];
+    uint16_t    gap_hist[APP_OTA_STATS_GAP_BUCKETS];
+} app_ota_stats_value_t;
+
+/* Called from the timer every APP_OTA_STATS_NOTIFY_MS while notifications are enabled, it must only hand the notification over to the Bluetooth® stack thread */
+typedef void (*app_ota_stats_notify_cb_t)(void);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_stats_init(app_ota_stats_notify_cb_t callback);
+
+void app_ota_stats_connected(void);
+
+void app_ota_stats_disconnected(void);
+
+void app_ota_stats_enable_notify(bool enable);
+
+void app_ota_stats_data(uint32_t now_us, uint16_t len);
+
+void app_ota_stats_notify_failed(void);
+
+void app_ota_stats_flash_busy(uint32_t elapsed_us);
+
+void app_ota_stats_get(app_ota_stats_value_t *p_value);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_STATS_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,239 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the OTA
+ *              streaming transfer.
+ *
+ *              In the legacy transfer every DATA chunk is a GATT Write Request
+ *              and the host waits for the Write Response before sending the
+ *              next one, so at most one chunk moves per round trip. In the
+ *              streaming transfer the host sends Write Commands and keeps up
+ *              to "window" packets in flight. The device acknowledges every
+ *              window / 2 packets with the next expected sequence number and
+ *              the number of image bytes accepted, which also returns the
+ *              credits to the host.
+ *
+ *              The link layer does not lose packets, a sequence gap only
+ *              follows a host side error. The device then sends one NAK and
+ *              drops everything until the expected packet arrives again.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "app_ota_stream.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef struct
+{
+    bool        enabled;
+    uint8_t     window;
+    uint8_t     ack_every;
+    uint8_t     since_ack;
+    bool        nak_sent;
+    uint16_t    next_seq;
+    uint32_t    offset;
+} app_ota_stream_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_stream_t stream;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/*
+ * Function Name:
+ * app_ota_stream_negotiate
+ *
+ * Function Description:
+ * @brief  Parse the options of CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD and
+ *         enable or disable the streaming transfer for this session.
+ *
+ * @param p_val  PREPARE_DOWNLOAD command as written to the control point
+ * @param len    length of the command
+ *
+ * @return uint8_t  granted window in packets, 0 for the legacy transfer
+ */
+uint8_t app_ota_stream_negotiate(const uint8_t *p_val, uint16_t len)
+{
+    memset(&stream, 0x00, sizeof(stream));
+
+    if ((len < 2) || ((p_val[1] & APP_OTA_PREPARE_OPT_STREAM) == 0))
+    {
+        return 0;
+    }
+
+    stream.window = APP_OTA_STREAM_DEFAULT_WINDOW;
+    if ((len >= 3) && (p_val[2] != 0))
+    {
+        stream.window = (p_val[2] < APP_OTA_STREAM_MAX_WINDOW) ? p_val[2] : APP_OTA_STREAM_MAX_WINDOW;
+    }
+    stream.ack_every = (stream.window > 1) ? (stream.window / 2) : 1;
+    stream.enabled = true;
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "OTA streaming transfer, window %d packets\n", stream.window);
+
+    return stream.window;
+}
+
+/*
+ * Function Name:
+ * app_ota_stream_start
+ *
+ * Function Description:
+ * @brief  Reset the sequence, called on CY_OTA_UPGRADE_COMMAND_DOWNLOAD.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_stream_start(void)
+{
+    stream.next_seq = 0;
+    stream.offset = 0;
+    stream.since_ack = 0;
+    stream.nak_sent = false;
+}
+
+/*
+ * Function Name:
+ * app_ota_stream_stop
+ *
+ * Function Description:
+ * @brief  Leave the streaming transfer, called on VERIFY and ABORT.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_stream_stop(void)
+{
+    stream.enabled = false;
+}
+
+bool app_ota_stream_enabled(void)
+{
+    return stream.enabled;
+}
+
+/*
+ * Function Name:
+ * app_ota_stream_rx
+ *
+ * Function Description:
+ * @brief  Check the sequence number of a streaming DATA packet.
+ *
+ * @param p_val          DATA packet including the sequence header
+ * @param len            length of the packet
+ * @param pp_payload     set to the image data on APP_OTA_STREAM_RX_ACCEPT
+ * @param p_payload_len  set to the image data length on APP_OTA_STREAM_RX_ACCEPT
+ *
+ * @return app_ota_stream_rx_t
+ */
+app_ota_stream_rx_t app_ota_stream_rx(const uint8_t *p_val, uint16_t len, const uint8_t **pp_payload, uint16_t *p_payload_len)
+{
+    uint16_t seq;
+    uint16_t behind;
+
+    if (len < APP_OTA_STREAM_HDR_LEN)
+    {
+        return APP_OTA_STREAM_RX_INVALID;
+    }
+
+    seq = (uint16_t)(p_val[0] | (p_val[1] << 8));
+    if (seq == stream.next_seq)
+    {
+        *pp_payload = &p_val[APP_OTA_STREAM_HDR_LEN];
+        *p_payload_len = len - APP_OTA_STREAM_HDR_LEN;
+        return APP_OTA_STREAM_RX_ACCEPT;
+    }
+
+    /* Packets of the window before the last NAK may still arrive */
+    behind = (uint16_t)(stream.next_seq - seq);
+    if ((behind <= stream.window) || (stream.nak_sent))
+    {
+        return APP_OTA_STREAM_RX_DUPLICATE;
+    }
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s() expected seq %d got %d\n", __func__, stream.next_seq, seq);
+    stream.nak_sent = true;
+    return APP_OTA_STREAM_RX_OUT_OF_ORDER;
+}
+
+/*
+ * Function Name:
+ * app_ota_stream_accepted
+ *
+ * Function Description:
+ * @brief  Advance the sequence after the payload of an accepted packet was stored.
+ *
+ * @param payload_len  image bytes in the packet
+ *
+ * @return bool  true if an acknowledgement is due
+ */
+bool app_ota_stream_accepted(uint16_t payload_len)
+{
+    stream.next_seq++;
+    stream.offset += payload_len;
+    stream.nak_sent = false;
+
+    if (++stream.since_ack >= stream.ack_every)
+    {
+        stream.since_ack = 0;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Function Name:
+ * app_ota_stream_build_ack
+ *
+ * Function Description:
+ * @brief  Format an acknowledgement notification.
+ *
+ * @param status  APP_OTA_STATUS_STREAM_ACK or APP_OTA_STATUS_STREAM_NAK
+ * @param p_buf   at least APP_OTA_STREAM_ACK_LEN bytes
+ *
+ * @return uint16_t  notification length
+ */
+uint16_t app_ota_stream_build_ack(uint8_t status, uint8_t *p_buf)
+{
+    p_buf[0] = status;
+    p_buf[1] = stream.window;
+    p_buf[2] = (uint8_t)(stream.next_seq >> 0);
+    p_buf[3] = (uint8_t)(stream.next_seq >> 8);
+    p_buf[4] = (uint8_t)(stream.offset >> 0);
+    p_buf[5] = (uint8_t)(stream.offset >> 8);
+    p_buf[6] = (uint8_t)(stream.offset >> 16);
+    p_buf[7] = (uint8_t)(stream.offset >> 24);
+
+    return APP_OTA_STREAM_ACK_LEN;
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
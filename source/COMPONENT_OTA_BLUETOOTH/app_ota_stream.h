@@ -0,0 +1,78 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the OTA
+ *              streaming transfer: sequence numbered DATA Write Commands
+ *              inside a credit window, acknowledged by periodic notifications
+ *              on the control point. See app_ota_protocol.h for the format.
+ */
+
+#ifndef __APP_OTA_STREAM_H__
+#define __APP_OTA_STREAM_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_ota_protocol.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Largest window granted to the host, in packets */
+#ifndef APP_OTA_STREAM_MAX_WINDOW
+#define APP_OTA_STREAM_MAX_WINDOW           (16)
+#endif
+
+/* Window used when the host does not request one */
+#ifndef APP_OTA_STREAM_DEFAULT_WINDOW
+#define APP_OTA_STREAM_DEFAULT_WINDOW       (8)
+#endif
+
+typedef enum
+{
+    APP_OTA_STREAM_RX_ACCEPT,           /* Expected packet, payload is to be stored */
+    APP_OTA_STREAM_RX_DUPLICATE,        /* Already accepted, drop silently */
+    APP_OTA_STREAM_RX_OUT_OF_ORDER,     /* Gap in the sequence, the host must go back */
+    APP_OTA_STREAM_RX_INVALID,          /* Too short to carry a header */
+} app_ota_stream_rx_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+uint8_t app_ota_stream_negotiate(const uint8_t *p_val, uint16_t len);
+
+void app_ota_stream_start(void);
+
+void app_ota_stream_stop(void);
+
+bool app_ota_stream_enabled(void);
+
+app_ota_stream_rx_t app_ota_stream_rx(const uint8_t *p_val, uint16_t len, const uint8_t **pp_payload, uint16_t *p_payload_len);
+
+bool app_ota_stream_accepted(uint16_t payload_len);
+
+uint16_t app_ota_stream_build_ack(uint8_t status, uint8_t *p_buf);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_STREAM_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,321 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions used to time the
+ *              phases of a Bluetooth® OTA update.
+ *
+ *              Every phase boundary keeps one timestamp of the microsecond
+ *              clock of app_ota_metrics.c, taken when the boundary is passed.
+ *              The commit latency of the storage thread goes into a histogram
+ *              of power of 2 buckets, so min, max and percentiles are known
+ *              without keeping every sample. Everything is in fixed memory and
+ *              reset when a new connection comes up.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cyhal.h"
+#include "app_ota_metrics.h"
+#include "app_ota_timing.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define APP_OTA_PHASE_BIT(phase)            (1UL << (phase))
+
+typedef struct
+{
+    /* Written by the Bluetooth® stack thread */
+    uint32_t    phase_valid;
+    uint32_t    phase_us[APP_OTA_NUM_PHASES];
+
+    /* Written by the storage thread */
+    uint32_t    commit_count;
+    uint32_t    commit_us_min;
+    uint32_t    commit_us_max;
+    uint32_t    commit_hist[APP_OTA_TIMING_HIST_BUCKETS];
+} app_ota_timing_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static app_ota_timing_t timing;
+
+static const char *const phase_name[APP_OTA_NUM_PHASES] =
+{
+    "connect",
+    "MTU exchange",
+    "pairing complete",
+    "PREPARE start",
+    "PREPARE end",
+    "first DATA",
+    "last DATA",
+    "VERIFY start",
+    "VERIFY end",
+    "indication confirm",
+    "reset",
+};
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/*
+ * Bucket 0 counts 0 us, bucket b counts [2^(b-1), 2^b) us
+ */
+static uint32_t app_ota_timing_bucket(uint32_t elapsed_us)
+{
+    uint32_t bucket = 0;
+
+    while ((elapsed_us != 0) && (bucket < (APP_OTA_TIMING_HIST_BUCKETS - 1)))
+    {
+        elapsed_us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/*
+ * Upper bound of the bucket holding the given percentile, clamped to the
+ * observed range. Called with the histogram copied out of the live counters.
+ */
+static uint32_t app_ota_timing_percentile(const app_ota_timing_t *p_snap, uint32_t percent)
+{
+    uint32_t rank;
+    uint32_t seen = 0;
+    uint32_t bucket;
+    uint32_t value = p_snap->commit_us_max;
+
+    if (p_snap->commit_count == 0)
+    {
+        return 0;
+    }
+
+    rank = (uint32_t)((((uint64_t)p_snap->commit_count * percent) + 99) / 100);
+    for (bucket = 0; bucket < APP_OTA_TIMING_HIST_BUCKETS; bucket++)
+    {
+        seen += p_snap->commit_hist[bucket];
+        if (seen >= rank)
+        {
+            if (bucket < (APP_OTA_TIMING_HIST_BUCKETS - 1))
+            {
+                value = (1UL << bucket) - 1;
+            }
+            break;
+        }
+    }
+
+    if (value > p_snap->commit_us_max)
+    {
+        value = p_snap->commit_us_max;
+    }
+    if (value < p_snap->commit_us_min)
+    {
+        value = p_snap->commit_us_min;
+    }
+    return value;
+}
+
+/*
+ * Function Name:
+ * app_ota_timing_connected
+ *
+ * Function Description:
+ * @brief  Clear the previous record and timestamp a new connection.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_timing_connected(void)
+{
+    uint32_t irq_state = cyhal_system_critical_section_enter();
+
+    memset(&timing, 0x00, sizeof(timing));
+    timing.commit_us_min = UINT32_MAX;
+
+    cyhal_system_critical_section_exit(irq_state);
+
+    app_ota_timing_mark(APP_OTA_PHASE_CONNECT);
+}
+
+/*
+ * Function Name:
+ * app_ota_timing_mark
+ *
+ * Function Description:
+ * @brief  Timestamp a phase boundary, a later call for the same phase
+ *         replaces the earlier timestamp.
+ *
+ * @param phase  phase boundary passed
+ *
+ * @return void
+ */
+void app_ota_timing_mark(app_ota_phase_t phase)
+{
+    if (phase >= APP_OTA_NUM_PHASES)
+    {
+        return;
+    }
+    timing.phase_us[phase] = app_ota_metrics_now_us();
+    timing.phase_valid |= APP_OTA_PHASE_BIT(phase);
+}
+
+/*
+ * Function Name:
+ * app_ota_timing_data
+ *
+ * Function Description:
+ * @brief  Timestamp image data, reuses the timestamp of the DATA write so
+ *         that the hot path does not read the clock twice.
+ *
+ * @param now_us  value of app_ota_metrics_now_us() for this write
+ *
+ * @return void
+ */
+void app_ota_timing_data(uint32_t now_us)
+{
+    if ((timing.phase_valid & APP_OTA_PHASE_BIT(APP_OTA_PHASE_FIRST_DATA)) == 0)
+    {
+        timing.phase_us[APP_OTA_PHASE_FIRST_DATA] = now_us;
+        timing.phase_valid |= APP_OTA_PHASE_BIT(APP_OTA_PHASE_FIRST_DATA);
+    }
+    timing.phase_us[APP_OTA_PHASE_LAST_DATA] = now_us;
+    timing.phase_valid |= APP_OTA_PHASE_BIT(APP_OTA_PHASE_LAST_DATA);
+}
+
+/*
+ * Function Name:
+ * app_ota_timing_commit
+ *
+ * Function Description:
+ * @brief  Account the time taken to commit one staged block to storage,
+ *         called from the storage thread.
+ *
+ * @param elapsed_us  duration of the storage write
+ *
+ * @return void
+ */
+void app_ota_timing_commit(uint32_t elapsed_us)
+{
+    uint32_t bucket = app_ota_timing_bucket(elapsed_us);
+    uint32_t irq_state = cyhal_system_critical_section_enter();
+
+    timing.commit_count++;
+    timing.commit_hist[bucket]++;
+    if (elapsed_us < timing.commit_us_min)
+    {
+        timing.commit_us_min = elapsed_us;
+    }
+    if (elapsed_us > timing.commit_us_max)
+    {
+        timing.commit_us_max = elapsed_us;
+    }
+
+    cyhal_system_critical_section_exit(irq_state);
+}
+
+/*
+ * Function Name:
+ * app_ota_timing_get
+ *
+ * Function Description:
+ * @brief  Fill the value of the OTA Timing characteristic.
+ *
+ * @param p_summary  filled with the phase times and the commit latency
+ *
+ * @return void
+ */
+void app_ota_timing_get(app_ota_timing_summary_t *p_summary)
+{
+    app_ota_timing_t snap;
+    uint32_t irq_state;
+    uint32_t phase;
+
+    irq_state = cyhal_system_critical_section_enter();
+    memcpy(&snap, &timing, sizeof(snap));
+    cyhal_system_critical_section_exit(irq_state);
+
+    memset(p_summary, 0x00, sizeof(*p_summary));
+    p_summary->phase_valid = snap.phase_valid;
+    for (phase = 0; phase < APP_OTA_NUM_PHASES; phase++)
+    {
+        if ((snap.phase_valid & APP_OTA_PHASE_BIT(phase)) != 0)
+        {
+            /* Unsigned difference, valid across the wrap of the clock */
+            p_summary->phase_us[phase] = snap.phase_us[phase] - snap.phase_us[APP_OTA_PHASE_CONNECT];
+        }
+    }
+
+    p_summary->commit_count = snap.commit_count;
+    if (snap.commit_count != 0)
+    {
+        p_summary->commit_us_min = snap.commit_us_min;
+        p_summary->commit_us_max = snap.commit_us_max;
+        p_summary->commit_us_p50 = app_ota_timing_percentile(&snap, 50);
+        p_summary->commit_us_p90 = app_ota_timing_percentile(&snap, 90);
+        p_summary->commit_us_p99 = app_ota_timing_percentile(&snap, 99);
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_timing_report
+ *
+ * Function Description:
+ * @brief  Log the phase times and the commit latency, called before the
+ *         reset into the new image and on disconnection.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_timing_report(void)
+{
+    app_ota_timing_summary_t summary;
+    uint32_t phase;
+    uint32_t prev_us = 0;
+
+    app_ota_timing_get(&summary);
+    if ((summary.phase_valid & APP_OTA_PHASE_BIT(APP_OTA_PHASE_PREPARE_START)) == 0)
+    {
+        /* No update was attempted on this connection */
+        return;
+    }
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "OTA phase timing (us since connect)\n");
+    for (phase = 0; phase < APP_OTA_NUM_PHASES; phase++)
+    {
+        if ((summary.phase_valid & APP_OTA_PHASE_BIT(phase)) != 0)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    %-18s : %10lu (%+ld)\n", phase_name[phase], summary.phase_us[phase], (long)(int32_t)(summary.phase_us[phase] - prev_us));
+            prev_us = summary.phase_us[phase];
+        }
+    }
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    block commits      : %lu\n", summary.commit_count);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    us per commit      : min %lu max %lu p50 %lu p90 %lu p99 %lu\n",
+               summary.commit_us_min, summary.commit_us_max, summary.commit_us_p50, summary.commit_us_p90, summary.commit_us_p99);
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
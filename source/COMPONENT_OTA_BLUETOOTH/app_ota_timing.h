@@ -0,0 +1,96 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes used to time the
+ *              phases of a Bluetooth® OTA update, from the connection to the
+ *              reset into the new image, and the latency of every block
+ *              committed to storage.
+ */
+
+#ifndef __APP_OTA_TIMING_H__
+#define __APP_OTA_TIMING_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Number of power of 2 buckets of the commit latency histogram, the last one is open ended */
+#ifndef APP_OTA_TIMING_HIST_BUCKETS
+#define APP_OTA_TIMING_HIST_BUCKETS         (24)
+#endif
+
+/* Phase boundaries, in the order they normally occur */
+typedef enum
+{
+    APP_OTA_PHASE_CONNECT,          /* GATT connection up                           */
+    APP_OTA_PHASE_MTU,              /* MTU exchange answered                        */
+    APP_OTA_PHASE_PAIRED,           /* pairing complete                             */
+    APP_OTA_PHASE_PREPARE_START,    /* PREPARE_DOWNLOAD received                    */
+    APP_OTA_PHASE_PREPARE_END,      /* slot erased, PREPARE_DOWNLOAD answered       */
+    APP_OTA_PHASE_FIRST_DATA,       /* first image data                             */
+    APP_OTA_PHASE_LAST_DATA,        /* latest image data                            */
+    APP_OTA_PHASE_VERIFY_START,     /* VERIFY received                              */
+    APP_OTA_PHASE_VERIFY_END,       /* image verified (or rejected)                 */
+    APP_OTA_PHASE_CONFIRM,          /* host confirmed the VERIFY indication         */
+    APP_OTA_PHASE_RESET,            /* cyhal_system_reset_device() called           */
+    APP_OTA_NUM_PHASES
+} app_ota_phase_t;
+
+/*
+ * Value of the OTA Timing characteristic, little-endian 32-bit words.
+ * Times are in microseconds since APP_OTA_PHASE_CONNECT, a phase is valid
+ * when its bit is set in phase_valid.
+ */
+typedef struct
+{
+    uint32_t    phase_valid;
+    uint32_t    phase_us[APP_OTA_NUM_PHASES];
+    uint32_t    commit_count;
+    uint32_t    commit_us_min;
+    uint32_t    commit_us_max;
+    uint32_t    commit_us_p50;
+    uint32_t    commit_us_p90;
+    uint32_t    commit_us_p99;
+} app_ota_timing_summary_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_timing_connected(void);
+
+void app_ota_timing_mark(app_ota_phase_t phase);
+
+void app_ota_timing_data(uint32_t now_us);
+
+void app_ota_timing_commit(uint32_t elapsed_us);
+
+void app_ota_timing_get(app_ota_timing_summary_t *p_summary);
+
+void app_ota_timing_report(void);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_TIMING_H__ */
+
+/* [] END OF FILE */
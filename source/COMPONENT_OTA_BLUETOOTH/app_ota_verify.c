@@ -0,0 +1,580 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function definitions of the
+ *              signature check of secure builds.
+ *
+ *              The storage thread feeds every block it commits into a SHA-256
+ *              context, so hashing overlaps with the transfer. The signature
+ *              comes with APP_OTA_COMMAND_SIGNATURE or with VERIFY, see
+ *              app_ota_protocol.h. If the blocks were not all seen in order
+ *              (a resumed download), the slot is read back and hashed at
+ *              VERIFY instead. The time spent hashing and verifying is logged
+ *              separately.
+ *
+ *              Hashing and verification go through a backend. The CC312
+ *              backend uses mbedtls, and is built when the mbedtls
+ *              configuration has the CC312 SHA-256 and ECDSA verify
+ *              (MBEDTLS_SHA256_ALT, MBEDTLS_ECDSA_VERIFY_ALT). It is selected
+ *              at start up if it hashes a known answer correctly. The
+ *              software backend is always built: app_ota_sha256.c and the
+ *              ECDSA of ota_ecc_pp.h.
+ */
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+#ifdef COMPONENT_OTA_BLUETOOTH_SECURE
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cy_ota_storage_api.h"
+#include "ota_context.h"
+#include "app_ota_verify.h"
+#include "app_ota_sha256.h"
+#include "app_ota_metrics.h"
+#include "app_ota_protocol.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/version.h"
+#include <string.h>
+
+#if defined(MBEDTLS_SHA256_ALT) && defined(MBEDTLS_ECDSA_VERIFY_ALT) && defined(MBEDTLS_ECDSA_C) && \
+    !defined(APP_OTA_VERIFY_SOFTWARE_ONLY)
+#include "mbedtls/ecdsa.h"
+#define APP_OTA_VERIFY_CC312
+#endif
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define APP_OTA_VERIFY_HASH_LEN             (APP_OTA_SHA256_HASH_LEN)
+
+#define APP_OTA_VERIFY_COORD_LEN            (32)
+
+#ifdef APP_OTA_VERIFY_CC312
+/* mbedtls 3 dropped the _ret suffix */
+#if (MBEDTLS_VERSION_NUMBER < 0x03000000)
+#define app_ota_verify_sha256_starts(ctx)           mbedtls_sha256_starts_ret((ctx), 0)
+#define app_ota_verify_sha256_update(ctx, p, len)   mbedtls_sha256_update_ret((ctx), (p), (len))
+#define app_ota_verify_sha256_finish(ctx, hash)     mbedtls_sha256_finish_ret((ctx), (hash))
+#else
+#define app_ota_verify_sha256_starts(ctx)           mbedtls_sha256_starts((ctx), 0)
+#define app_ota_verify_sha256_update(ctx, p, len)   mbedtls_sha256_update((ctx), (p), (len))
+#define app_ota_verify_sha256_finish(ctx, hash)     mbedtls_sha256_finish((ctx), (hash))
+#endif
+#endif /* APP_OTA_VERIFY_CC312 */
+
+/* Hash context of any backend */
+typedef union
+{
+    app_ota_sha256_t            soft;
+#ifdef APP_OTA_VERIFY_CC312
+    mbedtls_sha256_context      mbedtls;
+#endif
+} app_ota_verify_sha_t;
+
+/* Crypto backend, the hash functions return false if the engine failed */
+typedef struct
+{
+    const char  *name;
+    bool        (*sha256_start)(app_ota_verify_sha_t *p_sha);
+    bool        (*sha256_update)(app_ota_verify_sha_t *p_sha, const uint8_t *p_data, uint32_t len);
+    bool        (*sha256_finish)(app_ota_verify_sha_t *p_sha, uint8_t hash[APP_OTA_VERIFY_HASH_LEN]);
+    bool        (*ecdsa_verify)(const uint8_t hash[APP_OTA_VERIFY_HASH_LEN], const uint8_t signature[APP_OTA_SIGNATURE_LEN]);
+} app_ota_verify_backend_t;
+
+typedef struct
+{
+    bool                        active;
+    bool                        in_order;       /* every byte from 0 went through the context */
+    bool                        hash_ok;        /* no engine error so far                     */
+    volatile bool               has_signature;
+    uint32_t                    total_size;
+    uint32_t                    hashed;
+    uint32_t                    hash_us;        /* spent hashing while the image was stored   */
+    app_ota_verify_sha_t        sha;
+    uint8_t                     signature[APP_OTA_SIGNATURE_LEN];
+} app_ota_verify_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+static bool app_ota_verify_soft_sha256_start(app_ota_verify_sha_t *p_sha);
+static bool app_ota_verify_soft_sha256_update(app_ota_verify_sha_t *p_sha, const uint8_t *p_data, uint32_t len);
+static bool app_ota_verify_soft_sha256_finish(app_ota_verify_sha_t *p_sha, uint8_t hash[APP_OTA_VERIFY_HASH_LEN]);
+static bool app_ota_verify_soft_ecdsa_verify(const uint8_t hash[APP_OTA_VERIFY_HASH_LEN], const uint8_t signature[APP_OTA_SIGNATURE_LEN]);
+#ifdef APP_OTA_VERIFY_CC312
+static bool app_ota_verify_cc312_sha256_start(app_ota_verify_sha_t *p_sha);
+static bool app_ota_verify_cc312_sha256_update(app_ota_verify_sha_t *p_sha, const uint8_t *p_data, uint32_t len);
+static bool app_ota_verify_cc312_sha256_finish(app_ota_verify_sha_t *p_sha, uint8_t hash[APP_OTA_VERIFY_HASH_LEN]);
+static bool app_ota_verify_cc312_ecdsa_verify(const uint8_t hash[APP_OTA_VERIFY_HASH_LEN], const uint8_t signature[APP_OTA_SIGNATURE_LEN]);
+#endif
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+/* Public key of the image signer, see ota_ecc_pp.h */
+extern Point ecdsa256_public_key;
+
+/* In order of preference, the software backend is last */
+static const app_ota_verify_backend_t verify_backends[] =
+{
+#ifdef APP_OTA_VERIFY_CC312
+    {
+        "CC312",
+        app_ota_verify_cc312_sha256_start,
+        app_ota_verify_cc312_sha256_update,
+        app_ota_verify_cc312_sha256_finish,
+        app_ota_verify_cc312_ecdsa_verify
+    },
+#endif
+    {
+        "software",
+        app_ota_verify_soft_sha256_start,
+        app_ota_verify_soft_sha256_update,
+        app_ota_verify_soft_sha256_finish,
+        app_ota_verify_soft_ecdsa_verify
+    },
+};
+
+#define APP_OTA_VERIFY_NUM_BACKENDS         (sizeof(verify_backends) / sizeof(verify_backends[0]))
+
+/* SHA-256 of "abc", FIPS 180-4 example */
+static const uint8_t verify_kat_hash[APP_OTA_VERIFY_HASH_LEN] =
+{
+    0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+    0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD
+};
+
+static const app_ota_verify_backend_t *verify_backend = &verify_backends[APP_OTA_VERIFY_NUM_BACKENDS - 1];
+
+static app_ota_verify_t verify;
+
+static uint8_t verify_buf[APP_OTA_VERIFY_READ_CHUNK];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static bool app_ota_verify_soft_sha256_start(app_ota_verify_sha_t *p_sha)
+{
+    app_ota_sha256_start(&p_sha->soft);
+    return true;
+}
+
+static bool app_ota_verify_soft_sha256_update(app_ota_verify_sha_t *p_sha, const uint8_t *p_data, uint32_t len)
+{
+    app_ota_sha256_update(&p_sha->soft, p_data, len);
+    return true;
+}
+
+static bool app_ota_verify_soft_sha256_finish(app_ota_verify_sha_t *p_sha, uint8_t hash[APP_OTA_VERIFY_HASH_LEN])
+{
+    app_ota_sha256_finish(&p_sha->soft, hash);
+    return true;
+}
+
+static bool app_ota_verify_soft_ecdsa_verify(const uint8_t hash[APP_OTA_VERIFY_HASH_LEN], const uint8_t signature[APP_OTA_SIGNATURE_LEN])
+{
+    return (ecdsa_verify_((unsigned char *)hash, (unsigned char *)signature, &ecdsa256_public_key) != 0);
+}
+
+#ifdef APP_OTA_VERIFY_CC312
+static bool app_ota_verify_cc312_sha256_start(app_ota_verify_sha_t *p_sha)
+{
+    mbedtls_sha256_init(&p_sha->mbedtls);
+    return (app_ota_verify_sha256_starts(&p_sha->mbedtls) == 0);
+}
+
+static bool app_ota_verify_cc312_sha256_update(app_ota_verify_sha_t *p_sha, const uint8_t *p_data, uint32_t len)
+{
+    return (app_ota_verify_sha256_update(&p_sha->mbedtls, p_data, len) == 0);
+}
+
+static bool app_ota_verify_cc312_sha256_finish(app_ota_verify_sha_t *p_sha, uint8_t hash[APP_OTA_VERIFY_HASH_LEN])
+{
+    bool ok = (app_ota_verify_sha256_finish(&p_sha->mbedtls, hash) == 0);
+
+    mbedtls_sha256_free(&p_sha->mbedtls);
+    return ok;
+}
+
+/*
+ * Big-endian coordinate of the public key. The multi-precision numbers of
+ * ota_ecc_pp.h are arrays of 32-bit words, least significant word first.
+ */
+static void app_ota_verify_coord(const uint32_t *p_words, uint8_t *p_out)
+{
+    uint32_t i;
+
+    for (i = 0; i < (APP_OTA_VERIFY_COORD_LEN / 4); i++)
+    {
+        uint32_t word = p_words[(APP_OTA_VERIFY_COORD_LEN / 4) - 1 - i];
+
+        p_out[(i * 4) + 0] = (uint8_t)(word >> 24);
+        p_out[(i * 4) + 1] = (uint8_t)(word >> 16);
+        p_out[(i * 4) + 2] = (uint8_t)(word >> 8);
+        p_out[(i * 4) + 3] = (uint8_t)(word >> 0);
+    }
+}
+
+static bool app_ota_verify_cc312_ecdsa_verify(const uint8_t hash[APP_OTA_VERIFY_HASH_LEN], const uint8_t signature[APP_OTA_SIGNATURE_LEN])
+{
+    uint8_t key[1 + (2 * APP_OTA_VERIFY_COORD_LEN)];
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point q;
+    mbedtls_mpi r;
+    mbedtls_mpi s;
+    bool ok = false;
+
+    /* Uncompressed point: 0x04, X, Y */
+    key[0] = 0x04;
+    app_ota_verify_coord((const uint32_t *)ecdsa256_public_key.x, &key[1]);
+    app_ota_verify_coord((const uint32_t *)ecdsa256_public_key.y, &key[1 + APP_OTA_VERIFY_COORD_LEN]);
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&q);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    if ((mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1) == 0) &&
+        (mbedtls_ecp_point_read_binary(&grp, &q, key, sizeof(key)) == 0) &&
+        (mbedtls_mpi_read_binary(&r, &signature[0], APP_OTA_VERIFY_COORD_LEN) == 0) &&
+        (mbedtls_mpi_read_binary(&s, &signature[APP_OTA_VERIFY_COORD_LEN], APP_OTA_VERIFY_COORD_LEN) == 0))
+    {
+        ok = (mbedtls_ecdsa_verify(&grp, hash, APP_OTA_VERIFY_HASH_LEN, &q, &r, &s) == 0);
+    }
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_ecp_point_free(&q);
+    mbedtls_ecp_group_free(&grp);
+
+    return ok;
+}
+#endif /* APP_OTA_VERIFY_CC312 */
+
+/*
+ * Check that a backend hashes "abc" correctly
+ */
+static bool app_ota_verify_self_test(const app_ota_verify_backend_t *p_backend)
+{
+    static app_ota_verify_sha_t sha;
+    uint8_t hash[APP_OTA_VERIFY_HASH_LEN];
+
+    return p_backend->sha256_start(&sha) &&
+           p_backend->sha256_update(&sha, (const uint8_t *)"abc", 3) &&
+           p_backend->sha256_finish(&sha, hash) &&
+           (memcmp(hash, verify_kat_hash, sizeof(hash)) == 0);
+}
+
+/*
+ * Hash the image again from the upgrade slot
+ */
+static cy_rslt_t app_ota_verify_rehash(cy_ota_storage_context_t *storage_ptr)
+{
+    cy_ota_storage_read_info_t read_info;
+    uint32_t offset = 0;
+
+    /* The context of the first pass is dropped, the backend frees it on finish */
+    if (!verify_backend->sha256_finish(&verify.sha, verify_buf) || !verify_backend->sha256_start(&verify.sha))
+    {
+        return CY_RSLT_OTA_ERROR_VERIFY;
+    }
+    while (offset < verify.total_size)
+    {
+        read_info.offset = offset;
+        read_info.buffer = verify_buf;
+        read_info.size = verify.total_size - offset;
+        if (read_info.size > sizeof(verify_buf))
+        {
+            read_info.size = sizeof(verify_buf);
+        }
+        if (cy_ota_storage_read(storage_ptr, &read_info) != CY_RSLT_SUCCESS)
+        {
+            cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_ERR, "%s() cy_ota_storage_read() at 0x%lx Failed\n", __func__, offset);
+            return CY_RSLT_OTA_ERROR_VERIFY;
+        }
+        if (!verify_backend->sha256_update(&verify.sha, verify_buf, read_info.size))
+        {
+            return CY_RSLT_OTA_ERROR_VERIFY;
+        }
+        offset += read_info.size;
+    }
+    verify.hash_ok = true;
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * app_ota_verify_init
+ *
+ * Function Description:
+ * @brief  Select the first backend that passes its self test, called once
+ *         from bt_app_init().
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_verify_init(void)
+{
+    uint32_t i;
+
+    memset(&verify, 0x00, sizeof(verify));
+    for (i = 0; i < APP_OTA_VERIFY_NUM_BACKENDS; i++)
+    {
+        if (app_ota_verify_self_test(&verify_backends[i]))
+        {
+            break;
+        }
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_WARNING, "%s() %s backend failed its self test\n", __func__, verify_backends[i].name);
+    }
+    verify_backend = &verify_backends[(i < APP_OTA_VERIFY_NUM_BACKENDS) ? i : (APP_OTA_VERIFY_NUM_BACKENDS - 1)];
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Image verification backend: %s\n", verify_backend->name);
+
+#ifdef APP_OTA_VERIFY_BENCHMARK
+    app_ota_verify_benchmark();
+#endif
+}
+
+/*
+ * Function Name:
+ * app_ota_verify_benchmark
+ *
+ * Function Description:
+ * @brief  Time SHA-256 over APP_OTA_VERIFY_BENCH_BYTES and
+ *         APP_OTA_VERIFY_BENCH_ROUNDS ECDSA verifications on every backend.
+ *         The signature is not valid, the verification runs to the end
+ *         anyway.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_ota_verify_benchmark(void)
+{
+    static app_ota_verify_sha_t sha;
+    uint8_t hash[APP_OTA_VERIFY_HASH_LEN];
+    uint8_t signature[APP_OTA_SIGNATURE_LEN];
+    uint32_t sha_us;
+    uint32_t ecdsa_us;
+    uint32_t done;
+    uint32_t i;
+    uint32_t round;
+
+    memset(verify_buf, 0xA5, sizeof(verify_buf));
+    memset(signature, 0x5A, sizeof(signature));
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Verification benchmark: SHA-256 of %lu bytes, %d ECDSA verifications\n",
+               (uint32_t)APP_OTA_VERIFY_BENCH_BYTES, APP_OTA_VERIFY_BENCH_ROUNDS);
+    for (i = 0; i < APP_OTA_VERIFY_NUM_BACKENDS; i++)
+    {
+        const app_ota_verify_backend_t *p_backend = &verify_backends[i];
+
+        sha_us = app_ota_metrics_now_us();
+        (void)p_backend->sha256_start(&sha);
+        for (done = 0; done < APP_OTA_VERIFY_BENCH_BYTES; done += sizeof(verify_buf))
+        {
+            (void)p_backend->sha256_update(&sha, verify_buf, sizeof(verify_buf));
+        }
+        (void)p_backend->sha256_finish(&sha, hash);
+        sha_us = app_ota_metrics_now_us() - sha_us;
+
+        ecdsa_us = app_ota_metrics_now_us();
+        for (round = 0; round < APP_OTA_VERIFY_BENCH_ROUNDS; round++)
+        {
+            (void)p_backend->ecdsa_verify(hash, signature);
+        }
+        ecdsa_us = (app_ota_metrics_now_us() - ecdsa_us) / APP_OTA_VERIFY_BENCH_ROUNDS;
+
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    %-8s : SHA-256 %lu KB/s, ECDSA verify %lu us\n", p_backend->name,
+                   (sha_us != 0) ? (uint32_t)(((uint64_t)APP_OTA_VERIFY_BENCH_BYTES * 1000000ULL) / ((uint64_t)sha_us * 1024ULL)) : 0,
+                   ecdsa_us);
+    }
+}
+
+/*
+ * Function Name:
+ * app_ota_verify_start
+ *
+ * Function Description:
+ * @brief  Start hashing a new image, called on CY_OTA_UPGRADE_COMMAND_DOWNLOAD
+ *         before the storage thread is started.
+ *
+ * @param total_size  image size in bytes
+ *
+ * @return void
+ */
+void app_ota_verify_start(uint32_t total_size)
+{
+    if (verify.active)
+    {
+        (void)verify_backend->sha256_finish(&verify.sha, verify_buf);
+    }
+    memset(&verify, 0x00, sizeof(verify));
+    verify.hash_ok = verify_backend->sha256_start(&verify.sha);
+    verify.total_size = total_size;
+    verify.in_order = true;
+    verify.active = true;
+}
+
+/*
+ * Function Name:
+ * app_ota_verify_update
+ *
+ * Function Description:
+ * @brief  Hash a block, called by the storage thread once it is committed.
+ *
+ * @param offset  offset of the block in the image
+ * @param p_data  block data
+ * @param len     block length
+ *
+ * @return void
+ */
+void app_ota_verify_update(uint32_t offset, const uint8_t *p_data, uint32_t len)
+{
+    uint32_t start_us;
+
+    if ((!verify.active) || (!verify.in_order))
+    {
+        return;
+    }
+    if (offset != verify.hashed)
+    {
+        /* The start of the image was stored in an earlier session */
+        verify.in_order = false;
+        return;
+    }
+
+    start_us = app_ota_metrics_now_us();
+    if (!verify_backend->sha256_update(&verify.sha, p_data, len))
+    {
+        verify.hash_ok = false;
+    }
+    verify.hash_us += app_ota_metrics_now_us() - start_us;
+    verify.hashed += len;
+}
+
+/*
+ * Function Name:
+ * app_ota_verify_set_signature
+ *
+ * Function Description:
+ * @brief  Store the signature sent by the host.
+ *
+ * @param p_signature  APP_OTA_SIGNATURE_LEN bytes, r and s
+ *
+ * @return void
+ */
+void app_ota_verify_set_signature(const uint8_t *p_signature)
+{
+    memcpy(verify.signature, p_signature, sizeof(verify.signature));
+    verify.has_signature = true;
+}
+
+/*
+ * Function Name:
+ * app_ota_verify_has_signature
+ *
+ * Function Description:
+ * @brief  Check if the host sent the signature of the current image.
+ *
+ * @param void
+ *
+ * @return bool  true if app_ota_verify_finish() can verify the image
+ */
+bool app_ota_verify_has_signature(void)
+{
+    return verify.active && verify.has_signature;
+}
+
+/*
+ * Function Name:
+ * app_ota_verify_finish
+ *
+ * Function Description:
+ * @brief  Check the signature of the stored image, called on VERIFY once the
+ *         storage thread wrote the last block.
+ *
+ * @param storage_ptr  upgrade slot, read back if the image was not hashed in
+ *                     order
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS if the signature matches
+ */
+cy_rslt_t app_ota_verify_finish(cy_ota_storage_context_t *storage_ptr)
+{
+    uint8_t hash[APP_OTA_VERIFY_HASH_LEN];
+    uint32_t final_us;
+    uint32_t ecdsa_us;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (!app_ota_verify_has_signature())
+    {
+        return CY_RSLT_OTA_ERROR_VERIFY;
+    }
+
+    final_us = app_ota_metrics_now_us();
+    if ((!verify.in_order) || (!verify.hash_ok) || (verify.hashed != verify.total_size))
+    {
+        cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Image hashed 0x%lx of 0x%lx bytes in order, reading the slot back\n", verify.hashed, verify.total_size);
+        result = app_ota_verify_rehash(storage_ptr);
+    }
+    if (!verify_backend->sha256_finish(&verify.sha, hash))
+    {
+        result = CY_RSLT_OTA_ERROR_VERIFY;
+    }
+    final_us = app_ota_metrics_now_us() - final_us;
+
+    ecdsa_us = app_ota_metrics_now_us();
+    if ((result == CY_RSLT_SUCCESS) && !verify_backend->ecdsa_verify(hash, verify.signature))
+    {
+        result = CY_RSLT_OTA_ERROR_VERIFY;
+    }
+    ecdsa_us = app_ota_metrics_now_us() - ecdsa_us;
+
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "Signature %s (%s)\n", (result == CY_RSLT_SUCCESS) ? "verified" : "NOT verified", verify_backend->name);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    SHA-256 during transfer : %lu us\n", verify.hash_us);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    SHA-256 at VERIFY       : %lu us\n", final_us);
+    cy_log_msg(CYLF_MIDDLEWARE, CY_LOG_NOTICE, "    ECDSA verify            : %lu us\n", ecdsa_us);
+
+    verify.active = false;
+    return result;
+}
+
+/*
+ * Function Name:
+ * app_ota_verify_signature
+ *
+ * Function Description:
+ * @brief  Check a signature of the image signer over a SHA-256 hash, with the
+ *         selected backend.
+ *
+ * @param p_hash       APP_OTA_SHA256_HASH_LEN bytes
+ * @param p_signature  APP_OTA_SIGNATURE_LEN bytes, r and s
+ *
+ * @return bool  true if the signature matches
+ */
+bool app_ota_verify_signature(const uint8_t *p_hash, const uint8_t *p_signature)
+{
+    return verify_backend->ecdsa_verify(p_hash, p_signature);
+}
+
+#endif /* COMPONENT_OTA_BLUETOOTH_SECURE */
+
+#endif /* COMPONENT_OTA_BLUETOOTH */
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: This file consists of the function prototypes of the
+ *              signature check of secure builds. The image is hashed while
+ *              it is stored, so that only the ECDSA verification is left
+ *              when the host sends CY_OTA_UPGRADE_COMMAND_VERIFY. SHA-256
+ *              and ECDSA run on the CC312 crypto engine when the mbedtls
+ *              configuration routes them to it, in software otherwise.
+ */
+
+#ifndef __APP_OTA_VERIFY_H__
+#define __APP_OTA_VERIFY_H__
+
+#ifdef COMPONENT_OTA_BLUETOOTH
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "cy_ota_storage_api.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Bytes of the upgrade slot read at a time when the image has to be hashed again */
+#ifndef APP_OTA_VERIFY_READ_CHUNK
+#define APP_OTA_VERIFY_READ_CHUNK           (512)
+#endif
+
+/*
+ * Define APP_OTA_VERIFY_SOFTWARE_ONLY to leave the crypto engine alone, and
+ * APP_OTA_VERIFY_BENCHMARK to time every backend at start up.
+ */
+/* #define APP_OTA_VERIFY_SOFTWARE_ONLY */
+/* #define APP_OTA_VERIFY_BENCHMARK */
+
+/* Bytes hashed by the benchmark */
+#ifndef APP_OTA_VERIFY_BENCH_BYTES
+#define APP_OTA_VERIFY_BENCH_BYTES          (0x40000)
+#endif
+
+/* ECDSA verifications timed by the benchmark */
+#ifndef APP_OTA_VERIFY_BENCH_ROUNDS
+#define APP_OTA_VERIFY_BENCH_ROUNDS         (4)
+#endif
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void app_ota_verify_init(void);
+
+void app_ota_verify_benchmark(void);
+
+void app_ota_verify_start(uint32_t total_size);
+
+void app_ota_verify_update(uint32_t offset, const uint8_t *p_data, uint32_t len);
+
+void app_ota_verify_set_signature(const uint8_t *p_signature);
+
+bool app_ota_verify_has_signature(void);
+
+cy_rslt_t app_ota_verify_finish(cy_ota_storage_context_t *storage_ptr);
+
+bool app_ota_verify_signature(const uint8_t *p_hash, const uint8_t *p_signature);
+
+#endif      /* COMPONENT_OTA_BLUETOOTH */
+
+#endif      /* __APP_OTA_VERIFY_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the ECDSA of ota_ecc_pp.h, on OpenSSL
+ *              libcrypto, and the public key of the image signer. The key
+ *              pair is the test key of test_verify.c, so the tests can also
+ *              sign images they build at run time.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#define OPENSSL_SUPPRESS_DEPRECATED
+#include "ota_test.h"
+#include "ota_ecc_pp.h"
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/obj_mac.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define OTA_TEST_ECC_COORD_LEN              (32)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+/* Public key of the image signer, as the application defines it */
+Point ecdsa256_public_key =
+{
+    { 0xA7903FC3UL, 0x9055A45AUL, 0x09AD656BUL, 0x24CA5B0EUL, 0xA446AC96UL, 0x3122363DUL, 0x19ABBB7DUL, 0xFA0F8C68UL },
+    { 0xB8161026UL, 0x54B5FA0BUL, 0x83F36E25UL, 0xF0F5679DUL, 0xF8260300UL, 0x95AC2D3EUL, 0xCACF9519UL, 0x379E7AB5UL },
+    { 0 },
+};
+
+/* Private key of the test signer */
+static const uint8_t ota_test_ecc_private_key[OTA_TEST_ECC_COORD_LEN] =
+{
+    0xd1, 0x4c, 0xf4, 0x75, 0xbc, 0x4a, 0xba, 0x5c, 0xcf, 0xee, 0x23, 0x2f, 0x98, 0x56, 0xd1, 0xa9,
+    0x67, 0x79, 0x30, 0x06, 0xbd, 0x4a, 0x50, 0xc0, 0x8c, 0x46, 0xda, 0x67, 0x94, 0x35, 0xfc, 0xe7,
+};
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static BIGNUM *ota_test_ecc_coord(const uint32_t *p_words)
+{
+    uint8_t coord[OTA_TEST_ECC_COORD_LEN];
+    uint32_t i;
+
+    for (i = 0; i < KEY_LENGTH_DWORDS_P256; i++)
+    {
+        uint32_t word = p_words[KEY_LENGTH_DWORDS_P256 - 1 - i];
+
+        coord[(i * 4) + 0] = (uint8_t)(word >> 24);
+        coord[(i * 4) + 1] = (uint8_t)(word >> 16);
+        coord[(i * 4) + 2] = (uint8_t)(word >> 8);
+        coord[(i * 4) + 3] = (uint8_t)(word >> 0);
+    }
+    return BN_bin2bn(coord, sizeof(coord), NULL);
+}
+
+int ecdsa_verify_(unsigned char *digest, unsigned char *signature, Point *key)
+{
+    EC_KEY *ec_key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+    BIGNUM *x = ota_test_ecc_coord(key->x);
+    BIGNUM *y = ota_test_ecc_coord(key->y);
+    BIGNUM *r = BN_bin2bn(&signature[0], OTA_TEST_ECC_COORD_LEN, NULL);
+    BIGNUM *s = BN_bin2bn(&signature[OTA_TEST_ECC_COORD_LEN], OTA_TEST_ECC_COORD_LEN, NULL);
+    ECDSA_SIG *sig = ECDSA_SIG_new();
+    int ok = 0;
+
+    if ((ec_key != NULL) && (x != NULL) && (y != NULL) && (r != NULL) && (s != NULL) && (sig != NULL) &&
+        (EC_KEY_set_public_key_affine_coordinates(ec_key, x, y) == 1) &&
+        (ECDSA_SIG_set0(sig, r, s) == 1))
+    {
+        /* The signature owns r and s now */
+        r = NULL;
+        s = NULL;
+        ok = (ECDSA_do_verify(digest, 32, sig, ec_key) == 1);
+    }
+    BN_free(s);
+    BN_free(r);
+    BN_free(y);
+    BN_free(x);
+    ECDSA_SIG_free(sig);
+    EC_KEY_free(ec_key);
+    return ok;
+}
+
+bool ota_test_ecdsa_sign(const uint8_t *p_hash, uint8_t *p_signature)
+{
+    EC_KEY *ec_key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+    BIGNUM *d = BN_bin2bn(ota_test_ecc_private_key, sizeof(ota_test_ecc_private_key), NULL);
+    ECDSA_SIG *sig = NULL;
+    bool ok = false;
+
+    if ((ec_key != NULL) && (d != NULL) && (EC_KEY_set_private_key(ec_key, d) == 1))
+    {
+        sig = ECDSA_do_sign(p_hash, 32, ec_key);
+    }
+    if (sig != NULL)
+    {
+        ok = (BN_bn2binpad(ECDSA_SIG_get0_r(sig), &p_signature[0], OTA_TEST_ECC_COORD_LEN) == OTA_TEST_ECC_COORD_LEN) &&
+             (BN_bn2binpad(ECDSA_SIG_get0_s(sig), &p_signature[OTA_TEST_ECC_COORD_LEN], OTA_TEST_ECC_COORD_LEN) == OTA_TEST_ECC_COORD_LEN);
+    }
+    ECDSA_SIG_free(sig);
+    BN_free(d);
+    EC_KEY_free(ec_key);
+    return ok;
+}
+
+/* [] END OF FILE */
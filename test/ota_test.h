@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host test runner of the OTA data path modules. The modules
+ *              are built from source/COMPONENT_OTA_BLUETOOTH unchanged, with
+ *              the headers in stub/ standing in for the OTA library and the
+ *              generated configuration.
+ */
+
+#ifndef __OTA_TEST_H__
+#define __OTA_TEST_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define OTA_TEST_CHECK(cond)                ota_test_check((cond), #cond, __FILE__, __LINE__)
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+bool ota_test_check(bool ok, const char *expr, const char *file, int line);
+
+/* Deterministic test data */
+void ota_test_fill(uint8_t *p_buf, uint32_t len, uint32_t seed);
+
+/* Signature of a SHA-256 hash with the test key of ota_ecc_pp_host.c, r and s */
+bool ota_test_ecdsa_sign(const uint8_t *p_hash, uint8_t *p_signature);
+
+/* Test cases, one function per module */
+void test_crc32(void);
+void test_sha256(void);
+void test_decomp(void);
+void test_delta(void);
+void test_merkle(void);
+void test_pool(void);
+void test_attr_index(void);
+void test_stage(void);
+void test_coc(void);
+void test_verify(void);
+void test_stream(void);
+void test_image_info(void);
+void test_write_queue(void);
+
+#endif      /* __OTA_TEST_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host test runner of the OTA data path modules.
+ *
+ *              make -C test         builds and runs every test
+ *              make -C test V=1     also prints the log of the modules
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "ota_test.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef struct
+{
+    const char  *name;
+    void        (*run)(void);
+} ota_test_case_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static const ota_test_case_t ota_test_cases[] =
+{
+    { "crc32",  test_crc32  },
+    { "sha256", test_sha256 },
+    { "decomp", test_decomp },
+    { "delta",  test_delta  },
+    { "merkle", test_merkle },
+    { "pool",   test_pool   },
+    { "attr_index", test_attr_index },
+    { "stage",  test_stage  },
+    { "coc",    test_coc    },
+    { "verify", test_verify },
+    { "stream", test_stream },
+    { "image_info", test_image_info },
+    { "write_queue", test_write_queue },
+};
+
+static bool ota_test_verbose;
+static uint32_t ota_test_checks;
+static uint32_t ota_test_failed;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+void cy_log_msg(int facility, CY_LOG_LEVEL_T level, const char *fmt, ...)
+{
+    va_list args;
+
+    (void)facility;
+    (void)level;
+    if (ota_test_verbose)
+    {
+        va_start(args, fmt);
+        vprintf(fmt, args);
+        va_end(args);
+    }
+}
+
+bool ota_test_check(bool ok, const char *expr, const char *file, int line)
+{
+    ota_test_checks++;
+    if (!ok)
+    {
+        ota_test_failed++;
+        printf("  FAILED %s:%d: %s\n", file, line, expr);
+    }
+    return ok;
+}
+
+void ota_test_fill(uint8_t *p_buf, uint32_t len, uint32_t seed)
+{
+    uint32_t x = seed | 1;
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        p_buf[i] = (uint8_t)x;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t i;
+
+    ota_test_verbose = (argc > 1) && (strcmp(argv[1], "-v") == 0);
+
+    for (i = 0; i < (sizeof(ota_test_cases) / sizeof(ota_test_cases[0])); i++)
+    {
+        uint32_t failed = ota_test_failed;
+
+        ota_test_cases[i].run();
+        printf("%-11s %s\n", ota_test_cases[i].name, (ota_test_failed == failed) ? "ok" : "FAILED");
+    }
+    printf("%lu checks, %lu failed\n", (unsigned long)ota_test_checks, (unsigned long)ota_test_failed);
+
+    return (ota_test_failed == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
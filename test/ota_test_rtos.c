@@ -0,0 +1,284 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the RTOS abstraction and the HAL critical
+ *              section, on POSIX threads. Priorities and stacks are ignored,
+ *              the time is that of the monotonic clock.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cyabs_rtos.h"
+#include "cyhal.h"
+#include <errno.h>
+#include <time.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef struct
+{
+    cy_thread_entry_fn_t    entry_function;
+    cy_thread_arg_t         arg;
+} ota_test_thread_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static pthread_mutex_t ota_test_critical = PTHREAD_MUTEX_INITIALIZER;
+/* Nests like the interrupt mask it stands in for */
+static __thread uint32_t ota_test_critical_depth;
+
+/* Threads are never joined, the process ends with the test run */
+static ota_test_thread_t ota_test_threads[8];
+static uint32_t ota_test_num_threads;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/*
+ * Absolute time timeout_ms from now on the given clock
+ */
+static void ota_test_deadline(clockid_t clock, uint32_t timeout_ms, struct timespec *p_deadline)
+{
+    clock_gettime(clock, p_deadline);
+    p_deadline->tv_sec += timeout_ms / 1000;
+    p_deadline->tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (p_deadline->tv_nsec >= 1000000000L)
+    {
+        p_deadline->tv_sec++;
+        p_deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+static void *ota_test_thread_main(void *arg)
+{
+    ota_test_thread_t *p_thread = (ota_test_thread_t *)arg;
+
+    p_thread->entry_function(p_thread->arg);
+    return NULL;
+}
+
+cy_rslt_t cy_rtos_thread_create(cy_thread_t *thread, cy_thread_entry_fn_t entry_function, const char *name,
+                                void *stack, uint32_t stack_size, cy_thread_priority_t priority, cy_thread_arg_t arg)
+{
+    ota_test_thread_t *p_thread;
+
+    (void)name;
+    (void)stack;
+    (void)stack_size;
+    (void)priority;
+
+    if (ota_test_num_threads >= (sizeof(ota_test_threads) / sizeof(ota_test_threads[0])))
+    {
+        return CY_RSLT_OTA_ERROR_OUT_OF_MEMORY;
+    }
+    p_thread = &ota_test_threads[ota_test_num_threads++];
+    p_thread->entry_function = entry_function;
+    p_thread->arg = arg;
+    if (pthread_create(thread, NULL, ota_test_thread_main, p_thread) != 0)
+    {
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    pthread_detach(*thread);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_init_semaphore(cy_semaphore_t *semaphore, uint32_t maxcount, uint32_t initcount)
+{
+    pthread_mutex_init(&semaphore->mutex, NULL);
+    pthread_cond_init(&semaphore->cond, NULL);
+    semaphore->count = initcount;
+    semaphore->max_count = maxcount;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_get_semaphore(cy_semaphore_t *semaphore, uint32_t timeout_ms, bool in_isr)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    struct timespec deadline;
+
+    (void)in_isr;
+
+    ota_test_deadline(CLOCK_REALTIME, timeout_ms, &deadline);
+
+    pthread_mutex_lock(&semaphore->mutex);
+    while (semaphore->count == 0)
+    {
+        if (timeout_ms == CY_RTOS_NEVER_TIMEOUT)
+        {
+            pthread_cond_wait(&semaphore->cond, &semaphore->mutex);
+        }
+        else if (pthread_cond_timedwait(&semaphore->cond, &semaphore->mutex, &deadline) == ETIMEDOUT)
+        {
+            result = CY_RSLT_RTOS_TIMEOUT;
+            break;
+        }
+    }
+    if (result == CY_RSLT_SUCCESS)
+    {
+        semaphore->count--;
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    return result;
+}
+
+cy_rslt_t cy_rtos_set_semaphore(cy_semaphore_t *semaphore, bool in_isr)
+{
+    (void)in_isr;
+
+    pthread_mutex_lock(&semaphore->mutex);
+    if (semaphore->count < semaphore->max_count)
+    {
+        semaphore->count++;
+    }
+    pthread_cond_signal(&semaphore->cond);
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    return CY_RSLT_SUCCESS;
+}
+
+static bool ota_test_timer_expired(const cy_timer_t *timer)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec > timer->deadline.tv_sec) ||
+           ((now.tv_sec == timer->deadline.tv_sec) && (now.tv_nsec >= timer->deadline.tv_nsec));
+}
+
+static void *ota_test_timer_main(void *arg)
+{
+    cy_timer_t *timer = (cy_timer_t *)arg;
+
+    pthread_mutex_lock(&timer->mutex);
+    while (true)
+    {
+        if (!timer->running)
+        {
+            pthread_cond_wait(&timer->cond, &timer->mutex);
+            continue;
+        }
+        /* Started again or stopped while waiting, look at the new deadline */
+        if (!ota_test_timer_expired(timer))
+        {
+            pthread_cond_timedwait(&timer->cond, &timer->mutex, &timer->deadline);
+            continue;
+        }
+        if (timer->type == CY_TIMER_TYPE_PERIODIC)
+        {
+            ota_test_deadline(CLOCK_MONOTONIC, timer->period_ms, &timer->deadline);
+        }
+        else
+        {
+            timer->running = false;
+        }
+        pthread_mutex_unlock(&timer->mutex);
+        timer->callback(timer->arg);
+        pthread_mutex_lock(&timer->mutex);
+    }
+    return NULL;
+}
+
+cy_rslt_t cy_rtos_init_timer(cy_timer_t *timer, cy_timer_trigger_type_t type, cy_timer_callback_t fun, cy_timer_callback_arg_t arg)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&timer->mutex, NULL);
+    pthread_cond_init(&timer->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    timer->type = type;
+    timer->callback = fun;
+    timer->arg = arg;
+    timer->running = false;
+
+    /* Timers are never deleted, the process ends with the run */
+    if (pthread_create(&timer->thread, NULL, ota_test_timer_main, timer) != 0)
+    {
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    pthread_detach(timer->thread);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_start_timer(cy_timer_t *timer, cy_time_t num_ms)
+{
+    pthread_mutex_lock(&timer->mutex);
+    timer->period_ms = num_ms;
+    ota_test_deadline(CLOCK_MONOTONIC, num_ms, &timer->deadline);
+    timer->running = true;
+    pthread_cond_signal(&timer->cond);
+    pthread_mutex_unlock(&timer->mutex);
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_stop_timer(cy_timer_t *timer)
+{
+    pthread_mutex_lock(&timer->mutex);
+    timer->running = false;
+    pthread_cond_signal(&timer->cond);
+    pthread_mutex_unlock(&timer->mutex);
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_get_time(cy_time_t *tval)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    *tval = (cy_time_t)(((uint64_t)now.tv_sec * 1000ULL) + ((uint64_t)now.tv_nsec / 1000000ULL));
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms)
+{
+    struct timespec delay;
+
+    delay.tv_sec = num_ms / 1000;
+    delay.tv_nsec = (long)(num_ms % 1000) * 1000000L;
+    while ((nanosleep(&delay, &delay) != 0) && (errno == EINTR))
+    {
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+uint32_t cyhal_system_critical_section_enter(void)
+{
+    if (ota_test_critical_depth++ == 0)
+    {
+        pthread_mutex_lock(&ota_test_critical);
+    }
+    return 0;
+}
+
+void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    (void)old_state;
+    if (--ota_test_critical_depth == 0)
+    {
+        pthread_mutex_unlock(&ota_test_critical);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: OTA session simulator. The application is built for the host
+ *              from main.c and source/COMPONENT_OTA_BLUETOOTH unchanged, with
+ *              the Bluetooth® stack, the OTA library and the board replaced by
+ *              the stand-ins of this directory. ota_sim_bench.c is the peer, it
+ *              runs an update through the GATT handler of the application and
+ *              reports the throughput, the CPU time and the heap.
+ */
+
+#ifndef __OTA_SIM_H__
+#define __OTA_SIM_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include "wiced_bt_gatt.h"
+#include "wiced_bt_dev.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+/* Flash geometry of the simulated upgrade slot */
+#define OTA_SIM_SECTOR_SIZE                 (4096)
+#define OTA_SIM_PAGE_SIZE                   (256)
+
+/* What the peer received from the device, only used from the stack thread */
+typedef struct
+{
+    uint32_t    write_rsps;             /* Write and Execute Write responses        */
+    uint32_t    error_rsps;
+    uint8_t     last_error;
+    uint32_t    notifications;
+    uint32_t    indications;
+    bool        indication_pending;     /* waits for GATT_HANDLE_VALUE_CONF         */
+    uint8_t     cp_value[8];            /* last value sent on the control point     */
+    uint16_t    cp_len;
+    uint16_t    mtu;
+} ota_sim_peer_t;
+
+/* Simulated upgrade slot, a file of CY_DS_SIZE bytes */
+typedef struct
+{
+    const char  *path;
+    uint32_t    erase_us;               /* per OTA_SIM_SECTOR_SIZE sector           */
+    uint32_t    program_us;             /* per OTA_SIM_PAGE_SIZE page               */
+    bool        erase_ahead;            /* the application erases, see app_ota_erase.h */
+} ota_sim_slot_config_t;
+
+typedef struct
+{
+    uint32_t    sectors_erased;
+    uint32_t    pages_programmed;
+    uint32_t    program_ops;
+    uint32_t    bytes_programmed;
+    uint32_t    program_errors;         /* a bit programmed from 0 to 1             */
+} ota_sim_slot_stats_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+extern ota_sim_peer_t ota_sim_peer;
+extern bool ota_sim_verbose;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+/* Bluetooth® stack, ota_sim_stack.c */
+bool ota_sim_stack_pump(uint32_t timeout_ms);
+
+wiced_bt_gatt_status_t ota_sim_stack_gatt_event(wiced_bt_gatt_evt_t event, wiced_bt_gatt_event_data_t *p_event_data);
+
+/* OTA library and upgrade slot, ota_sim_ota.c */
+cy_rslt_t ota_sim_slot_open(const ota_sim_slot_config_t *p_config);
+
+void ota_sim_slot_get_stats(ota_sim_slot_stats_t *p_stats);
+
+/* main() of main.c, renamed by the build */
+int ota_sim_app_main(void);
+
+/* Board, ota_sim_board.c */
+uint32_t ota_sim_resets(void);
+
+void ota_sim_heap_get(size_t *p_in_use, size_t *p_peak, bool reset);
+
+#endif      /* __OTA_SIM_H__ */
+
+/* [] END OF FILE */
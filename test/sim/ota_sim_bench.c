@@ -0,0 +1,396 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: OTA session benchmark on the host. Plays the peer of an update:
+ *              connects, runs PREPARE_DOWNLOAD, DOWNLOAD, the DATA writes and
+ *              VERIFY through the GATT handler of the application, confirms the
+ *              indication and waits for the reset. Reports the throughput, the CPU
+ *              time spent in the handler per DATA write and the peak heap.
+ *
+ *                ota_sim_bench [-s size] [-m mtu] [-f slot] [-e] [-u] [-E us] [-P us] [-r seed] [-v]
+ *
+ *                -s  image size, 262144 by default
+ *                -m  ATT MTU asked by the peer, 517 by default
+ *                -f  file of the upgrade slot, kept between runs
+ *                -e  the application erases the slot ahead of the data
+ *                -u  ask to skip the blocks the slot already holds, needs -e
+ *                -E  time of a sector erase in us, -P of a page program
+ *                -r  seed of the image, the same seed sends the same image
+ *                -v  print the log of the application
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_sim.h"
+#include "app_ota_crc32.h"
+#include "app_ota_protocol.h"
+#include "GeneratedSource/cycfg_gatt_db.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define OTA_SIM_BENCH_CONN_ID               (0x8001)
+#define OTA_SIM_BENCH_TIMEOUT_MS            (10000)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static uint8_t ota_sim_bench_addr[BD_ADDR_LEN] = { 0x00, 0xA0, 0x50, 0x0B, 0xE0, 0x01 };
+
+static struct
+{
+    uint32_t    writes;
+    uint32_t    deferred;               /* DATA writes answered after the handler returned */
+    uint64_t    handler_ns;             /* CPU time of the stack thread in the handler      */
+    uint64_t    handler_max_ns;
+} bench;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static uint64_t ota_sim_bench_ns(clockid_t clock)
+{
+    struct timespec now;
+
+    clock_gettime(clock, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static void ota_sim_bench_fill(uint8_t *p_buf, uint32_t len, uint32_t seed)
+{
+    uint32_t x = seed | 1;
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        p_buf[i] = (uint8_t)x;
+    }
+}
+
+/* Run what the application serialized to the stack thread, without waiting */
+static void ota_sim_bench_drain(void)
+{
+    while (ota_sim_stack_pump(0))
+    {
+    }
+}
+
+/* Run the stack thread until the counter moves past its value */
+static bool ota_sim_bench_wait(const volatile uint32_t *p_count, uint32_t count)
+{
+    uint64_t deadline = ota_sim_bench_ns(CLOCK_MONOTONIC) + (OTA_SIM_BENCH_TIMEOUT_MS * 1000000ULL);
+
+    while (*p_count == count)
+    {
+        if (ota_sim_bench_ns(CLOCK_MONOTONIC) > deadline)
+        {
+            return false;
+        }
+        (void)ota_sim_stack_pump(1);
+    }
+    return true;
+}
+
+static wiced_bt_gatt_status_t ota_sim_bench_write(uint16_t handle, uint8_t *p_val, uint16_t len)
+{
+    wiced_bt_gatt_event_data_t event_data;
+
+    memset(&event_data, 0x00, sizeof(event_data));
+    event_data.attribute_request.conn_id = OTA_SIM_BENCH_CONN_ID;
+    event_data.attribute_request.opcode = GATT_REQ_WRITE;
+    event_data.attribute_request.data.write_req.handle = handle;
+    event_data.attribute_request.data.write_req.p_val = p_val;
+    event_data.attribute_request.data.write_req.val_len = len;
+    return ota_sim_stack_gatt_event(GATT_ATTRIBUTE_REQUEST_EVT, &event_data);
+}
+
+/* A control point command, answered with a notification or an indication */
+static bool ota_sim_bench_command(uint8_t *p_val, uint16_t len, const volatile uint32_t *p_answers)
+{
+    uint32_t answers = *p_answers;
+    uint32_t write_rsps = ota_sim_peer.write_rsps;
+
+    if (ota_sim_bench_write(HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, p_val, len) != WICED_BT_GATT_SUCCESS)
+    {
+        fprintf(stderr, "command 0x%02x refused, error 0x%02x\n", p_val[0], ota_sim_peer.last_error);
+        return false;
+    }
+    if (!ota_sim_bench_wait(&ota_sim_peer.write_rsps, write_rsps) || !ota_sim_bench_wait(p_answers, answers))
+    {
+        fprintf(stderr, "command 0x%02x not answered\n", p_val[0]);
+        return false;
+    }
+    if ((ota_sim_peer.cp_len < 1) || (ota_sim_peer.cp_value[0] != CY_OTA_UPGRADE_STATUS_OK))
+    {
+        fprintf(stderr, "command 0x%02x failed, status 0x%02x\n", p_val[0], ota_sim_peer.cp_value[0]);
+        return false;
+    }
+    return true;
+}
+
+/* A DATA write, timed in the handler, then paced by its response like the peer app */
+static bool ota_sim_bench_data(uint8_t *p_val, uint16_t len)
+{
+    uint32_t write_rsps = ota_sim_peer.write_rsps;
+    uint32_t error_rsps = ota_sim_peer.error_rsps;
+    uint64_t start_ns = ota_sim_bench_ns(CLOCK_THREAD_CPUTIME_ID);
+    uint64_t handler_ns;
+
+    (void)ota_sim_bench_write(HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE, p_val, len);
+    handler_ns = ota_sim_bench_ns(CLOCK_THREAD_CPUTIME_ID) - start_ns;
+
+    bench.writes++;
+    bench.handler_ns += handler_ns;
+    if (handler_ns > bench.handler_max_ns)
+    {
+        bench.handler_max_ns = handler_ns;
+    }
+    if ((ota_sim_peer.write_rsps == write_rsps) && (ota_sim_peer.error_rsps == error_rsps))
+    {
+        /* The storage thread sends it once there is room, see app_bt_send_data_write_rsp() */
+        uint64_t deadline = ota_sim_bench_ns(CLOCK_MONOTONIC) + (OTA_SIM_BENCH_TIMEOUT_MS * 1000000ULL);
+
+        bench.deferred++;
+        while ((ota_sim_peer.write_rsps == write_rsps) && (ota_sim_peer.error_rsps == error_rsps) &&
+               (ota_sim_bench_ns(CLOCK_MONOTONIC) < deadline))
+        {
+            (void)ota_sim_stack_pump(1);
+        }
+    }
+    ota_sim_bench_drain();
+    if (ota_sim_peer.error_rsps != error_rsps)
+    {
+        fprintf(stderr, "DATA write %lu failed, error 0x%02x\n", (unsigned long)bench.writes, ota_sim_peer.last_error);
+        return false;
+    }
+    if (ota_sim_peer.write_rsps == write_rsps)
+    {
+        fprintf(stderr, "DATA write %lu not answered\n", (unsigned long)bench.writes);
+        return false;
+    }
+    return true;
+}
+
+static bool ota_sim_bench_connect(uint16_t mtu)
+{
+    wiced_bt_gatt_event_data_t event_data;
+    uint8_t cccd[2] = { GATT_CLIENT_CONFIG_NOTIFICATION | GATT_CLIENT_CONFIG_INDICATION, 0 };
+
+    memset(&event_data, 0x00, sizeof(event_data));
+    event_data.connection_status.bd_addr = ota_sim_bench_addr;
+    event_data.connection_status.addr_type = BLE_ADDR_PUBLIC;
+    event_data.connection_status.conn_id = OTA_SIM_BENCH_CONN_ID;
+    event_data.connection_status.connected = WICED_TRUE;
+    event_data.connection_status.transport = BT_TRANSPORT_LE;
+    event_data.connection_status.link_role = 1;
+    if (ota_sim_stack_gatt_event(GATT_CONNECTION_STATUS_EVT, &event_data) != WICED_BT_GATT_SUCCESS)
+    {
+        return false;
+    }
+
+    memset(&event_data, 0x00, sizeof(event_data));
+    event_data.attribute_request.conn_id = OTA_SIM_BENCH_CONN_ID;
+    event_data.attribute_request.opcode = GATT_REQ_MTU;
+    event_data.attribute_request.data.remote_mtu = mtu;
+    if (ota_sim_stack_gatt_event(GATT_ATTRIBUTE_REQUEST_EVT, &event_data) != WICED_BT_GATT_SUCCESS)
+    {
+        return false;
+    }
+
+    return (ota_sim_bench_write(HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG, cccd, sizeof(cccd)) == WICED_BT_GATT_SUCCESS);
+}
+
+static void ota_sim_bench_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-s size] [-m mtu] [-f slot] [-e] [-u] [-E us] [-P us] [-r seed] [-v]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    ota_sim_slot_config_t slot_config = { .path = "build/ota_sim_slot.bin", .erase_us = 0, .program_us = 0 };
+    ota_sim_slot_stats_t slot_stats;
+    wiced_bt_gatt_event_data_t event_data;
+    uint32_t image_size = 262144;
+    uint32_t seed = 1;
+    uint16_t mtu = 517;
+    bool skip_unchanged = false;
+    uint8_t *p_image;
+    uint8_t command[6];
+    uint32_t crc32;
+    uint32_t offset;
+    uint16_t chunk;
+    uint64_t session_start_ns;
+    uint64_t data_start_ns;
+    uint64_t data_end_ns;
+    uint64_t session_end_ns;
+    uint64_t data_cpu_ns;
+    size_t heap_boot;
+    size_t heap_in_use;
+    size_t heap_peak;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:m:f:euE:P:r:v")) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            image_size = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'm':
+            mtu = (uint16_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            slot_config.path = optarg;
+            break;
+        case 'e':
+            slot_config.erase_ahead = true;
+            break;
+        case 'u':
+            skip_unchanged = true;
+            break;
+        case 'E':
+            slot_config.erase_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'P':
+            slot_config.program_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'v':
+            ota_sim_verbose = true;
+            break;
+        default:
+            ota_sim_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+    if ((image_size == 0) || (image_size > CY_DS_SIZE) || (mtu <= (GATT_DEF_BLE_MTU_SIZE - 1)))
+    {
+        ota_sim_bench_usage(argv[0]);
+        return 2;
+    }
+
+    p_image = malloc(image_size);
+    if ((p_image == NULL) || (ota_sim_slot_open(&slot_config) != CY_RSLT_SUCCESS))
+    {
+        fprintf(stderr, "cannot open the slot %s\n", slot_config.path);
+        return 1;
+    }
+    ota_sim_bench_fill(p_image, image_size, seed);
+    crc32 = APP_OTA_CRC32_FINAL(app_ota_crc32_update(APP_OTA_CRC32_INIT, p_image, image_size));
+
+    /* Boot, BTM_ENABLED_EVT registers the GATT handler. The heap used so far is the peer's */
+    ota_sim_heap_get(&heap_boot, &heap_peak, true);
+    (void)ota_sim_app_main();
+    if (!ota_sim_stack_pump(OTA_SIM_BENCH_TIMEOUT_MS) || !ota_sim_bench_connect(mtu))
+    {
+        fprintf(stderr, "the application did not start\n");
+        return 1;
+    }
+    ota_sim_bench_drain();
+    chunk = (uint16_t)(ota_sim_peer.mtu - 3);
+
+    session_start_ns = ota_sim_bench_ns(CLOCK_MONOTONIC);
+    command[0] = CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD;
+    if (!ota_sim_bench_command(command, 1, &ota_sim_peer.notifications))
+    {
+        return 1;
+    }
+
+    command[0] = CY_OTA_UPGRADE_COMMAND_DOWNLOAD;
+    command[1] = (uint8_t)(image_size >> 0);
+    command[2] = (uint8_t)(image_size >> 8);
+    command[3] = (uint8_t)(image_size >> 16);
+    command[4] = (uint8_t)(image_size >> 24);
+    command[5] = skip_unchanged ? APP_OTA_DOWNLOAD_OPT_SKIP_UNCHANGED : 0;
+    if (!ota_sim_bench_command(command, 6, &ota_sim_peer.notifications))
+    {
+        return 1;
+    }
+
+    data_start_ns = ota_sim_bench_ns(CLOCK_MONOTONIC);
+    data_cpu_ns = ota_sim_bench_ns(CLOCK_PROCESS_CPUTIME_ID);
+    for (offset = 0; offset < image_size; offset += chunk)
+    {
+        if (!ota_sim_bench_data(&p_image[offset], (uint16_t)MIN(chunk, image_size - offset)))
+        {
+            return 1;
+        }
+    }
+    data_cpu_ns = ota_sim_bench_ns(CLOCK_PROCESS_CPUTIME_ID) - data_cpu_ns;
+    data_end_ns = ota_sim_bench_ns(CLOCK_MONOTONIC);
+
+    command[0] = CY_OTA_UPGRADE_COMMAND_VERIFY;
+    command[1] = (uint8_t)(crc32 >> 0);
+    command[2] = (uint8_t)(crc32 >> 8);
+    command[3] = (uint8_t)(crc32 >> 16);
+    command[4] = (uint8_t)(crc32 >> 24);
+    if (!ota_sim_bench_command(command, 5, &ota_sim_peer.indications))
+    {
+        return 1;
+    }
+    session_end_ns = ota_sim_bench_ns(CLOCK_MONOTONIC);
+
+    /* Confirm the indication, the application switches to the new image */
+    memset(&event_data, 0x00, sizeof(event_data));
+    event_data.attribute_request.conn_id = OTA_SIM_BENCH_CONN_ID;
+    event_data.attribute_request.opcode = GATT_HANDLE_VALUE_CONF;
+    event_data.attribute_request.data.confirm_handle = HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE;
+    ota_sim_peer.indication_pending = false;
+    (void)ota_sim_stack_gatt_event(GATT_ATTRIBUTE_REQUEST_EVT, &event_data);
+    while (ota_sim_resets() == 0)
+    {
+        if (ota_sim_bench_ns(CLOCK_MONOTONIC) > (session_end_ns + (OTA_SIM_BENCH_TIMEOUT_MS * 1000000ULL)))
+        {
+            fprintf(stderr, "no reset after the confirmation\n");
+            return 1;
+        }
+        (void)ota_sim_stack_pump(1);
+    }
+
+    ota_sim_heap_get(&heap_in_use, &heap_peak, false);
+    ota_sim_slot_get_stats(&slot_stats);
+    printf("image       %lu bytes, %lu DATA writes of %u bytes, ATT MTU %u\n", (unsigned long)image_size,
+           (unsigned long)bench.writes, chunk, ota_sim_peer.mtu);
+    printf("session     %.1f ms, %.0f bytes/s\n", (double)(session_end_ns - session_start_ns) / 1e6,
+           (double)image_size * 1e9 / (double)(session_end_ns - session_start_ns));
+    printf("data        %.1f ms, %.0f bytes/s\n", (double)(data_end_ns - data_start_ns) / 1e6,
+           (double)image_size * 1e9 / (double)(data_end_ns - data_start_ns));
+    printf("handler     %.2f us CPU per DATA write (max %.2f), %lu responses deferred\n",
+           (double)bench.handler_ns / 1e3 / bench.writes, (double)bench.handler_max_ns / 1e3, (unsigned long)bench.deferred);
+    printf("process     %.2f us CPU per DATA write, all threads\n", (double)data_cpu_ns / 1e3 / bench.writes);
+    printf("heap        %lu bytes peak, %lu in use at the reset, allocated after boot\n",
+           (unsigned long)(heap_peak - heap_boot), (unsigned long)(heap_in_use - heap_boot));
+    printf("slot        %lu sectors erased, %lu program operations, %lu pages, %lu bytes programmed\n",
+           (unsigned long)slot_stats.sectors_erased, (unsigned long)slot_stats.program_ops,
+           (unsigned long)slot_stats.pages_programmed, (unsigned long)slot_stats.bytes_programmed);
+
+    free(p_image);
+    return (slot_stats.program_errors == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the board of the OTA session simulator: the
+ *              BSP, the debug UART, the log, the LED task and the reset. The heap
+ *              is the one of the host C library, wrapped at link time to keep its
+ *              peak in use, see the bench target of test/Makefile.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_sim.h"
+#include "cybsp.h"
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "led_task.h"
+#include <malloc.h>
+#include <stdarg.h>
+
+/* The debug UART of the application, not the one of the simulator */
+#undef printf
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+bool ota_sim_verbose;
+
+cy_thread_t led_task_handle;
+
+static volatile uint32_t ota_sim_reset_count;
+
+static struct
+{
+    size_t  in_use;
+    size_t  peak;
+} ota_sim_heap;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+cy_rslt_t cybsp_init(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_retarget_io_init(int tx, int rx, uint32_t baudrate)
+{
+    (void)tx;
+    (void)rx;
+    (void)baudrate;
+
+    return CY_RSLT_SUCCESS;
+}
+
+int ota_sim_uart_printf(const char *fmt, ...)
+{
+    va_list args;
+    int len = 0;
+
+    if (ota_sim_verbose)
+    {
+        va_start(args, fmt);
+        len = vprintf(fmt, args);
+        va_end(args);
+    }
+    return len;
+}
+
+cy_rslt_t cy_log_init(CY_LOG_LEVEL_T level, void *platform_printf, void *platform_gettime)
+{
+    (void)level;
+    (void)platform_printf;
+    (void)platform_gettime;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void cy_log_msg(int facility, CY_LOG_LEVEL_T level, const char *fmt, ...)
+{
+    va_list args;
+
+    (void)facility;
+    (void)level;
+    if (ota_sim_verbose)
+    {
+        va_start(args, fmt);
+        vprintf(fmt, args);
+        va_end(args);
+    }
+}
+
+/* The board has no LED to blink */
+void led_task(cy_thread_arg_t arg)
+{
+    (void)arg;
+}
+
+/* The device starts the new image, the simulated one only counts it */
+void cyhal_system_reset_device(void)
+{
+    __atomic_add_fetch(&ota_sim_reset_count, 1, __ATOMIC_SEQ_CST);
+}
+
+uint32_t ota_sim_resets(void)
+{
+    return __atomic_load_n(&ota_sim_reset_count, __ATOMIC_SEQ_CST);
+}
+
+/*
+ * Heap of the host C library, -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+ */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static void ota_sim_heap_add(void *ptr)
+{
+    size_t in_use;
+    size_t peak;
+
+    if (ptr != NULL)
+    {
+        in_use = __atomic_add_fetch(&ota_sim_heap.in_use, malloc_usable_size(ptr), __ATOMIC_SEQ_CST);
+        peak = __atomic_load_n(&ota_sim_heap.peak, __ATOMIC_SEQ_CST);
+        while ((in_use > peak) &&
+               !__atomic_compare_exchange_n(&ota_sim_heap.peak, &peak, in_use, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+        {
+        }
+    }
+}
+
+static void ota_sim_heap_remove(void *ptr)
+{
+    if (ptr != NULL)
+    {
+        __atomic_sub_fetch(&ota_sim_heap.in_use, malloc_usable_size(ptr), __ATOMIC_SEQ_CST);
+    }
+}
+
+void *__wrap_malloc(size_t size)
+{
+    void *ptr = __real_malloc(size);
+
+    ota_sim_heap_add(ptr);
+    return ptr;
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    void *ptr = __real_calloc(nmemb, size);
+
+    ota_sim_heap_add(ptr);
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    void *new_ptr;
+
+    ota_sim_heap_remove(ptr);
+    new_ptr = __real_realloc(ptr, size);
+    /* On failure the old block is still there */
+    ota_sim_heap_add((new_ptr != NULL) ? new_ptr : ((size != 0) ? ptr : NULL));
+    return new_ptr;
+}
+
+void __wrap_free(void *ptr)
+{
+    ota_sim_heap_remove(ptr);
+    __real_free(ptr);
+}
+
+/*
+ * Function Name:
+ * ota_sim_heap_get
+ *
+ * Function Description:
+ * @brief  Heap in use and its peak since the last reset of the peak.
+ *
+ * @param p_in_use  bytes in use
+ * @param p_peak    highest bytes in use
+ * @param reset     start a new peak at what is in use now
+ *
+ * @return void
+ */
+void ota_sim_heap_get(size_t *p_in_use, size_t *p_peak, bool reset)
+{
+    *p_in_use = __atomic_load_n(&ota_sim_heap.in_use, __ATOMIC_SEQ_CST);
+    *p_peak = reset ? __atomic_exchange_n(&ota_sim_heap.peak, *p_in_use, __ATOMIC_SEQ_CST)
+                    : __atomic_load_n(&ota_sim_heap.peak, __ATOMIC_SEQ_CST);
+}
+
+/* [] END OF FILE */
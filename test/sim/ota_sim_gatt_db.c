@@ -0,0 +1,79 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the GATT database and the Bluetooth® settings
+ *              generated by the Bluetooth® Configurator, for the OTA session
+ *              simulator. Only the values the application keeps are here, the
+ *              simulated stack does not serve the database itself.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "GeneratedSource/cycfg_bt_settings.h"
+#include "GeneratedSource/cycfg_gap.h"
+#include "GeneratedSource/cycfg_gatt_db.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define OTA_SIM_GATT_VALUE_SIZE             (256)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+const uint8_t gatt_database[] =
+{
+    /* Primary service OTA FW UPGRADE SERVICE */
+    (uint8_t)(HDLS_OTA_FW_UPGRADE_SERVICE), (uint8_t)(HDLS_OTA_FW_UPGRADE_SERVICE >> 8),
+    __UUID_SERVICE_OTA_FW_UPGRADE_SERVICE,
+};
+const uint16_t gatt_database_len = sizeof(gatt_database);
+
+uint8_t app_gap_device_name[] = "OTA Sim";
+const uint16_t app_gap_device_name_len = sizeof(app_gap_device_name) - 1;
+
+static uint8_t app_gap_appearance[2];
+static uint8_t app_ota_control_point[4];
+static uint8_t app_ota_control_point_cccd[2];
+static uint8_t app_ota_data[CY_BT_RX_PDU_SIZE];
+static uint8_t app_ota_timing[OTA_SIM_GATT_VALUE_SIZE];
+static uint8_t app_ota_statistics[OTA_SIM_GATT_VALUE_SIZE];
+static uint8_t app_ota_statistics_cccd[2];
+static uint8_t app_ota_image_identity[OTA_SIM_GATT_VALUE_SIZE];
+
+gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[] =
+{
+    { HDLC_GAP_DEVICE_NAME_VALUE, sizeof(app_gap_device_name) - 1, sizeof(app_gap_device_name) - 1, app_gap_device_name },
+    { HDLC_GAP_APPEARANCE_VALUE, sizeof(app_gap_appearance), sizeof(app_gap_appearance), app_gap_appearance },
+    { HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, sizeof(app_ota_control_point), 0, app_ota_control_point },
+    { HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG, sizeof(app_ota_control_point_cccd), sizeof(app_ota_control_point_cccd), app_ota_control_point_cccd },
+    { HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE, sizeof(app_ota_data), 0, app_ota_data },
+    { HDLC_OTA_FW_UPGRADE_SERVICE_OTA_TIMING_VALUE, sizeof(app_ota_timing), 0, app_ota_timing },
+    { HDLC_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_VALUE, sizeof(app_ota_statistics), 0, app_ota_statistics },
+    { HDLD_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_CLIENT_CHAR_CONFIG, sizeof(app_ota_statistics_cccd), sizeof(app_ota_statistics_cccd), app_ota_statistics_cccd },
+    { HDLC_OTA_FW_UPGRADE_SERVICE_OTA_IMAGE_IDENTITY_VALUE, sizeof(app_ota_image_identity), 0, app_ota_image_identity },
+};
+const uint16_t app_gatt_db_ext_attr_tbl_size = sizeof(app_gatt_db_ext_attr_tbl) / sizeof(app_gatt_db_ext_attr_tbl[0]);
+
+const wiced_bt_cfg_settings_t cy_bt_cfg_settings =
+{
+    .device_name = app_gap_device_name,
+    .max_mtu = CY_BT_RX_PDU_SIZE,
+};
+
+/* [] END OF FILE */
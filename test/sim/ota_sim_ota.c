@@ -0,0 +1,367 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the OTA library and its storage, for the OTA
+ *              session simulator. The upgrade slot is a file of CY_DS_SIZE bytes
+ *              with the rules of a NOR flash: an erase sets a sector to 0xFF, a
+ *              program only clears bits. Both take the time set by the
+ *              ota_sim_slot_config_t, so the slot is as slow as the flash it models.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_sim.h"
+#include "cy_ota_internal.h"
+#include "cy_ota_storage_api.h"
+#include "app_ota_slot.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define OTA_SIM_SLOT_SIZE                   (CY_DS_SIZE)
+#define OTA_SIM_CONTEXT_TAG                 (0x07A51B00)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static cy_ota_context_t ota_sim_context;
+
+static struct
+{
+    int                     fd;
+    ota_sim_slot_config_t   config;
+    ota_sim_slot_stats_t    stats;
+} slot =
+{
+    .fd = -1,
+};
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static void ota_sim_slot_busy(uint32_t us)
+{
+    struct timespec busy = { .tv_sec = us / 1000000, .tv_nsec = (long)(us % 1000000) * 1000L };
+
+    while ((us != 0) && (nanosleep(&busy, &busy) != 0))
+    {
+    }
+}
+
+/*
+ * Set whole sectors of the slot to 0xFF
+ */
+static cy_rslt_t ota_sim_slot_erase(uint32_t offset, uint32_t len)
+{
+    uint8_t sector[OTA_SIM_SECTOR_SIZE];
+
+    if ((slot.fd < 0) || ((offset % OTA_SIM_SECTOR_SIZE) != 0) || ((len % OTA_SIM_SECTOR_SIZE) != 0) ||
+        (offset > OTA_SIM_SLOT_SIZE) || (len > (OTA_SIM_SLOT_SIZE - offset)))
+    {
+        return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+    }
+
+    memset(sector, 0xFF, sizeof(sector));
+    for (; len != 0; offset += OTA_SIM_SECTOR_SIZE, len -= OTA_SIM_SECTOR_SIZE)
+    {
+        if (pwrite(slot.fd, sector, sizeof(sector), offset) != (ssize_t)sizeof(sector))
+        {
+            return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+        }
+        slot.stats.sectors_erased++;
+        ota_sim_slot_busy(slot.config.erase_us);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+/*
+ * Function Name:
+ * ota_sim_slot_open
+ *
+ * Function Description:
+ * @brief  Open the file of the upgrade slot, created erased if it does not
+ *         exist. What a previous run wrote stays there, as on the flash.
+ *
+ * @param p_config  slot file, timing and erase support
+ *
+ * @return cy_rslt_t  CY_RSLT_SUCCESS, CY_RSLT_OTA_ERROR_OPEN_STORAGE
+ */
+cy_rslt_t ota_sim_slot_open(const ota_sim_slot_config_t *p_config)
+{
+    struct stat st;
+    ota_sim_slot_config_t config = *p_config;
+
+    slot.fd = open(config.path, O_RDWR | O_CREAT, 0644);
+    if ((slot.fd < 0) || (fstat(slot.fd, &st) != 0))
+    {
+        return CY_RSLT_OTA_ERROR_OPEN_STORAGE;
+    }
+    if (st.st_size != OTA_SIM_SLOT_SIZE)
+    {
+        /* A new slot comes out of the factory erased, not timed */
+        slot.config.erase_us = 0;
+        if ((ftruncate(slot.fd, OTA_SIM_SLOT_SIZE) != 0) ||
+            (ota_sim_slot_erase(0, OTA_SIM_SLOT_SIZE) != CY_RSLT_SUCCESS))
+        {
+            return CY_RSLT_OTA_ERROR_OPEN_STORAGE;
+        }
+    }
+    slot.config = config;
+    memset(&slot.stats, 0x00, sizeof(slot.stats));
+    return CY_RSLT_SUCCESS;
+}
+
+void ota_sim_slot_get_stats(ota_sim_slot_stats_t *p_stats)
+{
+    *p_stats = slot.stats;
+}
+
+/* The application erases the slot when the simulated board lets it */
+uint32_t app_ota_slot_upgrade_erase_size(void)
+{
+    return slot.config.erase_ahead ? OTA_SIM_SECTOR_SIZE : 0;
+}
+
+cy_rslt_t app_ota_slot_erase_upgrade(uint32_t offset, uint32_t len)
+{
+    return ota_sim_slot_erase(offset, len);
+}
+
+/* cy_ota_storage_open() clears the whole upgrade slot */
+cy_rslt_t cy_ota_storage_open(cy_ota_storage_context_t *storage_ptr)
+{
+    (void)storage_ptr;
+
+    return ota_sim_slot_erase(0, OTA_SIM_SLOT_SIZE);
+}
+
+cy_rslt_t cy_ota_storage_read(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_read_info_t *chunk_info)
+{
+    (void)storage_ptr;
+
+    if ((slot.fd < 0) || (chunk_info->offset > OTA_SIM_SLOT_SIZE) || (chunk_info->size > (OTA_SIM_SLOT_SIZE - chunk_info->offset)) ||
+        (pread(slot.fd, chunk_info->buffer, chunk_info->size, chunk_info->offset) != (ssize_t)chunk_info->size))
+    {
+        return CY_RSLT_OTA_ERROR_READ_STORAGE;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+/* A program only clears bits, setting one back needs an erase first */
+cy_rslt_t cy_ota_storage_write(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_write_info_t *chunk_info)
+{
+    uint8_t page[OTA_SIM_PAGE_SIZE];
+    uint32_t offset = chunk_info->offset;
+    uint32_t done = 0;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    (void)storage_ptr;
+
+    if ((slot.fd < 0) || (offset > OTA_SIM_SLOT_SIZE) || (chunk_info->size > (OTA_SIM_SLOT_SIZE - offset)))
+    {
+        return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+    }
+
+    slot.stats.program_ops++;
+    while (done < chunk_info->size)
+    {
+        uint32_t len = MIN(chunk_info->size - done, OTA_SIM_PAGE_SIZE - ((offset + done) % OTA_SIM_PAGE_SIZE));
+        uint32_t i;
+
+        if (pread(slot.fd, page, len, offset + done) != (ssize_t)len)
+        {
+            return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+        }
+        for (i = 0; i < len; i++)
+        {
+            if ((page[i] & chunk_info->buffer[done + i]) != chunk_info->buffer[done + i])
+            {
+                result = CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+            }
+            page[i] &= chunk_info->buffer[done + i];
+        }
+        if (pwrite(slot.fd, page, len, offset + done) != (ssize_t)len)
+        {
+            return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+        }
+        slot.stats.pages_programmed++;
+        ota_sim_slot_busy(slot.config.program_us);
+        done += len;
+    }
+    slot.stats.bytes_programmed += done;
+    if (result != CY_RSLT_SUCCESS)
+    {
+        slot.stats.program_errors++;
+    }
+    return result;
+}
+
+cy_rslt_t cy_ota_storage_close(cy_ota_storage_context_t *storage_ptr)
+{
+    (void)storage_ptr;
+
+    return (fsync(slot.fd) == 0) ? CY_RSLT_SUCCESS : CY_RSLT_OTA_ERROR_CLOSE_STORAGE;
+}
+
+cy_rslt_t cy_ota_storage_verify(cy_ota_storage_context_t *storage_ptr)
+{
+    (void)storage_ptr;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_storage_image_validate(uint32_t app_id, void *file_des)
+{
+    (void)app_id;
+    (void)file_des;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_storage_get_app_info(void *file_des, cy_ota_app_info_t *app_info)
+{
+    (void)file_des;
+
+    memset(app_info, 0x00, sizeof(*app_info));
+    return CY_RSLT_SUCCESS;
+}
+
+/* OTA library, only the Bluetooth® download path of the application */
+cy_rslt_t cy_ota_agent_start(cy_ota_network_params_t *network_params, cy_ota_agent_params_t *agent_params,
+                             cy_ota_storage_interface_t *storage_iface, cy_ota_context_ptr *ota_ptr)
+{
+    if (ota_sim_context.tag == OTA_SIM_CONTEXT_TAG)
+    {
+        return CY_RSLT_OTA_ERROR_ALREADY_STARTED;
+    }
+    memset(&ota_sim_context, 0x00, sizeof(ota_sim_context));
+    ota_sim_context.tag = OTA_SIM_CONTEXT_TAG;
+    ota_sim_context.curr_state = CY_OTA_STATE_AGENT_WAITING;
+    ota_sim_context.network_params = *network_params;
+    ota_sim_context.agent_params = *agent_params;
+    ota_sim_context.storage_iface = *storage_iface;
+    *ota_ptr = &ota_sim_context;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_agent_stop(cy_ota_context_ptr *ota_ptr)
+{
+    memset(&ota_sim_context, 0x00, sizeof(ota_sim_context));
+    *ota_ptr = NULL;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_get_state(cy_ota_context_ptr ota_ptr, cy_ota_agent_state_t *ota_state)
+{
+    *ota_state = (ota_ptr != NULL) ? ((cy_ota_context_t *)ota_ptr)->curr_state : CY_OTA_STATE_NOT_INITIALIZED;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_ble_download_prepare(cy_ota_context_ptr ota_ptr)
+{
+    return (ota_ptr == &ota_sim_context) ? CY_RSLT_SUCCESS : CY_RSLT_OTA_ERROR_BADARG;
+}
+
+cy_rslt_t cy_ota_ble_download(cy_ota_context_ptr ota_ptr, uint32_t total_size)
+{
+    cy_ota_context_t *ctx = (cy_ota_context_t *)ota_ptr;
+
+    if ((ctx != &ota_sim_context) || (total_size > OTA_SIM_SLOT_SIZE))
+    {
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+    ctx->ota_storage_context.total_image_size = total_size;
+    ctx->ota_storage_context.total_bytes_written = 0;
+    ctx->curr_state = CY_OTA_STATE_STORAGE_OPEN;
+    if (ctx->storage_iface.ota_file_open(&ctx->ota_storage_context) != CY_RSLT_SUCCESS)
+    {
+        return CY_RSLT_OTA_ERROR_OPEN_STORAGE;
+    }
+    ctx->curr_state = CY_OTA_STATE_STORAGE_WRITE;
+    return CY_RSLT_SUCCESS;
+}
+
+/* Each chunk goes where the previous one ended */
+cy_rslt_t cy_ota_ble_download_write(cy_ota_context_ptr ota_ptr, uint8_t *data_buf, uint16_t len, uint16_t offset)
+{
+    cy_ota_context_t *ctx = (cy_ota_context_t *)ota_ptr;
+    cy_ota_storage_write_info_t write_info;
+
+    if ((ctx != &ota_sim_context) || (offset > len))
+    {
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+    memset(&write_info, 0x00, sizeof(write_info));
+    write_info.offset = ctx->ota_storage_context.total_bytes_written;
+    write_info.buffer = &data_buf[offset];
+    write_info.size = (uint32_t)(len - offset);
+    if (ctx->storage_iface.ota_file_write(&ctx->ota_storage_context, &write_info) != CY_RSLT_SUCCESS)
+    {
+        return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+    }
+    ctx->ota_storage_context.total_bytes_written += write_info.size;
+    return CY_RSLT_SUCCESS;
+}
+
+/* The application checked the CRC32 or the signature, the library closes and validates */
+cy_rslt_t cy_ota_ble_download_verify(cy_ota_context_ptr ota_ptr, uint32_t final_crc32, bool verify_signature)
+{
+    cy_ota_context_t *ctx = (cy_ota_context_t *)ota_ptr;
+
+    (void)final_crc32;
+    (void)verify_signature;
+
+    if (ctx != &ota_sim_context)
+    {
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+    ctx->curr_state = CY_OTA_STATE_VERIFY;
+    if ((ctx->storage_iface.ota_file_close(&ctx->ota_storage_context) != CY_RSLT_SUCCESS) ||
+        (ctx->storage_iface.ota_file_validate(0, &ctx->ota_storage_context) != CY_RSLT_SUCCESS))
+    {
+        return CY_RSLT_OTA_ERROR_VERIFY;
+    }
+    ctx->curr_state = CY_OTA_STATE_OTA_COMPLETE;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_ble_download_abort(cy_ota_context_ptr *ota_ptr)
+{
+    cy_ota_context_t *ctx = (cy_ota_context_t *)*ota_ptr;
+
+    if (ctx == &ota_sim_context)
+    {
+        (void)ctx->storage_iface.ota_file_close(&ctx->ota_storage_context);
+    }
+    return cy_ota_agent_stop(ota_ptr);
+}
+
+cy_rslt_t cy_ota_set_log_level(CY_LOG_LEVEL_T level)
+{
+    (void)level;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,539 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the Bluetooth® stack, for the OTA session
+ *              simulator. The thread of ota_sim_bench.c plays the stack thread:
+ *              it calls the GATT handler of the application for the requests
+ *              of the peer and runs the serialized events in ota_sim_stack_pump().
+ *              What the application sends is recorded in ota_sim_peer.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_sim.h"
+#include "wiced_bt_ble.h"
+#include "wiced_bt_l2c.h"
+#include "wiced_bt_stack.h"
+#include "GeneratedSource/cycfg_gatt_db.h"
+#include <errno.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define OTA_SIM_STACK_QUEUE_SIZE            (64)
+
+typedef struct
+{
+    int     (*p_fn)(void *);
+    void    *data;
+} ota_sim_stack_event_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+ota_sim_peer_t ota_sim_peer;
+
+static struct
+{
+    pthread_mutex_t                     mutex;
+    pthread_cond_t                      cond;
+    ota_sim_stack_event_t               queue[OTA_SIM_STACK_QUEUE_SIZE];
+    uint32_t                            head;
+    uint32_t                            tail;
+    wiced_bt_management_cback_t         *p_management_cback;
+    wiced_bt_gatt_cback_t               *p_gatt_cback;
+    wiced_bt_gatt_buffer_transmitted_t  transmitted[OTA_SIM_STACK_QUEUE_SIZE];
+    uint32_t                            transmitted_next;
+    wiced_bt_dev_rssi_result_t          rssi;
+    wiced_bt_dev_cmpl_cback_t           *p_rssi_cback;
+} stack =
+{
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+};
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+wiced_result_t wiced_app_event_serialize(int (*p_fn)(void *), void *data)
+{
+    wiced_result_t result = WICED_BT_ERROR;
+
+    pthread_mutex_lock(&stack.mutex);
+    if ((stack.tail - stack.head) < OTA_SIM_STACK_QUEUE_SIZE)
+    {
+        stack.queue[stack.tail % OTA_SIM_STACK_QUEUE_SIZE].p_fn = p_fn;
+        stack.queue[stack.tail % OTA_SIM_STACK_QUEUE_SIZE].data = data;
+        stack.tail++;
+        pthread_cond_signal(&stack.cond);
+        result = WICED_SUCCESS;
+    }
+    pthread_mutex_unlock(&stack.mutex);
+
+    return result;
+}
+
+/*
+ * Function Name:
+ * ota_sim_stack_pump
+ *
+ * Function Description:
+ * @brief  Run the next serialized event in the calling thread, which plays
+ *         the Bluetooth® stack thread.
+ *
+ * @param timeout_ms  how long to wait for an event
+ *
+ * @return bool  true if an event was run
+ */
+bool ota_sim_stack_pump(uint32_t timeout_ms)
+{
+    ota_sim_stack_event_t event;
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&stack.mutex);
+    while (stack.head == stack.tail)
+    {
+        if (pthread_cond_timedwait(&stack.cond, &stack.mutex, &deadline) == ETIMEDOUT)
+        {
+            pthread_mutex_unlock(&stack.mutex);
+            return false;
+        }
+    }
+    event = stack.queue[stack.head % OTA_SIM_STACK_QUEUE_SIZE];
+    stack.head++;
+    pthread_mutex_unlock(&stack.mutex);
+
+    event.p_fn(event.data);
+    return true;
+}
+
+/*
+ * Function Name:
+ * ota_sim_stack_gatt_event
+ *
+ * Function Description:
+ * @brief  Pass a GATT event to the application. Like the stack, a request
+ *         the application fails is answered with an Error Response.
+ *
+ * @param event         GATT event
+ * @param p_event_data  event data
+ *
+ * @return wiced_bt_gatt_status_t  status returned by the application
+ */
+wiced_bt_gatt_status_t ota_sim_stack_gatt_event(wiced_bt_gatt_evt_t event, wiced_bt_gatt_event_data_t *p_event_data)
+{
+    wiced_bt_gatt_status_t status;
+
+    if (stack.p_gatt_cback == NULL)
+    {
+        return WICED_BT_GATT_WRONG_STATE;
+    }
+    status = stack.p_gatt_cback(event, p_event_data);
+
+    if ((event == GATT_ATTRIBUTE_REQUEST_EVT) && (status != WICED_BT_GATT_SUCCESS) &&
+        ((p_event_data->attribute_request.opcode == GATT_REQ_WRITE) || (p_event_data->attribute_request.opcode == GATT_REQ_MTU)))
+    {
+        wiced_bt_gatt_server_send_error_rsp(p_event_data->attribute_request.conn_id, p_event_data->attribute_request.opcode,
+                                            p_event_data->attribute_request.data.write_req.handle, status);
+    }
+    return status;
+}
+
+/*
+ * GATT_APP_BUFFER_TRANSMITTED_EVT for a buffer handed to the stack
+ */
+static int ota_sim_stack_transmitted_event(void *p_data)
+{
+    wiced_bt_gatt_event_data_t event_data;
+
+    event_data.buffer_xmitted = *(wiced_bt_gatt_buffer_transmitted_t *)p_data;
+    ota_sim_stack_gatt_event(GATT_APP_BUFFER_TRANSMITTED_EVT, &event_data);
+    return 0;
+}
+
+static void ota_sim_stack_transmit(uint8_t *p_data, uint16_t len, void *p_app_ctxt)
+{
+    wiced_bt_gatt_buffer_transmitted_t *p_xmitted = &stack.transmitted[stack.transmitted_next++ % OTA_SIM_STACK_QUEUE_SIZE];
+
+    p_xmitted->p_app_data = p_data;
+    p_xmitted->len = len;
+    p_xmitted->p_app_ctxt = p_app_ctxt;
+    wiced_app_event_serialize(ota_sim_stack_transmitted_event, p_xmitted);
+}
+
+static void ota_sim_stack_control_point(uint16_t attr_handle, uint16_t val_len, const uint8_t *p_val)
+{
+    if (attr_handle == HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE)
+    {
+        ota_sim_peer.cp_len = MIN(val_len, sizeof(ota_sim_peer.cp_value));
+        memcpy(ota_sim_peer.cp_value, p_val, ota_sim_peer.cp_len);
+    }
+}
+
+static int ota_sim_stack_enabled_event(void *p_data)
+{
+    wiced_bt_management_evt_data_t event_data;
+
+    (void)p_data;
+
+    memset(&event_data, 0x00, sizeof(event_data));
+    event_data.enabled.status = WICED_BT_SUCCESS;
+    stack.p_management_cback(BTM_ENABLED_EVT, &event_data);
+    return 0;
+}
+
+wiced_result_t wiced_bt_stack_init(wiced_bt_management_cback_t *p_bt_management_cback,
+                                   const wiced_bt_cfg_settings_t *p_bt_cfg_settings)
+{
+    (void)p_bt_cfg_settings;
+
+    stack.p_management_cback = p_bt_management_cback;
+    /* BTM_ENABLED_EVT comes from the stack thread */
+    return wiced_app_event_serialize(ota_sim_stack_enabled_event, NULL);
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback)
+{
+    stack.p_gatt_cback = p_gatt_cback;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db, uint16_t size, wiced_bt_db_hash_t hash)
+{
+    (void)p_gatt_db;
+    (void)size;
+    (void)hash;
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/* The simulated peer does not discover the database */
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle, wiced_bt_uuid_t *p_uuid)
+{
+    (void)s_handle;
+    (void)e_handle;
+    (void)p_uuid;
+
+    return 0;
+}
+
+int wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream, int stream_len, uint8_t *p_pair_len,
+                                                 uint16_t attr_handle, uint16_t attr_len, const uint8_t *p_attr)
+{
+    if (((*p_pair_len != 0) && (*p_pair_len != (attr_len + 2))) || (stream_len < (attr_len + 2)))
+    {
+        return 0;
+    }
+    *p_pair_len = (uint8_t)(attr_len + 2);
+    p_stream[0] = (uint8_t)(attr_handle >> 0);
+    p_stream[1] = (uint8_t)(attr_handle >> 8);
+    memcpy(&p_stream[2], p_attr, attr_len);
+    return attr_len + 2;
+}
+
+uint16_t wiced_bt_gatt_get_handle_from_stream(uint8_t *p_handle_stream, int index)
+{
+    return (uint16_t)(p_handle_stream[index * 2] | (p_handle_stream[(index * 2) + 1] << 8));
+}
+
+int wiced_bt_gatt_put_read_multi_rsp_in_stream(wiced_bt_gatt_opcode_t opcode, uint8_t *p_stream, int stream_len,
+                                               uint16_t attr_handle, uint16_t attr_len, const uint8_t *p_attr)
+{
+    int used = 0;
+
+    (void)attr_handle;
+
+    if (opcode == GATT_REQ_READ_MULTI_VAR_LENGTH)
+    {
+        if (stream_len < 2)
+        {
+            return 0;
+        }
+        p_stream[used++] = (uint8_t)(attr_len >> 0);
+        p_stream[used++] = (uint8_t)(attr_len >> 8);
+    }
+    attr_len = (uint16_t)MIN(attr_len, stream_len - used);
+    memcpy(&p_stream[used], p_attr, attr_len);
+    return used + attr_len;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(uint16_t conn_id, uint16_t attr_handle, uint16_t val_len,
+                                                              uint8_t *p_val, void *p_app_ctxt)
+{
+    (void)conn_id;
+
+    ota_sim_peer.notifications++;
+    ota_sim_stack_control_point(attr_handle, val_len, p_val);
+    ota_sim_stack_transmit(p_val, val_len, p_app_ctxt);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(uint16_t conn_id, uint16_t attr_handle, uint16_t val_len,
+                                                            uint8_t *p_val, void *p_app_ctxt)
+{
+    (void)conn_id;
+
+    ota_sim_peer.indications++;
+    ota_sim_peer.indication_pending = true;
+    ota_sim_stack_control_point(attr_handle, val_len, p_val);
+    ota_sim_stack_transmit(p_val, val_len, p_app_ctxt);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t handle)
+{
+    (void)conn_id;
+    (void)opcode;
+    (void)handle;
+
+    ota_sim_peer.write_rsps++;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_execute_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode)
+{
+    (void)conn_id;
+    (void)opcode;
+
+    ota_sim_peer.write_rsps++;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_prepare_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t handle,
+                                                                   uint16_t offset, uint16_t len, uint8_t *p_data, void *p_app_ctxt)
+{
+    (void)conn_id;
+    (void)opcode;
+    (void)handle;
+    (void)offset;
+
+    ota_sim_stack_transmit(p_data, len, p_app_ctxt);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t handle,
+                                                           wiced_bt_gatt_status_t status)
+{
+    (void)conn_id;
+    (void)opcode;
+    (void)handle;
+
+    ota_sim_peer.error_rsps++;
+    ota_sim_peer.last_error = (uint8_t)status;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id, uint16_t remote_mtu, uint16_t local_mtu)
+{
+    (void)conn_id;
+
+    ota_sim_peer.mtu = MIN(remote_mtu, local_mtu);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+                                                                 uint8_t *p_attr, void *p_app_ctxt)
+{
+    (void)conn_id;
+    (void)opcode;
+
+    ota_sim_stack_transmit(p_attr, len, p_app_ctxt);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint8_t type_len,
+                                                                  uint16_t data_len, uint8_t *p_data, void *p_app_ctxt)
+{
+    (void)conn_id;
+    (void)opcode;
+    (void)type_len;
+
+    ota_sim_stack_transmit(p_data, data_len, p_app_ctxt);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_multiple_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+                                                                   uint8_t *p_data, void *p_app_ctxt)
+{
+    (void)conn_id;
+    (void)opcode;
+
+    ota_sim_stack_transmit(p_data, len, p_app_ctxt);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_result_t wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                                             wiced_bt_ble_address_type_t directed_advertisement_bdaddr_type,
+                                             wiced_bt_device_address_t directed_advertisement_bdaddr_ptr)
+{
+    (void)advert_mode;
+    (void)directed_advertisement_bdaddr_type;
+    (void)directed_advertisement_bdaddr_ptr;
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_bt_ble_set_raw_advertisement_data(uint8_t num_elem, wiced_bt_ble_advert_elem_t *p_ble_advert_data)
+{
+    (void)num_elem;
+    (void)p_ble_advert_data;
+
+    return WICED_SUCCESS;
+}
+
+/* The connection of the simulated peer, 7.5 ms interval */
+wiced_result_t wiced_bt_ble_get_connection_parameters(wiced_bt_device_address_t remote_bda, wiced_bt_ble_conn_params_t *p_conn_parameters)
+{
+    (void)remote_bda;
+
+    memset(p_conn_parameters, 0x00, sizeof(*p_conn_parameters));
+    p_conn_parameters->conn_interval = 6;
+    p_conn_parameters->supervision_timeout = 500;
+    return WICED_BT_SUCCESS;
+}
+
+void wiced_bt_ble_security_grant(wiced_bt_device_address_t bd_addr, uint8_t res)
+{
+    (void)bd_addr;
+    (void)res;
+}
+
+wiced_result_t wiced_bt_ble_set_data_packet_length(wiced_bt_device_address_t bd_addr, uint16_t tx_pdu_length, uint16_t tx_time)
+{
+    (void)bd_addr;
+    (void)tx_pdu_length;
+    (void)tx_time;
+
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t wiced_bt_ble_set_phy(wiced_bt_ble_phy_preferences_t *p_phy_preferences)
+{
+    (void)p_phy_preferences;
+
+    return WICED_BT_SUCCESS;
+}
+
+void wiced_bt_dev_confirm_req_reply(wiced_result_t res, wiced_bt_device_address_t bd_addr)
+{
+    (void)res;
+    (void)bd_addr;
+}
+
+wiced_result_t wiced_bt_dev_add_device_to_address_resolution_db(wiced_bt_device_link_keys_t *p_link_keys)
+{
+    (void)p_link_keys;
+
+    return WICED_BT_SUCCESS;
+}
+
+static int ota_sim_stack_rssi_event(void *p_data)
+{
+    (void)p_data;
+
+    stack.p_rssi_cback(&stack.rssi);
+    return 0;
+}
+
+wiced_result_t wiced_bt_dev_read_rssi(wiced_bt_device_address_t remote_bda, wiced_bt_transport_t transport, wiced_bt_dev_cmpl_cback_t *p_cback)
+{
+    (void)transport;
+
+    stack.rssi.status = WICED_BT_SUCCESS;
+    stack.rssi.rssi = -50;
+    memcpy(stack.rssi.rem_bda, remote_bda, BD_ADDR_LEN);
+    stack.p_rssi_cback = p_cback;
+    return (wiced_app_event_serialize(ota_sim_stack_rssi_event, NULL) == WICED_SUCCESS) ? WICED_BT_PENDING : WICED_BT_ERROR;
+}
+
+wiced_result_t wiced_bt_set_pairable_mode(uint8_t allow_pairing, uint8_t connect_only_paired)
+{
+    (void)allow_pairing;
+    (void)connect_only_paired;
+
+    return WICED_BT_SUCCESS;
+}
+
+wiced_bool_t wiced_bt_l2cap_update_ble_conn_params(wiced_bt_device_address_t rem_bdRa, uint16_t min_int, uint16_t max_int,
+                                                   uint16_t latency, uint16_t timeout)
+{
+    (void)rem_bdRa;
+    (void)min_int;
+    (void)max_int;
+    (void)latency;
+    (void)timeout;
+
+    return WICED_TRUE;
+}
+
+/* The simulated peer does not open an LE credit based channel */
+uint16_t wiced_bt_l2cap_le_register(uint16_t le_psm, wiced_bt_l2cap_le_appl_information_t *p_cb_info, void *context)
+{
+    (void)p_cb_info;
+    (void)context;
+
+    return le_psm;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_connect_rsp(wiced_bt_device_address_t p_bd_addr, uint8_t id, uint16_t lcid, uint16_t result, uint16_t mtu_local)
+{
+    (void)p_bd_addr;
+    (void)id;
+    (void)lcid;
+    (void)result;
+    (void)mtu_local;
+
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_disconnect_req(uint16_t lcid)
+{
+    (void)lcid;
+
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_disconnect_rsp(uint16_t lcid)
+{
+    (void)lcid;
+
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_set_user_congestion(uint16_t lcid, wiced_bool_t is_congested)
+{
+    (void)lcid;
+    (void)is_congested;
+
+    return WICED_TRUE;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the Bluetooth® Configurator settings, for the
+ *              OTA session simulator.
+ */
+
+#ifndef __CYCFG_BT_SETTINGS_H__
+#define __CYCFG_BT_SETTINGS_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "wiced_bt_cfg.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define CY_BT_RX_PDU_SIZE                   (512)
+/* As app_bt_gatt_handler.h falls back to it, so both can be included */
+#define CY_BT_MTU_SIZE CY_BT_RX_PDU_SIZE
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+extern const wiced_bt_cfg_settings_t cy_bt_cfg_settings;
+
+#endif      /* __CYCFG_BT_SETTINGS_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the Bluetooth® Configurator GAP settings, for
+ *              the OTA session simulator.
+ */
+
+#ifndef __CYCFG_GAP_H__
+#define __CYCFG_GAP_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+extern uint8_t app_gap_device_name[];
+extern const uint16_t app_gap_device_name_len;
+
+#endif      /* __CYCFG_GAP_H__ */
+
+/* [] END OF FILE */
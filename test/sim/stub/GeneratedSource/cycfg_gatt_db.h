@@ -0,0 +1,79 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the Bluetooth® Configurator GATT database of
+ *              COMPONENT_OTA_BLUETOOTH_NON_SECURE/design.cybt, for the OTA
+ *              session simulator. The database is in ota_sim_gatt_db.c.
+ */
+
+#ifndef __CYCFG_GATT_DB_H__
+#define __CYCFG_GATT_DB_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define __UUID_SERVICE_OTA_FW_UPGRADE_SERVICE   0x1F, 0x38, 0xA1, 0x38, 0xAD, 0x82, 0x35, 0x86, 0xA0, 0x43, 0x13, 0x5C, 0x47, 0x1E, 0x5D, 0xAE
+
+/* Service Generic Access */
+#define HDLS_GAP                                                        0x0001
+#define HDLC_GAP_DEVICE_NAME                                            0x0002
+#define HDLC_GAP_DEVICE_NAME_VALUE                                      0x0003
+#define HDLC_GAP_APPEARANCE                                             0x0004
+#define HDLC_GAP_APPEARANCE_VALUE                                       0x0005
+
+/* Service Generic Attribute */
+#define HDLS_GATT                                                       0x0006
+
+/* Service OTA FW UPGRADE SERVICE */
+#define HDLS_OTA_FW_UPGRADE_SERVICE                                     0x0007
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT           0x0008
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE     0x0009
+#define HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG 0x000A
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA                    0x000B
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE              0x000C
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_TIMING                          0x000D
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_TIMING_VALUE                    0x000E
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS                      0x000F
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_VALUE                0x0010
+#define HDLD_OTA_FW_UPGRADE_SERVICE_OTA_STATISTICS_CLIENT_CHAR_CONFIG   0x0011
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_IMAGE_IDENTITY                  0x0012
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_IMAGE_IDENTITY_VALUE            0x0013
+
+typedef struct
+{
+    uint16_t handle;
+    uint16_t max_len;
+    uint16_t cur_len;
+    uint8_t  *p_data;
+} gatt_db_lookup_table_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+extern const uint8_t gatt_database[];
+extern const uint16_t gatt_database_len;
+extern gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[];
+extern const uint16_t app_gatt_db_ext_attr_tbl_size;
+
+#endif      /* __CYCFG_GATT_DB_H__ */
+
+/* [] END OF FILE */
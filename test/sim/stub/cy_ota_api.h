@@ -0,0 +1,207 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the OTA library API, for the OTA session
+ *              simulator. The Bluetooth® upgrade commands are those of the
+ *              library, the result codes and the other values are not.
+ */
+
+#ifndef __CY_OTA_API_H__
+#define __CY_OTA_API_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef uint32_t cy_rslt_t;
+typedef void *cy_ota_context_ptr;
+
+#define CY_RSLT_SUCCESS                     (0)
+#define CY_RSLT_OTA_ERROR_GENERAL           (0x01)
+#define CY_RSLT_OTA_ERROR_BADARG            (0x02)
+#define CY_RSLT_OTA_ERROR_WRITE_STORAGE     (0x03)
+#define CY_RSLT_OTA_ERROR_READ_STORAGE      (0x04)
+#define CY_RSLT_OTA_ERROR_VERIFY            (0x05)
+#define CY_RSLT_OTA_ERROR_OUT_OF_MEMORY     (0x06)
+#define CY_RSLT_OTA_ERROR_OPEN_STORAGE      (0x07)
+#define CY_RSLT_OTA_ERROR_CLOSE_STORAGE     (0x08)
+#define CY_RSLT_OTA_ERROR_ALREADY_STARTED   (0x09)
+
+#define CYLF_MIDDLEWARE                     (0)
+
+typedef enum
+{
+    CY_LOG_OFF,
+    CY_LOG_ERR,
+    CY_LOG_WARNING,
+    CY_LOG_NOTICE,
+    CY_LOG_INFO,
+    CY_LOG_DEBUG,
+    CY_LOG_MAX
+} CY_LOG_LEVEL_T;
+
+typedef enum
+{
+    CY_OTA_CONNECTION_UNKNOWN,
+    CY_OTA_CONNECTION_MQTT,
+    CY_OTA_CONNECTION_HTTP,
+    CY_OTA_CONNECTION_HTTPS,
+    CY_OTA_CONNECTION_BLE,
+} cy_ota_connection_t;
+
+typedef enum
+{
+    CY_OTA_JOB_FLOW,
+    CY_OTA_DIRECT_FLOW,
+} cy_ota_update_flow_t;
+
+typedef enum
+{
+    CY_OTA_STATE_NOT_INITIALIZED,
+    CY_OTA_STATE_EXITING,
+    CY_OTA_STATE_INITIALIZING,
+    CY_OTA_STATE_AGENT_STARTED,
+    CY_OTA_STATE_AGENT_WAITING,
+    CY_OTA_STATE_STORAGE_OPEN,
+    CY_OTA_STATE_STORAGE_WRITE,
+    CY_OTA_STATE_STORAGE_CLOSE,
+    CY_OTA_STATE_VERIFY,
+    CY_OTA_STATE_OTA_COMPLETE,
+    CY_OTA_NUM_STATES
+} cy_ota_agent_state_t;
+
+typedef enum
+{
+    CY_OTA_REASON_STATE_CHANGE,
+    CY_OTA_REASON_SUCCESS,
+    CY_OTA_REASON_FAILURE,
+    CY_OTA_LAST_REASON
+} cy_ota_cb_reason_t;
+
+typedef enum
+{
+    CY_OTA_CB_RSLT_OTA_CONTINUE,
+    CY_OTA_CB_RSLT_OTA_STOP,
+    CY_OTA_CB_RSLT_APP_SUCCESS,
+    CY_OTA_CB_RSLT_APP_FAILED,
+} cy_ota_callback_results_t;
+
+typedef struct
+{
+    cy_ota_connection_t     initial_connection;
+    cy_ota_update_flow_t    use_get_job_flow;
+} cy_ota_network_params_t;
+
+typedef struct
+{
+    uint8_t                 validate_after_reboot;
+} cy_ota_agent_params_t;
+
+/* Bluetooth® upgrade commands and status, written to and notified on the control point */
+#define CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD     (1)
+#define CY_OTA_UPGRADE_COMMAND_DOWNLOAD             (2)
+#define CY_OTA_UPGRADE_COMMAND_VERIFY               (3)
+#define CY_OTA_UPGRADE_COMMAND_FINISH               (4)
+#define CY_OTA_UPGRADE_COMMAND_GET_STATUS           (5)
+#define CY_OTA_UPGRADE_COMMAND_CLEAR_STATUS         (6)
+#define CY_OTA_UPGRADE_COMMAND_ABORT                (7)
+
+#define CY_OTA_UPGRADE_STATUS_OK                    (0)
+#define CY_OTA_UPGRADE_STATUS_BAD                   (1)
+
+typedef struct
+{
+    uint32_t    total_image_size;
+    uint32_t    total_bytes_written;
+    uint32_t    last_offset;
+    uint32_t    last_size;
+    uint16_t    last_packet_received;
+    uint16_t    total_packets;
+    void        *storage_loc;
+} cy_ota_storage_context_t;
+
+typedef struct
+{
+    uint32_t    offset;
+    uint8_t     *buffer;
+    uint32_t    size;
+    uint16_t    packet_number;
+    uint16_t    total_packets;
+} cy_ota_storage_write_info_t;
+
+typedef struct
+{
+    uint32_t    offset;
+    uint8_t     *buffer;
+    uint32_t    size;
+} cy_ota_storage_read_info_t;
+
+typedef struct
+{
+    uint16_t    app_id;
+    uint8_t     major;
+    uint8_t     minor;
+    uint8_t     build;
+} cy_ota_app_info_t;
+
+typedef struct
+{
+    cy_rslt_t (*ota_file_open)(cy_ota_storage_context_t *storage_ptr);
+    cy_rslt_t (*ota_file_read)(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_read_info_t *chunk_info);
+    cy_rslt_t (*ota_file_write)(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_write_info_t *chunk_info);
+    cy_rslt_t (*ota_file_close)(cy_ota_storage_context_t *storage_ptr);
+    cy_rslt_t (*ota_file_verify)(cy_ota_storage_context_t *storage_ptr);
+    cy_rslt_t (*ota_file_validate)(uint32_t app_id, void *file_des);
+    cy_rslt_t (*ota_file_get_app_info)(void *file_des, cy_ota_app_info_t *app_info);
+} cy_ota_storage_interface_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void cy_log_msg(int facility, CY_LOG_LEVEL_T level, const char *fmt, ...);
+
+cy_rslt_t cy_log_init(CY_LOG_LEVEL_T level, void *platform_printf, void *platform_gettime);
+
+cy_rslt_t cy_ota_set_log_level(CY_LOG_LEVEL_T level);
+
+cy_rslt_t cy_ota_agent_start(cy_ota_network_params_t *network_params, cy_ota_agent_params_t *agent_params,
+                             cy_ota_storage_interface_t *storage_iface, cy_ota_context_ptr *ota_ptr);
+
+cy_rslt_t cy_ota_agent_stop(cy_ota_context_ptr *ota_ptr);
+
+cy_rslt_t cy_ota_get_state(cy_ota_context_ptr ota_ptr, cy_ota_agent_state_t *ota_state);
+
+cy_rslt_t cy_ota_ble_download_prepare(cy_ota_context_ptr ota_ptr);
+
+cy_rslt_t cy_ota_ble_download(cy_ota_context_ptr ota_ptr, uint32_t total_size);
+
+cy_rslt_t cy_ota_ble_download_write(cy_ota_context_ptr ota_ptr, uint8_t *data_buf, uint16_t len, uint16_t offset);
+
+cy_rslt_t cy_ota_ble_download_verify(cy_ota_context_ptr ota_ptr, uint32_t final_crc32, bool verify_signature);
+
+cy_rslt_t cy_ota_ble_download_abort(cy_ota_context_ptr *ota_ptr);
+
+#endif      /* __CY_OTA_API_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the OTA library context, for the OTA session
+ *              simulator. Only the storage part the application reaches into.
+ */
+
+#ifndef __CY_OTA_INTERNAL_H__
+#define __CY_OTA_INTERNAL_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef struct
+{
+    uint32_t                    tag;
+    cy_ota_agent_state_t        curr_state;
+    cy_ota_network_params_t     network_params;
+    cy_ota_agent_params_t       agent_params;
+    cy_ota_storage_interface_t  storage_iface;
+    cy_ota_storage_context_t    ota_storage_context;
+} cy_ota_context_t;
+
+#endif      /* __CY_OTA_INTERNAL_H__ */
+
+/* [] END OF FILE */
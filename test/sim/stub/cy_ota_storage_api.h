@@ -0,0 +1,49 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the storage of the OTA library, for the OTA
+ *              session simulator. The upgrade slot is a file, see ota_sim_ota.c.
+ */
+
+#ifndef __CY_OTA_STORAGE_API_H__
+#define __CY_OTA_STORAGE_API_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+cy_rslt_t cy_ota_storage_open(cy_ota_storage_context_t *storage_ptr);
+
+cy_rslt_t cy_ota_storage_read(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_read_info_t *chunk_info);
+
+cy_rslt_t cy_ota_storage_write(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_write_info_t *chunk_info);
+
+cy_rslt_t cy_ota_storage_close(cy_ota_storage_context_t *storage_ptr);
+
+cy_rslt_t cy_ota_storage_verify(cy_ota_storage_context_t *storage_ptr);
+
+cy_rslt_t cy_ota_storage_image_validate(uint32_t app_id, void *file_des);
+
+cy_rslt_t cy_ota_storage_get_app_info(void *file_des, cy_ota_app_info_t *app_info);
+
+#endif      /* __CY_OTA_STORAGE_API_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for retarget-io, for the OTA session simulator.
+ *              Like retarget-io on the target, printf() of the application goes
+ *              to the debug UART, which ota_sim_board.c only prints with -v.
+ */
+
+#ifndef __CY_RETARGET_IO_H__
+#define __CY_RETARGET_IO_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdio.h>
+#include "cy_ota_api.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define CY_RETARGET_IO_BAUDRATE             (115200)
+
+#define printf(...)                         ota_sim_uart_printf(__VA_ARGS__)
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+cy_rslt_t cy_retarget_io_init(int tx, int rx, uint32_t baudrate);
+
+int ota_sim_uart_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#endif      /* __CY_RETARGET_IO_H__ */
+
+/* [] END OF FILE */
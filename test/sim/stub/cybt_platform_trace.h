@@ -0,0 +1,29 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the trace of the Bluetooth® platform, for the
+ *              OTA session simulator.
+ */
+
+#ifndef __CYBT_PLATFORM_TRACE_H__
+#define __CYBT_PLATFORM_TRACE_H__
+
+#include "cy_ota_api.h"
+
+#endif      /* __CYBT_PLATFORM_TRACE_H__ */
+
+/* [] END OF FILE */
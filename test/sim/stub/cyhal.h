@@ -0,0 +1,51 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the HAL, for the OTA session simulator. The
+ *              critical section is in ota_test_rtos.c, the reset of the device
+ *              in ota_sim_board.c.
+ */
+
+#ifndef __CYHAL_H__
+#define __CYHAL_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include <assert.h>
+#include "cy_ota_api.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define __DMB()                             __sync_synchronize()
+#define __enable_irq()                      ((void)0)
+#define CY_ASSERT(x)                        assert(x)
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+uint32_t cyhal_system_critical_section_enter(void);
+
+void cyhal_system_critical_section_exit(uint32_t old_state);
+
+void cyhal_system_reset_device(void);
+
+#endif      /* __CYHAL_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the LE part of the Bluetooth® stack device
+ *              manager API, for the OTA session simulator.
+ */
+
+#ifndef __WICED_BT_BLE_H__
+#define __WICED_BT_BLE_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "wiced_bt_types.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef enum
+{
+    BTM_BLE_ADVERT_OFF,
+    BTM_BLE_ADVERT_DIRECTED_HIGH,
+    BTM_BLE_ADVERT_DIRECTED_LOW,
+    BTM_BLE_ADVERT_UNDIRECTED_HIGH,
+    BTM_BLE_ADVERT_UNDIRECTED_LOW,
+    BTM_BLE_ADVERT_NONCONN_HIGH,
+    BTM_BLE_ADVERT_NONCONN_LOW,
+    BTM_BLE_ADVERT_DISCOVERABLE_HIGH,
+    BTM_BLE_ADVERT_DISCOVERABLE_LOW,
+} wiced_bt_ble_advert_mode_t;
+
+#define BTM_BLE_GENERAL_DISCOVERABLE_FLAG   (0x01 << 1)
+#define BTM_BLE_BREDR_NOT_SUPPORTED         (0x01 << 2)
+
+typedef enum
+{
+    BTM_BLE_ADVERT_TYPE_FLAG            = 0x01,
+    BTM_BLE_ADVERT_TYPE_NAME_COMPLETE   = 0x09,
+} wiced_bt_ble_advert_type_t;
+
+typedef struct
+{
+    uint8_t                     *p_data;
+    uint16_t                    len;
+    wiced_bt_ble_advert_type_t  advert_type;
+} wiced_bt_ble_advert_elem_t;
+
+typedef struct
+{
+    uint8_t     role;
+    uint16_t    conn_interval;
+    uint16_t    conn_latency;
+    uint16_t    supervision_timeout;
+} wiced_bt_ble_conn_params_t;
+
+typedef struct
+{
+    uint8_t                     status;
+    wiced_bt_device_address_t   bd_addr;
+    uint16_t                    conn_interval;
+    uint16_t                    conn_latency;
+    uint16_t                    supervision_timeout;
+} wiced_bt_ble_connection_param_update_t;
+
+#define BTM_BLE_PREFER_1M_PHY               (0x01)
+#define BTM_BLE_PREFER_2M_PHY               (0x02)
+#define BTM_BLE_PREFER_LELR_PHY             (0x04)
+
+#define BTM_BLE_PREFER_NO_LELR              (0x0000)
+#define BTM_BLE_PREFER_LELR_S2              (0x0001)
+#define BTM_BLE_PREFER_LELR_S8              (0x0002)
+
+typedef struct
+{
+    wiced_bt_device_address_t   remote_bd_addr;
+    uint8_t                     tx_phys;
+    uint8_t                     rx_phys;
+    uint16_t                    phy_opts;
+} wiced_bt_ble_phy_preferences_t;
+
+typedef struct
+{
+    uint8_t                     status;
+    wiced_bt_device_address_t   bd_addr;
+    uint8_t                     tx_phy;
+    uint8_t                     rx_phy;
+} wiced_bt_ble_phy_update_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+wiced_result_t wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                                             wiced_bt_ble_address_type_t directed_advertisement_bdaddr_type,
+                                             wiced_bt_device_address_t directed_advertisement_bdaddr_ptr);
+
+wiced_result_t wiced_bt_ble_set_raw_advertisement_data(uint8_t num_elem, wiced_bt_ble_advert_elem_t *p_ble_advert_data);
+
+wiced_result_t wiced_bt_ble_get_connection_parameters(wiced_bt_device_address_t remote_bda, wiced_bt_ble_conn_params_t *p_conn_parameters);
+
+void wiced_bt_ble_security_grant(wiced_bt_device_address_t bd_addr, uint8_t res);
+
+wiced_result_t wiced_bt_ble_set_data_packet_length(wiced_bt_device_address_t bd_addr, uint16_t tx_pdu_length, uint16_t tx_time);
+
+wiced_result_t wiced_bt_ble_set_phy(wiced_bt_ble_phy_preferences_t *p_phy_preferences);
+
+#endif      /* __WICED_BT_BLE_H__ */
+
+/* [] END OF FILE */
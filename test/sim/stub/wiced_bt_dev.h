@@ -0,0 +1,214 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the device manager part of the Bluetooth®
+ *              stack API, for the OTA session simulator. Only the management
+ *              events and the fields the application uses.
+ */
+
+#ifndef __WICED_BT_DEV_H__
+#define __WICED_BT_DEV_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "wiced_bt_types.h"
+#include "wiced_bt_ble.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef wiced_result_t wiced_bt_dev_status_t;
+
+typedef enum
+{
+    BTM_ENABLED_EVT,
+    BTM_DISABLED_EVT,
+    BTM_POWER_MANAGEMENT_STATUS_EVT,
+    BTM_PIN_REQUEST_EVT,
+    BTM_USER_CONFIRMATION_REQUEST_EVT,
+    BTM_PASSKEY_NOTIFICATION_EVT,
+    BTM_PASSKEY_REQUEST_EVT,
+    BTM_KEYPRESS_NOTIFICATION_EVT,
+    BTM_PAIRING_IO_CAPABILITIES_BR_EDR_REQUEST_EVT,
+    BTM_PAIRING_IO_CAPABILITIES_BR_EDR_RESPONSE_EVT,
+    BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT,
+    BTM_PAIRING_COMPLETE_EVT,
+    BTM_ENCRYPTION_STATUS_EVT,
+    BTM_SECURITY_REQUEST_EVT,
+    BTM_SECURITY_FAILED_EVT,
+    BTM_SECURITY_ABORTED_EVT,
+    BTM_READ_LOCAL_OOB_DATA_COMPLETE_EVT,
+    BTM_REMOTE_OOB_DATA_REQUEST_EVT,
+    BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT,
+    BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT,
+    BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT,
+    BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT,
+    BTM_BLE_SCAN_STATE_CHANGED_EVT,
+    BTM_BLE_ADVERT_STATE_CHANGED_EVT,
+    BTM_SMP_REMOTE_OOB_DATA_REQUEST_EVT,
+    BTM_SMP_SC_REMOTE_OOB_DATA_REQUEST_EVT,
+    BTM_SMP_SC_LOCAL_OOB_DATA_NOTIFICATION_EVT,
+    BTM_SCO_CONNECTED_EVT,
+    BTM_SCO_DISCONNECTED_EVT,
+    BTM_SCO_CONNECTION_REQUEST_EVT,
+    BTM_SCO_CONNECTION_CHANGE_EVT,
+    BTM_BLE_CONNECTION_PARAM_UPDATE,
+    BTM_BLE_PHY_UPDATE_EVT,
+} wiced_bt_management_evt_t;
+
+typedef enum
+{
+    SMP_SUCCESS,
+    SMP_PASSKEY_ENTRY_FAIL,
+    SMP_OOB_FAIL,
+    SMP_PAIR_AUTH_FAIL,
+    SMP_CONFIRM_VALUE_ERR,
+    SMP_PAIR_NOT_SUPPORT,
+    SMP_ENC_KEY_SIZE,
+    SMP_INVALID_CMD,
+    SMP_PAIR_FAIL_UNKNOWN,
+    SMP_REPEATED_ATTEMPTS,
+    SMP_INVALID_PARAMETERS,
+    SMP_DHKEY_CHK_FAIL,
+    SMP_NUMERIC_COMPAR_FAIL,
+    SMP_BR_PAIRING_IN_PROGR,
+    SMP_XTRANS_DERIVE_NOT_ALLOW,
+    SMP_PAIR_INTERNAL_ERR,
+    SMP_UNKNOWN_IO_CAP,
+    SMP_INIT_FAIL,
+    SMP_CONFIRM_FAIL,
+    SMP_BUSY,
+    SMP_ENC_FAIL,
+    SMP_STARTED,
+    SMP_RSP_TIMEOUT,
+    SMP_FAIL,
+    SMP_CONN_TOUT,
+} wiced_bt_smp_status_t;
+
+#define BTM_IO_CAPABILITIES_NONE            (3)
+#define BTM_OOB_NONE                        (0)
+#define BTM_LE_AUTH_REQ_BOND                (0x01)
+#define BTM_LE_AUTH_REQ_MITM                (0x04)
+#define BTM_LE_KEY_PENC                     (0x01)
+#define BTM_LE_KEY_PID                      (0x02)
+
+typedef struct
+{
+    wiced_bt_device_address_t   bd_addr;
+    uint8_t                     key_data[80];
+} wiced_bt_device_link_keys_t;
+
+typedef struct
+{
+    uint8_t                     key_type_mask;
+    uint8_t                     local_key_data[40];
+} wiced_bt_local_identity_keys_t;
+
+typedef struct
+{
+    wiced_result_t              status;
+    uint8_t                     reason;
+    uint8_t                     sec_level;
+    wiced_bool_t                is_pair_cancel;
+    wiced_bt_device_address_t   resolved_bd_addr;
+    wiced_bt_ble_address_type_t resolved_bd_addr_type;
+} wiced_bt_dev_ble_pairing_info_t;
+
+typedef struct
+{
+    wiced_bt_device_address_t   bd_addr;
+    wiced_bt_transport_t        transport;
+    void                        *p_ref_data;
+    wiced_result_t              result;
+} wiced_bt_dev_encryption_status_t;
+
+typedef struct
+{
+    wiced_result_t              status;
+    uint8_t                     hci_status;
+    int8_t                      rssi;
+    wiced_bt_device_address_t   rem_bda;
+} wiced_bt_dev_rssi_result_t;
+
+typedef void (wiced_bt_dev_cmpl_cback_t)(void *p_data);
+
+typedef union
+{
+    struct
+    {
+        wiced_result_t          status;
+    } enabled;
+    struct
+    {
+        wiced_bt_device_address_t bd_addr;
+        uint32_t                numeric_value;
+    } user_confirmation_request;
+    struct
+    {
+        wiced_bt_device_address_t bd_addr;
+        uint32_t                passkey;
+    } user_passkey_notification;
+    struct
+    {
+        wiced_bt_device_address_t bd_addr;
+        uint8_t                 local_io_cap;
+        uint8_t                 oob_data;
+        uint8_t                 auth_req;
+        uint8_t                 max_key_size;
+        uint8_t                 init_keys;
+        uint8_t                 resp_keys;
+    } pairing_io_capabilities_ble_request;
+    struct
+    {
+        wiced_bt_device_address_t bd_addr;
+        wiced_bt_transport_t    transport;
+        union
+        {
+            wiced_bt_dev_ble_pairing_info_t ble;
+        } pairing_complete_info;
+    } pairing_complete;
+    wiced_bt_dev_encryption_status_t        encryption_status;
+    struct
+    {
+        wiced_bt_device_address_t bd_addr;
+    } security_request;
+    wiced_bt_device_link_keys_t             paired_device_link_keys_update;
+    wiced_bt_device_link_keys_t             paired_device_link_keys_request;
+    wiced_bt_local_identity_keys_t          local_identity_keys_update;
+    wiced_bt_local_identity_keys_t          local_identity_keys_request;
+    wiced_bt_ble_advert_mode_t              ble_advert_state_changed;
+    wiced_bt_ble_connection_param_update_t  ble_connection_param_update;
+    wiced_bt_ble_phy_update_t               ble_phy_update_event;
+} wiced_bt_management_evt_data_t;
+
+typedef wiced_result_t (wiced_bt_management_cback_t)(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void wiced_bt_dev_confirm_req_reply(wiced_result_t res, wiced_bt_device_address_t bd_addr);
+
+wiced_result_t wiced_bt_dev_add_device_to_address_resolution_db(wiced_bt_device_link_keys_t *p_link_keys);
+
+wiced_result_t wiced_bt_dev_read_rssi(wiced_bt_device_address_t remote_bda, wiced_bt_transport_t transport, wiced_bt_dev_cmpl_cback_t *p_cback);
+
+wiced_result_t wiced_bt_set_pairable_mode(uint8_t allow_pairing, uint8_t connect_only_paired);
+
+#endif      /* __WICED_BT_DEV_H__ */
+
+/* [] END OF FILE */
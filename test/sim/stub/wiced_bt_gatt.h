@@ -0,0 +1,266 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the GATT server part of the Bluetooth® stack
+ *              API, for the OTA session simulator. The opcodes are those of the
+ *              ATT protocol, the other values are not those of the stack.
+ */
+
+#ifndef __WICED_BT_GATT_H__
+#define __WICED_BT_GATT_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "wiced_bt_types.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define GATT_DEF_BLE_MTU_SIZE               (23)
+
+#define GATT_CLIENT_CONFIG_NOTIFICATION     (0x0001)
+#define GATT_CLIENT_CONFIG_INDICATION       (0x0002)
+
+#define GATT_PREPARE_WRITE_CANCEL           (0x00)
+#define GATT_PREPARE_WRITE_EXEC             (0x01)
+
+typedef enum
+{
+    WICED_BT_GATT_SUCCESS               = 0x00,
+    WICED_BT_GATT_INVALID_HANDLE        = 0x01,
+    WICED_BT_GATT_READ_NOT_PERMIT       = 0x02,
+    WICED_BT_GATT_WRITE_NOT_PERMIT      = 0x03,
+    WICED_BT_GATT_INVALID_PDU           = 0x04,
+    WICED_BT_GATT_INSUF_AUTHENTICATION  = 0x05,
+    WICED_BT_GATT_REQ_NOT_SUPPORTED     = 0x06,
+    WICED_BT_GATT_INVALID_OFFSET        = 0x07,
+    WICED_BT_GATT_INSUF_AUTHORIZATION   = 0x08,
+    WICED_BT_GATT_PREPARE_Q_FULL        = 0x09,
+    WICED_BT_GATT_ATTRIBUTE_NOT_FOUND   = 0x0A,
+    WICED_BT_GATT_NOT_LONG              = 0x0B,
+    WICED_BT_GATT_INSUF_KEY_SIZE        = 0x0C,
+    WICED_BT_GATT_INVALID_ATTR_LEN      = 0x0D,
+    WICED_BT_GATT_ERR_UNLIKELY          = 0x0E,
+    WICED_BT_GATT_INSUF_ENCRYPTION      = 0x0F,
+    WICED_BT_GATT_UNSUPPORT_GRP_TYPE    = 0x10,
+    WICED_BT_GATT_INSUF_RESOURCE        = 0x11,
+    WICED_BT_GATT_DATABASE_OUT_OF_SYNC  = 0x12,
+    WICED_BT_GATT_VALUE_NOT_ALLOWED     = 0x13,
+    WICED_BT_GATT_NO_RESOURCES          = 0x80,
+    WICED_BT_GATT_INTERNAL_ERROR        = 0x81,
+    WICED_BT_GATT_WRONG_STATE           = 0x82,
+    WICED_BT_GATT_DB_FULL               = 0x83,
+    WICED_BT_GATT_BUSY                  = 0x84,
+    WICED_BT_GATT_ERROR                 = 0x85,
+    WICED_BT_GATT_CMD_STARTED           = 0x86,
+    WICED_BT_GATT_ILLEGAL_PARAMETER     = 0x87,
+    WICED_BT_GATT_PENDING               = 0x88,
+    WICED_BT_GATT_AUTH_FAIL             = 0x89,
+    WICED_BT_GATT_MORE                  = 0x8A,
+    WICED_BT_GATT_INVALID_CFG           = 0x8B,
+    WICED_BT_GATT_SERVICE_STARTED       = 0x8C,
+    WICED_BT_GATT_ENCRYPTED_MITM        = WICED_BT_GATT_SUCCESS,
+    WICED_BT_GATT_ENCRYPTED_NO_MITM     = 0x8E,
+    WICED_BT_GATT_NOT_ENCRYPTED         = 0x8F,
+    WICED_BT_GATT_CONGESTED             = 0x90,
+    WICED_BT_GATT_NOT_ALLOWED           = 0x91,
+    WICED_BT_GATT_HANDLED               = 0x92,
+    WICED_BT_GATT_NO_PENDING_OPERATION  = 0x93,
+    WICED_BT_GATT_INDICATION_RESPONSE_PENDING = 0x94,
+    WICED_BT_GATT_INVALID_CONNECTION_ID = 0x95,
+    WICED_BT_GATT_BAD_OPCODE            = 0x96,
+    WICED_BT_GATT_WRITE_REQ_REJECTED    = 0xFC,
+    WICED_BT_GATT_CCC_CFG_ERR           = 0xFD,
+    WICED_BT_GATT_PRC_IN_PROGRESS       = 0xFE,
+    WICED_BT_GATT_OUT_OF_RANGE          = 0xFF,
+} wiced_bt_gatt_status_t;
+
+typedef enum
+{
+    GATT_REQ_MTU                        = 0x02,
+    GATT_REQ_READ_BY_TYPE               = 0x08,
+    GATT_REQ_READ                       = 0x0A,
+    GATT_REQ_READ_BLOB                  = 0x0C,
+    GATT_REQ_READ_MULTI                 = 0x0E,
+    GATT_REQ_WRITE                      = 0x12,
+    GATT_REQ_PREPARE_WRITE              = 0x16,
+    GATT_REQ_EXECUTE_WRITE              = 0x18,
+    GATT_HANDLE_VALUE_NOTIF             = 0x1B,
+    GATT_HANDLE_VALUE_CONF              = 0x1E,
+    GATT_REQ_READ_MULTI_VAR_LENGTH      = 0x20,
+    GATT_CMD_WRITE                      = 0x52,
+    GATT_CMD_SIGNED_WRITE               = 0xD2,
+} wiced_bt_gatt_opcode_t;
+
+typedef enum
+{
+    GATT_CONNECTION_STATUS_EVT,
+    GATT_OPERATION_CPLT_EVT,
+    GATT_DISCOVERY_RESULT_EVT,
+    GATT_DISCOVERY_CPLT_EVT,
+    GATT_ATTRIBUTE_REQUEST_EVT,
+    GATT_CONGESTION_EVT,
+    GATT_GET_RESPONSE_BUFFER_EVT,
+    GATT_APP_BUFFER_TRANSMITTED_EVT,
+} wiced_bt_gatt_evt_t;
+
+typedef enum
+{
+    GATT_CONN_UNKNOWN                   = 0x0000,
+    GATT_CONN_L2C_FAILURE               = 0x0001,
+    GATT_CONN_TIMEOUT                   = 0x0008,
+    GATT_CONN_TERMINATE_PEER_USER       = 0x0013,
+    GATT_CONN_TERMINATE_LOCAL_HOST      = 0x0016,
+    GATT_CONN_LMP_TIMEOUT               = 0x0022,
+    GATT_CONN_FAIL_ESTABLISH            = 0x003E,
+    GATT_CONN_CANCEL                    = 0x0100,
+} wiced_bt_gatt_disconn_reason_t;
+
+typedef uint8_t wiced_bt_db_hash_t[16];
+
+typedef struct
+{
+    uint16_t    handle;
+    uint16_t    offset;
+} wiced_bt_gatt_read_t;
+
+typedef struct
+{
+    uint16_t        s_handle;
+    uint16_t        e_handle;
+    wiced_bt_uuid_t uuid;
+} wiced_bt_gatt_read_by_type_t;
+
+typedef struct
+{
+    int         num_handles;
+    uint8_t     *p_handle_stream;
+} wiced_bt_gatt_read_multiple_req_t;
+
+typedef struct
+{
+    uint16_t    handle;
+    uint16_t    offset;
+    uint16_t    val_len;
+    uint8_t     *p_val;
+} wiced_bt_gatt_write_req_t;
+
+typedef struct
+{
+    uint16_t                conn_id;
+    wiced_bt_gatt_opcode_t  opcode;
+    union
+    {
+        wiced_bt_gatt_read_t                read_req;
+        wiced_bt_gatt_write_req_t           write_req;
+        uint16_t                            remote_mtu;
+        uint8_t                             exec_write;
+        uint16_t                            confirm_handle;
+        wiced_bt_gatt_read_by_type_t        read_by_type;
+        wiced_bt_gatt_read_multiple_req_t   read_multiple_req;
+    } data;
+    uint16_t                len_requested;
+} wiced_bt_gatt_attribute_request_t;
+
+typedef struct
+{
+    uint8_t                         *bd_addr;
+    wiced_bt_ble_address_type_t     addr_type;
+    uint16_t                        conn_id;
+    wiced_bool_t                    connected;
+    wiced_bt_gatt_disconn_reason_t  reason;
+    wiced_bt_transport_t            transport;
+    uint8_t                         link_role;
+} wiced_bt_gatt_connection_status_t;
+
+typedef struct
+{
+    uint8_t     *p_app_rsp_buffer;
+    void        *p_app_ctxt;
+} wiced_bt_gatt_buffer_t;
+
+typedef struct
+{
+    uint16_t                len_requested;
+    wiced_bt_gatt_buffer_t  buffer;
+} wiced_bt_gatt_buffer_request_t;
+
+typedef struct
+{
+    uint8_t     *p_app_data;
+    uint16_t    len;
+    void        *p_app_ctxt;
+} wiced_bt_gatt_buffer_transmitted_t;
+
+typedef union
+{
+    wiced_bt_gatt_connection_status_t   connection_status;
+    wiced_bt_gatt_attribute_request_t   attribute_request;
+    wiced_bt_gatt_buffer_request_t      buffer_request;
+    wiced_bt_gatt_buffer_transmitted_t  buffer_xmitted;
+} wiced_bt_gatt_event_data_t;
+
+typedef wiced_bt_gatt_status_t (wiced_bt_gatt_cback_t)(wiced_bt_gatt_evt_t event, wiced_bt_gatt_event_data_t *p_event_data);
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db, uint16_t size, wiced_bt_db_hash_t hash);
+
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle, wiced_bt_uuid_t *p_uuid);
+
+int wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream, int stream_len, uint8_t *p_pair_len,
+                                                 uint16_t attr_handle, uint16_t attr_len, const uint8_t *p_attr);
+
+uint16_t wiced_bt_gatt_get_handle_from_stream(uint8_t *p_handle_stream, int index);
+
+int wiced_bt_gatt_put_read_multi_rsp_in_stream(wiced_bt_gatt_opcode_t opcode, uint8_t *p_stream, int stream_len,
+                                               uint16_t attr_handle, uint16_t attr_len, const uint8_t *p_attr);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(uint16_t conn_id, uint16_t attr_handle, uint16_t val_len,
+                                                              uint8_t *p_val, void *p_app_ctxt);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(uint16_t conn_id, uint16_t attr_handle, uint16_t val_len,
+                                                            uint8_t *p_val, void *p_app_ctxt);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t handle);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_execute_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_prepare_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t handle,
+                                                                   uint16_t offset, uint16_t len, uint8_t *p_data, void *p_app_ctxt);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t handle,
+                                                           wiced_bt_gatt_status_t status);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id, uint16_t remote_mtu, uint16_t local_mtu);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+                                                                 uint8_t *p_attr, void *p_app_ctxt);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint8_t type_len,
+                                                                  uint16_t data_len, uint8_t *p_data, void *p_app_ctxt);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_multiple_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+                                                                   uint8_t *p_data, void *p_app_ctxt);
+
+#endif      /* __WICED_BT_GATT_H__ */
+
+/* [] END OF FILE */
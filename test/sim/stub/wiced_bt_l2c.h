@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the L2CAP part of the Bluetooth® stack API,
+ *              for the OTA session simulator. No LE credit based channel is
+ *              opened by the simulated peer.
+ */
+
+#ifndef __WICED_BT_L2C_H__
+#define __WICED_BT_L2C_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "wiced_bt_types.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define L2CAP_LE_RESULT_CONN_OK             (0)
+#define L2CAP_LE_RESULT_NO_RESOURCES        (4)
+
+typedef struct
+{
+    void (*le_connected_indication_cback)(void *context, wiced_bt_device_address_t bd_addr, uint16_t lcid, uint16_t psm, uint8_t id, uint16_t mtu_peer);
+    void (*le_connected_confirmation_cback)(void *context, uint16_t lcid, uint16_t result, uint16_t mtu_peer);
+    void (*le_disconnect_indication_cback)(void *context, uint16_t lcid, wiced_bool_t ack);
+    void (*le_disconnect_confirmation_cback)(void *context, uint16_t lcid, uint16_t result);
+    void (*le_data_indication_cback)(void *context, uint16_t lcid, uint8_t *p_buff, uint16_t buf_len);
+    void (*le_congestion_status_cback)(void *context, uint16_t lcid, wiced_bool_t is_congested);
+    void (*le_tx_complete_cback)(void *context, uint16_t lcid, uint16_t buf_count);
+} wiced_bt_l2cap_le_appl_information_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+uint16_t wiced_bt_l2cap_le_register(uint16_t le_psm, wiced_bt_l2cap_le_appl_information_t *p_cb_info, void *context);
+
+wiced_bool_t wiced_bt_l2cap_le_connect_rsp(wiced_bt_device_address_t p_bd_addr, uint8_t id, uint16_t lcid, uint16_t result, uint16_t mtu_local);
+
+wiced_bool_t wiced_bt_l2cap_le_disconnect_req(uint16_t lcid);
+
+wiced_bool_t wiced_bt_l2cap_le_disconnect_rsp(uint16_t lcid);
+
+wiced_bool_t wiced_bt_l2cap_le_set_user_congestion(uint16_t lcid, wiced_bool_t is_congested);
+
+wiced_bool_t wiced_bt_l2cap_update_ble_conn_params(wiced_bt_device_address_t rem_bdRa, uint16_t min_int, uint16_t max_int,
+                                                   uint16_t latency, uint16_t timeout);
+
+#endif      /* __WICED_BT_L2C_H__ */
+
+/* [] END OF FILE */
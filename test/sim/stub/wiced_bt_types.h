@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the basic types of the Bluetooth® stack, for
+ *              the OTA session simulator.
+ */
+
+#ifndef __WICED_BT_TYPES_H__
+#define __WICED_BT_TYPES_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "wiced_result.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef uint8_t wiced_bool_t;
+
+#define WICED_FALSE                         (0)
+#define WICED_TRUE                          (1)
+
+#ifndef MIN
+#define MIN(a, b)                           (((a) < (b)) ? (a) : (b))
+#endif
+
+#define BD_ADDR_LEN                         (6)
+typedef uint8_t wiced_bt_device_address_t[BD_ADDR_LEN];
+
+#define LINK_KEY_LEN                        (16)
+#define BT_OCTET16_LEN                      (16)
+typedef uint8_t BT_OCTET16[BT_OCTET16_LEN];
+
+typedef uint8_t wiced_bt_transport_t;
+#define BT_TRANSPORT_BR_EDR                 (1)
+#define BT_TRANSPORT_LE                     (2)
+
+typedef enum
+{
+    BLE_ADDR_PUBLIC                     = 0x00,
+    BLE_ADDR_RANDOM                     = 0x01,
+    BLE_ADDR_PUBLIC_ID                  = 0x02,
+    BLE_ADDR_RANDOM_ID                  = 0x03,
+} wiced_bt_ble_address_type_t;
+
+#define LEN_UUID_16                         (2)
+#define LEN_UUID_32                         (4)
+#define LEN_UUID_128                        (16)
+
+typedef struct
+{
+    uint16_t len;
+    union
+    {
+        uint16_t uuid16;
+        uint32_t uuid32;
+        uint8_t  uuid128[LEN_UUID_128];
+    } uu;
+} wiced_bt_uuid_t;
+
+#endif      /* __WICED_BT_TYPES_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the result codes of the Bluetooth® stack, for
+ *              the OTA session simulator. The values are not those of the stack.
+ */
+
+#ifndef __WICED_RESULT_H__
+#define __WICED_RESULT_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef uint32_t wiced_result_t;
+
+#define WICED_SUCCESS                       (0)
+#define WICED_ERROR                         (0x0004)
+#define WICED_BT_SUCCESS                    (0)
+#define WICED_BT_PENDING                    (0x0001)
+#define WICED_BT_ERROR                      (0x0004)
+
+#endif      /* __WICED_RESULT_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the Bluetooth® Configurator settings.
+ */
+
+#ifndef __CYCFG_BT_SETTINGS_H__
+#define __CYCFG_BT_SETTINGS_H__
+
+#define CY_BT_MTU_SIZE                      (512)
+
+#endif      /* __CYCFG_BT_SETTINGS_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the parts of the OTA library API used by the
+ *              modules under test. Only types, result codes, the logging call
+ *              and the image write, the values are not those of the library.
+ */
+
+#ifndef __CY_OTA_API_H__
+#define __CY_OTA_API_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef uint32_t cy_rslt_t;
+typedef void *cy_ota_context_ptr;
+
+#define CY_RSLT_SUCCESS                     (0)
+#define CY_RSLT_OTA_ERROR_GENERAL           (0x01)
+#define CY_RSLT_OTA_ERROR_BADARG            (0x02)
+#define CY_RSLT_OTA_ERROR_WRITE_STORAGE     (0x03)
+#define CY_RSLT_OTA_ERROR_READ_STORAGE      (0x04)
+#define CY_RSLT_OTA_ERROR_VERIFY            (0x05)
+#define CY_RSLT_OTA_ERROR_OUT_OF_MEMORY     (0x06)
+
+#define CYLF_MIDDLEWARE                     (0)
+
+typedef enum
+{
+    CY_LOG_OFF,
+    CY_LOG_ERR,
+    CY_LOG_WARNING,
+    CY_LOG_NOTICE,
+    CY_LOG_INFO,
+    CY_LOG_DEBUG,
+    CY_LOG_MAX
+} CY_LOG_LEVEL_T;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+void cy_log_msg(int facility, CY_LOG_LEVEL_T level, const char *fmt, ...);
+
+/* Provided by the test that needs it */
+cy_rslt_t cy_ota_ble_download_write(cy_ota_context_ptr ota_ptr, uint8_t *data_buf, uint16_t len, uint16_t offset);
+
+#endif      /* __CY_OTA_API_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the OTA storage interface types.
+ */
+
+#ifndef __CY_OTA_STORAGE_API_H__
+#define __CY_OTA_STORAGE_API_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef struct
+{
+    uint32_t    total_image_size;
+    uint32_t    total_bytes_written;
+} cy_ota_storage_context_t;
+
+typedef struct
+{
+    uint32_t    offset;
+    uint8_t     *buffer;
+    uint32_t    size;
+    uint16_t    packet_number;
+    uint16_t    total_packets;
+} cy_ota_storage_write_info_t;
+
+typedef struct
+{
+    uint32_t    offset;
+    uint8_t     *buffer;
+    uint32_t    size;
+} cy_ota_storage_read_info_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+/* Provided by the test that needs it */
+cy_rslt_t cy_ota_storage_read(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_read_info_t *chunk_info);
+
+#endif      /* __CY_OTA_STORAGE_API_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the RTOS abstraction, the subset used by the
+ *              modules under test and the OTA session simulator, implemented
+ *              in ota_test_rtos.c on POSIX threads.
+ */
+
+#ifndef __CYABS_RTOS_H__
+#define __CYABS_RTOS_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "cy_ota_api.h"
+#include <pthread.h>
+#include <time.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define CY_RTOS_NEVER_TIMEOUT               (0xFFFFFFFFUL)
+#define CY_RSLT_RTOS_TIMEOUT                (0x100)
+
+typedef enum
+{
+    CY_RTOS_PRIORITY_MIN,
+    CY_RTOS_PRIORITY_LOW,
+    CY_RTOS_PRIORITY_BELOWNORMAL,
+    CY_RTOS_PRIORITY_NORMAL,
+    CY_RTOS_PRIORITY_ABOVENORMAL,
+    CY_RTOS_PRIORITY_HIGH,
+    CY_RTOS_PRIORITY_REALTIME,
+    CY_RTOS_PRIORITY_MAX
+} cy_thread_priority_t;
+
+typedef void *cy_thread_arg_t;
+typedef void (*cy_thread_entry_fn_t)(cy_thread_arg_t arg);
+typedef pthread_t cy_thread_t;
+
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    uint32_t        count;
+    uint32_t        max_count;
+} cy_semaphore_t;
+
+typedef uint32_t cy_time_t;
+typedef void *cy_timer_callback_arg_t;
+typedef void (*cy_timer_callback_t)(cy_timer_callback_arg_t arg);
+
+typedef enum
+{
+    CY_TIMER_TYPE_PERIODIC,
+    CY_TIMER_TYPE_ONCE
+} cy_timer_trigger_type_t;
+
+/* Each timer runs its callback from its own thread */
+typedef struct
+{
+    pthread_mutex_t         mutex;
+    pthread_cond_t          cond;
+    pthread_t               thread;
+    cy_timer_trigger_type_t type;
+    cy_timer_callback_t     callback;
+    cy_timer_callback_arg_t arg;
+    uint32_t                period_ms;
+    struct timespec         deadline;
+    bool                    running;
+} cy_timer_t;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+cy_rslt_t cy_rtos_thread_create(cy_thread_t *thread, cy_thread_entry_fn_t entry_function, const char *name,
+                                void *stack, uint32_t stack_size, cy_thread_priority_t priority, cy_thread_arg_t arg);
+
+cy_rslt_t cy_rtos_init_semaphore(cy_semaphore_t *semaphore, uint32_t maxcount, uint32_t initcount);
+
+cy_rslt_t cy_rtos_get_semaphore(cy_semaphore_t *semaphore, uint32_t timeout_ms, bool in_isr);
+
+cy_rslt_t cy_rtos_set_semaphore(cy_semaphore_t *semaphore, bool in_isr);
+
+cy_rslt_t cy_rtos_init_timer(cy_timer_t *timer, cy_timer_trigger_type_t type, cy_timer_callback_t fun, cy_timer_callback_arg_t arg);
+
+cy_rslt_t cy_rtos_start_timer(cy_timer_t *timer, cy_time_t num_ms);
+
+cy_rslt_t cy_rtos_stop_timer(cy_timer_t *timer);
+
+cy_rslt_t cy_rtos_get_time(cy_time_t *tval);
+
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms);
+
+#endif      /* __CYABS_RTOS_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,29 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for mbedtls/version.h. The host build has no CC312
+ *              alternatives, so app_ota_verify.c uses its software backend.
+ */
+
+#ifndef __MBEDTLS_VERSION_H__
+#define __MBEDTLS_VERSION_H__
+
+#define MBEDTLS_VERSION_NUMBER              (0x03000000)
+
+#endif      /* __MBEDTLS_VERSION_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the P-256 ECDSA of the Bluetooth® OTA
+ *              library. The multi-precision numbers are arrays of 32-bit
+ *              words, least significant word first, ecdsa_verify_() takes
+ *              the SHA-256 hash and r and s big-endian.
+ */
+
+#ifndef __OTA_ECC_PP_H__
+#define __OTA_ECC_PP_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define KEY_LENGTH_DWORDS_P256              (8)
+
+typedef struct
+{
+    uint32_t    x[KEY_LENGTH_DWORDS_P256];
+    uint32_t    y[KEY_LENGTH_DWORDS_P256];
+    uint32_t    z[KEY_LENGTH_DWORDS_P256];
+} Point;
+
+/* *****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ * ****************************************************************************/
+int ecdsa_verify_(unsigned char *digest, unsigned char *signature, Point *key);
+
+#endif      /* __OTA_ECC_PP_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host stand-in for the GATT part of the Bluetooth® stack API
+ *              used by the modules under test.
+ */
+
+#ifndef __WICED_BT_GATT_H__
+#define __WICED_BT_GATT_H__
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include <stdint.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+typedef enum
+{
+    WICED_BT_GATT_SUCCESS               = 0x00,
+    WICED_BT_GATT_INVALID_HANDLE        = 0x01,
+    WICED_BT_GATT_WRITE_NOT_PERMIT      = 0x03,
+    WICED_BT_GATT_REQ_NOT_SUPPORTED     = 0x06,
+    WICED_BT_GATT_INVALID_OFFSET        = 0x07,
+    WICED_BT_GATT_PREPARE_Q_FULL        = 0x09,
+    WICED_BT_GATT_INVALID_ATTR_LEN      = 0x0D,
+    WICED_BT_GATT_INSUF_RESOURCE        = 0x11,
+    WICED_BT_GATT_ERROR                 = 0x85,
+} wiced_bt_gatt_status_t;
+
+#endif      /* __WICED_BT_GATT_H__ */
+
+/* [] END OF FILE */
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the GATT attribute handle index, and a
+ *              microbenchmark against the linear search it replaced on a
+ *              200 attribute database.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_bt_attr_index.h"
+#include <stdio.h>
+#include <time.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_ATTR_COUNT                     (200)
+#define TEST_ATTR_LOOKUPS                   (2000000)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static gatt_db_lookup_table_t test_attr_tbl[TEST_ATTR_COUNT];
+static uint8_t test_attr_values[TEST_ATTR_COUNT];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/* The lookup of app_bt_gatt_handler.c before the index */
+static gatt_db_lookup_table_t *test_attr_scan(uint16_t handle)
+{
+    uint16_t i;
+
+    for (i = 0; i < TEST_ATTR_COUNT; i++)
+    {
+        if (test_attr_tbl[i].handle == handle)
+        {
+            return &test_attr_tbl[i];
+        }
+    }
+    return NULL;
+}
+
+static double test_attr_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static double test_attr_bench(gatt_db_lookup_table_t *(*find)(uint16_t handle))
+{
+    volatile uint32_t sink = 0;
+    double start;
+    uint32_t i;
+
+    start = test_attr_now_ns();
+    for (i = 0; i < TEST_ATTR_LOOKUPS; i++)
+    {
+        /* Handles spread over the database, like reads of random characteristics */
+        sink += find((uint16_t)(1 + ((i * 7919u) % TEST_ATTR_COUNT)))->max_len;
+    }
+    (void)sink;
+    return (test_attr_now_ns() - start) / TEST_ATTR_LOOKUPS;
+}
+
+void test_attr_index(void)
+{
+    double scan_ns;
+    double index_ns;
+    uint16_t i;
+    bool same = true;
+
+    /* Handles 1..200 in a shuffled table order, as the configurator may emit them */
+    for (i = 0; i < TEST_ATTR_COUNT; i++)
+    {
+        test_attr_tbl[i].handle = (uint16_t)(1 + ((i * 37u) % TEST_ATTR_COUNT));
+        test_attr_tbl[i].max_len = 1;
+        test_attr_tbl[i].cur_len = 1;
+        test_attr_tbl[i].p_data = &test_attr_values[i];
+    }
+    app_bt_attr_index_build(test_attr_tbl, TEST_ATTR_COUNT);
+
+    for (i = 0; i <= APP_BT_ATTR_INDEX_MAX_HANDLE; i++)
+    {
+        same = same && (app_bt_attr_index_find(i) == test_attr_scan(i));
+    }
+    OTA_TEST_CHECK(same);
+    OTA_TEST_CHECK(app_bt_attr_index_find(0) == NULL);
+    OTA_TEST_CHECK(app_bt_attr_index_find(TEST_ATTR_COUNT + 1) == NULL);
+
+    /* The first entry of a duplicated handle wins */
+    test_attr_tbl[TEST_ATTR_COUNT - 1].handle = test_attr_tbl[0].handle;
+    app_bt_attr_index_build(test_attr_tbl, TEST_ATTR_COUNT);
+    OTA_TEST_CHECK(app_bt_attr_index_find(test_attr_tbl[0].handle) == &test_attr_tbl[0]);
+
+    /* Handles above the index are still found, by the linear search */
+    test_attr_tbl[TEST_ATTR_COUNT - 1].handle = APP_BT_ATTR_INDEX_MAX_HANDLE + 100;
+    app_bt_attr_index_build(test_attr_tbl, TEST_ATTR_COUNT);
+    OTA_TEST_CHECK(app_bt_attr_index_find(APP_BT_ATTR_INDEX_MAX_HANDLE + 100) == &test_attr_tbl[TEST_ATTR_COUNT - 1]);
+    OTA_TEST_CHECK(app_bt_attr_index_find(APP_BT_ATTR_INDEX_MAX_HANDLE + 101) == NULL);
+
+    /* Microbenchmark, every handle of the database in the index */
+    test_attr_tbl[TEST_ATTR_COUNT - 1].handle = (uint16_t)(1 + (((TEST_ATTR_COUNT - 1) * 37u) % TEST_ATTR_COUNT));
+    app_bt_attr_index_build(test_attr_tbl, TEST_ATTR_COUNT);
+    scan_ns = test_attr_bench(test_attr_scan);
+    index_ns = test_attr_bench(app_bt_attr_index_find);
+    printf("  %u attributes: linear search %.1f ns, index %.1f ns per lookup\n", TEST_ATTR_COUNT, scan_ns, index_ns);
+    OTA_TEST_CHECK(index_ns < scan_ns);
+}
+
+/* [] END OF FILE */
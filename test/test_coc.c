@@ -0,0 +1,257 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host simulator of the LE credit based OTA data channel. A
+ *              host with a fixed number of credits sends SDUs faster than
+ *              a simulated staging ring drains to flash. The stand-in stack
+ *              returns the credits of each SDU unless the channel is marked
+ *              congested, and returns the withheld ones when the congestion
+ *              is cleared, as on ROOM from the storage thread.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_ota_coc.h"
+#include "app_ota_stage.h"
+#include "wiced_bt_l2c.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_COC_IMAGE_SIZE                 ((8 * APP_OTA_STAGE_BLOCK_SIZE) + 300)
+#define TEST_COC_SDU_LEN                    (2000)
+#define TEST_COC_MPS                        (247)       /* payload of one K-frame            */
+#define TEST_COC_CREDITS                    (16)        /* credits granted on connection     */
+#define TEST_COC_SDUS_PER_BLOCK             (3)         /* SDUs received per block written   */
+#define TEST_COC_LCID                       (0x0040)
+#define TEST_COC_RING_SIZE                  (APP_OTA_STAGE_NUM_BLOCKS * APP_OTA_STAGE_BLOCK_SIZE)
+
+/* The credits the host holds when the channel is marked congested have to fit */
+#if ((TEST_COC_CREDITS * TEST_COC_MPS) > APP_OTA_STAGE_HEADROOM)
+#error "TEST_COC_CREDITS do not fit in APP_OTA_STAGE_HEADROOM"
+#endif
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static uint8_t test_coc_image[TEST_COC_IMAGE_SIZE];
+static uint8_t test_coc_rx[TEST_COC_IMAGE_SIZE];
+static uint32_t test_coc_rx_len;
+
+/* Simulated staging ring, bytes not written to flash yet */
+static uint32_t test_coc_ring_used;
+
+/* Stand-in stack */
+static wiced_bt_l2cap_le_appl_information_t *test_coc_appl;
+static uint16_t test_coc_connect_result;
+static uint32_t test_coc_disconnects;
+static bool test_coc_congested;
+static uint32_t test_coc_congestions;
+static uint32_t test_coc_host_credits;
+static uint32_t test_coc_withheld;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+uint16_t wiced_bt_l2cap_le_register(uint16_t le_psm, wiced_bt_l2cap_le_appl_information_t *p_cb_info, void *context)
+{
+    (void)context;
+    test_coc_appl = p_cb_info;
+    return le_psm;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_connect_rsp(wiced_bt_device_address_t p_bd_addr, uint8_t id, uint16_t lcid, uint16_t result, uint16_t mtu_local)
+{
+    (void)p_bd_addr;
+    (void)id;
+    (void)lcid;
+    (void)mtu_local;
+    test_coc_connect_result = result;
+    test_coc_congested = false;
+    test_coc_host_credits = TEST_COC_CREDITS;
+    test_coc_withheld = 0;
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_disconnect_req(uint16_t lcid)
+{
+    test_coc_disconnects++;
+    test_coc_appl->le_disconnect_confirmation_cback(NULL, lcid, 0);
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_disconnect_rsp(uint16_t lcid)
+{
+    (void)lcid;
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_set_user_congestion(uint16_t lcid, wiced_bool_t is_congested)
+{
+    (void)lcid;
+    test_coc_congested = (is_congested != WICED_FALSE);
+    if (test_coc_congested)
+    {
+        test_coc_congestions++;
+    }
+    else
+    {
+        test_coc_host_credits += test_coc_withheld;
+        test_coc_withheld = 0;
+    }
+    return WICED_TRUE;
+}
+
+/* The staging layer as seen from the Bluetooth® stack thread */
+static cy_rslt_t test_coc_data_callback(const uint8_t *p_data, uint16_t len)
+{
+    if (len > (TEST_COC_RING_SIZE - test_coc_ring_used))
+    {
+        return CY_RSLT_OTA_ERROR_OUT_OF_MEMORY;
+    }
+    test_coc_ring_used += len;
+    if ((test_coc_rx_len + len) <= sizeof(test_coc_rx))
+    {
+        memcpy(&test_coc_rx[test_coc_rx_len], p_data, len);
+    }
+    test_coc_rx_len += len;
+    return CY_RSLT_SUCCESS;
+}
+
+static bool test_coc_room_callback(void)
+{
+    return ((TEST_COC_RING_SIZE - test_coc_ring_used) >= APP_OTA_STAGE_HEADROOM);
+}
+
+/* The storage thread writes one block, ROOM reaches the stack thread */
+static void test_coc_write_block(void)
+{
+    test_coc_ring_used -= (test_coc_ring_used < APP_OTA_STAGE_BLOCK_SIZE) ? test_coc_ring_used : APP_OTA_STAGE_BLOCK_SIZE;
+    if (test_coc_room_callback())
+    {
+        app_ota_coc_room();
+    }
+}
+
+static uint32_t test_coc_frames(uint32_t len)
+{
+    /* The first K-frame carries the 2 byte SDU length */
+    return (len + 2 + TEST_COC_MPS - 1) / TEST_COC_MPS;
+}
+
+/* One SDU received by the stack, its credits are returned after the callback */
+static void test_coc_receive(const uint8_t *p_data, uint32_t len)
+{
+    uint32_t frames = test_coc_frames(len);
+
+    test_coc_host_credits -= frames;
+    test_coc_appl->le_data_indication_cback(NULL, TEST_COC_LCID, (uint8_t *)p_data, (uint16_t)len);
+    if (test_coc_congested)
+    {
+        test_coc_withheld += frames;
+    }
+    else
+    {
+        test_coc_host_credits += frames;
+    }
+}
+
+static void test_coc_connect(void)
+{
+    wiced_bt_device_address_t bd_addr = { 0 };
+
+    test_coc_ring_used = 0;
+    test_coc_rx_len = 0;
+    test_coc_appl->le_connected_indication_cback(NULL, bd_addr, TEST_COC_LCID, APP_OTA_COC_PSM, 1, APP_OTA_COC_MTU);
+}
+
+void test_coc(void)
+{
+    uint32_t pos = 0;
+    uint32_t sdus = 0;
+    uint32_t stalls = 0;
+
+    ota_test_fill(test_coc_image, sizeof(test_coc_image), 0xC0C);
+    OTA_TEST_CHECK(app_ota_coc_init(test_coc_data_callback, test_coc_room_callback) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_coc_appl != NULL);
+
+    /* Only accepted while an OTA session asked for the channel */
+    test_coc_connect();
+    OTA_TEST_CHECK(test_coc_connect_result == L2CAP_LE_RESULT_NO_RESOURCES);
+    OTA_TEST_CHECK(!app_ota_coc_connected());
+
+    /* A host that honours the credits never overruns the ring */
+    app_ota_coc_enable(true);
+    test_coc_connect();
+    OTA_TEST_CHECK(test_coc_connect_result == L2CAP_LE_RESULT_CONN_OK);
+    OTA_TEST_CHECK(app_ota_coc_connected());
+    while (pos < TEST_COC_IMAGE_SIZE)
+    {
+        uint32_t len = ((TEST_COC_IMAGE_SIZE - pos) < TEST_COC_SDU_LEN) ? (TEST_COC_IMAGE_SIZE - pos) : TEST_COC_SDU_LEN;
+
+        if (test_coc_host_credits < test_coc_frames(len))
+        {
+            /* Out of credits, the host waits for the storage thread */
+            stalls++;
+            OTA_TEST_CHECK(test_coc_congested);
+            test_coc_write_block();
+            continue;
+        }
+        test_coc_receive(&test_coc_image[pos], len);
+        pos += len;
+        if ((++sdus % TEST_COC_SDUS_PER_BLOCK) == 0)
+        {
+            test_coc_write_block();
+        }
+    }
+    OTA_TEST_CHECK(test_coc_disconnects == 0);
+    OTA_TEST_CHECK(app_ota_coc_connected());
+    OTA_TEST_CHECK(stalls > 0);
+    OTA_TEST_CHECK(test_coc_congestions > 0);
+    OTA_TEST_CHECK(test_coc_rx_len == TEST_COC_IMAGE_SIZE);
+    OTA_TEST_CHECK(memcmp(test_coc_rx, test_coc_image, TEST_COC_IMAGE_SIZE) == 0);
+
+    /* Once the ring drains every credit is back with the host */
+    while (test_coc_ring_used > 0)
+    {
+        test_coc_write_block();
+    }
+    OTA_TEST_CHECK(!test_coc_congested);
+    OTA_TEST_CHECK(test_coc_host_credits == TEST_COC_CREDITS);
+
+    /* A host that ignores the credits is disconnected, not blocked on */
+    test_coc_connect();
+    OTA_TEST_CHECK(test_coc_connect_result == L2CAP_LE_RESULT_NO_RESOURCES);
+    app_ota_coc_disconnect();
+    test_coc_connect();
+    OTA_TEST_CHECK(app_ota_coc_connected());
+    for (pos = 0; (pos < TEST_COC_RING_SIZE) && app_ota_coc_connected(); pos += TEST_COC_SDU_LEN)
+    {
+        test_coc_appl->le_data_indication_cback(NULL, TEST_COC_LCID, test_coc_image, TEST_COC_SDU_LEN);
+    }
+    OTA_TEST_CHECK(!app_ota_coc_connected());
+    OTA_TEST_CHECK(test_coc_disconnects == 2);
+    OTA_TEST_CHECK(test_coc_ring_used <= TEST_COC_RING_SIZE);
+
+    app_ota_coc_enable(false);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the running CRC32.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_ota_crc32.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+void test_crc32(void)
+{
+    static uint8_t buf[10000];
+    const char *check = "123456789";
+    uint32_t crc;
+    uint32_t pos;
+    uint32_t step;
+
+    /* Check value of CRC-32/ISO-HDLC, the zlib.crc32() of the host scripts */
+    crc = app_ota_crc32_update(APP_OTA_CRC32_INIT, (const uint8_t *)check, (uint32_t)strlen(check));
+    crc = APP_OTA_CRC32_FINAL(crc);
+    OTA_TEST_CHECK(crc == 0xCBF43926UL);
+
+    OTA_TEST_CHECK(APP_OTA_CRC32_FINAL(app_ota_crc32_update(APP_OTA_CRC32_INIT, buf, 0)) == 0);
+
+    /* The running CRC does not depend on how the image is split in DATA writes */
+    ota_test_fill(buf, sizeof(buf), 1);
+    crc = APP_OTA_CRC32_FINAL(app_ota_crc32_update(APP_OTA_CRC32_INIT, buf, sizeof(buf)));
+    for (step = 1; step <= 509; step += 127)
+    {
+        uint32_t running = APP_OTA_CRC32_INIT;
+
+        for (pos = 0; pos < sizeof(buf); pos += step)
+        {
+            running = app_ota_crc32_update(running, &buf[pos], ((sizeof(buf) - pos) < step) ? (sizeof(buf) - pos) : step);
+        }
+        OTA_TEST_CHECK(APP_OTA_CRC32_FINAL(running) == crc);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the heatshrink image decoder. The compressed
+ *              images are made by a small greedy encoder of the same bit
+ *              stream, see app_ota_decomp.c.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "cy_ota_api.h"
+#include "app_ota_decomp.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_DECOMP_IMAGE_SIZE              (20000)
+
+typedef struct
+{
+    uint8_t     *p_buf;
+    uint32_t    max_len;
+    uint32_t    len;
+    uint32_t    bits;
+    uint8_t     num_bits;
+} test_bit_writer_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static uint8_t test_image[TEST_DECOMP_IMAGE_SIZE];
+static uint8_t test_packed[TEST_DECOMP_IMAGE_SIZE * 2];
+static uint8_t test_output[TEST_DECOMP_IMAGE_SIZE];
+static uint32_t test_output_len;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static cy_rslt_t test_decomp_output(const uint8_t *p_data, uint16_t len)
+{
+    if ((test_output_len + len) > sizeof(test_output))
+    {
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    memcpy(&test_output[test_output_len], p_data, len);
+    test_output_len += len;
+    return CY_RSLT_SUCCESS;
+}
+
+static void test_put_bits(test_bit_writer_t *p_bw, uint32_t value, uint8_t count)
+{
+    while (count-- > 0)
+    {
+        p_bw->bits = (p_bw->bits << 1) | ((value >> count) & 1);
+        if (++p_bw->num_bits == 8)
+        {
+            if (p_bw->len < p_bw->max_len)
+            {
+                p_bw->p_buf[p_bw->len] = (uint8_t)p_bw->bits;
+            }
+            p_bw->len++;
+            p_bw->bits = 0;
+            p_bw->num_bits = 0;
+        }
+    }
+}
+
+/* Greedy LZSS with the window and lookahead of the decoder, padded with zero bits */
+static uint32_t test_decomp_encode(const uint8_t *p_in, uint32_t in_len, uint8_t *p_out, uint32_t out_max)
+{
+    const uint32_t window = 1UL << APP_OTA_DECOMP_WINDOW_BITS;
+    const uint32_t max_count = 1UL << APP_OTA_DECOMP_LOOKAHEAD_BITS;
+    test_bit_writer_t bw = { p_out, out_max, 0, 0, 0 };
+    uint32_t pos = 0;
+
+    while (pos < in_len)
+    {
+        uint32_t best_len = 0;
+        uint32_t best_dist = 0;
+        uint32_t dist;
+
+        for (dist = 1; (dist <= window) && (dist <= pos); dist++)
+        {
+            uint32_t len = 0;
+
+            while ((len < max_count) && ((pos + len) < in_len) && (p_in[pos + len - dist] == p_in[pos + len]))
+            {
+                len++;
+            }
+            if (len > best_len)
+            {
+                best_len = len;
+                best_dist = dist;
+            }
+        }
+
+        if (best_len >= 2)
+        {
+            test_put_bits(&bw, 0, 1);
+            test_put_bits(&bw, best_dist - 1, APP_OTA_DECOMP_WINDOW_BITS);
+            test_put_bits(&bw, best_len - 1, APP_OTA_DECOMP_LOOKAHEAD_BITS);
+            pos += best_len;
+        }
+        else
+        {
+            test_put_bits(&bw, 1, 1);
+            test_put_bits(&bw, p_in[pos], 8);
+            pos++;
+        }
+    }
+    if (bw.num_bits != 0)
+    {
+        test_put_bits(&bw, 0, (uint8_t)(8 - bw.num_bits));
+    }
+
+    return bw.len;
+}
+
+/* Decode in chunks of chunk_len, returns the first error */
+static cy_rslt_t test_decomp_run(const uint8_t *p_packed, uint32_t packed_len, uint32_t image_size, uint32_t chunk_len)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t pos;
+
+    test_output_len = 0;
+    app_ota_decomp_start(image_size);
+    for (pos = 0; (pos < packed_len) && (result == CY_RSLT_SUCCESS); pos += chunk_len)
+    {
+        uint32_t len = ((packed_len - pos) < chunk_len) ? (packed_len - pos) : chunk_len;
+
+        result = app_ota_decomp_write(&p_packed[pos], (uint16_t)len);
+    }
+    app_ota_decomp_stop();
+
+    return result;
+}
+
+void test_decomp(void)
+{
+    static const uint32_t chunks[] = { 1, 7, 244, 509, 4096 };
+    uint32_t packed_len;
+    uint32_t i;
+
+    app_ota_decomp_init(test_decomp_output);
+
+    /* Firmware like content: repeated structures with a few changes, and some noise */
+    for (i = 0; i < sizeof(test_image); i++)
+    {
+        test_image[i] = (uint8_t)((i % 64) < 48 ? (i / 64) ^ (i % 13) : 0xFF);
+    }
+    ota_test_fill(&test_image[12000], 3000, 3);
+
+    packed_len = test_decomp_encode(test_image, sizeof(test_image), test_packed, sizeof(test_packed));
+    OTA_TEST_CHECK(packed_len < sizeof(test_image));
+
+    for (i = 0; i < (sizeof(chunks) / sizeof(chunks[0])); i++)
+    {
+        OTA_TEST_CHECK(test_decomp_run(test_packed, packed_len, sizeof(test_image), chunks[i]) == CY_RSLT_SUCCESS);
+        OTA_TEST_CHECK(test_output_len == sizeof(test_image));
+        OTA_TEST_CHECK(memcmp(test_output, test_image, sizeof(test_image)) == 0);
+        OTA_TEST_CHECK(app_ota_decomp_output_len() == sizeof(test_image));
+    }
+
+    /* A back reference overlapping its own output repeats the last byte */
+    memset(test_image, 'A', 100);
+    packed_len = test_decomp_encode(test_image, 100, test_packed, sizeof(test_packed));
+    OTA_TEST_CHECK(packed_len < 20);
+    OTA_TEST_CHECK(test_decomp_run(test_packed, packed_len, 100, 3) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK((test_output_len == 100) && (memcmp(test_output, test_image, 100) == 0));
+
+    /* A stream decoding to more than the announced size is refused */
+    OTA_TEST_CHECK(test_decomp_run(test_packed, packed_len, 99, 244) != CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_output_len <= 99);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the delta patch decoder, patch format in
+ *              app_ota_delta.h. The running image is read from a buffer
+ *              through the app_ota_slot.h functions defined here.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "cy_ota_api.h"
+#include "app_ota_delta.h"
+#include "app_ota_slot.h"
+#include "app_ota_crc32.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_DELTA_IMAGE_SIZE               (6000)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static uint8_t test_image[TEST_DELTA_IMAGE_SIZE];
+static uint8_t test_base[TEST_DELTA_IMAGE_SIZE];
+static uint8_t test_new[TEST_DELTA_IMAGE_SIZE];
+static uint8_t test_patch[TEST_DELTA_IMAGE_SIZE * 2];
+static uint8_t test_output[TEST_DELTA_IMAGE_SIZE];
+static uint32_t test_output_len;
+
+/* Running image seen by the decoder, none while NULL */
+static const uint8_t *test_slot;
+static uint32_t test_slot_len;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+bool app_ota_slot_active_readable(void)
+{
+    return (test_slot != NULL);
+}
+
+cy_rslt_t app_ota_slot_read_active(uint32_t offset, uint8_t *p_buf, uint32_t len)
+{
+    if ((test_slot == NULL) || (offset > test_slot_len) || (len > (test_slot_len - offset)))
+    {
+        return CY_RSLT_OTA_ERROR_READ_STORAGE;
+    }
+    memcpy(p_buf, &test_slot[offset], len);
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t test_delta_output(const uint8_t *p_data, uint16_t len)
+{
+    if ((test_output_len + len) > sizeof(test_output))
+    {
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    memcpy(&test_output[test_output_len], p_data, len);
+    test_output_len += len;
+    return CY_RSLT_SUCCESS;
+}
+
+static uint32_t test_put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)(value >> 0);
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+    return 4;
+}
+
+static uint32_t test_delta_header(uint8_t *p, uint32_t base_size, uint32_t base_crc32, uint32_t image_size)
+{
+    memset(p, 0x00, APP_OTA_DELTA_HEADER_LEN);
+    memcpy(p, APP_OTA_DELTA_MAGIC, 4);
+    p[4] = APP_OTA_DELTA_VERSION;
+    test_put_u32(&p[8], base_size);
+    test_put_u32(&p[12], base_crc32);
+    test_put_u32(&p[16], image_size);
+    return APP_OTA_DELTA_HEADER_LEN;
+}
+
+static uint32_t test_delta_insert(uint8_t *p, const uint8_t *p_data, uint32_t len)
+{
+    p[0] = APP_OTA_DELTA_OP_INSERT;
+    test_put_u32(&p[1], len);
+    memcpy(&p[5], p_data, len);
+    return 5 + len;
+}
+
+static uint32_t test_delta_record(uint8_t *p, uint8_t op, uint32_t len, uint32_t base_offset)
+{
+    p[0] = op;
+    test_put_u32(&p[1], len);
+    test_put_u32(&p[5], base_offset);
+    return 9;
+}
+
+/* Apply in chunks of chunk_len, returns the first error */
+static cy_rslt_t test_delta_run(const uint8_t *p_patch, uint32_t patch_len, uint32_t image_size, uint32_t chunk_len)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t pos;
+
+    test_output_len = 0;
+    app_ota_delta_start(image_size);
+    for (pos = 0; (pos < patch_len) && (result == CY_RSLT_SUCCESS); pos += chunk_len)
+    {
+        uint32_t len = ((patch_len - pos) < chunk_len) ? (patch_len - pos) : chunk_len;
+
+        result = app_ota_delta_write(&p_patch[pos], (uint16_t)len);
+    }
+    app_ota_delta_stop();
+
+    return result;
+}
+
+void test_delta(void)
+{
+    static const uint32_t chunks[] = { 1, 3, 20, 244, 4096 };
+    uint32_t len;
+    uint32_t i;
+
+    app_ota_delta_init(test_delta_output);
+    ota_test_fill(test_image, sizeof(test_image), 4);
+
+    /* Without a base image, a patch of INSERT records only */
+    len = test_delta_header(test_patch, 0, 0, sizeof(test_image));
+    len += test_delta_insert(&test_patch[len], test_image, 1000);
+    len += test_delta_insert(&test_patch[len], &test_image[1000], sizeof(test_image) - 1000);
+    for (i = 0; i < (sizeof(chunks) / sizeof(chunks[0])); i++)
+    {
+        OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_image), chunks[i]) == CY_RSLT_SUCCESS);
+        OTA_TEST_CHECK((test_output_len == sizeof(test_image)) && (memcmp(test_output, test_image, sizeof(test_image)) == 0));
+    }
+
+    /* Records past the announced image size are refused */
+    OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_image) - 1, 244) != CY_RSLT_SUCCESS);
+
+    /* A patch for another image size, version or format is refused before anything is written */
+    len = test_delta_header(test_patch, 0, 0, sizeof(test_image) + 1);
+    len += test_delta_insert(&test_patch[len], test_image, 100);
+    OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_image), 244) != CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_output_len == 0);
+
+    test_delta_header(test_patch, 0, 0, sizeof(test_image));
+    test_patch[4] = APP_OTA_DELTA_VERSION + 1;
+    OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_image), 244) != CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_output_len == 0);
+
+    /* A base CRC that is not the one of the running image */
+    test_delta_header(test_patch, 0, 0x12345678UL, sizeof(test_image));
+    OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_image), 244) != CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_output_len == 0);
+
+    /* Unknown record type, and a COPY outside of the base image */
+    len = test_delta_header(test_patch, 0, 0, sizeof(test_image));
+    test_patch[len++] = 0x7F;
+    OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_image), 244) != CY_RSLT_SUCCESS);
+
+    len = test_delta_header(test_patch, 0, 0, sizeof(test_image));
+    test_patch[len] = APP_OTA_DELTA_OP_COPY;
+    test_put_u32(&test_patch[len + 1], 16);
+    test_put_u32(&test_patch[len + 5], 0);
+    len += 9;
+    OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_image), 244) != CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_output_len == 0);
+
+    /*
+     * Against a running image: a moved region (COPY), a moved region with
+     * small changes (ADD, longer than APP_OTA_DELTA_CHUNK_SIZE) and new code
+     * (INSERT)
+     */
+    OTA_TEST_CHECK(!app_ota_delta_supported());
+    ota_test_fill(test_base, sizeof(test_base), 5);
+    test_slot = test_base;
+    test_slot_len = sizeof(test_base);
+    OTA_TEST_CHECK(app_ota_delta_supported());
+
+    memcpy(test_new, &test_base[3000], 2000);
+    for (i = 0; i < 2000; i++)
+    {
+        test_new[2000 + i] = (uint8_t)(test_base[i] + (((i % 97) == 0) ? 3 : 0));
+    }
+    memcpy(&test_new[4000], test_image, 2000);
+
+    len = test_delta_header(test_patch, sizeof(test_base),
+                            APP_OTA_CRC32_FINAL(app_ota_crc32_update(APP_OTA_CRC32_INIT, test_base, sizeof(test_base))),
+                            sizeof(test_new));
+    len += test_delta_record(&test_patch[len], APP_OTA_DELTA_OP_COPY, 2000, 3000);
+    len += test_delta_record(&test_patch[len], APP_OTA_DELTA_OP_ADD, 2000, 0);
+    for (i = 0; i < 2000; i++)
+    {
+        test_patch[len++] = (uint8_t)(test_new[2000 + i] - test_base[i]);
+    }
+    len += test_delta_insert(&test_patch[len], &test_new[4000], 2000);
+    for (i = 0; i < (sizeof(chunks) / sizeof(chunks[0])); i++)
+    {
+        OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_new), chunks[i]) == CY_RSLT_SUCCESS);
+        OTA_TEST_CHECK((test_output_len == sizeof(test_new)) && (memcmp(test_output, test_new, sizeof(test_new)) == 0));
+    }
+
+    /* Another running image, and one that cannot be read to the end */
+    test_base[10] ^= 0x01;
+    OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_new), 244) != CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_output_len == 0);
+    test_base[10] ^= 0x01;
+    test_slot_len = sizeof(test_base) - 1;
+    OTA_TEST_CHECK(test_delta_run(test_patch, len, sizeof(test_new), 244) == CY_RSLT_OTA_ERROR_READ_STORAGE);
+    OTA_TEST_CHECK(test_output_len == 0);
+
+    test_slot = NULL;
+    test_slot_len = 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Known answer tests of the image info check: an accepted
+ *              descriptor, a wrong board, a downgrade, the running version,
+ *              and truncated or malformed descriptors.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_ota_image_info.h"
+#include "app_ota_protocol.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_IMAGE_INFO_IMAGE_SIZE          (0x00123456UL)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static uint32_t test_image_info_rejects;
+static uint8_t test_image_info_reason;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static void test_image_info_reject_cb(uint8_t reason)
+{
+    test_image_info_rejects++;
+    test_image_info_reason = reason;
+}
+
+static void test_image_info_build(uint8_t *p_desc, uint16_t board_id, uint8_t major, uint8_t minor, uint16_t build, uint32_t image_size)
+{
+    memcpy(p_desc, APP_OTA_IMAGE_INFO_MAGIC, 4);
+    p_desc[4] = APP_OTA_IMAGE_INFO_VERSION;
+    p_desc[5] = 0;
+    p_desc[6] = (uint8_t)(board_id >> 0);
+    p_desc[7] = (uint8_t)(board_id >> 8);
+    p_desc[8] = major;
+    p_desc[9] = minor;
+    p_desc[10] = (uint8_t)(build >> 0);
+    p_desc[11] = (uint8_t)(build >> 8);
+    p_desc[12] = (uint8_t)(image_size >> 0);
+    p_desc[13] = (uint8_t)(image_size >> 8);
+    p_desc[14] = (uint8_t)(image_size >> 16);
+    p_desc[15] = (uint8_t)(image_size >> 24);
+}
+
+/* Run a descriptor followed by image data through a new download, returns the reject reason */
+static uint8_t test_image_info_run(const uint8_t *p_desc, uint16_t desc_len)
+{
+    uint8_t data[APP_OTA_IMAGE_INFO_LEN + 4];
+    const uint8_t *p_data = data;
+    uint16_t len = desc_len + 4;
+    cy_rslt_t result;
+
+    memcpy(data, p_desc, desc_len);
+    memset(&data[desc_len], 0xA5, 4);
+    test_image_info_rejects = 0;
+    test_image_info_reason = APP_OTA_IMAGE_REJECT_NONE;
+
+    OTA_TEST_CHECK(app_ota_image_info_start(true, TEST_IMAGE_INFO_IMAGE_SIZE) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(app_ota_image_info_pending());
+    result = app_ota_image_info_write(&p_data, &len);
+    if (result == CY_RSLT_SUCCESS)
+    {
+        /* The descriptor is taken off, the image data is left in place */
+        OTA_TEST_CHECK(!app_ota_image_info_pending());
+        OTA_TEST_CHECK(test_image_info_rejects == 0);
+        OTA_TEST_CHECK(p_data == &data[APP_OTA_IMAGE_INFO_LEN]);
+        OTA_TEST_CHECK(len == 4);
+    }
+    else
+    {
+        /* Refused once, later data is refused without a second notification */
+        OTA_TEST_CHECK(result == CY_RSLT_OTA_ERROR_VERIFY);
+        OTA_TEST_CHECK(app_ota_image_info_pending());
+        OTA_TEST_CHECK(app_ota_image_info_write(&p_data, &len) == CY_RSLT_OTA_ERROR_VERIFY);
+        OTA_TEST_CHECK(test_image_info_rejects == 1);
+    }
+    app_ota_image_info_stop();
+    return test_image_info_reason;
+}
+
+void test_image_info(void)
+{
+    uint8_t desc[APP_OTA_IMAGE_INFO_LEN];
+    uint8_t reject[APP_OTA_IMAGE_REJECT_LEN];
+    const uint8_t *p_data;
+    uint16_t len;
+    uint8_t major;
+    uint8_t minor;
+    uint16_t build;
+    uint16_t pos;
+
+    app_ota_image_info_init(test_image_info_reject_cb);
+
+    /* Accepted: newer build, minor and major */
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD + 1, TEST_IMAGE_INFO_IMAGE_SIZE);
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_NONE);
+    OTA_TEST_CHECK(app_ota_image_info_version(&major, &minor, &build));
+    OTA_TEST_CHECK((major == APP_VERSION_MAJOR) && (minor == APP_VERSION_MINOR) && (build == (APP_VERSION_BUILD + 1)));
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR, APP_VERSION_MINOR + 1, 0, TEST_IMAGE_INFO_IMAGE_SIZE);
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_NONE);
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR + 1, 0, 0, TEST_IMAGE_INFO_IMAGE_SIZE);
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_NONE);
+
+    /* Wrong board */
+    test_image_info_build(desc, APP_OTA_BOARD_ID + 1, APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD + 1, TEST_IMAGE_INFO_IMAGE_SIZE);
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_BOARD);
+
+    /* Downgrade: older build, and a higher build of an older minor */
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD - 1, TEST_IMAGE_INFO_IMAGE_SIZE);
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_DOWNGRADE);
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR, APP_VERSION_MINOR - 1, 0xFFFF, TEST_IMAGE_INFO_IMAGE_SIZE);
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_DOWNGRADE);
+
+    /* The running version */
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD, TEST_IMAGE_INFO_IMAGE_SIZE);
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_SAME_VERSION);
+
+    /* Malformed: another image size, magic or descriptor version */
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD + 1, TEST_IMAGE_INFO_IMAGE_SIZE - 1);
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_FORMAT);
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD + 1, TEST_IMAGE_INFO_IMAGE_SIZE);
+    desc[0] ^= 0x20;
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_FORMAT);
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD + 1, TEST_IMAGE_INFO_IMAGE_SIZE);
+    desc[4] = APP_OTA_IMAGE_INFO_VERSION + 1;
+    OTA_TEST_CHECK(test_image_info_run(desc, sizeof(desc)) == APP_OTA_IMAGE_REJECT_FORMAT);
+
+    /* Truncated: a descriptor cut short is neither accepted nor refused, no data passes */
+    test_image_info_build(desc, APP_OTA_BOARD_ID, APP_VERSION_MAJOR, APP_VERSION_MINOR, APP_VERSION_BUILD + 1, TEST_IMAGE_INFO_IMAGE_SIZE);
+    OTA_TEST_CHECK(app_ota_image_info_start(true, TEST_IMAGE_INFO_IMAGE_SIZE) == CY_RSLT_SUCCESS);
+    p_data = desc;
+    len = APP_OTA_IMAGE_INFO_LEN - 1;
+    OTA_TEST_CHECK(app_ota_image_info_write(&p_data, &len) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(len == 0);
+    OTA_TEST_CHECK(app_ota_image_info_pending());
+    OTA_TEST_CHECK(!app_ota_image_info_version(&major, &minor, &build));
+    app_ota_image_info_stop();
+
+    /* The same descriptor split in single bytes */
+    OTA_TEST_CHECK(app_ota_image_info_start(true, TEST_IMAGE_INFO_IMAGE_SIZE) == CY_RSLT_SUCCESS);
+    for (pos = 0; pos < APP_OTA_IMAGE_INFO_LEN; pos++)
+    {
+        OTA_TEST_CHECK(app_ota_image_info_pending());
+        p_data = &desc[pos];
+        len = 1;
+        OTA_TEST_CHECK(app_ota_image_info_write(&p_data, &len) == CY_RSLT_SUCCESS);
+        OTA_TEST_CHECK(len == 0);
+    }
+    OTA_TEST_CHECK(!app_ota_image_info_pending());
+    OTA_TEST_CHECK(app_ota_image_info_version(&major, &minor, &build));
+    app_ota_image_info_stop();
+
+    /* Without a descriptor the data passes unchanged and the version is unknown */
+    OTA_TEST_CHECK(app_ota_image_info_start(false, TEST_IMAGE_INFO_IMAGE_SIZE) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(!app_ota_image_info_pending());
+    p_data = desc;
+    len = sizeof(desc);
+    OTA_TEST_CHECK(app_ota_image_info_write(&p_data, &len) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK((p_data == desc) && (len == sizeof(desc)));
+    OTA_TEST_CHECK(!app_ota_image_info_version(&major, &minor, &build));
+    app_ota_image_info_stop();
+
+    /* Refusal notification */
+    OTA_TEST_CHECK(app_ota_image_info_build_reject(APP_OTA_IMAGE_REJECT_BOARD, reject) == APP_OTA_IMAGE_REJECT_LEN);
+    OTA_TEST_CHECK(reject[0] == APP_OTA_STATUS_IMAGE_REJECTED);
+    OTA_TEST_CHECK(reject[1] == APP_OTA_IMAGE_REJECT_BOARD);
+    OTA_TEST_CHECK((reject[2] | (reject[3] << 8)) == APP_OTA_BOARD_ID);
+    OTA_TEST_CHECK((reject[4] == APP_VERSION_MAJOR) && (reject[5] == APP_VERSION_MINOR));
+    OTA_TEST_CHECK((reject[6] | (reject[7] << 8)) == APP_VERSION_BUILD);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the Merkle framed data authentication, framing
+ *              in app_ota_merkle.h. The tree is built here the way
+ *              scripts/Bluetooth/ota_merkle.py builds it, and the header is
+ *              signed with the test key of ota_ecc_pp_host.c.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "cy_ota_api.h"
+#include "app_ota_merkle.h"
+#include "app_ota_sha256.h"
+#include "app_ota_protocol.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_MERKLE_GROUP_SHIFT             (9)
+#define TEST_MERKLE_GROUP_SIZE              (1UL << TEST_MERKLE_GROUP_SHIFT)
+#define TEST_MERKLE_PAYLOAD_SIZE            (5 * TEST_MERKLE_GROUP_SIZE + 100)
+#define TEST_MERKLE_GROUPS                  (6)
+#define TEST_MERKLE_DEPTH                   (3)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static uint8_t test_payload[TEST_MERKLE_PAYLOAD_SIZE];
+static uint8_t test_framed[TEST_MERKLE_PAYLOAD_SIZE + TEST_MERKLE_GROUPS * TEST_MERKLE_DEPTH * APP_OTA_MERKLE_HASH_LEN];
+static uint8_t test_output[TEST_MERKLE_PAYLOAD_SIZE];
+static uint32_t test_output_len;
+
+/* tree[level][index], level 0 are the leaves */
+static uint8_t test_tree[TEST_MERKLE_DEPTH + 1][TEST_MERKLE_GROUPS][APP_OTA_MERKLE_HASH_LEN];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static cy_rslt_t test_merkle_output(const uint8_t *p_data, uint16_t len)
+{
+    if ((test_output_len + len) > sizeof(test_output))
+    {
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    memcpy(&test_output[test_output_len], p_data, len);
+    test_output_len += len;
+    return CY_RSLT_SUCCESS;
+}
+
+static void test_merkle_hash(uint8_t prefix, const uint8_t *p_a, uint32_t a_len, const uint8_t *p_b, uint32_t b_len, uint8_t *p_out)
+{
+    app_ota_sha256_t sha;
+
+    app_ota_sha256_start(&sha);
+    app_ota_sha256_update(&sha, &prefix, 1);
+    app_ota_sha256_update(&sha, p_a, a_len);
+    app_ota_sha256_update(&sha, p_b, b_len);
+    app_ota_sha256_finish(&sha, p_out);
+}
+
+/* Sign the header with the test key */
+static void test_merkle_sign(uint8_t *p_header)
+{
+    uint8_t hash[APP_OTA_MERKLE_HASH_LEN];
+    app_ota_sha256_t sha;
+
+    app_ota_sha256_start(&sha);
+    app_ota_sha256_update(&sha, p_header, APP_OTA_MERKLE_HEADER_LEN);
+    app_ota_sha256_finish(&sha, hash);
+    OTA_TEST_CHECK(ota_test_ecdsa_sign(hash, &p_header[APP_OTA_MERKLE_HEADER_LEN]));
+}
+
+/* Build the tree, the header and the framed payload, returns the framed length */
+static uint32_t test_merkle_build(uint8_t *p_header)
+{
+    uint32_t count = TEST_MERKLE_GROUPS;
+    uint32_t level;
+    uint32_t group;
+    uint32_t pos = 0;
+
+    for (group = 0; group < TEST_MERKLE_GROUPS; group++)
+    {
+        uint32_t offset = group * TEST_MERKLE_GROUP_SIZE;
+        uint32_t len = ((TEST_MERKLE_PAYLOAD_SIZE - offset) < TEST_MERKLE_GROUP_SIZE) ? (TEST_MERKLE_PAYLOAD_SIZE - offset) : TEST_MERKLE_GROUP_SIZE;
+
+        test_merkle_hash(0x00, &test_payload[offset], len, NULL, 0, test_tree[0][group]);
+    }
+    for (level = 0; level < TEST_MERKLE_DEPTH; level++)
+    {
+        uint32_t i;
+
+        for (i = 0; i < (count + 1) / 2; i++)
+        {
+            const uint8_t *p_right = ((2 * i + 1) < count) ? test_tree[level][2 * i + 1] : test_tree[level][2 * i];
+
+            test_merkle_hash(0x01, test_tree[level][2 * i], APP_OTA_MERKLE_HASH_LEN, p_right, APP_OTA_MERKLE_HASH_LEN, test_tree[level + 1][i]);
+        }
+        count = (count + 1) / 2;
+    }
+
+    memset(p_header, 0x00, APP_OTA_MERKLE_HEADER_LEN + APP_OTA_SIGNATURE_LEN);
+    memcpy(p_header, APP_OTA_MERKLE_MAGIC, 4);
+    p_header[4] = APP_OTA_MERKLE_VERSION;
+    p_header[5] = TEST_MERKLE_GROUP_SHIFT;
+    p_header[6] = TEST_MERKLE_DEPTH;
+    p_header[8] = (uint8_t)(TEST_MERKLE_PAYLOAD_SIZE >> 0);
+    p_header[9] = (uint8_t)(TEST_MERKLE_PAYLOAD_SIZE >> 8);
+    p_header[10] = (uint8_t)(TEST_MERKLE_PAYLOAD_SIZE >> 16);
+    p_header[11] = (uint8_t)(TEST_MERKLE_PAYLOAD_SIZE >> 24);
+    memcpy(&p_header[12], test_tree[TEST_MERKLE_DEPTH][0], APP_OTA_MERKLE_HASH_LEN);
+    test_merkle_sign(p_header);
+
+    for (group = 0; group < TEST_MERKLE_GROUPS; group++)
+    {
+        uint32_t offset = group * TEST_MERKLE_GROUP_SIZE;
+        uint32_t len = ((TEST_MERKLE_PAYLOAD_SIZE - offset) < TEST_MERKLE_GROUP_SIZE) ? (TEST_MERKLE_PAYLOAD_SIZE - offset) : TEST_MERKLE_GROUP_SIZE;
+        uint32_t index = group;
+        uint32_t nodes = TEST_MERKLE_GROUPS;
+
+        for (level = 0; level < TEST_MERKLE_DEPTH; level++)
+        {
+            uint32_t sibling = ((index ^ 1) < nodes) ? (index ^ 1) : index;
+
+            memcpy(&test_framed[pos], test_tree[level][sibling], APP_OTA_MERKLE_HASH_LEN);
+            pos += APP_OTA_MERKLE_HASH_LEN;
+            index >>= 1;
+            nodes = (nodes + 1) / 2;
+        }
+        memcpy(&test_framed[pos], &test_payload[offset], len);
+        pos += len;
+    }
+
+    return pos;
+}
+
+/* Session with the framed data sent in chunks of chunk_len, returns the first error */
+static cy_rslt_t test_merkle_run(const uint8_t *p_header, uint32_t framed_len, uint32_t chunk_len)
+{
+    cy_rslt_t result;
+    uint32_t pos;
+
+    test_output_len = 0;
+    app_ota_merkle_start();
+    result = app_ota_merkle_set_header(p_header, APP_OTA_MERKLE_HEADER_LEN + APP_OTA_SIGNATURE_LEN);
+    for (pos = 0; (pos < framed_len) && (result == CY_RSLT_SUCCESS); pos += chunk_len)
+    {
+        uint32_t len = ((framed_len - pos) < chunk_len) ? (framed_len - pos) : chunk_len;
+
+        result = app_ota_merkle_write(&test_framed[pos], (uint16_t)len);
+    }
+
+    return result;
+}
+
+void test_merkle(void)
+{
+    static const uint32_t chunks[] = { 1, 31, 244, 509 };
+    uint8_t header[APP_OTA_MERKLE_HEADER_LEN + APP_OTA_SIGNATURE_LEN];
+    uint32_t framed_len;
+    uint32_t i;
+
+    app_ota_merkle_init(test_merkle_output);
+    ota_test_fill(test_payload, sizeof(test_payload), 5);
+    framed_len = test_merkle_build(header);
+
+    for (i = 0; i < (sizeof(chunks) / sizeof(chunks[0])); i++)
+    {
+        OTA_TEST_CHECK(test_merkle_run(header, framed_len, chunks[i]) == CY_RSLT_SUCCESS);
+        OTA_TEST_CHECK(app_ota_merkle_complete());
+        OTA_TEST_CHECK((test_output_len == sizeof(test_payload)) && (memcmp(test_output, test_payload, sizeof(test_payload)) == 0));
+        app_ota_merkle_stop();
+    }
+
+    /* A session cut short is not complete */
+    OTA_TEST_CHECK(test_merkle_run(header, framed_len - 1, 244) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(!app_ota_merkle_complete());
+    app_ota_merkle_stop();
+
+    /* A changed byte in group 2 stops the data at the group, nothing of it is passed on */
+    test_framed[2 * (TEST_MERKLE_DEPTH * APP_OTA_MERKLE_HASH_LEN + TEST_MERKLE_GROUP_SIZE) + 200] ^= 0x01;
+    OTA_TEST_CHECK(test_merkle_run(header, framed_len, 244) == CY_RSLT_OTA_ERROR_VERIFY);
+    OTA_TEST_CHECK(test_output_len == 2 * TEST_MERKLE_GROUP_SIZE);
+    OTA_TEST_CHECK(app_ota_merkle_write(test_framed, 1) == CY_RSLT_OTA_ERROR_VERIFY);
+    OTA_TEST_CHECK(!app_ota_merkle_complete());
+    app_ota_merkle_stop();
+    test_framed[2 * (TEST_MERKLE_DEPTH * APP_OTA_MERKLE_HASH_LEN + TEST_MERKLE_GROUP_SIZE) + 200] ^= 0x01;
+
+    /* A header with a bad signature or a depth that does not match is refused, and so is the data */
+    header[APP_OTA_MERKLE_HEADER_LEN] ^= 0x01;
+    OTA_TEST_CHECK(test_merkle_run(header, framed_len, 244) != CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_output_len == 0);
+    app_ota_merkle_stop();
+    header[APP_OTA_MERKLE_HEADER_LEN] ^= 0x01;
+
+    header[6] = TEST_MERKLE_DEPTH + 1;
+    OTA_TEST_CHECK(test_merkle_run(header, framed_len, 244) != CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_output_len == 0);
+    app_ota_merkle_stop();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the GATT buffer pool.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_bt_pool.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+void test_pool(void)
+{
+    uint8_t *small[APP_BT_POOL_SMALL_COUNT];
+    uint8_t *large[APP_BT_POOL_LARGE_COUNT];
+    app_bt_pool_stats_t stats;
+    uint8_t *p;
+    uint32_t i;
+
+    app_bt_pool_init();
+    OTA_TEST_CHECK(app_bt_pool_num_classes() == 2);
+
+    /* The smallest class that fits, every block distinct, aligned and writable */
+    for (i = 0; i < APP_BT_POOL_SMALL_COUNT; i++)
+    {
+        small[i] = app_bt_pool_alloc(APP_BT_POOL_SMALL_SIZE);
+        OTA_TEST_CHECK(small[i] != NULL);
+        OTA_TEST_CHECK(((uintptr_t)small[i] % 8) == 0);
+        memset(small[i], (int)i, APP_BT_POOL_SMALL_SIZE);
+    }
+    for (i = 1; i < APP_BT_POOL_SMALL_COUNT; i++)
+    {
+        OTA_TEST_CHECK((small[i] != small[i - 1]) && (small[i - 1][APP_BT_POOL_SMALL_SIZE - 1] == (uint8_t)(i - 1)));
+    }
+
+    /* A full small class spills into the large one, until that is full too */
+    for (i = 0; i < APP_BT_POOL_LARGE_COUNT; i++)
+    {
+        large[i] = app_bt_pool_alloc(1);
+        OTA_TEST_CHECK(large[i] != NULL);
+    }
+    OTA_TEST_CHECK(app_bt_pool_alloc(1) == NULL);
+    OTA_TEST_CHECK(app_bt_pool_alloc(APP_BT_POOL_LARGE_SIZE + 1) == NULL);
+
+    OTA_TEST_CHECK(app_bt_pool_get_stats(0, &stats));
+    OTA_TEST_CHECK((stats.in_use == APP_BT_POOL_SMALL_COUNT) && (stats.exhausted == APP_BT_POOL_LARGE_COUNT + 1));
+    OTA_TEST_CHECK(app_bt_pool_get_stats(1, &stats));
+    OTA_TEST_CHECK((stats.in_use == APP_BT_POOL_LARGE_COUNT) && (stats.high_water == APP_BT_POOL_LARGE_COUNT));
+    OTA_TEST_CHECK(!app_bt_pool_get_stats(2, &stats));
+
+    /* A freed block is handed out again */
+    p = large[1];
+    app_bt_pool_free(p);
+    OTA_TEST_CHECK(app_bt_pool_alloc(APP_BT_POOL_LARGE_SIZE) == p);
+
+    for (i = 0; i < APP_BT_POOL_SMALL_COUNT; i++)
+    {
+        app_bt_pool_free(small[i]);
+    }
+    for (i = 0; i < APP_BT_POOL_LARGE_COUNT; i++)
+    {
+        app_bt_pool_free(large[i]);
+    }
+    app_bt_pool_free(NULL);
+    OTA_TEST_CHECK(app_bt_pool_get_stats(0, &stats) && (stats.in_use == 0) && (stats.high_water == APP_BT_POOL_SMALL_COUNT));
+    OTA_TEST_CHECK(app_bt_pool_get_stats(1, &stats) && (stats.in_use == 0));
+}
+
+/* [] END OF FILE */
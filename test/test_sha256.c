@@ -0,0 +1,110 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the software SHA-256, FIPS 180-2 examples.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_ota_sha256.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static const uint8_t sha256_abc[APP_OTA_SHA256_HASH_LEN] =
+{
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+};
+
+static const uint8_t sha256_empty[APP_OTA_SHA256_HASH_LEN] =
+{
+    0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+    0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55,
+};
+
+static const uint8_t sha256_two_blocks[APP_OTA_SHA256_HASH_LEN] =
+{
+    0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+    0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1,
+};
+
+static const uint8_t sha256_million_a[APP_OTA_SHA256_HASH_LEN] =
+{
+    0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+    0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0,
+};
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+static void test_sha256_hash(const char *p_msg, uint8_t hash[APP_OTA_SHA256_HASH_LEN])
+{
+    app_ota_sha256_t sha;
+
+    app_ota_sha256_start(&sha);
+    app_ota_sha256_update(&sha, (const uint8_t *)p_msg, (uint32_t)strlen(p_msg));
+    app_ota_sha256_finish(&sha, hash);
+}
+
+void test_sha256(void)
+{
+    static uint8_t buf[1001];
+    uint8_t hash[APP_OTA_SHA256_HASH_LEN];
+    uint8_t whole[APP_OTA_SHA256_HASH_LEN];
+    app_ota_sha256_t sha;
+    uint32_t i;
+
+    test_sha256_hash("abc", hash);
+    OTA_TEST_CHECK(memcmp(hash, sha256_abc, sizeof(hash)) == 0);
+
+    test_sha256_hash("", hash);
+    OTA_TEST_CHECK(memcmp(hash, sha256_empty, sizeof(hash)) == 0);
+
+    /* The padding does not fit the first block */
+    test_sha256_hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", hash);
+    OTA_TEST_CHECK(memcmp(hash, sha256_two_blocks, sizeof(hash)) == 0);
+
+    /* A million times 'a', in updates that do not line up with the blocks */
+    memset(buf, 'a', sizeof(buf));
+    app_ota_sha256_start(&sha);
+    for (i = 0; i < 1000; i++)
+    {
+        app_ota_sha256_update(&sha, buf, ((i % 2) == 0) ? 999 : 1001);
+    }
+    app_ota_sha256_finish(&sha, hash);
+    OTA_TEST_CHECK(memcmp(hash, sha256_million_a, sizeof(hash)) == 0);
+
+    /* Byte by byte and in one update give the same hash */
+    ota_test_fill(buf, sizeof(buf), 2);
+    app_ota_sha256_start(&sha);
+    app_ota_sha256_update(&sha, buf, sizeof(buf));
+    app_ota_sha256_finish(&sha, whole);
+    app_ota_sha256_start(&sha);
+    for (i = 0; i < sizeof(buf); i++)
+    {
+        app_ota_sha256_update(&sha, &buf[i], 1);
+    }
+    app_ota_sha256_finish(&sha, hash);
+    OTA_TEST_CHECK(memcmp(hash, whole, sizeof(hash)) == 0);
+}
+
+/* [] END OF FILE */
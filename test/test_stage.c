@@ -0,0 +1,595 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host simulator of the staging layer. The storage thread runs
+ *              on a POSIX thread and programs a simulated flash with a fixed
+ *              cost per program operation. The same image is written once
+ *              per DATA packet, as before the staging layer, and once through
+ *              the ring, and the number of program operations and the time
+ *              spent in the DATA write path are printed for both. The
+ *              finish on VERIFY reads the simulated flash back. A data
+ *              callback that expands every byte stands in for the decoder.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_ota_stage.h"
+#include "app_ota_crc32.h"
+#include "app_ota_sha256.h"
+#include "app_ota_verify.h"
+#include "app_ota_protocol.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_STAGE_IMAGE_SIZE               ((16 * APP_OTA_STAGE_BLOCK_SIZE) + 1000)
+/* Image of the resumed sessions, the part after the first block fits the ring */
+#define TEST_STAGE_RESUME_SIZE              ((3 * APP_OTA_STAGE_BLOCK_SIZE) + 500)
+#define TEST_STAGE_PACKET_LEN               (244)       /* DATA write of a 247 byte ATT MTU */
+#define TEST_STAGE_FLASH_OP_US              (200)       /* cost of one program operation    */
+#define TEST_STAGE_EVENT_TIMEOUT_MS         (2000)
+#define TEST_STAGE_EXPAND                   (16)        /* image bytes per received byte    */
+#define TEST_STAGE_EXPAND_INPUT             (4000)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static uint8_t test_image[TEST_STAGE_IMAGE_SIZE];
+static uint8_t test_flash[TEST_STAGE_IMAGE_SIZE];
+static uint32_t test_flash_len;
+
+/* Simulated flash, only touched by the storage thread while the ring is in use */
+static volatile uint32_t test_flash_ops;
+static volatile uint32_t test_flash_unaligned;
+static volatile uint32_t test_flash_reads;
+static volatile uint32_t test_flash_fail_at;        /* program operation to fail, 0 for none */
+static volatile bool test_flash_hold;               /* stall the storage thread              */
+static volatile bool test_flash_corrupt;            /* flip a bit of the data read back      */
+static volatile bool test_flash_skip;               /* let unchanged blocks be compared      */
+static volatile uint32_t test_flash_skipped;        /* blocks reported as skipped            */
+
+/* Data callback, run by the storage thread */
+static volatile uint32_t test_stage_expand;         /* image bytes per received byte, 0 to pass through */
+static volatile bool test_stage_data_fail;          /* refuse the data like a failed check              */
+
+/* Events of the storage thread */
+static pthread_mutex_t test_event_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t test_event_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t test_events[APP_OTA_STAGE_EVT_DONE + 1];
+
+static int test_context;
+static cy_ota_storage_context_t test_storage;
+
+/* Checkpoint reader, like the Bluetooth® stack thread on APP_OTA_STAGE_EVT_COMMIT */
+static volatile bool test_checkpoint_stop;
+static uint32_t test_checkpoint_reads;
+static uint32_t test_checkpoint_torn;
+
+static volatile uint32_t test_job_arg;              /* argument of the last job run */
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/* Stand-ins for the modules the staging layer reports to */
+uint32_t app_ota_metrics_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((ts.tv_sec * 1000000L) + (ts.tv_nsec / 1000L));
+}
+
+void app_ota_timing_commit(uint32_t elapsed_us)
+{
+    (void)elapsed_us;
+}
+
+void app_ota_stats_flash_busy(uint32_t elapsed_us)
+{
+    (void)elapsed_us;
+}
+
+bool app_ota_erase_ahead(void)
+{
+    return false;
+}
+
+bool app_ota_erase_may_skip(uint32_t offset, uint32_t len)
+{
+    (void)offset;
+    (void)len;
+    return test_flash_skip;
+}
+
+void app_ota_erase_skipped(uint32_t offset, uint32_t len)
+{
+    (void)offset;
+    (void)len;
+    test_flash_skipped++;
+}
+
+cy_rslt_t cy_ota_storage_read(cy_ota_storage_context_t *storage_ptr, cy_ota_storage_read_info_t *chunk_info)
+{
+    if ((storage_ptr != &test_storage) || ((chunk_info->offset + chunk_info->size) > test_flash_len))
+    {
+        return CY_RSLT_OTA_ERROR_READ_STORAGE;
+    }
+    memcpy(chunk_info->buffer, &test_flash[chunk_info->offset], chunk_info->size);
+    test_flash_reads++;
+    if (test_flash_corrupt && (chunk_info->offset == 0))
+    {
+        chunk_info->buffer[0] ^= 0x01;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_ble_download_write(cy_ota_context_ptr ota_ptr, uint8_t *data_buf, uint16_t len, uint16_t offset)
+{
+    (void)ota_ptr;
+    (void)offset;
+
+    while (test_flash_hold)
+    {
+        usleep(1000);
+    }
+    test_flash_ops++;
+    if (test_flash_ops == test_flash_fail_at)
+    {
+        return CY_RSLT_OTA_ERROR_WRITE_STORAGE;
+    }
+    /* The library writes where the previous write ended */
+    if ((test_storage.total_bytes_written % APP_OTA_STAGE_BLOCK_SIZE) != 0)
+    {
+        test_flash_unaligned++;
+    }
+    if ((test_storage.total_bytes_written + len) <= sizeof(test_flash))
+    {
+        memcpy(&test_flash[test_storage.total_bytes_written], data_buf, len);
+    }
+    test_storage.total_bytes_written += len;
+    if (test_storage.total_bytes_written > test_flash_len)
+    {
+        test_flash_len = test_storage.total_bytes_written;
+    }
+    usleep(TEST_STAGE_FLASH_OP_US);
+
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t test_stage_data_callback(const uint8_t *p_data, uint16_t len)
+{
+    uint8_t expanded[TEST_STAGE_EXPAND];
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint16_t i;
+
+    if (test_stage_data_fail)
+    {
+        return CY_RSLT_OTA_ERROR_VERIFY;
+    }
+    if (test_stage_expand == 0)
+    {
+        return app_ota_stage_output(p_data, len);
+    }
+    for (i = 0; (i < len) && (result == CY_RSLT_SUCCESS); i++)
+    {
+        memset(expanded, p_data[i], test_stage_expand);
+        result = app_ota_stage_output(expanded, test_stage_expand);
+    }
+    return result;
+}
+
+static void test_stage_callback(app_ota_stage_evt_t event, cy_rslt_t result)
+{
+    (void)result;
+
+    pthread_mutex_lock(&test_event_mutex);
+    test_events[event]++;
+    pthread_cond_broadcast(&test_event_cond);
+    pthread_mutex_unlock(&test_event_mutex);
+}
+
+static uint32_t test_stage_events(app_ota_stage_evt_t event)
+{
+    uint32_t count;
+
+    pthread_mutex_lock(&test_event_mutex);
+    count = test_events[event];
+    pthread_mutex_unlock(&test_event_mutex);
+    return count;
+}
+
+/* Wait until an event was raised more than seen times */
+static bool test_stage_wait_event(app_ota_stage_evt_t event, uint32_t seen)
+{
+    struct timespec deadline;
+    bool raised = true;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += TEST_STAGE_EVENT_TIMEOUT_MS / 1000;
+
+    pthread_mutex_lock(&test_event_mutex);
+    while (raised && (test_events[event] <= seen))
+    {
+        raised = (pthread_cond_timedwait(&test_event_cond, &test_event_mutex, &deadline) == 0);
+    }
+    pthread_mutex_unlock(&test_event_mutex);
+    return raised;
+}
+
+/* VERIFY: write the tail, read the image back and wait for the outcome */
+static cy_rslt_t test_stage_finish(void)
+{
+    uint32_t done = test_stage_events(APP_OTA_STAGE_EVT_DONE);
+    cy_rslt_t result = app_ota_stage_finish(&test_storage);
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+    if (!test_stage_wait_event(APP_OTA_STAGE_EVT_DONE, done))
+    {
+        return CY_RSLT_OTA_ERROR_GENERAL;
+    }
+    return app_ota_stage_error();
+}
+
+static void test_stage_reset_flash(void)
+{
+    test_flash_ops = 0;
+    test_flash_unaligned = 0;
+    test_flash_reads = 0;
+    test_flash_len = 0;
+    test_flash_fail_at = 0;
+    test_flash_corrupt = false;
+    test_flash_skip = false;
+    test_flash_skipped = 0;
+    test_storage.total_bytes_written = 0;
+    memset(test_flash, 0x00, sizeof(test_flash));
+}
+
+static void *test_stage_release(void *arg)
+{
+    (void)arg;
+    usleep(20000);
+    test_flash_hold = false;
+    return NULL;
+}
+
+static void *test_stage_checkpoint_reader(void *arg)
+{
+    uint32_t last_offset = 0xFFFFFFFFUL;
+    uint32_t last_crc32 = 0;
+
+    (void)arg;
+    while (!test_checkpoint_stop)
+    {
+        uint32_t offset;
+        uint32_t crc32;
+
+        app_ota_stage_checkpoint(&offset, &crc32);
+        test_checkpoint_reads++;
+        if (offset != last_offset)
+        {
+            last_offset = offset;
+            last_crc32 = (offset <= TEST_STAGE_IMAGE_SIZE) ? app_ota_crc32_update(APP_OTA_CRC32_INIT, test_image, offset) : 0;
+        }
+        if (crc32 != last_crc32)
+        {
+            test_checkpoint_torn++;
+        }
+    }
+    return NULL;
+}
+
+static void test_stage_job(uint32_t arg)
+{
+    test_job_arg = arg;
+}
+
+/* Signature of the first size bytes of the test image */
+static bool test_stage_sign(uint32_t size, uint8_t *p_signature)
+{
+    uint8_t hash[APP_OTA_SHA256_HASH_LEN];
+    app_ota_sha256_t sha;
+
+    app_ota_sha256_start(&sha);
+    app_ota_sha256_update(&sha, test_image, size);
+    app_ota_sha256_finish(&sha, hash);
+    return ota_test_ecdsa_sign(hash, p_signature);
+}
+
+/*
+ * The DATA writes of a host that waits for each write response, timed like
+ * the Bluetooth® stack callback
+ */
+static bool test_stage_transfer(uint32_t size, uint32_t *p_max_us, uint32_t *p_total_us)
+{
+    uint32_t pos;
+    bool ok = true;
+
+    *p_max_us = 0;
+    *p_total_us = 0;
+    for (pos = 0; ok && (pos < size); pos += TEST_STAGE_PACKET_LEN)
+    {
+        uint32_t len = ((size - pos) < TEST_STAGE_PACKET_LEN) ? (size - pos) : TEST_STAGE_PACKET_LEN;
+        uint32_t start_us = app_ota_metrics_now_us();
+        uint32_t rooms = test_stage_events(APP_OTA_STAGE_EVT_ROOM);
+        uint32_t elapsed_us;
+        bool room;
+
+        ok = (app_ota_stage_write(&test_image[pos], len) == CY_RSLT_SUCCESS);
+        room = app_ota_stage_has_room();
+        elapsed_us = app_ota_metrics_now_us() - start_us;
+        *p_total_us += elapsed_us;
+        if (elapsed_us > *p_max_us)
+        {
+            *p_max_us = elapsed_us;
+        }
+
+        /* The write response is held back, the host waits for it */
+        while (ok && !room)
+        {
+            ok = test_stage_wait_event(APP_OTA_STAGE_EVT_ROOM, rooms);
+            rooms = test_stage_events(APP_OTA_STAGE_EVT_ROOM);
+            room = app_ota_stage_has_room();
+        }
+    }
+    return ok;
+}
+
+void test_stage(void)
+{
+    uint32_t direct_ops;
+    uint32_t direct_max_us = 0;
+    uint32_t direct_total_us = 0;
+    uint32_t staged_max_us;
+    uint32_t staged_total_us;
+    uint32_t packets = 0;
+    uint32_t pos;
+    uint32_t errors;
+    pthread_t release;
+    pthread_t checkpoint_reader;
+    uint8_t signature[APP_OTA_SIGNATURE_LEN];
+    uint8_t resume_signature[APP_OTA_SIGNATURE_LEN];
+    static uint8_t overrun[APP_OTA_STAGE_NUM_BLOCKS * APP_OTA_STAGE_BLOCK_SIZE];
+
+    ota_test_fill(test_image, sizeof(test_image), 0x5747);
+    OTA_TEST_CHECK(test_stage_sign(TEST_STAGE_IMAGE_SIZE, signature));
+    OTA_TEST_CHECK(test_stage_sign(TEST_STAGE_RESUME_SIZE, resume_signature));
+    OTA_TEST_CHECK(app_ota_stage_init(test_stage_callback, test_stage_data_callback) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(app_ota_stage_write(test_image, 1) == CY_RSLT_OTA_ERROR_BADARG);
+
+    /* Before the staging layer: one program operation per DATA write, in the callback */
+    test_stage_reset_flash();
+    for (pos = 0; pos < TEST_STAGE_IMAGE_SIZE; pos += TEST_STAGE_PACKET_LEN)
+    {
+        uint32_t len = ((TEST_STAGE_IMAGE_SIZE - pos) < TEST_STAGE_PACKET_LEN) ? (TEST_STAGE_IMAGE_SIZE - pos) : TEST_STAGE_PACKET_LEN;
+        uint32_t start_us = app_ota_metrics_now_us();
+        uint32_t elapsed_us;
+
+        (void)cy_ota_ble_download_write(&test_context, &test_image[pos], (uint16_t)len, 0);
+        elapsed_us = app_ota_metrics_now_us() - start_us;
+        direct_total_us += elapsed_us;
+        if (elapsed_us > direct_max_us)
+        {
+            direct_max_us = elapsed_us;
+        }
+        packets++;
+    }
+    direct_ops = test_flash_ops;
+    OTA_TEST_CHECK(direct_ops == packets);
+
+    /* Through the ring: whole blocks on block boundaries, then the tail, hashed as they are committed */
+    test_stage_reset_flash();
+    app_ota_verify_start(TEST_STAGE_IMAGE_SIZE);
+    app_ota_stage_start(&test_context);
+    test_checkpoint_stop = false;
+    OTA_TEST_CHECK(pthread_create(&checkpoint_reader, NULL, test_stage_checkpoint_reader, NULL) == 0);
+    OTA_TEST_CHECK(test_stage_transfer(TEST_STAGE_IMAGE_SIZE, &staged_max_us, &staged_total_us));
+    OTA_TEST_CHECK(app_ota_stage_received() == TEST_STAGE_IMAGE_SIZE);
+    app_ota_verify_set_signature(signature);
+    OTA_TEST_CHECK(test_stage_finish() == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_flash_ops == ((TEST_STAGE_IMAGE_SIZE + APP_OTA_STAGE_BLOCK_SIZE - 1) / APP_OTA_STAGE_BLOCK_SIZE));
+    OTA_TEST_CHECK(test_flash_unaligned == 0);
+    OTA_TEST_CHECK(test_flash_len == TEST_STAGE_IMAGE_SIZE);
+    OTA_TEST_CHECK(memcmp(test_flash, test_image, TEST_STAGE_IMAGE_SIZE) == 0);
+    OTA_TEST_CHECK(app_ota_stage_committed() == TEST_STAGE_IMAGE_SIZE);
+    OTA_TEST_CHECK(app_ota_stage_committed_crc32() == app_ota_crc32_update(APP_OTA_CRC32_INIT, test_image, TEST_STAGE_IMAGE_SIZE));
+#if APP_OTA_STAGE_READ_BACK
+    OTA_TEST_CHECK(app_ota_stage_read_back_crc32() == app_ota_stage_committed_crc32());
+#else
+    /* The image was hashed as it was stored, VERIFY does not read the slot */
+    OTA_TEST_CHECK(test_flash_reads == 0);
+#endif
+    test_checkpoint_stop = true;
+    pthread_join(checkpoint_reader, NULL);
+    OTA_TEST_CHECK(test_checkpoint_reads != 0);
+    OTA_TEST_CHECK(test_checkpoint_torn == 0);
+    OTA_TEST_CHECK(app_ota_stage_depth() == 0);
+    OTA_TEST_CHECK(staged_total_us < direct_total_us);
+
+    printf("  %lu bytes in %lu writes: direct %lu program operations, %lu us per write (max %lu),"
+           " staged %lu program operations, %lu us per write (max %lu)\n",
+           (unsigned long)TEST_STAGE_IMAGE_SIZE, (unsigned long)packets,
+           (unsigned long)direct_ops, (unsigned long)(direct_total_us / packets), (unsigned long)direct_max_us,
+           (unsigned long)test_flash_ops, (unsigned long)(staged_total_us / packets), (unsigned long)staged_max_us);
+
+    /* A resumed image is hashed from the slot at the finish */
+    test_stage_reset_flash();
+    memcpy(test_flash, test_image, APP_OTA_STAGE_BLOCK_SIZE);
+    test_flash_len = APP_OTA_STAGE_BLOCK_SIZE;
+    test_storage.total_bytes_written = APP_OTA_STAGE_BLOCK_SIZE;
+    app_ota_verify_start(TEST_STAGE_RESUME_SIZE);
+    app_ota_stage_start(&test_context);
+    app_ota_stage_resume(APP_OTA_STAGE_BLOCK_SIZE, app_ota_crc32_update(APP_OTA_CRC32_INIT, test_image, APP_OTA_STAGE_BLOCK_SIZE));
+    OTA_TEST_CHECK(app_ota_stage_write(&test_image[APP_OTA_STAGE_BLOCK_SIZE], TEST_STAGE_RESUME_SIZE - APP_OTA_STAGE_BLOCK_SIZE) == CY_RSLT_SUCCESS);
+    app_ota_verify_set_signature(resume_signature);
+    OTA_TEST_CHECK(test_stage_finish() == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK((test_flash_len == TEST_STAGE_RESUME_SIZE) && (memcmp(test_flash, test_image, TEST_STAGE_RESUME_SIZE) == 0));
+
+    /* So is a slot that does not hold the signed image */
+    test_stage_reset_flash();
+    test_flash_len = APP_OTA_STAGE_BLOCK_SIZE;
+    test_storage.total_bytes_written = APP_OTA_STAGE_BLOCK_SIZE;
+    app_ota_verify_start(TEST_STAGE_RESUME_SIZE);
+    app_ota_stage_start(&test_context);
+    app_ota_stage_resume(APP_OTA_STAGE_BLOCK_SIZE, APP_OTA_CRC32_INIT);
+    OTA_TEST_CHECK(app_ota_stage_write(&test_image[APP_OTA_STAGE_BLOCK_SIZE], TEST_STAGE_RESUME_SIZE - APP_OTA_STAGE_BLOCK_SIZE) == CY_RSLT_SUCCESS);
+    app_ota_verify_set_signature(resume_signature);
+    OTA_TEST_CHECK(test_stage_finish() == CY_RSLT_OTA_ERROR_VERIFY);
+
+    /* Blocks the slot already holds are compared and skipped, the library's offset moves past them */
+    test_stage_reset_flash();
+    memcpy(test_flash, test_image, TEST_STAGE_IMAGE_SIZE);
+    test_flash[(2 * APP_OTA_STAGE_BLOCK_SIZE) + 10] ^= 0x01;
+    test_flash[TEST_STAGE_IMAGE_SIZE - 1] ^= 0x01;
+    test_flash_len = TEST_STAGE_IMAGE_SIZE;
+    test_flash_skip = true;
+    app_ota_verify_start(TEST_STAGE_IMAGE_SIZE);
+    app_ota_stage_start(&test_context);
+    app_ota_stage_skip_unchanged(&test_storage);
+    OTA_TEST_CHECK(test_stage_transfer(TEST_STAGE_IMAGE_SIZE, &staged_max_us, &staged_total_us));
+    app_ota_verify_set_signature(signature);
+    OTA_TEST_CHECK(test_stage_finish() == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_flash_ops == 2);
+    OTA_TEST_CHECK(app_ota_stage_skipped() == (((TEST_STAGE_IMAGE_SIZE + APP_OTA_STAGE_BLOCK_SIZE - 1) / APP_OTA_STAGE_BLOCK_SIZE) - 2));
+    OTA_TEST_CHECK(test_flash_skipped == app_ota_stage_skipped());
+    OTA_TEST_CHECK(test_flash_unaligned == 0);
+    OTA_TEST_CHECK(test_storage.total_bytes_written == TEST_STAGE_IMAGE_SIZE);
+    OTA_TEST_CHECK(memcmp(test_flash, test_image, TEST_STAGE_IMAGE_SIZE) == 0);
+    OTA_TEST_CHECK(app_ota_stage_committed_crc32() == app_ota_crc32_update(APP_OTA_CRC32_INIT, test_image, TEST_STAGE_IMAGE_SIZE));
+
+    /* Without the option every block is programmed */
+    test_stage_reset_flash();
+    test_flash_skip = true;
+    app_ota_stage_start(&test_context);
+    OTA_TEST_CHECK(test_stage_transfer(TEST_STAGE_IMAGE_SIZE, &staged_max_us, &staged_total_us));
+    OTA_TEST_CHECK(test_stage_finish() == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_flash_ops == ((TEST_STAGE_IMAGE_SIZE + APP_OTA_STAGE_BLOCK_SIZE - 1) / APP_OTA_STAGE_BLOCK_SIZE));
+    OTA_TEST_CHECK((app_ota_stage_skipped() == 0) && (test_flash_skipped == 0));
+
+    /* Data that expands many times over is written by the storage thread, the host only waits for room */
+    test_stage_reset_flash();
+    app_ota_stage_start(&test_context);
+    test_stage_expand = TEST_STAGE_EXPAND;
+    errors = test_stage_events(APP_OTA_STAGE_EVT_ERROR);
+    OTA_TEST_CHECK(test_stage_transfer(TEST_STAGE_EXPAND_INPUT, &staged_max_us, &staged_total_us));
+    OTA_TEST_CHECK(test_stage_finish() == CY_RSLT_SUCCESS);
+    test_stage_expand = 0;
+    OTA_TEST_CHECK(test_stage_events(APP_OTA_STAGE_EVT_ERROR) == errors);
+    OTA_TEST_CHECK(test_flash_len == (TEST_STAGE_EXPAND * TEST_STAGE_EXPAND_INPUT));
+    OTA_TEST_CHECK(test_flash_unaligned == 0);
+    OTA_TEST_CHECK(test_flash_ops == (((TEST_STAGE_EXPAND * TEST_STAGE_EXPAND_INPUT) + APP_OTA_STAGE_BLOCK_SIZE - 1) / APP_OTA_STAGE_BLOCK_SIZE));
+    for (pos = 0; pos < (TEST_STAGE_EXPAND * TEST_STAGE_EXPAND_INPUT); pos++)
+    {
+        if (test_flash[pos] != test_image[pos / TEST_STAGE_EXPAND])
+        {
+            break;
+        }
+    }
+    OTA_TEST_CHECK(pos == (TEST_STAGE_EXPAND * TEST_STAGE_EXPAND_INPUT));
+    OTA_TEST_CHECK(app_ota_stage_committed() == (TEST_STAGE_EXPAND * TEST_STAGE_EXPAND_INPUT));
+#if APP_OTA_STAGE_READ_BACK
+    OTA_TEST_CHECK(app_ota_stage_read_back_crc32() == app_ota_stage_committed_crc32());
+#endif
+
+    /* A host that ignores the flow control is refused instead of blocking the callback */
+    test_stage_reset_flash();
+    app_ota_stage_start(&test_context);
+    test_flash_hold = true;
+    OTA_TEST_CHECK(app_ota_stage_fits(sizeof(overrun)));
+    OTA_TEST_CHECK(!app_ota_stage_fits(sizeof(overrun) + 1));
+    OTA_TEST_CHECK(app_ota_stage_write(overrun, sizeof(overrun)) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(!app_ota_stage_fits(1));
+    OTA_TEST_CHECK(app_ota_stage_write(overrun, 1) == CY_RSLT_OTA_ERROR_OUT_OF_MEMORY);
+    OTA_TEST_CHECK(!app_ota_stage_has_room());
+    pos = test_stage_events(APP_OTA_STAGE_EVT_ROOM);
+    test_flash_hold = false;
+    OTA_TEST_CHECK(test_stage_wait_event(APP_OTA_STAGE_EVT_ROOM, pos));
+    OTA_TEST_CHECK(test_stage_finish() == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(app_ota_stage_has_room());
+
+#if APP_OTA_STAGE_READ_BACK
+    /* The read back covers the flash, not what was received */
+    test_stage_reset_flash();
+    app_ota_stage_start(&test_context);
+    test_flash_corrupt = true;
+    OTA_TEST_CHECK(app_ota_stage_write(test_image, 5000) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_stage_finish() == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(app_ota_stage_committed_crc32() == app_ota_crc32_update(APP_OTA_CRC32_INIT, test_image, 5000));
+    OTA_TEST_CHECK(app_ota_stage_read_back_crc32() != app_ota_stage_committed_crc32());
+#endif
+
+    /* Abort drops what the storage thread has not started on */
+    test_stage_reset_flash();
+    app_ota_stage_start(&test_context);
+    test_flash_hold = true;
+    OTA_TEST_CHECK(app_ota_stage_write(overrun, 3 * APP_OTA_STAGE_BLOCK_SIZE) == CY_RSLT_SUCCESS);
+    usleep(10000);
+    OTA_TEST_CHECK(pthread_create(&release, NULL, test_stage_release, NULL) == 0);
+    app_ota_stage_abort();
+    pthread_join(release, NULL);
+    OTA_TEST_CHECK(test_flash_ops <= 1);
+    OTA_TEST_CHECK(app_ota_stage_write(overrun, 1) == CY_RSLT_OTA_ERROR_BADARG);
+
+    /* A storage error is reported once and sticks until the next session */
+    test_stage_reset_flash();
+    app_ota_stage_start(&test_context);
+    test_flash_fail_at = 2;
+    errors = test_stage_events(APP_OTA_STAGE_EVT_ERROR);
+    OTA_TEST_CHECK(app_ota_stage_write(test_image, 3 * APP_OTA_STAGE_BLOCK_SIZE) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_stage_wait_event(APP_OTA_STAGE_EVT_ERROR, errors));
+    OTA_TEST_CHECK(app_ota_stage_error() == CY_RSLT_OTA_ERROR_WRITE_STORAGE);
+    OTA_TEST_CHECK(app_ota_stage_write(test_image, 1) == CY_RSLT_OTA_ERROR_WRITE_STORAGE);
+    OTA_TEST_CHECK(test_stage_finish() == CY_RSLT_OTA_ERROR_WRITE_STORAGE);
+    OTA_TEST_CHECK(app_ota_stage_committed() == APP_OTA_STAGE_BLOCK_SIZE);
+    OTA_TEST_CHECK(test_stage_events(APP_OTA_STAGE_EVT_ERROR) == (errors + 1));
+    app_ota_stage_start(&test_context);
+    OTA_TEST_CHECK(app_ota_stage_error() == CY_RSLT_SUCCESS);
+
+    /* So is data refused by the data callback */
+    test_stage_reset_flash();
+    app_ota_stage_start(&test_context);
+    test_stage_data_fail = true;
+    errors = test_stage_events(APP_OTA_STAGE_EVT_ERROR);
+    OTA_TEST_CHECK(app_ota_stage_write(test_image, APP_OTA_STAGE_BLOCK_SIZE) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_stage_wait_event(APP_OTA_STAGE_EVT_ERROR, errors));
+    OTA_TEST_CHECK(app_ota_stage_error() == CY_RSLT_OTA_ERROR_VERIFY);
+    OTA_TEST_CHECK(test_flash_ops == 0);
+    test_stage_data_fail = false;
+    app_ota_stage_abort();
+
+    /* Work handed to the storage thread runs there with its argument */
+    test_job_arg = 0;
+    OTA_TEST_CHECK(app_ota_stage_run(test_stage_job, 0x1234) == CY_RSLT_SUCCESS);
+    for (pos = 0; (pos < TEST_STAGE_EVENT_TIMEOUT_MS) && (test_job_arg == 0); pos++)
+    {
+        usleep(1000);
+    }
+    OTA_TEST_CHECK(test_job_arg == 0x1234);
+    OTA_TEST_CHECK(app_ota_stage_run(NULL, 0) == CY_RSLT_OTA_ERROR_GENERAL);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the streaming transfer window: acknowledgements,
+ *              the NAK on a sequence gap, duplicates and the sequence wrap.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_ota_stream.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_STREAM_PAYLOAD_LEN             (20)
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/* Offer one DATA packet, as the handler does. Sets *p_ack when an acknowledgement is due. */
+static app_ota_stream_rx_t test_stream_packet(uint16_t seq, bool *p_ack)
+{
+    uint8_t packet[APP_OTA_STREAM_HDR_LEN + TEST_STREAM_PAYLOAD_LEN];
+    const uint8_t *p_payload = NULL;
+    uint16_t payload_len = 0;
+    app_ota_stream_rx_t rx;
+
+    packet[0] = (uint8_t)(seq >> 0);
+    packet[1] = (uint8_t)(seq >> 8);
+    memset(&packet[APP_OTA_STREAM_HDR_LEN], (uint8_t)seq, TEST_STREAM_PAYLOAD_LEN);
+
+    *p_ack = false;
+    rx = app_ota_stream_rx(packet, sizeof(packet), &p_payload, &payload_len);
+    if (rx == APP_OTA_STREAM_RX_ACCEPT)
+    {
+        OTA_TEST_CHECK(p_payload == &packet[APP_OTA_STREAM_HDR_LEN]);
+        OTA_TEST_CHECK(payload_len == TEST_STREAM_PAYLOAD_LEN);
+        *p_ack = app_ota_stream_accepted(payload_len);
+    }
+    return rx;
+}
+
+/* Next expected sequence number and accepted bytes, as reported in an acknowledgement */
+static void test_stream_ack(uint8_t status, uint16_t *p_next_seq, uint32_t *p_offset)
+{
+    uint8_t ack[APP_OTA_STREAM_ACK_LEN];
+
+    OTA_TEST_CHECK(app_ota_stream_build_ack(status, ack) == APP_OTA_STREAM_ACK_LEN);
+    OTA_TEST_CHECK(ack[0] == status);
+    *p_next_seq = (uint16_t)(ack[2] | (ack[3] << 8));
+    *p_offset = (uint32_t)ack[4] | ((uint32_t)ack[5] << 8) | ((uint32_t)ack[6] << 16) | ((uint32_t)ack[7] << 24);
+}
+
+void test_stream(void)
+{
+    const uint8_t prepare_legacy[] = { 0x01 };
+    const uint8_t prepare_default[] = { 0x01, APP_OTA_PREPARE_OPT_STREAM };
+    const uint8_t prepare_large[] = { 0x01, APP_OTA_PREPARE_OPT_STREAM, 200 };
+    const uint8_t prepare_window[] = { 0x01, APP_OTA_PREPARE_OPT_STREAM, 8 };
+    const uint8_t *p_payload;
+    uint16_t payload_len;
+    uint16_t next_seq;
+    uint32_t offset;
+    uint32_t acks;
+    uint16_t seq;
+    bool ack;
+
+    /* Negotiation: legacy without the option, the window is clamped */
+    OTA_TEST_CHECK(app_ota_stream_negotiate(prepare_legacy, sizeof(prepare_legacy)) == 0);
+    OTA_TEST_CHECK(!app_ota_stream_enabled());
+    OTA_TEST_CHECK(app_ota_stream_negotiate(prepare_default, sizeof(prepare_default)) == APP_OTA_STREAM_DEFAULT_WINDOW);
+    OTA_TEST_CHECK(app_ota_stream_negotiate(prepare_large, sizeof(prepare_large)) == APP_OTA_STREAM_MAX_WINDOW);
+    OTA_TEST_CHECK(app_ota_stream_negotiate(prepare_window, sizeof(prepare_window)) == 8);
+    OTA_TEST_CHECK(app_ota_stream_enabled());
+
+    /* In order: an acknowledgement every window / 2 packets */
+    app_ota_stream_start();
+    acks = 0;
+    for (seq = 0; seq < 32; seq++)
+    {
+        OTA_TEST_CHECK(test_stream_packet(seq, &ack) == APP_OTA_STREAM_RX_ACCEPT);
+        OTA_TEST_CHECK(ack == (((seq + 1) % 4) == 0));
+        acks += (ack) ? 1 : 0;
+    }
+    OTA_TEST_CHECK(acks == 8);
+    test_stream_ack(APP_OTA_STATUS_STREAM_ACK, &next_seq, &offset);
+    OTA_TEST_CHECK(next_seq == 32);
+    OTA_TEST_CHECK(offset == (32 * TEST_STREAM_PAYLOAD_LEN));
+
+    /* Too short for the sequence header */
+    OTA_TEST_CHECK(app_ota_stream_rx((const uint8_t *)"\x20", 1, &p_payload, &payload_len) == APP_OTA_STREAM_RX_INVALID);
+
+    /* Duplicates of the last window are dropped without a NAK */
+    OTA_TEST_CHECK(test_stream_packet(31, &ack) == APP_OTA_STREAM_RX_DUPLICATE);
+    OTA_TEST_CHECK(test_stream_packet(24, &ack) == APP_OTA_STREAM_RX_DUPLICATE);
+    OTA_TEST_CHECK(!ack);
+    test_stream_ack(APP_OTA_STATUS_STREAM_ACK, &next_seq, &offset);
+    OTA_TEST_CHECK(next_seq == 32);
+    OTA_TEST_CHECK(offset == (32 * TEST_STREAM_PAYLOAD_LEN));
+
+    /* Gap: one NAK, everything dropped until the expected packet is sent again */
+    OTA_TEST_CHECK(test_stream_packet(33, &ack) == APP_OTA_STREAM_RX_OUT_OF_ORDER);
+    test_stream_ack(APP_OTA_STATUS_STREAM_NAK, &next_seq, &offset);
+    OTA_TEST_CHECK(next_seq == 32);
+    OTA_TEST_CHECK(offset == (32 * TEST_STREAM_PAYLOAD_LEN));
+    OTA_TEST_CHECK(test_stream_packet(34, &ack) == APP_OTA_STREAM_RX_DUPLICATE);
+    OTA_TEST_CHECK(test_stream_packet(35, &ack) == APP_OTA_STREAM_RX_DUPLICATE);
+    OTA_TEST_CHECK(test_stream_packet(32, &ack) == APP_OTA_STREAM_RX_ACCEPT);
+    OTA_TEST_CHECK(test_stream_packet(33, &ack) == APP_OTA_STREAM_RX_ACCEPT);
+    test_stream_ack(APP_OTA_STATUS_STREAM_ACK, &next_seq, &offset);
+    OTA_TEST_CHECK(next_seq == 34);
+    OTA_TEST_CHECK(offset == (34 * TEST_STREAM_PAYLOAD_LEN));
+
+    /* A later gap is reported again */
+    OTA_TEST_CHECK(test_stream_packet(40, &ack) == APP_OTA_STREAM_RX_OUT_OF_ORDER);
+    OTA_TEST_CHECK(test_stream_packet(34, &ack) == APP_OTA_STREAM_RX_ACCEPT);
+
+    /* The 16-bit sequence wraps, duplicates are recognized across the wrap */
+    app_ota_stream_start();
+    for (seq = 0; seq != 0xFFFE; seq++)
+    {
+        (void)app_ota_stream_accepted(0);
+    }
+    OTA_TEST_CHECK(test_stream_packet(0xFFFE, &ack) == APP_OTA_STREAM_RX_ACCEPT);
+    OTA_TEST_CHECK(test_stream_packet(0xFFFF, &ack) == APP_OTA_STREAM_RX_ACCEPT);
+    OTA_TEST_CHECK(test_stream_packet(0x0000, &ack) == APP_OTA_STREAM_RX_ACCEPT);
+    OTA_TEST_CHECK(test_stream_packet(0xFFFF, &ack) == APP_OTA_STREAM_RX_DUPLICATE);
+    OTA_TEST_CHECK(test_stream_packet(0x0002, &ack) == APP_OTA_STREAM_RX_OUT_OF_ORDER);
+    OTA_TEST_CHECK(test_stream_packet(0x0001, &ack) == APP_OTA_STREAM_RX_ACCEPT);
+    test_stream_ack(APP_OTA_STATUS_STREAM_ACK, &next_seq, &offset);
+    OTA_TEST_CHECK(next_seq == 2);
+    OTA_TEST_CHECK(offset == (4 * TEST_STREAM_PAYLOAD_LEN));
+
+    app_ota_stream_stop();
+    OTA_TEST_CHECK(!app_ota_stream_enabled());
+}
+
+/* [] END OF FILE */
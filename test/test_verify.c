@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the software backend of the signature check,
+ *              SHA-256 and P-256 ECDSA. The known answer was made with
+ *              OpenSSL and checked with "openssl dgst -sha256 -verify".
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_ota_verify.h"
+#include "app_ota_sha256.h"
+#include "app_ota_protocol.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_VERIFY_IMAGE_SIZE              (5000)
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+/* FIPS 180-2 two block example, signed with the test key of ota_ecc_pp_host.c */
+static const char verify_kat_msg[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+static const uint8_t verify_kat_hash[APP_OTA_SHA256_HASH_LEN] =
+{
+    0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+    0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1,
+};
+
+static const uint8_t verify_kat_signature[APP_OTA_SIGNATURE_LEN] =
+{
+    0x0e, 0x39, 0xa2, 0x2b, 0xb6, 0x5a, 0x6a, 0xc4, 0x3e, 0xb3, 0x76, 0xd1, 0x43, 0xc3, 0x0a, 0x41,
+    0xc6, 0x27, 0x03, 0x4d, 0xda, 0xcf, 0xfc, 0xb0, 0xb2, 0xee, 0x74, 0x3d, 0x31, 0x79, 0xe1, 0xa0,
+    0x24, 0xee, 0x19, 0x02, 0x01, 0xa1, 0x25, 0x71, 0xd6, 0xeb, 0x55, 0x9f, 0xa3, 0x6d, 0x2f, 0x37,
+    0x18, 0x55, 0xb6, 0xe1, 0xa2, 0xbf, 0xb8, 0xf7, 0x34, 0xd7, 0xce, 0x8f, 0x79, 0xc0, 0xbc, 0x2f,
+};
+
+static uint8_t test_verify_image[TEST_VERIFY_IMAGE_SIZE];
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/* Hash an image in blocks like the storage thread, then check the signature */
+static cy_rslt_t test_verify_image_blocks(const uint8_t *p_image, uint32_t size, uint32_t block, const uint8_t *p_signature)
+{
+    uint32_t offset;
+
+    app_ota_verify_start(size);
+    for (offset = 0; offset < size; offset += block)
+    {
+        app_ota_verify_update(offset, &p_image[offset], ((size - offset) < block) ? (size - offset) : block);
+    }
+    if (p_signature != NULL)
+    {
+        app_ota_verify_set_signature(p_signature);
+    }
+    return app_ota_verify_finish(NULL);
+}
+
+void test_verify(void)
+{
+    uint8_t hash[APP_OTA_SHA256_HASH_LEN];
+    uint8_t signature[APP_OTA_SIGNATURE_LEN];
+    app_ota_sha256_t sha;
+
+    app_ota_verify_init();
+
+    /* Known answer, on the hash and through the image path */
+    OTA_TEST_CHECK(app_ota_verify_signature(verify_kat_hash, verify_kat_signature));
+    OTA_TEST_CHECK(test_verify_image_blocks((const uint8_t *)verify_kat_msg, sizeof(verify_kat_msg) - 1, 7, verify_kat_signature) == CY_RSLT_SUCCESS);
+    OTA_TEST_CHECK(test_verify_image_blocks((const uint8_t *)verify_kat_msg, sizeof(verify_kat_msg) - 1, 64, verify_kat_signature) == CY_RSLT_SUCCESS);
+
+    /* Any changed bit of the hash, r or s is refused */
+    memcpy(hash, verify_kat_hash, sizeof(hash));
+    hash[31] ^= 0x01;
+    OTA_TEST_CHECK(!app_ota_verify_signature(hash, verify_kat_signature));
+    memcpy(signature, verify_kat_signature, sizeof(signature));
+    signature[0] ^= 0x80;
+    OTA_TEST_CHECK(!app_ota_verify_signature(verify_kat_hash, signature));
+    memcpy(signature, verify_kat_signature, sizeof(signature));
+    signature[APP_OTA_SIGNATURE_LEN - 1] ^= 0x01;
+    OTA_TEST_CHECK(!app_ota_verify_signature(verify_kat_hash, signature));
+    OTA_TEST_CHECK(test_verify_image_blocks((const uint8_t *)verify_kat_msg, sizeof(verify_kat_msg) - 2, 7, verify_kat_signature) == CY_RSLT_OTA_ERROR_VERIFY);
+
+    /* s = 0 is out of range */
+    memcpy(signature, verify_kat_signature, sizeof(signature));
+    memset(&signature[APP_OTA_SIGNATURE_LEN / 2], 0x00, APP_OTA_SIGNATURE_LEN / 2);
+    OTA_TEST_CHECK(!app_ota_verify_signature(verify_kat_hash, signature));
+
+    /* No signature, nothing to verify */
+    OTA_TEST_CHECK(test_verify_image_blocks((const uint8_t *)verify_kat_msg, sizeof(verify_kat_msg) - 1, 7, NULL) == CY_RSLT_OTA_ERROR_VERIFY);
+
+    /* An image signed at run time, hashed in flash sector sized blocks */
+    ota_test_fill(test_verify_image, sizeof(test_verify_image), 9);
+    app_ota_sha256_start(&sha);
+    app_ota_sha256_update(&sha, test_verify_image, sizeof(test_verify_image));
+    app_ota_sha256_finish(&sha, hash);
+    OTA_TEST_CHECK(ota_test_ecdsa_sign(hash, signature));
+    OTA_TEST_CHECK(test_verify_image_blocks(test_verify_image, sizeof(test_verify_image), 4096, signature) == CY_RSLT_SUCCESS);
+    test_verify_image[4096] ^= 0x01;
+    OTA_TEST_CHECK(test_verify_image_blocks(test_verify_image, sizeof(test_verify_image), 4096, signature) == CY_RSLT_OTA_ERROR_VERIFY);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2024, Cypress Semiconductor Corporation (an Infineon company)
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Description: Host tests of the queued writes engine: several handles in
+ *              one queue, the offset order of each handle, a full queue,
+ *              a failing handle and cancel.
+ */
+
+/* *****************************************************************************
+ *                              INCLUDES
+ * ****************************************************************************/
+#include "ota_test.h"
+#include "app_bt_write_queue.h"
+#include <string.h>
+
+/* *****************************************************************************
+ *                              DEFINES
+ * ****************************************************************************/
+#define TEST_WQ_CONN_ID                     (0x0040)
+#define TEST_WQ_HANDLE_DATA                 (0x0010)
+#define TEST_WQ_HANDLE_CP                   (0x0020)
+#define TEST_WQ_SEG_LEN                     (100)
+#define TEST_WQ_MAX_CALLS                   (4)
+
+typedef struct
+{
+    uint16_t    handle;
+    uint8_t     num_segs;
+    uint16_t    total_len;
+    uint8_t     value[APP_BT_WRITE_QUEUE_SIZE];
+} test_wq_call_t;
+
+/* *****************************************************************************
+ *                              Data
+ * ****************************************************************************/
+static test_wq_call_t test_wq_calls[TEST_WQ_MAX_CALLS];
+static uint8_t test_wq_num_calls;
+static uint16_t test_wq_fail_handle;
+
+/* *****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ * ****************************************************************************/
+
+/* Records the value of each handle as it would be written */
+static wiced_bt_gatt_status_t test_wq_callback(void *context, uint16_t handle, const app_bt_write_seg_t *p_segs, uint8_t num_segs, uint16_t total_len)
+{
+    test_wq_call_t *p_call;
+    uint16_t pos = 0;
+    uint8_t i;
+
+    OTA_TEST_CHECK(context == (void *)test_wq_calls);
+    if (test_wq_num_calls >= TEST_WQ_MAX_CALLS)
+    {
+        return WICED_BT_GATT_ERROR;
+    }
+    p_call = &test_wq_calls[test_wq_num_calls++];
+    p_call->handle = handle;
+    p_call->num_segs = num_segs;
+    p_call->total_len = total_len;
+    for (i = 0; i < num_segs; i++)
+    {
+        memcpy(&p_call->value[pos], p_segs[i].p_data, p_segs[i].len);
+        pos += p_segs[i].len;
+    }
+    OTA_TEST_CHECK(pos == total_len);
+
+    return (handle == test_wq_fail_handle) ? WICED_BT_GATT_WRITE_NOT_PERMIT : WICED_BT_GATT_SUCCESS;
+}
+
+static wiced_bt_gatt_status_t test_wq_execute(uint16_t *p_err_handle)
+{
+    test_wq_num_calls = 0;
+    *p_err_handle = 0;
+    return app_bt_write_queue_execute(TEST_WQ_CONN_ID, test_wq_callback, test_wq_calls, p_err_handle);
+}
+
+void test_write_queue(void)
+{
+    static uint8_t data[APP_BT_WRITE_QUEUE_SIZE + TEST_WQ_SEG_LEN];
+    const uint8_t cp[] = { 0x03, 0x11, 0x22 };
+    const uint8_t *p_stored;
+    uint16_t err_handle;
+    uint16_t offset;
+    uint32_t segs;
+
+    ota_test_fill(data, sizeof(data), 0x5157);
+    app_bt_write_queue_clear();
+    test_wq_fail_handle = 0;
+
+    /* Two handles interleaved: one callback per handle, in the order the handles were first prepared */
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, 0, data, TEST_WQ_SEG_LEN, &p_stored) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(memcmp(p_stored, data, TEST_WQ_SEG_LEN) == 0);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_CP, 0, cp, 1, &p_stored) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, TEST_WQ_SEG_LEN, &data[TEST_WQ_SEG_LEN], TEST_WQ_SEG_LEN, &p_stored) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_CP, 1, &cp[1], 2, &p_stored) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, 2 * TEST_WQ_SEG_LEN, &data[2 * TEST_WQ_SEG_LEN], 7, &p_stored) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(test_wq_execute(&err_handle) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(test_wq_num_calls == 2);
+    OTA_TEST_CHECK(test_wq_calls[0].handle == TEST_WQ_HANDLE_DATA);
+    OTA_TEST_CHECK(test_wq_calls[0].num_segs == 3);
+    OTA_TEST_CHECK(test_wq_calls[0].total_len == ((2 * TEST_WQ_SEG_LEN) + 7));
+    OTA_TEST_CHECK(memcmp(test_wq_calls[0].value, data, test_wq_calls[0].total_len) == 0);
+    OTA_TEST_CHECK(test_wq_calls[1].handle == TEST_WQ_HANDLE_CP);
+    OTA_TEST_CHECK(test_wq_calls[1].num_segs == 2);
+    OTA_TEST_CHECK(test_wq_calls[1].total_len == sizeof(cp));
+    OTA_TEST_CHECK(memcmp(test_wq_calls[1].value, cp, sizeof(cp)) == 0);
+
+    /* The queue is empty after an Execute Write */
+    OTA_TEST_CHECK(test_wq_execute(&err_handle) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(test_wq_num_calls == 0);
+
+    /* Offsets must follow the value already queued for the handle */
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, 5, data, TEST_WQ_SEG_LEN, &p_stored) == WICED_BT_GATT_INVALID_OFFSET);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, 0, data, TEST_WQ_SEG_LEN, &p_stored) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, 0, data, TEST_WQ_SEG_LEN, &p_stored) == WICED_BT_GATT_INVALID_OFFSET);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, 2 * TEST_WQ_SEG_LEN, data, TEST_WQ_SEG_LEN, &p_stored) == WICED_BT_GATT_INVALID_OFFSET);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_CP, 0, cp, 1, &p_stored) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, TEST_WQ_SEG_LEN, &data[TEST_WQ_SEG_LEN], TEST_WQ_SEG_LEN, &p_stored) == WICED_BT_GATT_SUCCESS);
+
+    /* Another connection cannot use the queue */
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID + 1, TEST_WQ_HANDLE_CP, 0, cp, 1, &p_stored) == WICED_BT_GATT_PREPARE_Q_FULL);
+    OTA_TEST_CHECK(app_bt_write_queue_execute(TEST_WQ_CONN_ID + 1, test_wq_callback, test_wq_calls, &err_handle) == WICED_BT_GATT_SUCCESS);
+
+    /* Cancel drops everything */
+    app_bt_write_queue_clear();
+    OTA_TEST_CHECK(test_wq_execute(&err_handle) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(test_wq_num_calls == 0);
+
+    /* Full by bytes: the arena takes APP_BT_WRITE_QUEUE_SIZE, the value that overflows is refused alone */
+    for (offset = 0; (offset + TEST_WQ_SEG_LEN) <= APP_BT_WRITE_QUEUE_SIZE; offset += TEST_WQ_SEG_LEN)
+    {
+        if (app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, offset, &data[offset], TEST_WQ_SEG_LEN, &p_stored) != WICED_BT_GATT_SUCCESS)
+        {
+            break;
+        }
+    }
+    segs = offset / TEST_WQ_SEG_LEN;
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, offset, &data[offset], TEST_WQ_SEG_LEN, &p_stored) == WICED_BT_GATT_PREPARE_Q_FULL);
+    OTA_TEST_CHECK(test_wq_execute(&err_handle) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(test_wq_num_calls == 1);
+    OTA_TEST_CHECK(test_wq_calls[0].num_segs == segs);
+    OTA_TEST_CHECK(test_wq_calls[0].total_len == offset);
+    OTA_TEST_CHECK(memcmp(test_wq_calls[0].value, data, offset) == 0);
+
+    /* Full by segments */
+    for (offset = 0; offset < APP_BT_WRITE_QUEUE_MAX_SEGMENTS; offset++)
+    {
+        OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, offset, &data[offset], 1, &p_stored) == WICED_BT_GATT_SUCCESS);
+    }
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, offset, &data[offset], 1, &p_stored) == WICED_BT_GATT_PREPARE_Q_FULL);
+    OTA_TEST_CHECK(test_wq_execute(&err_handle) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(test_wq_calls[0].total_len == APP_BT_WRITE_QUEUE_MAX_SEGMENTS);
+
+    /* A failing handle stops the Execute Write and is reported, the queue is dropped */
+    test_wq_fail_handle = TEST_WQ_HANDLE_CP;
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_CP, 0, cp, sizeof(cp), &p_stored) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(app_bt_write_queue_prepare(TEST_WQ_CONN_ID, TEST_WQ_HANDLE_DATA, 0, data, TEST_WQ_SEG_LEN, &p_stored) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(test_wq_execute(&err_handle) == WICED_BT_GATT_WRITE_NOT_PERMIT);
+    OTA_TEST_CHECK(err_handle == TEST_WQ_HANDLE_CP);
+    OTA_TEST_CHECK(test_wq_num_calls == 1);
+    OTA_TEST_CHECK(test_wq_execute(&err_handle) == WICED_BT_GATT_SUCCESS);
+    OTA_TEST_CHECK(test_wq_num_calls == 0);
+    test_wq_fail_handle = 0;
+}
+
+/* [] END OF FILE */